@@ -28,6 +28,8 @@ class UCookCommandlet
 	bool bLeakTest;  
 	/** Save all cooked packages without versions. These are then assumed to be current version on load. This is dangerous but results in smaller patch sizes. */
 	bool bUnversioned;
+	/** Save properties of cooked packages without tags, as a bitmask of non-default values. Requires the game to be built from the same property layout. */
+	bool bUnversionedProperties;
 	/** Generate manifests for building streaming install packages */
 	bool bGenerateStreamingInstallManifests;
 	/** All commandline tokens */
@@ -493,6 +493,7 @@ int32 UCookCommandlet::Main(const FString& CmdLineParams)
 	bCookAll = Switches.Contains(TEXT("COOKALL"));   // Cook everything
 	bLeakTest = Switches.Contains(TEXT("LEAKTEST"));   // Test for UObject leaks
 	bUnversioned = Switches.Contains(TEXT("UNVERSIONED"));   // Save all cooked packages without versions. These are then assumed to be current version on load. This is dangerous but results in smaller patch sizes.
+	bUnversionedProperties = Switches.Contains(TEXT("UNVERSIONEDPROPERTIES"));   // Save cooked properties without tags. Smaller and faster to load, but any property layout change requires a recook.
 	bGenerateStreamingInstallManifests = Switches.Contains(TEXT("MANIFESTS"));   // Generate manifests for building streaming install packages
 	bCompressed = Switches.Contains(TEXT("COMPRESSED"));
 	bIterativeCooking = Switches.Contains(TEXT("ITERATE"));
@@ -1043,7 +1044,7 @@ bool UCookCommandlet::Cook(const TArray<ITargetPlatform*>& Platforms, TArray<FSt
 
 					bool bWasUpToDate = false;
 
-					SaveCookedPackage(Pkg, SAVE_KeepGUID | SAVE_Async | (bUnversioned ? SAVE_Unversioned : 0), bWasUpToDate);
+					SaveCookedPackage(Pkg, SAVE_KeepGUID | SAVE_Async | (bUnversioned ? SAVE_Unversioned : 0) | (bUnversionedProperties ? SAVE_UnversionedProperties : 0), bWasUpToDate);
 
 					PackagesToNotReload.Add(Pkg->GetName());
 					Pkg->PackageFlags |= PKG_ReloadingForCooker;
@@ -145,37 +145,36 @@ public:
 				delete InputFilePtr;
 			}
 
-			// Prepare for output
-			FArchive* OutputFilePtr = CreateOutputArchive();
-			check(OutputFilePtr);
-			WriteToOutputArchive(OutputFilePtr, JobResults);
-
-			// Close the output file.
-			delete OutputFilePtr;
-
-#if PLATFORM_MAC			
-			// Change the output file name to requested one
-			IFileManager::Get().Move(*OutputFilePath, *TempFilePath);
-#endif
-
 #if PLATFORM_SUPPORTS_NAMED_PIPES
-			if (CommunicationMode == ThroughNamedPipeOnce || CommunicationMode == ThroughNamedPipe)
+			if (IsUsingNamedPipes())
 			{
-				VerifyResult(Pipe.WriteInt32(TransferBufferOut.Num()), TEXT("Writing Transfer Size"));
-				VerifyResult(Pipe.WriteBytes(TransferBufferOut.Num(), TransferBufferOut.GetData()), TEXT("Writing Transfer Buffer"));
-//FPlatformMisc::LowLevelOutputDebugStringf(TEXT("*** Closing pipe...\n"));
-				Pipe.Destroy();
-
+				// The results have already been streamed back one job at a time
 				if (CommunicationMode == ThroughNamedPipeOnce)
 				{
+					Pipe.Destroy();
 					// Give up CPU time while we are waiting
 					FPlatformProcess::Sleep(0.02f);
 					break;
 				}
 
+				// Stay connected, the next batch arrives through the same pipe
 				LastConnectionTime = FPlatformTime::Seconds();
+				continue;
 			}
 #endif	// PLATFORM_SUPPORTS_NAMED_PIPES
+
+			// Prepare for output
+			FArchive* OutputFilePtr = CreateOutputArchive();
+			check(OutputFilePtr);
+			WriteToOutputArchive(OutputFilePtr, JobResults);
+
+			// Close the output file.
+			delete OutputFilePtr;
+
+#if PLATFORM_MAC			
+			// Change the output file name to requested one
+			IFileManager::Get().Move(*OutputFilePath, *TempFilePath);
+#endif
 		}
 
 		UE_LOG(LogShaders, Log, TEXT("Exiting job loop"));
@@ -229,19 +228,25 @@ private:
 #if PLATFORM_SUPPORTS_NAMED_PIPES
 				check(IsUsingNamedPipes()); //UE_LOG(LogShaders, Log, TEXT("Opening Pipe %s\n"), *InputFilePath);
 //FPlatformMisc::LowLevelOutputDebugStringf(TEXT("*** Trying to open pipe %s\n"), *InputFilePath);
-				if (Pipe.Create(InputFilePath, false, false))
+				// The connection is kept between batches, so only connect if there isn't one already
+				if (Pipe.IsCreated() || Pipe.Create(InputFilePath, false, false))
 				{
 //FPlatformMisc::LowLevelOutputDebugStringf(TEXT("\tOpened!!!\n"));
-					// Read the total number of bytes
+					// Read the total number of bytes, this blocks until the next batch is sent
 					int32 TransferSize = 0;
-					VerifyResult(Pipe.ReadInt32(TransferSize));
+					if (Pipe.ReadInt32(TransferSize))
+					{
+						// Prealloc and read the full buffer
+						TransferBufferIn.Empty(TransferSize);
+						TransferBufferIn.AddUninitialized(TransferSize);	//UE_LOG(LogShaders, Log, TEXT("Reading Buffer\n"));
+						VerifyResult(Pipe.ReadBytes(TransferSize, TransferBufferIn.GetData()));
 
-					// Prealloc and read the full buffer
-					TransferBufferIn.Empty(TransferSize);
-					TransferBufferIn.AddUninitialized(TransferSize);	//UE_LOG(LogShaders, Log, TEXT("Reading Buffer\n"));
-					VerifyResult(Pipe.ReadBytes(TransferSize, TransferBufferIn.GetData()));
+						return new FMemoryReader(TransferBufferIn);
+					}
 
-					return new FMemoryReader(TransferBufferIn);
+					// The engine closed its end, e.g. to recreate the pipe after an error. Reconnect.
+					Pipe.Destroy();
+					LastConnectionTime = FPlatformTime::Seconds();
 				}
 
 				double DeltaTime = FPlatformTime::Seconds();
@@ -295,12 +300,38 @@ private:
 			FShaderCompilerOutput CompilerOutput;
 			ProcessCompilationJob(CompilerInput,CompilerOutput,WorkingDirectory);
 
+#if PLATFORM_SUPPORTS_NAMED_PIPES
+			if (IsUsingNamedPipes())
+			{
+				// Send the result back right away so the engine can use it while the rest of the batch compiles
+				WriteJobResultToPipe(CompilerOutput);
+				continue;
+			}
+#endif	// PLATFORM_SUPPORTS_NAMED_PIPES
+
 			// Serialize the job's output.
 			FJobResult& JobResult = *new(OutJobResults) FJobResult;
 			JobResult.CompilerOutput = CompilerOutput;
 		}
 	}
 
+#if PLATFORM_SUPPORTS_NAMED_PIPES
+	/** Sends the output of a single job through the pipe, in the same format as an output file holding one job. */
+	void WriteJobResultToPipe(const FShaderCompilerOutput& CompilerOutput)
+	{
+		TArray<FJobResult> JobResults;
+		FJobResult& JobResult = *new(JobResults) FJobResult;
+		JobResult.CompilerOutput = CompilerOutput;
+
+		TransferBufferOut.Reset();
+		FMemoryWriter TransferWriter(TransferBufferOut);
+		WriteToOutputArchive(&TransferWriter, JobResults);
+
+		VerifyResult(Pipe.WriteInt32(TransferBufferOut.Num()), TEXT("Writing Transfer Size"));
+		VerifyResult(Pipe.WriteBytes(TransferBufferOut.Num(), TransferBufferOut.GetData()), TEXT("Writing Transfer Buffer"));
+	}
+#endif	// PLATFORM_SUPPORTS_NAMED_PIPES
+
 	FArchive* CreateOutputArchive()
 	{
 		FArchive* OutputFilePtr = NULL;
@@ -610,7 +641,15 @@ INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
 
 	TCHAR OutputFilePath[PLATFORM_MAX_FILEPATH_LENGTH];
 	FCString::Strncpy(OutputFilePath, ArgV[1], PLATFORM_MAX_FILEPATH_LENGTH);
-	FCString::Strncat(OutputFilePath, ArgV[5], PLATFORM_MAX_FILEPATH_LENGTH);
+	// The output name is the pipe's name when talking through a named pipe, so the crash report goes to a file of its own
+	if (ArgC > 6 && FCString::Strnicmp(ArgV[6], TEXT("-communicatethroughnamedpipe"), 28) == 0)
+	{
+		FCString::Strncat(OutputFilePath, TEXT("WorkerCrash.out"), PLATFORM_MAX_FILEPATH_LENGTH);
+	}
+	else
+	{
+		FCString::Strncat(OutputFilePath, ArgV[5], PLATFORM_MAX_FILEPATH_LENGTH);
+	}
 
 	const int32 ReturnCode = GuardedMainWrapper(ArgC,ArgV,OutputFilePath);
 	return ReturnCode;
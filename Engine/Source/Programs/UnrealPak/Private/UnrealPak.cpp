@@ -7,6 +7,7 @@
 #include "BigInt.h"
 #include "SignedArchiveWriter.h"
 #include "KeyGenerator.h"
+#include "ParallelFor.h"
 
 IMPLEMENT_APPLICATION(UnrealPak, "UnrealPak");
 
@@ -101,7 +102,56 @@ FString GetCommonRootPath(TArray<FPakInputPair>& FilesToAdd)
 }
 
 
-bool CopyFileToPak(FArchive& InPak, const FString& InMountPoint, const FPakInputPair& InFile, uint8*& InOutPersistentBuffer, int64& InOutBufferSize, FPakEntryPair& OutNewEntry)
+/** Uncompressed size of the blocks compressed entries are split into. */
+static const int64 PakCompressionBlockSize = 64 * 1024;
+
+/**
+ * Compresses a file into blocks, which can be decompressed independently of each other so that the runtime can seek within the file
+ * and decompress large reads in parallel. Blocks that do not shrink are stored uncompressed.
+ *
+ * @param UncompressedData File contents.
+ * @param UncompressedSize Size of the file.
+ * @param InOutCompressedBuffer Scratch buffer, receives the compressed blocks.
+ * @param OutBlockSizes Stored size of each block.
+ * @return Total stored size of all blocks.
+ */
+int64 CompressFileBlocks(const uint8* UncompressedData, int64 UncompressedSize, TArray<uint8>& InOutCompressedBuffer, TArray<int32>& OutBlockSizes)
+{
+	// zlib can make incompressible data slightly bigger, leave it some room
+	const int64 MaxCompressedBlockSize = PakCompressionBlockSize + PakCompressionBlockSize / 10 + 1024;
+	const int32 NumBlocks = (int32)((UncompressedSize + PakCompressionBlockSize - 1) / PakCompressionBlockSize);
+	InOutCompressedBuffer.Reset();
+	InOutCompressedBuffer.AddUninitialized(NumBlocks * MaxCompressedBlockSize);
+	OutBlockSizes.Reset();
+	OutBlockSizes.AddZeroed(NumBlocks);
+
+	uint8* CompressedData = InOutCompressedBuffer.GetTypedData();
+	int32* BlockSizes = OutBlockSizes.GetTypedData();
+	ParallelFor(NumBlocks, [=](int32 BlockIndex)
+	{
+		const uint8* UncompressedBlock = UncompressedData + BlockIndex * PakCompressionBlockSize;
+		const int32 UncompressedBlockSize = (int32)FMath::Min(PakCompressionBlockSize, UncompressedSize - BlockIndex * PakCompressionBlockSize);
+		uint8* CompressedBlock = CompressedData + BlockIndex * MaxCompressedBlockSize;
+		int32 CompressedBlockSize = (int32)MaxCompressedBlockSize;
+		if (!FCompression::CompressMemory(COMPRESS_ZLIB, CompressedBlock, CompressedBlockSize, UncompressedBlock, UncompressedBlockSize) || CompressedBlockSize >= UncompressedBlockSize)
+		{
+			FMemory::Memcpy(CompressedBlock, UncompressedBlock, UncompressedBlockSize);
+			CompressedBlockSize = UncompressedBlockSize;
+		}
+		BlockSizes[BlockIndex] = CompressedBlockSize;
+	}, EParallelForFlags::AllowNamedThreadCaller);
+
+	// Pack the blocks back to back
+	int64 CompressedSize = 0;
+	for (int32 BlockIndex = 0; BlockIndex < NumBlocks; BlockIndex++)
+	{
+		FMemory::Memmove(CompressedData + CompressedSize, CompressedData + BlockIndex * MaxCompressedBlockSize, BlockSizes[BlockIndex]);
+		CompressedSize += BlockSizes[BlockIndex];
+	}
+	return CompressedSize;
+}
+
+bool CopyFileToPak(FArchive& InPak, const FString& InMountPoint, const FPakInputPair& InFile, bool bCompress, uint8*& InOutPersistentBuffer, int64& InOutBufferSize, TArray<uint8>& InOutCompressedBuffer, FPakEntryPair& OutNewEntry)
 {	
 	TAutoPtr<FArchive> FileHandle(IFileManager::Get().CreateFileReader(*InFile.Source));
 	bool bFileExists = FileHandle.IsValid();
@@ -122,12 +172,39 @@ bool CopyFileToPak(FArchive& InPak, const FString& InMountPoint, const FPakInput
 
 		// Load to buffer
 		FileHandle->Serialize(InOutPersistentBuffer, FileSize);
-		// Calculate the buffer hash value
-		FSHA1::HashBuffer(InOutPersistentBuffer, FileSize, OutNewEntry.Info.Hash);
+
+		uint8* DataToWrite = InOutPersistentBuffer;
+		if (bCompress && FileSize > 0)
+		{
+			TArray<int32> BlockSizes;
+			const int64 CompressedSize = CompressFileBlocks(InOutPersistentBuffer, FileSize, InOutCompressedBuffer, BlockSizes);
+			// Keep the file uncompressed if compression does not buy anything, reading it is cheaper that way
+			if (CompressedSize < FileSize)
+			{
+				OutNewEntry.Info.Size = CompressedSize;
+				OutNewEntry.Info.CompressionMethod = COMPRESS_ZLIB;
+				OutNewEntry.Info.CompressionBlockSize = (uint32)PakCompressionBlockSize;
+				OutNewEntry.Info.CompressionBlocks.AddZeroed(BlockSizes.Num());
+
+				// Block offsets are relative to the entry header, whose size depends on the number of blocks but not on their offsets
+				int64 BlockStart = OutNewEntry.Info.GetSerializedSize(FPakInfo::PakFile_Version_Latest);
+				for (int32 BlockIndex = 0; BlockIndex < BlockSizes.Num(); BlockIndex++)
+				{
+					FPakCompressedBlock& Block = OutNewEntry.Info.CompressionBlocks[BlockIndex];
+					Block.CompressedStart = BlockStart;
+					Block.CompressedEnd = BlockStart + BlockSizes[BlockIndex];
+					BlockStart = Block.CompressedEnd;
+				}
+				DataToWrite = InOutCompressedBuffer.GetTypedData();
+			}
+		}
+
+		// Calculate the hash value of the data as it is stored
+		FSHA1::HashBuffer(DataToWrite, OutNewEntry.Info.Size, OutNewEntry.Info.Hash);
 
 		// Write to file
 		OutNewEntry.Info.Serialize(InPak, FPakInfo::PakFile_Version_Latest);
-		InPak.Serialize(InOutPersistentBuffer, FileSize);
+		InPak.Serialize(DataToWrite, OutNewEntry.Info.Size);
 	}
 	return bFileExists;
 }
@@ -416,18 +493,29 @@ bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
 	FString MountPoint = GetCommonRootPath(FilesToAdd);
 	uint8* ReadBuffer = NULL;
 	int64 BufferSize = 0;
+	TArray<uint8> CompressedBuffer;
+	const bool bCompress = FParse::Param(FCommandLine::Get(), TEXT("compress"));
+	int64 TotalUncompressedSize = 0;
 
 	for (int32 FileIndex = 0; FileIndex < FilesToAdd.Num(); FileIndex++)
 	{
 		//  Remember the offset but don't serialize it with the entry header.
 		const int64 NewEntryOffset = PakFileHandle->Tell();
 		FPakEntryPair NewEntry;
-		if (CopyFileToPak(*PakFileHandle, MountPoint, FilesToAdd[FileIndex], ReadBuffer, BufferSize, NewEntry) == true)
+		if (CopyFileToPak(*PakFileHandle, MountPoint, FilesToAdd[FileIndex], bCompress, ReadBuffer, BufferSize, CompressedBuffer, NewEntry) == true)
 		{
 			// Update offset now and store it in the index (and only in index)
 			NewEntry.Info.Offset = NewEntryOffset;
 			Index.Add(NewEntry);
-			UE_LOG(LogPakFile, Display, TEXT("Added file \"%s\", %lld bytes."), *NewEntry.Filename, NewEntry.Info.Size);
+			TotalUncompressedSize += NewEntry.Info.UncompressedSize;
+			if (NewEntry.Info.CompressionMethod != COMPRESS_None)
+			{
+				UE_LOG(LogPakFile, Display, TEXT("Added file \"%s\", %lld bytes (%lld bytes uncompressed)."), *NewEntry.Filename, NewEntry.Info.Size, NewEntry.Info.UncompressedSize);
+			}
+			else
+			{
+				UE_LOG(LogPakFile, Display, TEXT("Added file \"%s\", %lld bytes."), *NewEntry.Filename, NewEntry.Info.Size);
+			}
 		}
 		else
 		{
@@ -462,7 +550,7 @@ bool CreatePakFile(const TCHAR* Filename, TArray<FPakInputPair>& FilesToAdd)
 	// Save trailer (offset, size, hash value)
 	Info.Serialize(*PakFileHandle);
 
-	UE_LOG(LogPakFile, Display, TEXT("Added %d files, %lld bytes total, time %.2lfs."), Index.Num(), PakFileHandle->TotalSize(), FPlatformTime::Seconds() - StartTime);
+	UE_LOG(LogPakFile, Display, TEXT("Added %d files, %lld bytes total (%lld bytes uncompressed), time %.2lfs."), Index.Num(), PakFileHandle->TotalSize(), TotalUncompressedSize, FPlatformTime::Seconds() - StartTime);
 
 	PakFileHandle->Close();
 	PakFileHandle.Reset();
@@ -550,7 +638,28 @@ bool ExtractFilesFromPak(const TCHAR* InPakFilename, const TCHAR* InDestPath)
 				TAutoPtr<FArchive> FileHandle(IFileManager::Get().CreateFileWriter(*DestFilename));
 				if (FileHandle.IsValid())
 				{
-					BufferedCopyFile(*FileHandle, PakReader, Entry.Size, Buffer, BufferSize);
+					if (Entry.CompressionMethod != COMPRESS_None)
+					{
+						// Let the pak file handle do the decompression
+						FPakFileHandle PakFileHandle(PakFile, Entry, &PakReader, true);
+						int64 RemainingSizeToCopy = Entry.UncompressedSize;
+						while (RemainingSizeToCopy > 0)
+						{
+							const int64 SizeToCopy = FMath::Min(BufferSize, RemainingSizeToCopy);
+							if (!PakFileHandle.Read((uint8*)Buffer, SizeToCopy))
+							{
+								UE_LOG(LogPakFile, Error, TEXT("Unable to decompress \"%s\"."), *It.Filename());
+								ErrorCount++;
+								break;
+							}
+							FileHandle->Serialize(Buffer, SizeToCopy);
+							RemainingSizeToCopy -= SizeToCopy;
+						}
+					}
+					else
+					{
+						BufferedCopyFile(*FileHandle, PakReader, Entry.Size, Buffer, BufferSize);
+					}
 					UE_LOG(LogPakFile, Display, TEXT("Extracted \"%s\" to \"%s\"."), *It.Filename(), *DestFilename);
 				}
 				else
@@ -584,6 +693,7 @@ bool ExtractFilesFromPak(const TCHAR* InPakFilename, const TCHAR* InDestPath)
  *   -Test test if the pak file is healthy
  *   -Extract extracts pak file contents (followed by a path, i.e.: -extract D:\ExtractedPak)
  *   -Create=filename response file to create a pak file with
+ *   -Compress use with -create to store files as zlib compressed blocks
  *   -Sign=filename use the key pair in filename to sign a pak file, or: -sign=key_hex_values_separated_with_+, i.e: -sign=0x123456789abcdef+0x1234567+0x12345abc
  *    where the first number is the private key exponend, the second one is modulus and the third one is the public key exponent.
  *   -Signed use with -extract and -test to let the code know this is a signed pak
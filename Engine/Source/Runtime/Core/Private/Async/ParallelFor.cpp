@@ -0,0 +1,68 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	ParallelFor.cpp: ParallelFor scaling benchmark
+=============================================================================*/
+
+#include "CorePrivate.h"
+#include "ParallelFor.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Exec handler that runs the same loop with 0 to N helper workers and reports the speedup over the serial run.
+ * Usage: PARALLELFORBENCH [NUM=n] [WORK=n]
+ *   NUM	number of iterations
+ *   WORK	amount of arithmetic per iteration, small values expose the scheduling overhead
+ */
+static class FParallelForBenchExec : private FSelfRegisteringExec
+{
+	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) OVERRIDE
+	{
+		if( FParse::Command( &Cmd, TEXT("PARALLELFORBENCH") ) )
+		{
+			int32 Num = 1000000;
+			int32 Work = 64;
+			FParse::Value( Cmd, TEXT("NUM="), Num );
+			FParse::Value( Cmd, TEXT("WORK="), Work );
+
+			TArray<float> Results;
+			Results.AddZeroed(Num);
+			float* ResultsData = Results.GetData();
+			auto Body = [ResultsData, Work](int32 Index)
+			{
+				float Value = float(Index);
+				for (int32 Step = 0; Step < Work; Step++)
+				{
+					Value = FMath::Sqrt(Value * 1.0001f + 1.0f);
+				}
+				ResultsData[Index] = Value;
+			};
+
+			const int32 NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads();
+			Ar.Logf( TEXT("ParallelFor benchmark: %d iterations, work %d, %d worker threads"), Num, Work, NumWorkers );
+
+			double SerialSeconds = 0.0;
+			for (int32 NumHelpers = 0; NumHelpers <= NumWorkers; NumHelpers++)
+			{
+				// best of a few runs to filter out noise from other threads
+				double BestSeconds = MAX_dbl;
+				for (int32 Run = 0; Run < 5; Run++)
+				{
+					const double StartTime = FPlatformTime::Seconds();
+					ParallelForImpl::ParallelForWithMaxHelpers(Num, Body, EParallelForFlags::AllowNamedThreadCaller, NumHelpers);
+					BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartTime);
+				}
+				if (NumHelpers == 0)
+				{
+					SerialSeconds = BestSeconds;
+				}
+				Ar.Logf( TEXT("  %2d threads: %8.3fms  speedup %5.2fx"), NumHelpers + 1, BestSeconds * 1000.0, SerialSeconds / BestSeconds );
+			}
+			return true;
+		}
+		return false;
+	}
+} ParallelForBenchExec;
+
+#endif // !UE_BUILD_SHIPPING
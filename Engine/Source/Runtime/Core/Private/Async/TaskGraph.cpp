@@ -9,6 +9,17 @@ DEFINE_LOG_CATEGORY_STATIC(LogTaskGraph, Log, All);
 DEFINE_STAT(STAT_FReturnGraphTask);
 DEFINE_STAT(STAT_FTriggerEventGraphTask);
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued High Priority Tasks"), STAT_TaskGraph_QueuedHighPriorityTasks, STATGROUP_Threading);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued Normal Priority Tasks"), STAT_TaskGraph_QueuedNormalPriorityTasks, STATGROUP_Threading);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued Background Tasks"), STAT_TaskGraph_QueuedBackgroundTasks, STATGROUP_Threading);
+DECLARE_DWORD_COUNTER_STAT(TEXT("High Priority Tasks Started"), STAT_TaskGraph_StartedHighPriorityTasks, STATGROUP_Threading);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Normal Priority Tasks Started"), STAT_TaskGraph_StartedNormalPriorityTasks, STATGROUP_Threading);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Background Tasks Started"), STAT_TaskGraph_StartedBackgroundTasks, STATGROUP_Threading);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("High Priority Task Wait (ms)"), STAT_TaskGraph_HighPriorityWaitTime, STATGROUP_Threading);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Normal Priority Task Wait (ms)"), STAT_TaskGraph_NormalPriorityWaitTime, STATGROUP_Threading);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Background Task Wait (ms)"), STAT_TaskGraph_BackgroundWaitTime, STATGROUP_Threading);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tasks Pushed To Own Deque"), STAT_TaskGraph_LocalPushes, STATGROUP_Threading);
+
 namespace ENamedThreads
 {
 	CORE_API Type RenderThread = ENamedThreads::GameThread; // defaults to game and is set and reset by the render thread itself
@@ -114,6 +125,179 @@ private:
 
 };
 
+/** 
+ *	If true, tasks that a worker thread spawns for "any thread" go into that worker's FWorkStealingQueue, otherwise they go into its incoming list like tasks from other threads.
+ *	Only read when a task is queued, so it is safe to flip while the system is idle. Exists so that TASKGRAPHBENCH can compare both schedulers.
+**/
+static bool GTaskGraphUseWorkStealingQueues = true;
+
+/** 
+ *	FWorkStealingQueue
+ *	Fixed capacity Chase-Lev deque for the tasks a worker thread spawns itself.
+ *	The owning thread pushes and pops at the bottom (LIFO, so that freshly spawned work runs while its data is still in cache), 
+ *	any other thread steals from the top (FIFO, so that thieves take the oldest and usually largest pieces of work).
+ *	Only the owner ever writes Bottom; Top is only advanced with a compare and swap, which is how the owner and the thieves agree on who gets the last task.
+ *	Indices are free running and wrap, so they are always compared by their difference.
+**/
+class FWorkStealingQueue
+{
+public:
+	/** Constructor, sets the queue to the empty state. **/
+	FWorkStealingQueue()
+		: Top(0)
+		, Bottom(0)
+	{
+		FMemory::Memzero(Tasks, sizeof(Tasks));
+	}
+
+	/** 
+	 *	Adds a task to the bottom of the queue. Only called from the owning thread.
+	 *	@param Task; the task to add to the queue
+	 *	@return false if the queue is full, in which case the caller needs to put the task somewhere else
+	**/
+	bool Push(FBaseGraphTask* Task)
+	{
+		const int32 LocalBottom = Bottom;
+		const int32 LocalTop = Top;
+		// a stale Top is smaller than the real one, so this can only err on the side of reporting full
+		if (Distance(LocalTop, LocalBottom) >= CAPACITY)
+		{
+			return false;
+		}
+		Tasks[LocalBottom & INDEX_MASK] = Task;
+		// the task must be visible before the new bottom is
+		FPlatformMisc::MemoryBarrier();
+		Bottom = LocalBottom + 1;
+		return true;
+	}
+
+	/** 
+	 *	Pops the most recently pushed task. Only called from the owning thread.
+	 *	@return The newest task in the queue or NULL if the queue is empty or the last task was stolen from under us
+	**/
+	FBaseGraphTask* Pop()
+	{
+		const int32 LocalBottom = Bottom - 1;
+		Bottom = LocalBottom;
+		// the new bottom must be visible to thieves before we look at top
+		FPlatformMisc::MemoryBarrier();
+		const int32 LocalTop = Top;
+		if (Distance(LocalTop, LocalBottom) < 0)
+		{
+			// empty, put bottom back
+			Bottom = LocalBottom + 1;
+			return NULL;
+		}
+		FBaseGraphTask* Task = Tasks[LocalBottom & INDEX_MASK];
+		if (LocalTop == LocalBottom)
+		{
+			// last task, race the thieves for it
+			if (FPlatformAtomics::InterlockedCompareExchange(&Top, LocalTop + 1, LocalTop) != LocalTop)
+			{
+				Task = NULL;
+			}
+			Bottom = LocalTop + 1;
+		}
+		return Task;
+	}
+
+	/** 
+	 *	Steals the oldest task. Can be called from any thread.
+	 *	@return The oldest task in the queue or NULL if the queue was empty or another thread got there first
+	**/
+	FBaseGraphTask* Steal()
+	{
+		const int32 LocalTop = Top;
+		FPlatformMisc::MemoryBarrier();
+		const int32 LocalBottom = Bottom;
+		if (Distance(LocalTop, LocalBottom) <= 0)
+		{
+			return NULL;
+		}
+		// the slot cannot be reused until Top moves past it, and if it does our compare and swap fails
+		FBaseGraphTask* Task = Tasks[LocalTop & INDEX_MASK];
+		if (FPlatformAtomics::InterlockedCompareExchange(&Top, LocalTop + 1, LocalTop) != LocalTop)
+		{
+			return NULL;
+		}
+		return Task;
+	}
+
+	/** Returns true if the queue looked empty. CAUTION this can change before the function returns. **/
+	bool IsProbablyEmpty() const
+	{
+		return Distance(Top, Bottom) <= 0;
+	}
+
+private:
+	enum
+	{
+		/** Maximum number of tasks in the queue, must be a power of two. Tasks beyond this overflow into the incoming list. **/
+		CAPACITY=1024,
+		INDEX_MASK=CAPACITY - 1
+	};
+
+	/** Signed distance from From to To that is correct across wrap around of the indices. **/
+	static FORCEINLINE int32 Distance(int32 From, int32 To)
+	{
+		return int32(uint32(To) - uint32(From));
+	}
+
+	/** Ring buffer of tasks, only the [Top,Bottom) range is valid. **/
+	FBaseGraphTask*		Tasks[CAPACITY];
+	/** Index of the oldest task. Advanced by thieves and, for the last task, by the owner. **/
+	volatile int32		Top;
+	/** Index one past the newest task. Only written by the owner. **/
+	volatile int32		Bottom;
+};
+
+/** 
+ *	FPriorityTaskQueue
+ *	Thread safe FIFO for high priority and background tasks that have not been given to a particular worker.
+ *	These are low volume compared to normal tasks, so a lock is fine, and an empty queue can be checked without taking it.
+**/
+class FPriorityTaskQueue
+{
+public:
+	/** 
+	 *	Adds a task to the queue.
+	 *	@param Task; the task to add to the queue
+	**/
+	void Enqueue(FBaseGraphTask* Task)
+	{
+		FScopeLock Lock(&CriticalSection);
+		Tasks.Enqueue(Task);
+		NumQueued.Increment();
+	}
+
+	/** 
+	 *	Pops a task off the queue.
+	 *	@return The oldest task in the queue or NULL if the queue is empty
+	**/
+	FBaseGraphTask* Dequeue()
+	{
+		if (!NumQueued.GetValue())
+		{
+			return NULL;
+		}
+		FScopeLock Lock(&CriticalSection);
+		FBaseGraphTask* Task = Tasks.Dequeue();
+		if (Task)
+		{
+			NumQueued.Decrement();
+		}
+		return Task;
+	}
+
+private:
+	/** Protects Tasks. **/
+	FCriticalSection	CriticalSection;
+	/** The tasks, oldest first. **/
+	FTaskQueue			Tasks;
+	/** Number of tasks in the queue, readable without the lock. **/
+	FThreadSafeCounter	NumQueued;
+};
+
 
 /** 
  *	FTaskThread
@@ -134,6 +318,8 @@ public:
 		, PerThreadIDTLSSlot(0xffffffff)
 		, bAllowsStealsFromMe(false)
 		, bStealsFromOthers(false)
+		, StealRandomState(1)
+		, TasksSinceBackgroundWork(0)
 	{
 		NewTasks.Reset(128);
 	}
@@ -152,6 +338,8 @@ public:
 		PerThreadIDTLSSlot = InPerThreadIDTLSSlot;
 		bAllowsStealsFromMe = bInAllowsStealsFromMe;
 		bStealsFromOthers = bInStealsFromOthers;
+		// any non-zero seed works for xorshift, this just keeps the threads from picking the same victims in lock step
+		StealRandomState = (uint32(InThreadId) + 1) * 0x9E3779B9u;
 	}
 
 	// Calls meant to be called from "this thread".
@@ -264,17 +452,33 @@ public:
 				else
 				{
 					// because of stealing, we are only going to take one item
-					for (int32 Count = SPIN_COUNT + 1; !Task && Count ; Count--)
+					// high priority work jumps the queue, and every so often background work does too, so that a steady stream of normal work cannot starve it
+					Task = FindPriorityWork(ETaskPriority::High);
+					if (!Task && TasksSinceBackgroundWork >= BACKGROUND_STARVATION_INTERVAL)
+					{
+						Task = FindPriorityWork(ETaskPriority::Background);
+					}
+					// then our own deque, newest task first, then the tasks other threads gave us
+					if (!Task)
+					{
+						Task = StealableQueue.Pop();
+					}
+					if (!Task)
 					{
 						Task = Queue(QueueIndex).IncomingQueue.PopIfNotClosed();
+					}
+					// then spin for a while looking for work on the other workers before giving up our time slice, and eventually parking
+					for (int32 Count = WORKER_SPIN_COUNT + 1; !Task && Count ; Count--)
+					{
+						Task = FindWork();
 						if (!Task)
 						{
-							Task = FindWork();
+							Task = Queue(QueueIndex).IncomingQueue.PopIfNotClosed();
 						}
 					}
 					if (FPlatformProcess::SupportsMultithreading())
 					{
-						for (int32 Count = SLEEP_COUNT; !Task && Count ; Count--)
+						for (int32 Count = WORKER_SLEEP_COUNT; !Task && Count ; Count--)
 						{
 							FPlatformProcess::Sleep(0.0f);
 							Task = Queue(QueueIndex).IncomingQueue.PopIfNotClosed();
@@ -295,6 +499,8 @@ public:
 								bTasksOpen = false;
 							}
 #endif
+							// our deque is empty here, only the owner pushes to it, so the incoming list is the only thing that can wake us
+							checkThreadGraph(StealableQueue.IsProbablyEmpty());
 							if (Stall(QueueIndex))
 							{
 								Task = Queue(QueueIndex).IncomingQueue.PopIfNotClosed();
@@ -311,8 +517,26 @@ public:
 					bTasksOpen = true;
 					ProcessingTasks.Start(*StatName);
 				}
+				if (bAllowsStealsFromMe)
+				{
+					NoteTaskStarted(Task);
+				}
 #endif
+				// the background slot for this task was claimed when it was taken off the shared queue
+				const bool bBackgroundTask = bAllowsStealsFromMe && Task->GetPriority() == ETaskPriority::Background;
+				if (bBackgroundTask)
+				{
+					TasksSinceBackgroundWork = 0;
+				}
+				else
+				{
+					TasksSinceBackgroundWork++;
+				}
 				Task->Execute(NewTasks, ENamedThreads::Type(ThreadId | (QueueIndex << ENamedThreads::QueueIndexShift)));
+				if (bBackgroundTask)
+				{
+					NotifyBackgroundTaskComplete();
+				}
 			}
 			else
 			{
@@ -341,8 +565,12 @@ public:
 		checkThreadGraph(Queue(QueueIndex).StallRestartEvent); // make sure we are started up
 		if (bAllowsStealsFromMe)
 		{
-			bool bWasReopenedByMe = Queue(QueueIndex).IncomingQueue.ReopenIfClosedAndPush(Task);
-			checkThreadGraph(!bWasReopenedByMe); // if I am stalled, why am I here?
+			checkThreadGraph((FTaskThread*)FPlatformTLS::GetTlsValue(PerThreadIDTLSSlot) == this); // verify that we are the thread they say we are
+			if (!GTaskGraphUseWorkStealingQueues || !StealableQueue.Push(Task))
+			{
+				bool bWasReopenedByMe = Queue(QueueIndex).IncomingQueue.ReopenIfClosedAndPush(Task);
+				checkThreadGraph(!bWasReopenedByMe); // if I am stalled, why am I here?
+			}
 		}
 		else
 		{
@@ -409,9 +637,65 @@ public:
 	FBaseGraphTask* RequestSteal()
 	{
 		checkThreadGraph(bAllowsStealsFromMe); 
-		return Queue(0).IncomingQueue.PopIfNotClosed();
+		// oldest task the owner spawned itself, then anything that was given to the owner but it has not gotten to yet
+		FBaseGraphTask* Task = StealableQueue.Steal();
+		if (!Task)
+		{
+			Task = Queue(0).IncomingQueue.PopIfNotClosed();
+		}
+		return Task;
 	}
 
+#if STATS
+	/** 
+	 *	Updates the per priority stats when a task is handed to a worker thread.
+	 *	@param Task; the task that was queued
+	 **/
+	static void NoteTaskQueued(FBaseGraphTask* Task)
+	{
+		Task->QueuedCycles = FPlatformTime::Cycles();
+		switch (Task->GetPriority())
+		{
+		case ETaskPriority::High:
+			INC_DWORD_STAT(STAT_TaskGraph_QueuedHighPriorityTasks);
+			break;
+		case ETaskPriority::Background:
+			INC_DWORD_STAT(STAT_TaskGraph_QueuedBackgroundTasks);
+			break;
+		default:
+			INC_DWORD_STAT(STAT_TaskGraph_QueuedNormalPriorityTasks);
+			break;
+		}
+	}
+
+	/** 
+	 *	Updates the per priority stats when a worker thread starts a task.
+	 *	@param Task; the task that is about to execute
+	 **/
+	static void NoteTaskStarted(FBaseGraphTask* Task)
+	{
+		const float WaitMilliseconds = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - Task->QueuedCycles);
+		switch (Task->GetPriority())
+		{
+		case ETaskPriority::High:
+			DEC_DWORD_STAT(STAT_TaskGraph_QueuedHighPriorityTasks);
+			INC_DWORD_STAT(STAT_TaskGraph_StartedHighPriorityTasks);
+			INC_FLOAT_STAT_BY(STAT_TaskGraph_HighPriorityWaitTime, WaitMilliseconds);
+			break;
+		case ETaskPriority::Background:
+			DEC_DWORD_STAT(STAT_TaskGraph_QueuedBackgroundTasks);
+			INC_DWORD_STAT(STAT_TaskGraph_StartedBackgroundTasks);
+			INC_FLOAT_STAT_BY(STAT_TaskGraph_BackgroundWaitTime, WaitMilliseconds);
+			break;
+		default:
+			DEC_DWORD_STAT(STAT_TaskGraph_QueuedNormalPriorityTasks);
+			INC_DWORD_STAT(STAT_TaskGraph_StartedNormalPriorityTasks);
+			INC_FLOAT_STAT_BY(STAT_TaskGraph_NormalPriorityWaitTime, WaitMilliseconds);
+			break;
+		}
+	}
+#endif
+
 	/** 
 	 *Return true if this thread is processing tasks. This is only a "guess" if you ask for a thread other than yourself because that can change before the function returns.
 	 *@param QueueIndex, Queue to request quit from
@@ -479,6 +763,12 @@ private:
 		SPIN_COUNT=0,
 		/** The number of times to call FPlatformProcess::Sleep(0) and look for work before deciding to block on the stall event **/
 		SLEEP_COUNT=0,
+		/** The number of times a worker thread scans the other workers for work before it starts yielding. Waking a parked thread costs far more than a few scans. **/
+		WORKER_SPIN_COUNT=16,
+		/** The number of times a worker thread calls FPlatformProcess::Sleep(0) and looks for work before parking on the stall event **/
+		WORKER_SLEEP_COUNT=4,
+		/** A worker thread that has run this many other tasks in a row takes a waiting background task ahead of its normal work **/
+		BACKGROUND_STARVATION_INTERVAL=16,
 	};
 
 	/** Grouping of the data for an individual queue. **/
@@ -531,6 +821,19 @@ private:
 					int32 NewValue = IsStalled.Increment();
 					NotifyStalling();
 					checkThreadGraph(NewValue == 1); // there should be no concurrent calls to Stall!
+					if (bAllowsStealsFromMe)
+					{
+						// a task may have been queued, or pushed onto a peer's deque, after we last looked but before we were on the stalled list, in which case nobody is going to hand it to us
+						// FindWork checks the priority queues and then tries to steal from the other unnamed threads, skipping this one
+						FBaseGraphTask* LateTask = FindWork();
+						if (LateTask && Queue(QueueIndex).IncomingQueue.ReopenIfClosedAndPush(LateTask))
+						{
+							// we reopened our own queue, so nobody is going to trigger the event
+							NewValue = IsStalled.Decrement();
+							checkThreadGraph(NewValue == 0); // there should be no concurrent calls to Stall!
+							return true;
+						}
+					}
 					Queue(QueueIndex).StallRestartEvent->Wait();
 					NewValue = IsStalled.Decrement();
 					checkThreadGraph(NewValue == 0); // there should be no concurrent calls to Stall!
@@ -551,6 +854,28 @@ private:
 	 */
 	FBaseGraphTask* FindWork();
 
+	/**
+	 *	Internal function to get a waiting high priority or background task. Called from this thread.
+	 *	A background task that is returned holds one of the running background slots until NotifyBackgroundTaskComplete is called.
+	 *	@param Priority; ETaskPriority::High or ETaskPriority::Background
+	 *	@return Task to process, if any.
+	 */
+	FBaseGraphTask* FindPriorityWork(ETaskPriority::Type Priority);
+
+	/**
+	 *	Internal function to release the background slot of a background task that just finished. Called from this thread.
+	 */
+	void NotifyBackgroundTaskComplete();
+
+	/** @return next value of this thread's xorshift generator, used to pick steal victims. Called from this thread. **/
+	FORCEINLINE uint32 NextStealRandom()
+	{
+		StealRandomState ^= StealRandomState << 13;
+		StealRandomState ^= StealRandomState >> 17;
+		StealRandomState ^= StealRandomState << 5;
+		return StealRandomState;
+	}
+
 	/**
 	 *	Internal function to notify the that system that I am stalling. This is a hint to give me a job asap.
 	 */
@@ -580,6 +905,12 @@ private:
 	bool												bAllowsStealsFromMe;
 	/** If true, this is a worker thread and I will attempt to steal tasks when I run out of work. **/
 	bool												bStealsFromOthers;
+	/** State of the random generator used to pick steal victims. **/
+	uint32												StealRandomState;
+	/** Number of tasks this thread has run since its last background task. **/
+	int32												TasksSinceBackgroundWork;
+	/** For worker threads, the tasks this thread spawned itself. Other workers steal from here. **/
+	FWorkStealingQueue									StealableQueue;
 
 };
 
@@ -660,6 +991,8 @@ public:
 		PerThreadIDTLSSlot = FPlatformTLS::AllocTlsSlot();
 
 		NextUnnamedThreadMod = NumThreads - NumNamedThreads;
+		// keep at least one worker free of background work whenever there is more than one
+		MaxRunningBackgroundTasks = FMath::Max(NextUnnamedThreadMod - 1, 1);
 
 		for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
 		{
@@ -729,6 +1062,17 @@ public:
 		}
 		if (ThreadToExecuteOn == ENamedThreads::AnyThread)
 		{
+			const ETaskPriority::Type Priority = Task->GetPriority();
+			if (Priority != ETaskPriority::Normal && FPlatformProcess::SupportsMultithreading())
+			{
+				QueuePriorityTask(Task, Priority);
+				return;
+			}
+			if (CurrentThreadIfKnown >= NumNamedThreads && GTaskGraphUseWorkStealingQueues)
+			{
+				QueueTaskFromWorker(Task, CurrentThreadIfKnown);
+				return;
+			}
 			FTaskThread* TempTarget = StalledUnnamedThreads.Pop(); //@todo it is possible that a thread is in the process of stalling and we just missed it, non-fatal, but we could lose a whole task of potential parallelism.
 			if (TempTarget)
 			{
@@ -746,6 +1090,12 @@ public:
 					ThreadToExecuteOn = ENamedThreads::GameThread;
 				}
 			}
+#if STATS
+			if (ThreadToExecuteOn >= NumNamedThreads)
+			{
+				FTaskThread::NoteTaskQueued(Task);
+			}
+#endif
 		}
 		int32 QueueToExecuteOn = ENamedThreads::GetQueueIndex(ThreadToExecuteOn);
 		ThreadToExecuteOn = ENamedThreads::GetThreadIndex(ThreadToExecuteOn);
@@ -881,28 +1231,35 @@ public:
 	// API used by FWorkerThread's
 
 	/** 
-	 *	Attempt to steal some work from another thread.
+	 *	Attempt to steal some work from another thread. Waiting high priority tasks come first and background tasks last.
+	 *	Victims are visited starting at a random worker so that idle threads spread out over the busy ones instead of all hammering the same queue.
 	 *	@param	ThreadInNeed; Id of the thread requesting work.
+	 *	@param	RandomValue; random number from the thread in need, used to pick the first victim.
 	 *	@return Task that was stolen if any was found.
 	**/
-	FBaseGraphTask* FindWork(ENamedThreads::Type ThreadInNeed)
+	FBaseGraphTask* FindWork(ENamedThreads::Type ThreadInNeed, uint32 RandomValue)
 	{
 		// this can be called before my constructor is finished
+		const int32 NumUnnamedThreads = NumThreads - NumNamedThreads;
+		if (NumUnnamedThreads <= 0)
+		{
+			return NULL;
+		}
+		FBaseGraphTask* HighPriorityTask = FindPriorityWork(ETaskPriority::High);
+		if (HighPriorityTask)
+		{
+			return HighPriorityTask;
+		}
+		const int32 FirstVictim = int32(RandomValue % uint32(NumUnnamedThreads));
 		for (int32 Pass = 0; Pass < 2; Pass++)
 		{
-			for (int32 Test = ThreadInNeed - 1; Test >= NumNamedThreads; Test--)
+			for (int32 Offset = 0; Offset < NumUnnamedThreads; Offset++)
 			{
-				if (Pass || !Thread(Test).IsProbablyStalled())
+				const int32 Test = NumNamedThreads + (FirstVictim + Offset) % NumUnnamedThreads;
+				if (Test == ThreadInNeed)
 				{
-					FBaseGraphTask* Task = Thread(Test).RequestSteal();
-					if (Task)
-					{
-						return Task;
-					}
+					continue;
 				}
-			}
-			for (int32 Test = NumThreads - 1; Test > ThreadInNeed; Test--)
-			{
 				if (Pass || !Thread(Test).IsProbablyStalled())
 				{
 					FBaseGraphTask* Task = Thread(Test).RequestSteal();
@@ -913,7 +1270,46 @@ public:
 				}
 			}
 		}
-		return NULL;
+		// nothing else to do, so this is a good time for background work
+		return FindPriorityWork(ETaskPriority::Background);
+	}
+
+	/** 
+	 *	Get a waiting high priority or background task. Background tasks are only handed out while fewer than MaxRunningBackgroundTasks are running.
+	 *	The slot is claimed before the task is dequeued, so racing workers can never push the count over the limit; a returned background task keeps its slot until NotifyBackgroundTaskComplete.
+	 *	@param	Priority; ETaskPriority::High or ETaskPriority::Background
+	 *	@return Task to process, if any.
+	**/
+	FBaseGraphTask* FindPriorityWork(ETaskPriority::Type Priority)
+	{
+		checkThreadGraph(Priority != ETaskPriority::Normal);
+		if (Priority != ETaskPriority::Background)
+		{
+			return PriorityQueues[Priority].Dequeue();
+		}
+		if (RunningBackgroundTasks.Increment() > MaxRunningBackgroundTasks)
+		{
+			// overshot, somebody else got the last slot
+			RunningBackgroundTasks.Decrement();
+			return NULL;
+		}
+		FBaseGraphTask* Task = PriorityQueues[Priority].Dequeue();
+		if (!Task)
+		{
+			RunningBackgroundTasks.Decrement();
+		}
+		return Task;
+	}
+
+	/** 
+	 *	Releases the slot of a background task that just finished executing.
+	 *	Background tasks that were held back by the limit have nobody else to hand them out, so a stalled worker is woken for the next one.
+	**/
+	void NotifyBackgroundTaskComplete()
+	{
+		int32 NewValue = RunningBackgroundTasks.Decrement();
+		checkThreadGraph(NewValue >= 0);
+		WakeStalledThreadForPriorityWork(ETaskPriority::Background);
 	}
 
 	/** 
@@ -944,6 +1340,77 @@ private:
 		return WorkerThreads[Index].TaskGraphWorker;
 	}
 
+	/** 
+	 *	Internal function to queue a high priority or background task for the worker threads.
+	 *	The task goes into the shared queue for its priority first and only then do we look for a stalled thread to wake. 
+	 *	A stalling thread puts itself on the stalled list first and only then checks the shared queues, so one of us always sees the other.
+	 *	@param	Task; the task to queue
+	 *	@param	Priority; priority of the task, not ETaskPriority::Normal
+	**/
+	void QueuePriorityTask(FBaseGraphTask* Task, ETaskPriority::Type Priority)
+	{
+#if STATS
+		FTaskThread::NoteTaskQueued(Task);
+#endif
+		PriorityQueues[Priority].Enqueue(Task);
+		WakeStalledThreadForPriorityWork(Priority);
+	}
+
+	/** 
+	 *	Internal function to hand a waiting high priority or background task to a stalled worker thread, if there are both.
+	 *	@param	Priority; priority of the shared queue to take the task from, not ETaskPriority::Normal
+	**/
+	void WakeStalledThreadForPriorityWork(ETaskPriority::Type Priority)
+	{
+		FTaskThread* StalledThread = StalledUnnamedThreads.Pop();
+		if (StalledThread)
+		{
+			FBaseGraphTask* WakeTask = FindPriorityWork(Priority);
+			if (WakeTask)
+			{
+				StalledThread->EnqueueFromOtherThread(0, WakeTask);
+			}
+			else
+			{
+				// somebody else got to it, or there are already enough background tasks running; the thread is still stalled as far as we know
+				StalledUnnamedThreads.Push(StalledThread);
+			}
+		}
+	}
+
+	/** 
+	 *	Internal function to queue a normal priority task that a worker thread spawned for any thread.
+	 *	The task goes onto the spawning worker's own deque, and if another worker is stalled, it is handed the oldest task from that deque, just as if it had stolen it.
+	 *	@param	Task; the task to queue
+	 *	@param	CurrentThread; the worker thread we are running on
+	**/
+	void QueueTaskFromWorker(FBaseGraphTask* Task, ENamedThreads::Type CurrentThread)
+	{
+		checkThreadGraph(CurrentThread >= NumNamedThreads && CurrentThread < NumThreads);
+#if STATS
+		FTaskThread::NoteTaskQueued(Task);
+		INC_DWORD_STAT(STAT_TaskGraph_LocalPushes);
+#endif
+		FTaskThread& Spawner = Thread(CurrentThread);
+		Spawner.EnqueueFromThisThread(0, Task);
+		FTaskThread* StalledThread = StalledUnnamedThreads.Pop();
+		// the stalled list is only a hint, we may find ourselves on it if we were woken some other way; there is nothing to wake then
+		if (StalledThread && StalledThread != &Spawner)
+		{
+			// a stalled thread only wakes up when its incoming list is reopened, so steal on its behalf rather than just triggering it
+			FBaseGraphTask* StolenTask = Spawner.RequestSteal();
+			if (StolenTask)
+			{
+				StalledThread->EnqueueFromOtherThread(0, StolenTask);
+			}
+			else
+			{
+				// somebody else already took it
+				StalledUnnamedThreads.Push(StalledThread);
+			}
+		}
+	}
+
 	/** 
 	 *	Examines the TLS to determine the identity of the current thread.
 	 *	@return	Id of the thread that is this thread or ENamedThreads::AnyThread if this thread is unknown or is a named thread that has not attached yet.
@@ -991,6 +1458,12 @@ private:
 	uint32				PerThreadIDTLSSlot;
 	/** Thread safe list of stalled thread "Hints". **/
 	TLockFreePointerList<FTaskThread>		StalledUnnamedThreads; 
+	/** Shared queues for tasks that are not ETaskPriority::Normal, indexed by priority. The normal queue is unused. **/
+	FPriorityTaskQueue	PriorityQueues[ETaskPriority::Num];
+	/** Number of worker threads currently executing background tasks. **/
+	FThreadSafeCounter	RunningBackgroundTasks;
+	/** Maximum number of worker threads that will be handed background tasks at the same time. **/
+	int32				MaxRunningBackgroundTasks;
 };
 
 
@@ -998,7 +1471,7 @@ private:
 
 FBaseGraphTask* FTaskThread::FindWork()
 {
-	return FTaskGraphImplementation::Get().FindWork(ThreadId);
+	return FTaskGraphImplementation::Get().FindWork(ThreadId, NextStealRandom());
 }
 
 void FTaskThread::NotifyStalling()
@@ -1006,6 +1479,16 @@ void FTaskThread::NotifyStalling()
 	return FTaskGraphImplementation::Get().NotifyStalling(ThreadId);
 }
 
+FBaseGraphTask* FTaskThread::FindPriorityWork(ETaskPriority::Type Priority)
+{
+	return FTaskGraphImplementation::Get().FindPriorityWork(Priority);
+}
+
+void FTaskThread::NotifyBackgroundTaskComplete()
+{
+	FTaskGraphImplementation::Get().NotifyBackgroundTaskComplete();
+}
+
 
 
 // Statics in FTaskGraphInterface
@@ -1028,6 +1511,11 @@ FTaskGraphInterface& FTaskGraphInterface::Get()
 	return *TaskGraphImplementationSingleton;
 }
 
+bool FTaskGraphInterface::IsRunning()
+{
+	return TaskGraphImplementationSingleton != NULL;
+}
+
 
 // Statics and some implementations from FBaseGraphTask and FGraphEvent
 
@@ -1120,5 +1608,233 @@ FGraphEvent::~FGraphEvent()
 }
 
 
+#if !UE_BUILD_SHIPPING
+
+namespace TaskGraphBench
+{
+	/** Written by leaf tasks so the compiler cannot throw their work away. **/
+	static volatile float Sink = 0.0f;
+
+	/** Burns a small, fixed amount of time. **/
+	static float DoWork(int32 Work)
+	{
+		float Value = 1.0f;
+		for (int32 Step = 0; Step < Work; Step++)
+		{
+			Value = FMath::Sqrt(Value * 1.0001f + 1.0f);
+		}
+		return Value;
+	}
+
+	/** Node of a binary fork/join tree. Forks two children and joins by not completing until both of them have. **/
+	class FForkJoinTask
+	{
+	public:
+		FForkJoinTask(int32 InDepth, int32 InWork)
+			: Depth(InDepth)
+			, Work(InWork)
+		{
+		}
+		FORCEINLINE TStatId GetStatId() const
+		{
+			RETURN_QUICK_DECLARE_CYCLE_STAT(FForkJoinTask, STATGROUP_TaskGraphTasks);
+		}
+		static ENamedThreads::Type GetDesiredThread()
+		{
+			return ENamedThreads::AnyThread;
+		}
+		static ESubsequentsMode::Type GetSubsequentsMode() 
+		{ 
+			return ESubsequentsMode::TrackSubsequents; 
+		}
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			if (Depth > 0)
+			{
+				MyCompletionGraphEvent->DontCompleteUntil(TGraphTask<FForkJoinTask>::CreateTask(NULL, CurrentThread).ConstructAndDispatchWhenReady(Depth - 1, Work));
+				MyCompletionGraphEvent->DontCompleteUntil(TGraphTask<FForkJoinTask>::CreateTask(NULL, CurrentThread).ConstructAndDispatchWhenReady(Depth - 1, Work));
+			}
+			else
+			{
+				Sink = DoWork(Work);
+			}
+		}
+	private:
+		int32 Depth;
+		int32 Work;
+	};
+
+	/** Fine grained leaf of a fan out, records how long it waited between being spawned and starting to run. **/
+	class FFanOutChildTask
+	{
+	public:
+		FFanOutChildTask(double* InLatency, double InSpawnTime, int32 InWork)
+			: Latency(InLatency)
+			, SpawnTime(InSpawnTime)
+			, Work(InWork)
+		{
+		}
+		FORCEINLINE TStatId GetStatId() const
+		{
+			RETURN_QUICK_DECLARE_CYCLE_STAT(FFanOutChildTask, STATGROUP_TaskGraphTasks);
+		}
+		static ENamedThreads::Type GetDesiredThread()
+		{
+			return ENamedThreads::AnyThread;
+		}
+		static ESubsequentsMode::Type GetSubsequentsMode() 
+		{ 
+			return ESubsequentsMode::TrackSubsequents; 
+		}
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			*Latency = FPlatformTime::Seconds() - SpawnTime;
+			Sink = DoWork(Work);
+		}
+	private:
+		double* Latency;
+		double SpawnTime;
+		int32 Work;
+	};
 
+	/** Runs on a worker and spawns all of the children from there, which is the case the per worker deques are for. **/
+	class FFanOutTask
+	{
+	public:
+		FFanOutTask(double* InLatencies, int32 InNumChildren, int32 InWork)
+			: Latencies(InLatencies)
+			, NumChildren(InNumChildren)
+			, Work(InWork)
+		{
+		}
+		FORCEINLINE TStatId GetStatId() const
+		{
+			RETURN_QUICK_DECLARE_CYCLE_STAT(FFanOutTask, STATGROUP_TaskGraphTasks);
+		}
+		static ENamedThreads::Type GetDesiredThread()
+		{
+			return ENamedThreads::AnyThread;
+		}
+		static ESubsequentsMode::Type GetSubsequentsMode() 
+		{ 
+			return ESubsequentsMode::TrackSubsequents; 
+		}
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			for (int32 Index = 0; Index < NumChildren; Index++)
+			{
+				MyCompletionGraphEvent->DontCompleteUntil(TGraphTask<FFanOutChildTask>::CreateTask(NULL, CurrentThread).ConstructAndDispatchWhenReady(&Latencies[Index], FPlatformTime::Seconds(), Work));
+			}
+		}
+	private:
+		double* Latencies;
+		int32 NumChildren;
+		int32 Work;
+	};
+
+	/** @return the given percentile of an array that has already been sorted. **/
+	static double Percentile(const TArray<double>& Sorted, double Fraction)
+	{
+		if (!Sorted.Num())
+		{
+			return 0.0;
+		}
+		return Sorted[FMath::Min(Sorted.Num() - 1, int32(Sorted.Num() * Fraction))];
+	}
+
+	/** Runs both benchmarks with the current scheduler setting and logs the results. **/
+	static void Run(FOutputDevice& Ar, int32 Depth, int32 FanOut, int32 Work, int32 NumRuns)
+	{
+		Ar.Logf( TEXT("%s:"), GTaskGraphUseWorkStealingQueues ? TEXT("Work stealing deques") : TEXT("Incoming lists only") );
+
+		// fork/join, the latency that matters is the time for the whole tree
+		{
+			const int32 NumTasks = (1 << (Depth + 1)) - 1;
+			TArray<double> Times;
+			double TotalSeconds = 0.0;
+			for (int32 RunIndex = 0; RunIndex < NumRuns; RunIndex++)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				FGraphEventArray Root;
+				Root.Add(TGraphTask<FForkJoinTask>::CreateTask().ConstructAndDispatchWhenReady(Depth, Work));
+				FTaskGraphInterface::Get().WaitUntilTasksComplete(Root);
+				const double Seconds = FPlatformTime::Seconds() - StartTime;
+				Times.Add(Seconds);
+				TotalSeconds += Seconds;
+			}
+			Times.Sort();
+			Ar.Logf( TEXT("  fork/join  %7d tasks: %10.0f tasks/s   tree p50 %8.3fms  p99 %8.3fms  max %8.3fms"),
+				NumTasks, NumTasks * NumRuns / TotalSeconds, Percentile(Times, 0.5) * 1000.0, Percentile(Times, 0.99) * 1000.0, Times.Last() * 1000.0 );
+		}
+
+		// fan out, the latency that matters is how long each task waits to be picked up
+		{
+			TArray<double> Latencies;
+			Latencies.AddZeroed(FanOut * NumRuns);
+			double TotalSeconds = 0.0;
+			for (int32 RunIndex = 0; RunIndex < NumRuns; RunIndex++)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				FGraphEventArray Root;
+				Root.Add(TGraphTask<FFanOutTask>::CreateTask().ConstructAndDispatchWhenReady(&Latencies[RunIndex * FanOut], FanOut, Work));
+				FTaskGraphInterface::Get().WaitUntilTasksComplete(Root);
+				TotalSeconds += FPlatformTime::Seconds() - StartTime;
+			}
+			Latencies.Sort();
+			Ar.Logf( TEXT("  fan out    %7d tasks: %10.0f tasks/s   wait p50 %8.3fus  p99 %8.3fus  max %8.3fus"),
+				FanOut, FanOut * NumRuns / TotalSeconds, Percentile(Latencies, 0.5) * 1000000.0, Percentile(Latencies, 0.99) * 1000000.0, Latencies.Last() * 1000000.0 );
+		}
+	}
+}
+
+/**
+ * Exec handler that measures task graph throughput and tail latency.
+ * Usage: TASKGRAPHBENCH [DEPTH=n] [FANOUT=n] [WORK=n] [RUNS=n] [MODE=deque|incoming|both]
+ *   DEPTH	depth of the binary fork/join tree
+ *   FANOUT	number of tasks a single worker task spawns
+ *   WORK	amount of arithmetic per leaf task, small values expose the scheduling overhead
+ *   RUNS	number of times each benchmark is repeated, percentiles are taken over all runs
+ *   MODE	run with the per worker deques, with everything going through the incoming lists as before, or both
+ */
+static class FTaskGraphBenchExec : private FSelfRegisteringExec
+{
+	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) OVERRIDE
+	{
+		if( FParse::Command( &Cmd, TEXT("TASKGRAPHBENCH") ) )
+		{
+			int32 Depth = 14;
+			int32 FanOut = 10000;
+			int32 Work = 16;
+			int32 NumRuns = 20;
+			FString Mode(TEXT("both"));
+			FParse::Value( Cmd, TEXT("DEPTH="), Depth );
+			FParse::Value( Cmd, TEXT("FANOUT="), FanOut );
+			FParse::Value( Cmd, TEXT("WORK="), Work );
+			FParse::Value( Cmd, TEXT("RUNS="), NumRuns );
+			FParse::Value( Cmd, TEXT("MODE="), Mode );
+			Depth = FMath::Clamp(Depth, 0, 20);
+			FanOut = FMath::Max(FanOut, 1);
+			NumRuns = FMath::Max(NumRuns, 1);
+
+			Ar.Logf( TEXT("Task graph benchmark: depth %d, fan out %d, work %d, %d runs, %d worker threads"), Depth, FanOut, Work, NumRuns, FTaskGraphInterface::Get().GetNumWorkerThreads() );
+
+			// only flipped between runs, while the workers are idle
+			const bool bOldUseWorkStealingQueues = GTaskGraphUseWorkStealingQueues;
+			if (Mode != TEXT("deque"))
+			{
+				GTaskGraphUseWorkStealingQueues = false;
+				TaskGraphBench::Run(Ar, Depth, FanOut, Work, NumRuns);
+			}
+			if (Mode != TEXT("incoming"))
+			{
+				GTaskGraphUseWorkStealingQueues = true;
+				TaskGraphBench::Run(Ar, Depth, FanOut, Work, NumRuns);
+			}
+			GTaskGraphUseWorkStealingQueues = bOldUseWorkStealingQueues;
+			return true;
+		}
+		return false;
+	}
+} TaskGraphBenchExec;
 
+#endif // !UE_BUILD_SHIPPING
@@ -7,6 +7,8 @@
 #include "CorePrivate.h"
 
 #include "MallocBinned.h"
+#include "MallocJemalloc.h"
+#include "MallocTBB.h"
 #include "MemoryMisc.h"
 
 /** Malloc binned allocator specific stats. */
@@ -20,6 +22,12 @@ DEFINE_STAT(STAT_Binned_CurrentAllocs);
 DEFINE_STAT(STAT_Binned_TotalAllocs);
 DEFINE_STAT(STAT_Binned_SlackCurrent);
 
+DEFINE_STAT(STAT_Binned_ThreadCachedCurrent);
+DEFINE_STAT(STAT_Binned_ThreadCaches);
+DEFINE_STAT(STAT_Binned_ThreadCacheHits);
+DEFINE_STAT(STAT_Binned_ThreadCacheMisses);
+DEFINE_STAT(STAT_Binned_ThreadCacheFlushes);
+
 void FMallocBinned::GetAllocatorStats( FGenericMemoryStats& out_Stats )
 {
 	FMalloc::GetAllocatorStats( out_Stats );
@@ -64,5 +72,196 @@ void FMallocBinned::GetAllocatorStats( FGenericMemoryStats& out_Stats )
 	out_Stats.Add( GET_STATFNAME( STAT_Binned_CurrentAllocs ), LocalCurrentAllocs );
 	out_Stats.Add( GET_STATFNAME( STAT_Binned_TotalAllocs ), LocalTotalAllocs );
 	out_Stats.Add( GET_STATFNAME( STAT_Binned_SlackCurrent ), LocalSlackCurrent );
+
+#ifdef CACHE_PER_THREAD_BLOCKS
+	SIZE_T	LocalThreadCachedCurrent = 0;
+	uint32	LocalThreadCaches = 0;
+	uint64	LocalThreadCacheHits = 0;
+	uint64	LocalThreadCacheMisses = 0;
+	uint64	LocalThreadCacheFlushes = 0;
+	GatherThreadCacheStats( LocalThreadCachedCurrent, LocalThreadCaches, LocalThreadCacheHits, LocalThreadCacheMisses, LocalThreadCacheFlushes );
+
+	out_Stats.Add( GET_STATFNAME( STAT_Binned_ThreadCachedCurrent ), LocalThreadCachedCurrent );
+	out_Stats.Add( GET_STATFNAME( STAT_Binned_ThreadCaches ), LocalThreadCaches );
+	out_Stats.Add( GET_STATFNAME( STAT_Binned_ThreadCacheHits ), (SIZE_T)LocalThreadCacheHits );
+	out_Stats.Add( GET_STATFNAME( STAT_Binned_ThreadCacheMisses ), (SIZE_T)LocalThreadCacheMisses );
+	out_Stats.Add( GET_STATFNAME( STAT_Binned_ThreadCacheFlushes ), (SIZE_T)LocalThreadCacheFlushes );
+#endif
 #endif // STATS
-}
\ No newline at end of file
+}
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * One thread of the MALLOCBENCH command. Churns random small allocations through a private
+ * working set, then frees a batch that was allocated by the previous thread to exercise cross-thread frees.
+ */
+class FMallocBenchRunnable : public FRunnable
+{
+public:
+	enum
+	{
+		LIVE_SLOTS = 4096,
+		CROSS_THREAD_BATCH = 16384,
+		MAX_ALLOC_SIZE = 1024,
+	};
+
+	FMallocBenchRunnable(FMalloc* InAllocator, bool bInUseThreadCaches, int32 InNumOps, int32 InSeed, FThreadSafeCounter& InReadyCounter, int32 InNumThreads, TArray<void*>& InOutgoing, TArray<void*>& InIncoming)
+		: Allocator(InAllocator)
+		, bUseThreadCaches(bInUseThreadCaches)
+		, NumOps(InNumOps)
+		, Seed(InSeed)
+		, ReadyCounter(InReadyCounter)
+		, NumThreads(InNumThreads)
+		, Outgoing(InOutgoing)
+		, Incoming(InIncoming)
+		, ChurnSeconds(0.0)
+		, CrossThreadSeconds(0.0)
+	{
+	}
+
+	virtual uint32 Run() OVERRIDE
+	{
+		if (bUseThreadCaches)
+		{
+			Allocator->SetupTLSCachesOnCurrentThread();
+		}
+
+		FRandomStream Random(Seed);
+		void* Live[LIVE_SLOTS];
+		FMemory::Memzero(Live, sizeof(Live));
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Op = 0; Op < NumOps; Op++)
+		{
+			int32 Slot = Random.RandHelper(LIVE_SLOTS);
+			Allocator->Free(Live[Slot]);
+			Live[Slot] = Allocator->Malloc(1 + Random.RandHelper(MAX_ALLOC_SIZE), DEFAULT_ALIGNMENT);
+		}
+		for (int32 Slot = 0; Slot < LIVE_SLOTS; Slot++)
+		{
+			Allocator->Free(Live[Slot]);
+		}
+		ChurnSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Outgoing.Num(); Index++)
+		{
+			Outgoing[Index] = Allocator->Malloc(1 + Random.RandHelper(MAX_ALLOC_SIZE), DEFAULT_ALIGNMENT);
+		}
+		ReadyCounter.Increment();
+		while (ReadyCounter.GetValue() < NumThreads)
+		{
+			FPlatformProcess::Sleep(0.0f);
+		}
+		for (int32 Index = 0; Index < Incoming.Num(); Index++)
+		{
+			Allocator->Free(Incoming[Index]);
+		}
+		CrossThreadSeconds = FPlatformTime::Seconds() - StartTime;
+
+		if (bUseThreadCaches)
+		{
+			Allocator->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+		return 0;
+	}
+
+	FMalloc* Allocator;
+	bool bUseThreadCaches;
+	int32 NumOps;
+	int32 Seed;
+	FThreadSafeCounter& ReadyCounter;
+	int32 NumThreads;
+	TArray<void*>& Outgoing;
+	TArray<void*>& Incoming;
+	double ChurnSeconds;
+	double CrossThreadSeconds;
+};
+
+/** Runs the benchmark on NumThreads threads and logs the slowest thread's times, which is what the caller would wait for. */
+static void RunMallocBench(const TCHAR* Name, FMalloc* Allocator, bool bUseThreadCaches, int32 NumThreads, int32 NumOps, FOutputDevice& Ar)
+{
+	TArray<TArray<void*> > Batches;
+	Batches.AddZeroed(NumThreads);
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+	{
+		Batches[ThreadIndex].AddZeroed(FMallocBenchRunnable::CROSS_THREAD_BATCH);
+	}
+
+	FThreadSafeCounter ReadyCounter;
+	TArray<FMallocBenchRunnable*> Runnables;
+	TArray<FRunnableThread*> Threads;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+	{
+		TArray<void*>& Incoming = Batches[(ThreadIndex + NumThreads - 1) % NumThreads];
+		Runnables.Add(new FMallocBenchRunnable(Allocator, bUseThreadCaches, NumOps, ThreadIndex + 1, ReadyCounter, NumThreads, Batches[ThreadIndex], Incoming));
+	}
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+	{
+		Threads.Add(FRunnableThread::Create(Runnables[ThreadIndex], *FString::Printf(TEXT("MallocBench%d"), ThreadIndex)));
+	}
+
+	double ChurnSeconds = 0.0;
+	double CrossThreadSeconds = 0.0;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+	{
+		Threads[ThreadIndex]->WaitForCompletion();
+		delete Threads[ThreadIndex];
+		ChurnSeconds = FMath::Max(ChurnSeconds, Runnables[ThreadIndex]->ChurnSeconds);
+		CrossThreadSeconds = FMath::Max(CrossThreadSeconds, Runnables[ThreadIndex]->CrossThreadSeconds);
+		delete Runnables[ThreadIndex];
+	}
+
+	const double TotalOps = double(NumOps) * NumThreads;
+	Ar.Logf(TEXT("%-24s churn %8.2fms (%6.1f ns/op)   cross-thread %8.2fms"), Name, ChurnSeconds * 1000.0, ChurnSeconds * 1000000000.0 / TotalOps, CrossThreadSeconds * 1000.0);
+}
+
+/**
+ * Exec handler comparing the small block thread caches of FMallocBinned against the plain binned path and the other allocators.
+ * Usage: MALLOCBENCH [THREADS=n] [OPS=n]
+ */
+static class FMallocBenchExec : private FSelfRegisteringExec
+{
+	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) OVERRIDE
+	{
+		if( FParse::Command( &Cmd, TEXT("MALLOCBENCH") ) )
+		{
+			int32 NumThreads = FPlatformMisc::NumberOfCores();
+			int32 NumOps = 2000000;
+			FParse::Value( Cmd, TEXT("THREADS="), NumThreads );
+			FParse::Value( Cmd, TEXT("OPS="), NumOps );
+			NumThreads = FMath::Max(NumThreads, 1);
+
+			Ar.Logf( TEXT("Malloc benchmark: %d threads, %d ops per thread, sizes 1-%d bytes"), NumThreads, NumOps, (int32)FMallocBenchRunnable::MAX_ALLOC_SIZE );
+			// Fresh instances so neither run inherits warm pools. FMallocBinned is too large for the stack and does
+			// not return its bookkeeping pages on destruction, which is acceptable for a debug command.
+			{
+				FMallocBinned* Binned = new FMallocBinned(FPlatformMemory::GetConstants().PageSize & MAX_uint32, 0x100000000);
+				RunMallocBench( TEXT("binned"), Binned, false, NumThreads, NumOps, Ar );
+				delete Binned;
+			}
+			{
+				FMallocBinned* Binned = new FMallocBinned(FPlatformMemory::GetConstants().PageSize & MAX_uint32, 0x100000000);
+				RunMallocBench( TEXT("binned + thread caches"), Binned, true, NumThreads, NumOps, Ar );
+				delete Binned;
+			}
+#if PLATFORM_SUPPORTS_JEMALLOC
+			{
+				FMallocJemalloc Jemalloc;
+				RunMallocBench( TEXT("jemalloc"), &Jemalloc, false, NumThreads, NumOps, Ar );
+			}
+#endif
+#if PLATFORM_SUPPORTS_TBB && TBB_ALLOCATOR_ALLOWED
+			{
+				FMallocTBB TBB;
+				RunMallocBench( TEXT("tbb"), &TBB, false, NumThreads, NumOps, Ar );
+			}
+#endif
+			return true;
+		}
+		return false;
+	}
+} MallocBenchExec;
+
+#endif // !UE_BUILD_SHIPPING
\ No newline at end of file
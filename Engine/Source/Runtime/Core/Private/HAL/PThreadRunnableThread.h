@@ -249,6 +249,8 @@ protected:
 		uint32 ExitCode = 1;
 		check(Runnable);
 
+		FMemory::SetupTLSCachesOnCurrentThread();
+
 		// Initialize the runnable object
 		if (Runnable->Init() == true)
 		{
@@ -271,6 +273,8 @@ protected:
 			delete Runnable;
 			Runnable = NULL;
 		}
+		// Hand anything this thread cached back to the allocator before the thread goes away
+		FMemory::ClearAndDisableTLSCachesOnCurrentThread();
 		// Clean ourselves up without waiting
 		ThreadIsRunning = false;
 		return ExitCode;
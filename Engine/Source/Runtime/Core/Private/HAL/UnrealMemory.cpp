@@ -35,6 +35,9 @@ void GCreateMalloc()
 	{
 		GMalloc = new FMallocThreadSafeProxy( GMalloc );
 	}
+
+	// the thread that creates the allocator is the main thread, it never goes through FRunnableThread
+	GMalloc->SetupTLSCachesOnCurrentThread();
 }
 
 
@@ -100,6 +103,24 @@ SIZE_T FMemory::GetAllocSize( void* Original )
 	return GMalloc->GetAllocationSize( Original, Size ) ? Size : 0;
 }
 
+void FMemory::SetupTLSCachesOnCurrentThread()
+{
+	if( !GMalloc )
+	{
+		GCreateMalloc();
+		CA_ASSUME( GMalloc != NULL );	// Don't want to assert, but suppress static analysis warnings about potentially NULL GMalloc
+	}
+	GMalloc->SetupTLSCachesOnCurrentThread();
+}
+
+void FMemory::ClearAndDisableTLSCachesOnCurrentThread()
+{
+	if( GMalloc )
+	{
+		GMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+}
+
 void FMemory::TestMemory()
 {
 #if !UE_BUILD_SHIPPING
@@ -0,0 +1,419 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	LinuxAsyncIOSystem.cpp: Linux implementation of the async IO system
+=============================================================================*/
+
+#include "CorePrivate.h"
+#include "LinuxAsyncIOSystem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Merged read count"),STAT_AsyncIO_MergedReadCount,STATGROUP_AsyncIO);
+
+/** Largest read that requests are merged into. */
+static const int64 MaxMergedReadSize = 1024 * 1024;
+
+/** Requests up to this far apart are merged, reading the data in between is cheaper than a second request. */
+static const int64 MaxMergedReadGap = 16 * 1024;
+
+/** Default number of threads that fulfill requests, including the IO thread. Can be changed with [Core.System] AsyncIOReadThreads. */
+static const int32 DefaultNumReadThreads = 4;
+
+/** Runnable of the extra reader threads. */
+class FLinuxAsyncIOReader : public FRunnable
+{
+public:
+	FLinuxAsyncIOReader(FLinuxAsyncIOSystem& InOwner, FLinuxAsyncIOSystem::FReaderContext& InContext)
+		: Owner(InOwner)
+		, Context(InContext)
+	{
+	}
+
+	virtual uint32 Run() OVERRIDE
+	{
+		Owner.RunReader(Context);
+		return 0;
+	}
+
+	virtual void Stop() OVERRIDE
+	{
+		// IsRunning has already been cleared by the IO thread, this just makes sure the reader wakes up to see it
+		Owner.OutstandingRequestsEvent->Trigger();
+	}
+
+private:
+	FLinuxAsyncIOSystem& Owner;
+	FLinuxAsyncIOSystem::FReaderContext& Context;
+};
+
+FLinuxAsyncIOSystem::FLinuxAsyncIOSystem(IPlatformFile& InLowLevel)
+	: FAsyncIOSystemBase(InLowLevel)
+	, LastReadEnd(0)
+{
+}
+
+bool FLinuxAsyncIOSystem::Init()
+{
+	FAsyncIOSystemBase::Init();
+
+	int32 NumReadThreads = DefaultNumReadThreads;
+	GConfig->GetInt(TEXT("Core.System"), TEXT("AsyncIOReadThreads"), NumReadThreads, GEngineIni);
+	NumReadThreads = FPlatformProcess::SupportsMultithreading() ? FMath::Clamp(NumReadThreads, 1, 16) : 1;
+
+	// The IO thread is a reader as well
+	for (int32 ReaderIndex = 1; ReaderIndex < NumReadThreads; ReaderIndex++)
+	{
+		FReaderContext* Context = new FReaderContext();
+		FRunnable* Runnable = new FLinuxAsyncIOReader(*this, *Context);
+		FRunnableThread* Thread = FRunnableThread::Create(Runnable, *FString::Printf(TEXT("AsyncIOReader%d"), ReaderIndex), 0, 0, 16384, TPri_AboveNormal);
+		if (Thread == NULL)
+		{
+			delete Runnable;
+			delete Context;
+			break;
+		}
+		ReaderContexts.Add(Context);
+		ReaderRunnables.Add(Runnable);
+		ReaderThreads.Add(Thread);
+	}
+	return true;
+}
+
+void FLinuxAsyncIOSystem::Exit()
+{
+	// IsRunning has been cleared by Stop, so the readers are on their way out
+	for (int32 ReaderIndex = 0; ReaderIndex < ReaderThreads.Num(); ReaderIndex++)
+	{
+		ReaderThreads[ReaderIndex]->Kill(true);
+		delete ReaderThreads[ReaderIndex];
+		delete ReaderRunnables[ReaderIndex];
+		FlushReaderHandles(*ReaderContexts[ReaderIndex]);
+		delete ReaderContexts[ReaderIndex];
+	}
+	ReaderThreads.Empty();
+	ReaderRunnables.Empty();
+	ReaderContexts.Empty();
+	FlushReaderHandles(MainContext);
+
+	FAsyncIOSystemBase::Exit();
+}
+
+void FLinuxAsyncIOSystem::Suspend()
+{
+	// Readers check SuspendCount under the same lock before picking up requests, so once it is set no new reads
+	// can start and waiting for the ones in flight is enough.
+	{
+		FScopeLock ScopeLock( CriticalSection );
+		SuspendCount.Increment();
+	}
+	while( BusyWithRequest.GetValue() > 0 )
+	{
+		FPlatformProcess::Sleep( 0.001f );
+	}
+}
+
+void FLinuxAsyncIOSystem::Resume()
+{
+	SuspendCount.Decrement();
+	OutstandingRequestsEvent->Trigger();
+}
+
+void FLinuxAsyncIOSystem::BlockTillAllRequestsFinishedAndFlushHandles()
+{
+	BlockTillAllRequestsFinished();
+
+	FScopeLock ScopeLock( &HandleCriticalSection );
+	FlushReaderHandles(MainContext);
+	for (int32 ReaderIndex = 0; ReaderIndex < ReaderContexts.Num(); ReaderIndex++)
+	{
+		FlushReaderHandles(*ReaderContexts[ReaderIndex]);
+	}
+}
+
+void FLinuxAsyncIOSystem::FlushReaderHandles( FReaderContext& Context )
+{
+	for( TMap<FString,IFileHandle*>::TIterator It(Context.Handles); It; ++It )
+	{
+		delete It.Value();
+	}
+	Context.Handles.Empty();
+	Context.HandlesToDestroy.Empty();
+}
+
+void FLinuxAsyncIOSystem::DestroyHintedHandles( FReaderContext& Context )
+{
+	FScopeLock ScopeLock( &HandleCriticalSection );
+	for (int32 FileIndex = 0; FileIndex < Context.HandlesToDestroy.Num(); FileIndex++)
+	{
+		IFileHandle* FileHandle = Context.Handles.FindRef(Context.HandlesToDestroy[FileIndex]);
+		if (FileHandle)
+		{
+			delete FileHandle;
+			Context.Handles.Remove(Context.HandlesToDestroy[FileIndex]);
+		}
+	}
+	Context.HandlesToDestroy.Empty();
+}
+
+bool FLinuxAsyncIOSystem::InternalRead( IFileHandle* FileHandle, int64 Offset, int64 Size, void* Dest )
+{
+	// No ExclusiveReadCriticalSection here, reads from different threads go through different handles and Suspend waits for them instead
+	bool bRetVal = false;
+
+	STAT(double ReadTime = 0);
+	{
+		SCOPE_SECONDS_COUNTER(ReadTime);
+		bRetVal = PlatformReadDoNotCallDirectly( FileHandle, Offset, Size, Dest );
+	}
+	INC_FLOAT_STAT_BY(STAT_AsyncIO_PlatformReadTime,(float)ReadTime);
+
+	STAT(ConstrainBandwidth(Size, ReadTime));
+
+	return bRetVal;
+}
+
+int32 FLinuxAsyncIOSystem::PlatformGetNextRequestIndex()
+{
+	// Highest priority band first, like the base implementation.
+	EAsyncIOPriority HighestPriority = static_cast<EAsyncIOPriority>(AIOP_MIN - 1);
+	for( int32 CurrentRequestIndex=0; CurrentRequestIndex<OutstandingRequests.Num(); CurrentRequestIndex++ )
+	{
+		HighestPriority = FMath::Max(HighestPriority, OutstandingRequests[CurrentRequestIndex].Priority);
+	}
+
+	// Within the band, keep sweeping forward through the file that was read last, otherwise start over
+	// at the lowest offset of the first file in name order. This turns requests queued in random order
+	// into mostly sequential reads.
+	int32 BestIndex = INDEX_NONE;
+	bool bBestIsAhead = false;
+	for( int32 CurrentRequestIndex=0; CurrentRequestIndex<OutstandingRequests.Num(); CurrentRequestIndex++ )
+	{
+		const FAsyncIORequest& IORequest = OutstandingRequests[CurrentRequestIndex];
+		if( IORequest.Priority != HighestPriority )
+		{
+			continue;
+		}
+		const bool bIsAhead = !IORequest.bIsDestroyHandleRequest && IORequest.Offset >= LastReadEnd && IORequest.FileName == LastFileName;
+		if( BestIndex == INDEX_NONE )
+		{
+			BestIndex = CurrentRequestIndex;
+			bBestIsAhead = bIsAhead;
+			continue;
+		}
+		const FAsyncIORequest& BestRequest = OutstandingRequests[BestIndex];
+		bool bIsBetter;
+		if( bIsAhead != bBestIsAhead )
+		{
+			bIsBetter = bIsAhead;
+		}
+		else if( bIsAhead )
+		{
+			bIsBetter = IORequest.Offset < BestRequest.Offset;
+		}
+		else if( IORequest.FileName != BestRequest.FileName )
+		{
+			bIsBetter = IORequest.FileName < BestRequest.FileName;
+		}
+		else
+		{
+			bIsBetter = IORequest.Offset < BestRequest.Offset;
+		}
+		if( bIsBetter )
+		{
+			BestIndex = CurrentRequestIndex;
+			bBestIsAhead = bIsAhead;
+		}
+	}
+	return BestIndex;
+}
+
+void FLinuxAsyncIOSystem::GatherRequests( FReaderContext& Context )
+{
+	const int32 FirstIndex = PlatformGetNextRequestIndex();
+	if( FirstIndex == INDEX_NONE )
+	{
+		return;
+	}
+	Context.Requests.Add( OutstandingRequests[FirstIndex] );
+	OutstandingRequests.RemoveAt( FirstIndex );
+
+	// Copies, as merging requests grows the array
+	const FString FileName = Context.Requests[0].FileName;
+	const int64 ReadStart = Context.Requests[0].Offset;
+	int64 ReadEnd = ReadStart + Context.Requests[0].Size;
+	if( Context.Requests[0].bIsDestroyHandleRequest )
+	{
+		return;
+	}
+
+	// Compressed requests read their chunk table first and are fulfilled on their own
+	if( Context.Requests[0].UncompressedSize == 0 )
+	{
+		bool bMergedRequest = true;
+		while( bMergedRequest )
+		{
+			bMergedRequest = false;
+			for( int32 CurrentRequestIndex=0; CurrentRequestIndex<OutstandingRequests.Num(); CurrentRequestIndex++ )
+			{
+				// Any priority will do, the data comes for free
+				const FAsyncIORequest& IORequest = OutstandingRequests[CurrentRequestIndex];
+				if( !IORequest.bIsDestroyHandleRequest
+				&&	IORequest.UncompressedSize == 0
+				&&	IORequest.Offset >= ReadStart
+				&&	IORequest.Offset <= ReadEnd + MaxMergedReadGap
+				&&	IORequest.Offset + IORequest.Size - ReadStart <= MaxMergedReadSize
+				&&	IORequest.FileName == FileName )
+				{
+					ReadEnd = FMath::Max(ReadEnd, IORequest.Offset + IORequest.Size);
+					Context.Requests.Add( IORequest );
+					OutstandingRequests.RemoveAt( CurrentRequestIndex );
+					bMergedRequest = true;
+					break;
+				}
+			}
+		}
+	}
+
+	LastFileName = FileName;
+	LastReadEnd = ReadEnd;
+}
+
+void FLinuxAsyncIOSystem::FulfillRequests( FReaderContext& Context )
+{
+	DestroyHintedHandles(Context);
+
+	const FAsyncIORequest& FirstRequest = Context.Requests[0];
+	if( FirstRequest.bIsDestroyHandleRequest )
+	{
+		// Every reader may have a handle to the file, each one closes its own when it next runs
+		FScopeLock ScopeLock( &HandleCriticalSection );
+		MainContext.HandlesToDestroy.Add(FirstRequest.FileName);
+		for (int32 ReaderIndex = 0; ReaderIndex < ReaderContexts.Num(); ReaderIndex++)
+		{
+			ReaderContexts[ReaderIndex]->HandlesToDestroy.Add(FirstRequest.FileName);
+		}
+	}
+	else
+	{
+		IFileHandle* FileHandle = Context.Handles.FindRef( FirstRequest.FileName );
+		if( !FileHandle )
+		{
+			FileHandle = PlatformCreateHandle( *FirstRequest.FileName );
+			if( FileHandle )
+			{
+				Context.Handles.Add( FirstRequest.FileName, FileHandle );
+			}
+		}
+
+		if( FileHandle )
+		{
+			if( FirstRequest.UncompressedSize )
+			{
+				// Data is compressed on disc so we need to also decompress.
+				FulfillCompressedRead( FirstRequest, FileHandle );
+			}
+			else if( Context.Requests.Num() == 1 )
+			{
+				InternalRead( FileHandle, FirstRequest.Offset, FirstRequest.Size, FirstRequest.Dest );
+			}
+			else
+			{
+				// One read for all of the requests, then hand every request its part
+				int64 ReadEnd = 0;
+				for( int32 MergedIndex=0; MergedIndex<Context.Requests.Num(); MergedIndex++ )
+				{
+					ReadEnd = FMath::Max(ReadEnd, Context.Requests[MergedIndex].Offset + Context.Requests[MergedIndex].Size);
+				}
+				Context.ScratchBuffer.Reset();
+				Context.ScratchBuffer.AddUninitialized(ReadEnd - FirstRequest.Offset);
+				InternalRead( FileHandle, FirstRequest.Offset, Context.ScratchBuffer.Num(), Context.ScratchBuffer.GetTypedData() );
+				for( int32 MergedIndex=0; MergedIndex<Context.Requests.Num(); MergedIndex++ )
+				{
+					const FAsyncIORequest& IORequest = Context.Requests[MergedIndex];
+					FMemory::Memcpy( IORequest.Dest, Context.ScratchBuffer.GetTypedData() + (IORequest.Offset - FirstRequest.Offset), IORequest.Size );
+				}
+				INC_DWORD_STAT_BY( STAT_AsyncIO_MergedReadCount, Context.Requests.Num() - 1 );
+			}
+			for( int32 MergedIndex=0; MergedIndex<Context.Requests.Num(); MergedIndex++ )
+			{
+				INC_DWORD_STAT( STAT_AsyncIO_FulfilledReadCount );
+				INC_DWORD_STAT_BY( STAT_AsyncIO_FulfilledReadSize, Context.Requests[MergedIndex].Size );
+			}
+		}
+		else
+		{
+			//@todo streaming: add warning once we have thread safe logging.
+		}
+
+		for( int32 MergedIndex=0; MergedIndex<Context.Requests.Num(); MergedIndex++ )
+		{
+			DEC_DWORD_STAT( STAT_AsyncIO_OutstandingReadCount );
+			DEC_DWORD_STAT_BY( STAT_AsyncIO_OutstandingReadSize, Context.Requests[MergedIndex].Size );
+		}
+	}
+
+	// Requests fulfilled.
+	for( int32 MergedIndex=0; MergedIndex<Context.Requests.Num(); MergedIndex++ )
+	{
+		if( Context.Requests[MergedIndex].Counter )
+		{
+			Context.Requests[MergedIndex].Counter->Decrement();
+		}
+	}
+	Context.Requests.Reset();
+}
+
+void FLinuxAsyncIOSystem::ProcessRequests( FReaderContext& Context )
+{
+	bool bHasMoreRequests = false;
+	{
+		FScopeLock ScopeLock( CriticalSection );
+		if( SuspendCount.GetValue() == 0 )
+		{
+			GatherRequests( Context );
+			if( Context.Requests.Num() )
+			{
+				// We're busy. Updated inside scoped lock to ensure BlockTillAllRequestsFinished and Suspend work correctly.
+				BusyWithRequest.Increment();
+			}
+		}
+		bHasMoreRequests = OutstandingRequests.Num() > 0;
+	}
+
+	if( Context.Requests.Num() )
+	{
+		if( bHasMoreRequests )
+		{
+			// The event only wakes up one thread, pass the work on to another reader
+			OutstandingRequestsEvent->Trigger();
+		}
+		FulfillRequests( Context );
+		// We're done reading for now.
+		BusyWithRequest.Decrement();
+	}
+	else if( !bHasMoreRequests && SuspendCount.GetValue() == 0 && FPlatformProcess::SupportsMultithreading() )
+	{
+		// We're really out of requests now, wait till the calling thread signals further work
+		OutstandingRequestsEvent->Wait();
+	}
+}
+
+void FLinuxAsyncIOSystem::RunReader( FReaderContext& Context )
+{
+	// Same loop as Run on the IO thread
+	while( IsRunning.GetValue() > 0 )
+	{
+		while( !GIsRequestingExit && SuspendCount.GetValue() > 0 )
+		{
+			FPlatformProcess::Sleep(0.005);
+		}
+
+		ProcessRequests( Context );
+	}
+	// The event only wakes up one thread, pass the shutdown on to the other readers
+	OutstandingRequestsEvent->Trigger();
+}
+
+void FLinuxAsyncIOSystem::Tick()
+{
+	ProcessRequests( MainContext );
+}
@@ -0,0 +1,111 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	LinuxAsyncIOSystem.h: Linux implementation of the async IO system
+=============================================================================*/
+
+#pragma once
+
+#include "../Serialization/AsyncIOSystemBase.h"
+
+/**
+ * Async IO system that keeps several reads in flight, which pays off on SSDs and network drives that
+ * can serve many requests at once. The IO thread and a few extra reader threads all pull requests from
+ * the shared queue. Within the highest priority band, requests are served in file and offset order,
+ * and requests for nearby data in the same file are merged into a single read.
+ */
+struct FLinuxAsyncIOSystem : public FAsyncIOSystemBase
+{
+	/**
+	 * Constructor
+	 * @param InLowLevel	Low level file system to use to satisfy requests.
+	**/
+	FLinuxAsyncIOSystem(IPlatformFile& InLowLevel);
+
+	// FAsyncIOSystemBase interface
+
+	virtual void BlockTillAllRequestsFinishedAndFlushHandles() OVERRIDE;
+	virtual bool Init() OVERRIDE;
+	virtual void Exit() OVERRIDE;
+	virtual void Suspend() OVERRIDE;
+	virtual void Resume() OVERRIDE;
+	virtual void Tick() OVERRIDE;
+
+protected:
+
+	/** State owned by one of the threads that fulfill requests. */
+	struct FReaderContext
+	{
+		/** File handles of this thread. They are not shared as handles are not safe to read from several threads at once. */
+		TMap<FString, IFileHandle*>		Handles;
+		/** Files whose handles should be closed the next time this thread runs, added when a destroy handle request is fulfilled. Guarded by HandleCriticalSection. */
+		TArray<FString>					HandlesToDestroy;
+		/** Requests this thread is working on, the first one followed by the ones merged into it. */
+		TArray<FAsyncIORequest>			Requests;
+		/** Buffer merged requests are read into. */
+		TArray<uint8>					ScratchBuffer;
+	};
+
+	virtual bool InternalRead( IFileHandle* FileHandle, int64 Offset, int64 Size, void* Dest ) OVERRIDE;
+	virtual int32 PlatformGetNextRequestIndex() OVERRIDE;
+
+	/**
+	 * Picks the next request and merges nearby requests for the same file into it.
+	 * Called with CriticalSection locked.
+	 *
+	 * @param	Context		Context of the calling thread, receives the requests
+	 */
+	void GatherRequests( FReaderContext& Context );
+
+	/**
+	 * Fulfills the requests gathered by GatherRequests.
+	 *
+	 * @param	Context		Context of the calling thread
+	 */
+	void FulfillRequests( FReaderContext& Context );
+
+	/**
+	 * Picks up and fulfills requests, or waits for more to be queued if there are none.
+	 *
+	 * @param	Context		Context of the calling thread
+	 */
+	void ProcessRequests( FReaderContext& Context );
+
+	/**
+	 * Main loop of the extra reader threads.
+	 *
+	 * @param	Context		Context of the calling thread
+	 */
+	void RunReader( FReaderContext& Context );
+
+	/**
+	 * Closes all handles of a reader. The reader must not be busy with a request.
+	 *
+	 * @param	Context		Context of the reader
+	 */
+	void FlushReaderHandles( FReaderContext& Context );
+
+	/**
+	 * Closes the handles for files that were hinted as done with.
+	 *
+	 * @param	Context		Context of the calling thread
+	 */
+	void DestroyHintedHandles( FReaderContext& Context );
+
+	friend class FLinuxAsyncIOReader;
+
+	/** Context of the IO thread. */
+	FReaderContext					MainContext;
+	/** Contexts of the extra reader threads. */
+	TArray<FReaderContext*>			ReaderContexts;
+	/** Runnables of the extra reader threads. */
+	TArray<FRunnable*>				ReaderRunnables;
+	/** Extra reader threads. */
+	TArray<FRunnableThread*>		ReaderThreads;
+	/** Guards HandlesToDestroy of every context. */
+	FCriticalSection				HandleCriticalSection;
+	/** File the last request was picked from, used to keep sweeping forward through it. Guarded by CriticalSection. */
+	FString							LastFileName;
+	/** End of the data the last request read. Guarded by CriticalSection. */
+	int64							LastReadEnd;
+};
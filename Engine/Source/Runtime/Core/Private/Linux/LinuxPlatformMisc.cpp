@@ -7,6 +7,7 @@
 #include "CorePrivate.h"
 #include "LinuxPlatformMisc.h"
 #include "LinuxApplication.h"
+#include "LinuxAsyncIOSystem.h"
 
 #include <sys/sysinfo.h>
 #include <sched.h>
@@ -224,6 +225,11 @@ uint32 FLinuxMisc::GetKeyMap( uint16* KeyCodes, FString* KeyNames, uint32 MaxMap
 	return NumMappings;
 }
 
+FAsyncIOSystemBase* FLinuxMisc::GetPlatformSpecificAsyncIOSystem()
+{
+	return new FLinuxAsyncIOSystem(FPlatformFileManager::Get().GetPlatformFile());
+}
+
 int32 FLinuxMisc::NumberOfCores()
 {
 	cpu_set_t AvailableCpusMask;
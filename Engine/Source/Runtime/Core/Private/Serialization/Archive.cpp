@@ -87,6 +87,7 @@ void FArchive::Reset()
 	ArShouldSkipBulkData				= false;
 	ArMaxSerializeSize					= 0;
 	ArIsFilterEditorOnly				= false;
+	ArUseUnversionedPropertySerialization = false;
 	ArIsSaveGame						= false;
 	CookingTargetPlatform				= NULL;
 
@@ -125,6 +126,7 @@ void FArchive::CopyTrivialFArchiveStatusMembers(const FArchive& ArchiveToCopy)
 	ArShouldSkipBulkData                 = ArchiveToCopy.ArShouldSkipBulkData;
 	ArMaxSerializeSize                   = ArchiveToCopy.ArMaxSerializeSize;
 	ArIsFilterEditorOnly                 = ArchiveToCopy.ArIsFilterEditorOnly;
+	ArUseUnversionedPropertySerialization = ArchiveToCopy.ArUseUnversionedPropertySerialization;
 	ArIsSaveGame                         = ArchiveToCopy.ArIsSaveGame;
 	CookingTargetPlatform                = ArchiveToCopy.CookingTargetPlatform;
 }
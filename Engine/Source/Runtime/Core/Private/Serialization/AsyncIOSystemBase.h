@@ -223,7 +223,8 @@ protected:
 	};
 
 	/** 
-	 * Implements shared stats handling and passes read to PlatformReadDoNotCallDirectly
+	 * Implements shared stats handling and passes read to PlatformReadDoNotCallDirectly. Reads are serialized
+	 * with ExclusiveReadCriticalSection, platforms that issue reads from several threads override this.
 	 *
 	 * @param	FileHandle	Platform specific file handle
 	 * @param	Offset		Offset in bytes from start, INDEX_NONE if file pointer shouldn't be changed
@@ -232,7 +233,7 @@ protected:
 	 *
 	 * @return	true if read was successful, false otherwise
 	 */	
-	bool InternalRead( IFileHandle* FileHandle, int64 Offset, int64 Size, void* Dest );
+	virtual bool InternalRead( IFileHandle* FileHandle, int64 Offset, int64 Size, void* Dest );
 
 
 	/** 
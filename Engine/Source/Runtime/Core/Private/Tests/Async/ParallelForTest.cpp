@@ -0,0 +1,88 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	ParallelForTest.cpp: Unit tests for ParallelFor.
+=============================================================================*/
+
+#include "CorePrivate.h"
+#include "AutomationTest.h"
+#include "ParallelFor.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForTest, "Core.Async.ParallelFor", EAutomationTestFlags::ATF_SmokeTest)
+
+
+/** Runs a loop of Num iterations and checks that every index was visited exactly once. */
+static bool TestParallelForVisitsEachIndexOnce(int32 Num, EParallelForFlags::Type Flags)
+{
+	TArray<int32> Visits;
+	Visits.AddZeroed(Num);
+	int32* VisitsData = Visits.GetData();
+
+	ParallelFor(Num, [VisitsData](int32 Index)
+	{
+		FPlatformAtomics::InterlockedIncrement(&VisitsData[Index]);
+	}, Flags);
+
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		if (Visits[Index] != 1)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool FParallelForTest::RunTest( const FString& Parameters )
+{
+	const int32 Sizes[] = { 0, 1, 2, 3, 7, 64, 1000, 100000 };
+	const EParallelForFlags::Type FlagSets[] = { EParallelForFlags::None, EParallelForFlags::ForceSingleThread, EParallelForFlags::AllowNamedThreadCaller };
+
+	for (int32 SizeIndex = 0; SizeIndex < ARRAY_COUNT(Sizes); SizeIndex++)
+	{
+		for (int32 FlagIndex = 0; FlagIndex < ARRAY_COUNT(FlagSets); FlagIndex++)
+		{
+			TestTrue(*FString::Printf(TEXT("Every index must be visited exactly once (Num=%d, Flags=%d)"), Sizes[SizeIndex], (int32)FlagSets[FlagIndex]),
+				TestParallelForVisitsEachIndexOnce(Sizes[SizeIndex], FlagSets[FlagIndex]));
+		}
+	}
+
+	// results written by the body must be visible to the caller once ParallelFor returns
+	{
+		const int32 Num = 50000;
+		TArray<int64> Squares;
+		Squares.AddZeroed(Num);
+		int64* SquaresData = Squares.GetData();
+		ParallelFor(Num, [SquaresData](int32 Index)
+		{
+			SquaresData[Index] = int64(Index) * Index;
+		}, EParallelForFlags::AllowNamedThreadCaller);
+
+		int64 Sum = 0;
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Sum += Squares[Index];
+		}
+		const int64 Expected = int64(Num - 1) * Num * (2 * int64(Num) - 1) / 6;
+		TestEqual(TEXT("Sum of squares computed in parallel must match the closed form"), Sum, Expected);
+	}
+
+	// nested loops must not deadlock, even when the outer loop occupies every worker
+	{
+		const int32 Outer = 32;
+		const int32 Inner = 256;
+		FThreadSafeCounter Counter;
+		ParallelFor(Outer, [&Counter](int32 OuterIndex)
+		{
+			ParallelFor(Inner, [&Counter](int32 InnerIndex)
+			{
+				Counter.Increment();
+			});
+		}, EParallelForFlags::AllowNamedThreadCaller);
+		TestEqual(TEXT("Nested ParallelFor must run every inner iteration"), Counter.GetValue(), Outer * Inner);
+	}
+
+	return true;
+}
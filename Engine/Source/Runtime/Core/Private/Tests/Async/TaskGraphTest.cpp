@@ -0,0 +1,117 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	TaskGraphTest.cpp: Unit tests for task graph scheduling.
+=============================================================================*/
+
+#include "CorePrivate.h"
+#include "AutomationTest.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTaskGraphPriorityTest, "Core.Async.TaskGraph.Priorities", EAutomationTestFlags::ATF_SmokeTest)
+
+
+/** Number of tasks of one priority in DoTask right now, and the most that ever were at once. */
+struct FTaskGraphTestConcurrency
+{
+	FThreadSafeCounter Running;
+	volatile int32 PeakRunning;
+
+	FTaskGraphTestConcurrency()
+		: PeakRunning(0)
+	{
+	}
+
+	void Enter()
+	{
+		const int32 NowRunning = Running.Increment();
+		for (int32 Peak = PeakRunning; NowRunning > Peak; Peak = PeakRunning)
+		{
+			if (FPlatformAtomics::InterlockedCompareExchange(&PeakRunning, NowRunning, Peak) == Peak)
+			{
+				break;
+			}
+		}
+	}
+
+	void Leave()
+	{
+		Running.Decrement();
+	}
+};
+
+/** Counts its execution, and forks children of the same priority until Depth reaches zero. */
+class FTaskGraphTestTask
+{
+public:
+	FTaskGraphTestTask(FThreadSafeCounter* InCounter, FTaskGraphTestConcurrency* InConcurrency, int32 InDepth, ETaskPriority::Type InPriority)
+		: Counter(InCounter)
+		, Concurrency(InConcurrency)
+		, Depth(InDepth)
+		, Priority(InPriority)
+	{
+	}
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FTaskGraphTestTask, STATGROUP_TaskGraphTasks);
+	}
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		Concurrency->Enter();
+		Counter->Increment();
+		if (Depth > 0)
+		{
+			MyCompletionGraphEvent->DontCompleteUntil(TGraphTask<FTaskGraphTestTask>::CreateTask(NULL, CurrentThread, Priority).ConstructAndDispatchWhenReady(Counter, Concurrency, Depth - 1, Priority));
+			MyCompletionGraphEvent->DontCompleteUntil(TGraphTask<FTaskGraphTestTask>::CreateTask(NULL, CurrentThread, Priority).ConstructAndDispatchWhenReady(Counter, Concurrency, Depth - 1, Priority));
+		}
+		// stay busy for a moment, so that tasks of the same priority overlap whenever the scheduler lets them
+		const double EndTime = FPlatformTime::Seconds() + 0.00005;
+		while (FPlatformTime::Seconds() < EndTime)
+		{
+		}
+		Concurrency->Leave();
+	}
+private:
+	FThreadSafeCounter* Counter;
+	FTaskGraphTestConcurrency* Concurrency;
+	int32 Depth;
+	ETaskPriority::Type Priority;
+};
+
+
+bool FTaskGraphPriorityTest::RunTest( const FString& Parameters )
+{
+	const int32 Depth = 8;
+	const int32 TasksPerTree = (1 << (Depth + 1)) - 1;
+
+	// trees of every priority at once, so that high priority and background work has to share the workers with normal work
+	FThreadSafeCounter Counters[ETaskPriority::Num];
+	FTaskGraphTestConcurrency Concurrency[ETaskPriority::Num];
+	FGraphEventArray Roots;
+	for (int32 Priority = 0; Priority < ETaskPriority::Num; Priority++)
+	{
+		FGraphEventRef Root = TGraphTask<FTaskGraphTestTask>::CreateTask(NULL, ENamedThreads::AnyThread, ETaskPriority::Type(Priority)).ConstructAndDispatchWhenReady(&Counters[Priority], &Concurrency[Priority], Depth, ETaskPriority::Type(Priority));
+		TestEqual(TEXT("Graph events report the priority of their task"), int32(Root->GetPriority()), Priority);
+		Roots.Add(Root);
+	}
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(Roots);
+
+	TestEqual(TEXT("Every high priority task ran"), Counters[ETaskPriority::High].GetValue(), TasksPerTree);
+	TestEqual(TEXT("Every normal priority task ran"), Counters[ETaskPriority::Normal].GetValue(), TasksPerTree);
+	TestEqual(TEXT("Every background task ran"), Counters[ETaskPriority::Background].GetValue(), TasksPerTree);
+
+	// the task graph keeps a worker free of background work whenever it has more than one
+	const int32 MaxRunningBackgroundTasks = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads() - 1, 1);
+	TestTrue(FString::Printf(TEXT("At most %d background tasks ran at once, saw %d"), MaxRunningBackgroundTasks, Concurrency[ETaskPriority::Background].PeakRunning),
+		Concurrency[ETaskPriority::Background].PeakRunning <= MaxRunningBackgroundTasks);
+
+	return true;
+}
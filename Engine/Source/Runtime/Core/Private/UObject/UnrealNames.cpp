@@ -223,15 +223,16 @@ FNameEntry*** FName::GetNameTableForDebuggerVisualizers_MT()
 }
 
 
-FCriticalSection* FName::GetCriticalSection()
+FCriticalSection* FName::GetHashBucketCriticalSection(int32 HashIndex)
 {
-	static FCriticalSection*	CriticalSection = NULL;
-	if( CriticalSection == NULL )
+	static FCriticalSection* CriticalSections = NULL;
+	if( CriticalSections == NULL )
 	{
+		// first called while registering the hardcoded names, before any other thread can create names
 		check(IsInGameThread());
-		CriticalSection = new FCriticalSection();
+		CriticalSections = new FCriticalSection[FNameDefs::NameHashLockCount];
 	}
-	return CriticalSection;
+	return &CriticalSections[HashIndex & (FNameDefs::NameHashLockCount - 1)];
 }
 
 FString FName::NameToDisplayString( const FString& InDisplayName, const bool bIsBool )
@@ -608,8 +609,8 @@ void FName::Init(const WIDECHAR* InName, int32 InNumber, EFindName FindType, boo
 			return;
 		}
 	}
-	// acquire the lock
-	FScopeLock ScopeLock(GetCriticalSection());
+	// acquire the lock for this bucket only, names that hash to buckets covered by other locks are added concurrently
+	FScopeLock ScopeLock(GetHashBucketCriticalSection(iHash));
 	if (OutIndex < 0)
 	{
 		// Try to find the name in the hash. AGAIN...we might have been adding from a different thread and we just missed it
@@ -643,6 +644,7 @@ void FName::Init(const WIDECHAR* InName, int32 InNumber, EFindName FindType, boo
 	{
 		UE_LOG(LogUnrealNames, Fatal, TEXT("Hardcoded name '%s' at index %i was duplicated (or unexpected concurrency). Existing entry is '%s'."), *NewEntry->GetPlainNameString(), NewEntry->GetIndex(), *Names[OutIndex]->GetPlainNameString() );
 	}
+	// this also publishes the entry to the lock free lookups above, so it must come after the entry is fully written
 	if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&NameHash[iHash], NewEntry, OldHash) != OldHash) // we use an atomic operation to check for unexpected concurrency, verify alignment, etc
 	{
 		check(0); // someone changed this while we were changing it
@@ -945,7 +947,6 @@ public:
 		TotalAllocatedPages	= 0;
 		CurrentPoolStart	= NULL;
 		CurrentPoolEnd		= NULL;
-		check(ThreadGuard.GetValue() == 0);
 	}
 
 	/**
@@ -956,11 +957,14 @@ public:
 	 */
 	FNameEntry* Allocate( int32 Size )
 	{
-		check(ThreadGuard.Increment() == 1);
 		// Some platforms need all of the name entries to be aligned to 4 bytes, so by
 		// aligning the size here the next allocation will be aligned to 4
 		Size = Align( Size, ALIGNOF(FNameEntry) );
 
+		// Names are added under per bucket locks, so several threads can allocate at once. The lock
+		// is only held for the pointer bump, which is short next to the hashing and lookups around it.
+		FScopeLock ScopeLock(&CriticalSection);
+
 		// Allocate a new pool if current one is exhausted. We don't worry about a little bit
 		// of waste at the end given the relative size of pool to average and max allocation.
 		if( CurrentPoolEnd - CurrentPoolStart < Size )
@@ -971,7 +975,6 @@ public:
 		// Return current pool start as allocation and increment by size.
 		FNameEntry* NameEntry = (FNameEntry*) CurrentPoolStart;
 		CurrentPoolStart += Size;
-		check(ThreadGuard.Decrement() == 0);
 		return NameEntry;
 	}
 
@@ -1011,8 +1014,8 @@ private:
 	uint8* CurrentPoolEnd;
 	/** Total number of pages that have been allocated.								*/
 	int32 TotalAllocatedPages;
-	/** Threadsafe counter to test for unwanted concurrency							*/
-	FThreadSafeCounter ThreadGuard;
+	/** Guards the pool pointers against concurrent allocations.					*/
+	FCriticalSection CriticalSection;
 };
 
 /** Global allocator for name entries. */
@@ -1023,7 +1026,7 @@ FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* H
 	const SIZE_T NameLen  = bIsPureAnsi ? FCStringAnsi::Strlen((ANSICHAR*)Name) : FCString::Strlen((TCHAR*)Name);
 	int32 NameEntrySize	  = FNameEntry::GetSize( NameLen, bIsPureAnsi );
 	FNameEntry* NameEntry = GNameEntryPoolAllocator.Allocate( NameEntrySize );
-	FName::NameEntryMemorySize += NameEntrySize;
+	FPlatformAtomics::InterlockedAdd( &FName::NameEntryMemorySize, NameEntrySize );
 	NameEntry->Index      = (Index << NAME_INDEX_SHIFT) | (bIsPureAnsi ? 0 : 1);
 	NameEntry->HashNext   = HashNext;
 	// Can't rely on the template override for static arrays since the safe crt version of strcpy will fill in
@@ -1031,12 +1034,12 @@ FNameEntry* AllocateNameEntry( const void* Name, NAME_INDEX Index, FNameEntry* H
 	if( bIsPureAnsi )
 	{
 		FCStringAnsi::Strcpy( const_cast<ANSICHAR*>(NameEntry->GetAnsiName()), NameLen + 1, (ANSICHAR*) Name );
-		FName::NumAnsiNames++;
+		FPlatformAtomics::InterlockedIncrement( &FName::NumAnsiNames );
 	}
 	else
 	{
 		FCStringWide::Strcpy( const_cast<WIDECHAR*>(NameEntry->GetWideName()), NameLen + 1, (WIDECHAR*) Name );
-		FName::NumWideNames++;
+		FPlatformAtomics::InterlockedIncrement( &FName::NumWideNames );
 	}
 	return NameEntry;
 }
@@ -1138,6 +1141,89 @@ static class FFNameExec: private FSelfRegisteringExec
 				check(Test.TestCounter.GetValue() == FTest::NUM_TESTS * FTest::NUM_TASKS);
 				Ar.Logf( TEXT("Ran fname threading test."));
 			}
+			else if( FParse::Command(&Cmd,TEXT("LOADBENCH")) )
+			{
+				// Creates the names of many package name tables, the way async loading and asset registry scanning do,
+				// first from this thread alone and then from several tasks at once.
+				int32 NumPackages = 4000;
+				int32 NamesPerPackage = 200;
+				int32 NumTasks = 8;
+				FParse::Value(Cmd, TEXT("PACKAGES="), NumPackages);
+				FParse::Value(Cmd, TEXT("NAMES="), NamesPerPackage);
+				FParse::Value(Cmd, TEXT("TASKS="), NumTasks);
+				NumPackages = FMath::Max(NumPackages, 1);
+				NamesPerPackage = FMath::Max(NamesPerPackage, 1);
+				NumTasks = FMath::Max(NumTasks, 1);
+
+				struct FLoadBench
+				{
+					TArray<TArray<FString> > NameTables;
+					FThreadSafeCounter NextPackage;
+					FLoadBench(int32 RunIndex, int32 NumPackages, int32 NamesPerPackage)
+					{
+						// names are unique to the run so they are really added rather than found. A quarter of each table
+						// are names most packages share, like class and property names, the rest are the package's own.
+						NameTables.AddZeroed(NumPackages);
+						for (int32 PackageIndex = 0; PackageIndex < NumPackages; PackageIndex++)
+						{
+							TArray<FString>& NameTable = NameTables[PackageIndex];
+							for (int32 NameIndex = 0; NameIndex < NamesPerPackage; NameIndex++)
+							{
+								if (NameIndex % 4 == 0)
+								{
+									NameTable.Add(FString::Printf(TEXT("LoadBench%d_Common%d"), RunIndex, (NameIndex * 7 + PackageIndex) % 1000));
+								}
+								else
+								{
+									NameTable.Add(FString::Printf(TEXT("LoadBench%d_Package%d_Export_%d"), RunIndex, PackageIndex, NameIndex));
+								}
+							}
+						}
+					}
+					void Thread()
+					{
+						for (int32 PackageIndex = NextPackage.Increment() - 1; PackageIndex < NameTables.Num(); PackageIndex = NextPackage.Increment() - 1)
+						{
+							const TArray<FString>& NameTable = NameTables[PackageIndex];
+							for (int32 NameIndex = 0; NameIndex < NameTable.Num(); NameIndex++)
+							{
+								FName Name(*NameTable[NameIndex]);
+								check(Name != NAME_None);
+							}
+						}
+					}
+				};
+
+				static int32 RunIndex = 0;
+				FLoadBench SingleThreaded(RunIndex++, NumPackages, NamesPerPackage);
+				FLoadBench MultiThreaded(RunIndex++, NumPackages, NamesPerPackage);
+				const int32 TotalNames = NumPackages * NamesPerPackage;
+
+				int32 NamesBefore = FName::GetMaxNames();
+				double StartTime = FPlatformTime::Seconds();
+				SingleThreaded.Thread();
+				double SingleThreadedTime = FPlatformTime::Seconds() - StartTime;
+				Ar.Logf(TEXT("FName load bench: 1 thread, %d packages, %d names, %d new: %.2fms (%.0f names/s)"),
+					NumPackages, TotalNames, FName::GetMaxNames() - NamesBefore, SingleThreadedTime * 1000.0, TotalNames / FMath::Max(SingleThreadedTime, 0.000001));
+
+				NamesBefore = FName::GetMaxNames();
+				StartTime = FPlatformTime::Seconds();
+				FGraphEventArray Handles;
+				for (int32 TaskIndex = 0; TaskIndex < NumTasks; TaskIndex++)
+				{
+					new (Handles) FGraphEventRef(FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+						FSimpleDelegateGraphTask::FDelegate::CreateRaw(&MultiThreaded, &FLoadBench::Thread),
+						TEXT("FName Load Bench"),
+						NULL,
+						ENamedThreads::AnyThread
+						));
+				}
+				FTaskGraphInterface::Get().WaitUntilTasksComplete(Handles, ENamedThreads::GameThread);
+				double MultiThreadedTime = FPlatformTime::Seconds() - StartTime;
+				Ar.Logf(TEXT("FName load bench: %d tasks, %d packages, %d names, %d new: %.2fms (%.0f names/s, %.2fx)"),
+					NumTasks, NumPackages, TotalNames, FName::GetMaxNames() - NamesBefore, MultiThreadedTime * 1000.0, TotalNames / FMath::Max(MultiThreadedTime, 0.000001),
+					SingleThreadedTime / FMath::Max(MultiThreadedTime, 0.000001));
+			}
 			return true;
 #endif // !UE_BUILD_SHIPPING
 		}
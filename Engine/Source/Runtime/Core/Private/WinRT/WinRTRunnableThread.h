@@ -125,6 +125,8 @@ class FRunnableThreadWinRT : public FRunnableThread
 
 		ThreadID = GetCurrentThreadId();
 
+		FMemory::SetupTLSCachesOnCurrentThread();
+
 		// Initialize the runnable object
 		if (Runnable->Init() == true)
 		{
@@ -147,6 +149,8 @@ class FRunnableThreadWinRT : public FRunnableThread
 			delete Runnable;
 			Runnable = NULL;
 		}
+		// Hand anything this thread cached back to the allocator before the thread goes away
+		FMemory::ClearAndDisableTLSCachesOnCurrentThread();
 		// Clean ourselves up without waiting
 		if (bShouldDeleteSelf == true)
 		{
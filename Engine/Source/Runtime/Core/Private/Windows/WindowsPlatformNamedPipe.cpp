@@ -253,8 +253,7 @@ bool FWindowsPlatformNamedPipe::UpdateAsyncStatusAfterRW()
 	switch (LastError)
 	{
 		case ERROR_IO_PENDING:
-			// Yield CPU time while waiting
-			FPlatformProcess::Sleep(.01f);
+			// Callers poll pending IO across several pipes, so leave it to them to yield
 			return true;
 
 		case ERROR_NO_DATA:
@@ -302,8 +301,7 @@ bool FWindowsPlatformNamedPipe::UpdateAsyncStatus()
 					switch (LastError)
 					{
 						case ERROR_IO_INCOMPLETE:
-							// Yield CPU time while waiting
-							FPlatformProcess::Sleep(.01f);
+							// Callers poll pending IO across several pipes, so leave it to them to yield
 							break;
 
 						case ERROR_BROKEN_PIPE:
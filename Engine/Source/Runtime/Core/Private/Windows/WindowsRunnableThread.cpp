@@ -64,6 +64,8 @@ uint32 FRunnableThreadWin::Run()
 	UE_LOG(LogThreadingWindows, Log, TEXT("Runnable thread %s is on Process %d."), *ThreadName  , static_cast<uint32>(::GetCurrentProcessorNumber()) );
 #endif
 
+	FMemory::SetupTLSCachesOnCurrentThread();
+
 	// Initialize the runnable object
 	if (Runnable->Init() == true)
 	{
@@ -86,6 +88,8 @@ uint32 FRunnableThreadWin::Run()
 		delete Runnable;
 		Runnable = NULL;
 	}
+	// Hand anything this thread cached back to the allocator before the thread goes away
+	FMemory::ClearAndDisableTLSCachesOnCurrentThread();
 	// Clean ourselves up without waiting
 	if (bShouldDeleteSelf == true)
 	{
@@ -0,0 +1,242 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	ParallelFor.h: Data parallel loops on top of the task graph
+=============================================================================*/
+
+#pragma once
+
+#include "TaskGraphInterfaces.h"
+
+namespace EParallelForFlags
+{
+	enum Type
+	{
+		/** Default behavior. */
+		None = 0,
+		/** Run every iteration on the calling thread. Useful for debugging and for measuring the serial cost of a loop. */
+		ForceSingleThread = 1,
+		/**
+		 * Named threads (game, rendering, stats) run the loop by themselves unless they pass this flag, so that a named thread
+		 * only goes wide where it is known to be worth pulling every worker off whatever it was doing.
+		 */
+		AllowNamedThreadCaller = 2,
+	};
+}
+
+namespace ParallelForImpl
+{
+	/**
+	 * State shared between the calling thread and the helper tasks of one ParallelFor.
+	 * Iterations are handed out in chunks from a single atomic cursor. Chunks start large and shrink as the loop
+	 * nears its end (guided self scheduling), so that the threads finish close together without paying for an atomic per iteration.
+	 * Helper tasks may start after all of the work has been claimed, so this is reference counted and outlives the call.
+	 */
+	template<typename BodyType>
+	class TParallelForData
+	{
+	public:
+		TParallelForData(int32 InNum, const BodyType& InBody, int32 InNumParticipants)
+			: Body(InBody)
+			, Num(InNum)
+			, NumParticipants(InNumParticipants)
+			, NextIndex(0)
+			, DoneEvent(FPlatformProcess::CreateSynchEvent(true))
+		{
+			// one reference for the calling thread
+			ReferenceCount.Increment();
+		}
+
+		~TParallelForData()
+		{
+			delete DoneEvent;
+		}
+
+		void AddRef()
+		{
+			ReferenceCount.Increment();
+		}
+
+		void Release()
+		{
+			if (ReferenceCount.Decrement() == 0)
+			{
+				delete this;
+			}
+		}
+
+		/** Executes chunks until none are left. Called by the caller and by every helper task. */
+		void Process()
+		{
+			int32 Start;
+			int32 End;
+			while (ClaimChunk(Start, End))
+			{
+				for (int32 Index = Start; Index < End; Index++)
+				{
+					Body(Index);
+				}
+				const int32 ChunkSize = End - Start;
+				if (NumCompleted.Add(ChunkSize) + ChunkSize == Num)
+				{
+					DoneEvent->Trigger();
+				}
+			}
+		}
+
+		/** Blocks until every iteration has executed, including the chunks still running on helper threads. */
+		void Wait()
+		{
+			if (NumCompleted.GetValue() != Num)
+			{
+				DoneEvent->Wait();
+			}
+		}
+
+	private:
+		/**
+		 * Claims the next chunk of iterations.
+		 * @return false if all iterations have been claimed
+		 */
+		bool ClaimChunk(int32& OutStart, int32& OutEnd)
+		{
+			while (true)
+			{
+				const int32 Start = NextIndex;
+				if (Start >= Num)
+				{
+					return false;
+				}
+				const int32 Remaining = Num - Start;
+				const int32 ChunkSize = FMath::Max(Remaining / (NumParticipants * 2), 1);
+				if (FPlatformAtomics::InterlockedCompareExchange(&NextIndex, Start + ChunkSize, Start) == Start)
+				{
+					OutStart = Start;
+					OutEnd = Start + ChunkSize;
+					return true;
+				}
+			}
+		}
+
+		/** Loop body, owned by the caller. Only touched while the caller is blocked in ParallelFor. */
+		const BodyType&		Body;
+		/** Number of iterations. */
+		const int32			Num;
+		/** Number of threads that will be pulling chunks, used to size them. */
+		const int32			NumParticipants;
+		/** First iteration that has not been claimed yet. */
+		volatile int32		NextIndex;
+		/** Number of iterations that have finished executing. */
+		FThreadSafeCounter	NumCompleted;
+		/** Triggered by whoever finishes the last iteration. */
+		FEvent*				DoneEvent;
+		/** The caller plus every helper task that has not run yet. */
+		FThreadSafeCounter	ReferenceCount;
+	};
+
+	/** Task that lends a worker thread to a ParallelFor. */
+	template<typename BodyType>
+	class TParallelForTask
+	{
+	public:
+		TParallelForTask(TParallelForData<BodyType>* InData)
+			: Data(InData)
+		{
+		}
+
+		FORCEINLINE TStatId GetStatId() const
+		{
+			RETURN_QUICK_DECLARE_CYCLE_STAT(TParallelForTask, STATGROUP_TaskGraphTasks);
+		}
+
+		static ENamedThreads::Type GetDesiredThread()
+		{
+			return ENamedThreads::AnyThread;
+		}
+
+		static ESubsequentsMode::Type GetSubsequentsMode()
+		{
+			return ESubsequentsMode::FireAndForget;
+		}
+
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			Data->Process();
+			Data->Release();
+		}
+
+	private:
+		TParallelForData<BodyType>* Data;
+	};
+
+	/** @return true if a loop of Num iterations with these flags should run on the calling thread alone. */
+	inline bool ShouldRunSingleThreaded(int32 Num, EParallelForFlags::Type Flags)
+	{
+		if (Num <= 1 || (Flags & EParallelForFlags::ForceSingleThread) || !FPlatformProcess::SupportsMultithreading())
+		{
+			return true;
+		}
+		if (!FTaskGraphInterface::IsRunning() || FTaskGraphInterface::Get().GetNumWorkerThreads() < 1)
+		{
+			return true;
+		}
+		if (!(Flags & EParallelForFlags::AllowNamedThreadCaller))
+		{
+			const ENamedThreads::Type CurrentThread = FTaskGraphInterface::Get().GetCurrentThreadIfKnown();
+			if (CurrentThread != ENamedThreads::AnyThread && ENamedThreads::GetThreadIndex(CurrentThread) <= ENamedThreads::ActualRenderingThread)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Implementation of ParallelFor that also caps the number of worker threads that help out. Exposed for benchmarking.
+	 * @param MaxHelperThreads	upper bound on the number of worker threads used in addition to the caller
+	 */
+	template<typename BodyType>
+	void ParallelForWithMaxHelpers(int32 Num, const BodyType& Body, EParallelForFlags::Type Flags, int32 MaxHelperThreads)
+	{
+		if (Num <= 0)
+		{
+			return;
+		}
+		const int32 NumHelpers = ShouldRunSingleThreaded(Num, Flags) ? 0 : FMath::Min3(FTaskGraphInterface::Get().GetNumWorkerThreads(), Num - 1, MaxHelperThreads);
+		if (NumHelpers <= 0)
+		{
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				Body(Index);
+			}
+			return;
+		}
+
+		TParallelForData<BodyType>* Data = new TParallelForData<BodyType>(Num, Body, NumHelpers + 1);
+		for (int32 HelperIndex = 0; HelperIndex < NumHelpers; HelperIndex++)
+		{
+			Data->AddRef();
+			TGraphTask<TParallelForTask<BodyType> >::CreateTask().ConstructAndDispatchWhenReady(Data);
+		}
+
+		// the caller does its share rather than sleeping, so the loop makes progress even if every worker is busy
+		Data->Process();
+		Data->Wait();
+		Data->Release();
+	}
+}
+
+/**
+ * Executes Body(Index) for every Index in [0, Num), spreading the iterations over the task graph worker threads.
+ * The calling thread takes part and the call returns once every iteration has finished. Iterations run in no
+ * particular order, so the body must be safe to run concurrently for different indices.
+ *
+ * @param Num		number of iterations
+ * @param Body		callable taking an int32 index, typically a lambda
+ * @param Flags		see EParallelForFlags
+ */
+template<typename BodyType>
+void ParallelFor(int32 Num, const BodyType& Body, EParallelForFlags::Type Flags = EParallelForFlags::None)
+{
+	ParallelForImpl::ParallelForWithMaxHelpers(Num, Body, Flags, MAX_int32);
+}
@@ -80,6 +80,23 @@ namespace ESubsequentsMode
 	};
 }
 
+namespace ETaskPriority
+{
+	/** 
+	 *	Scheduling class of a task. Only tasks that run on ENamedThreads::AnyThread are affected, named threads always run their tasks in order.
+	 *	High priority tasks are picked up by the next worker that looks for work, ahead of everything else.
+	 *	Background tasks only run when a worker has nothing else to do, or periodically so that they are not starved, and never on all of the workers at once.
+	**/
+	enum Type
+	{
+		High,
+		Normal,
+		Background,
+
+		Num
+	};
+}
+
 /** Convenience typedef for a reference counted pointer to a graph event **/
 typedef TRefCountPtr<class FGraphEvent> FGraphEventRef;
 
@@ -120,6 +137,11 @@ public:
 	 *	@return a reference to the task graph system
 	**/
 	static CORE_API FTaskGraphInterface& Get();
+	/** 
+	 *	Check whether the system has been started, for code that may run before Startup or after Shutdown.
+	 *	@return true if Get can be called
+	**/
+	static CORE_API bool IsRunning();
 
 	/** Return the current thread type, if known. **/
 	virtual ENamedThreads::Type GetCurrentThreadIfKnown() = 0;
@@ -210,6 +232,7 @@ protected:
 	 **/
 	FBaseGraphTask(int32 InNumberOfPrerequistitesOutstanding)
 		: ThreadToExecuteOn(ENamedThreads::AnyThread)
+		, Priority(ETaskPriority::Normal)
 		, NumberOfPrerequistitesOutstanding(InNumberOfPrerequistitesOutstanding + 1) // + 1 is not a prerequisite, it is a lock to prevent it from executing while it is getting prerequisites, one it is safe to execute, call PrerequisitesComplete
 	{
 		checkThreadGraph(LifeStage.Increment() == int32(LS_Contructed));
@@ -224,6 +247,25 @@ protected:
 		checkThreadGraph(LifeStage.Increment() == int32(LS_ThreadSet));
 	}
 
+	/** 
+	 *	Sets the scheduling class of the task. Must be called before the task is queued.
+	 *	@param InPriority; priority to run with if the task runs on a worker thread
+	 **/
+	void SetPriority(ETaskPriority::Type InPriority)
+	{
+		checkThreadGraph(InPriority >= 0 && InPriority < ETaskPriority::Num);
+		Priority = InPriority;
+	}
+
+public:
+	/** @return the scheduling class of this task **/
+	ETaskPriority::Type GetPriority() const
+	{
+		return Priority;
+	}
+
+protected:
+
 	/** 
 	 *	Indicates that the prerequisites are set up and that the task can be executed as soon as the prerequisites are finished.
 	 *	@param NumAlreadyFinishedPrequistes; the number of prerequisites that have not been set up because those tasks had already completed.
@@ -308,8 +350,14 @@ private:
 
 	/**	Thread to execute on, can be ENamedThreads::AnyThread to execute on any unnamed thread **/
 	ENamedThreads::Type			ThreadToExecuteOn;
+	/**	Scheduling class, only used when ThreadToExecuteOn is ENamedThreads::AnyThread **/
+	ETaskPriority::Type			Priority;
 	/**	Number of prerequisites outstanding. When this drops to zero, the thread is queued for execution.  **/
 	FThreadSafeCounter			NumberOfPrerequistitesOutstanding; 
+#if STATS
+	/**	FPlatformTime::Cycles() when the task was handed to a worker thread, used for the wait time stats **/
+	uint32						QueuedCycles;
+#endif
 
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
@@ -389,6 +437,22 @@ public:
 	{
 		return SubsequentList.IsClosed();
 	}
+
+	/**
+	 *	@return the priority of the task that completes this event. Work that the task defers with DontCompleteUntil is gathered at this priority. 
+	**/
+	ETaskPriority::Type GetPriority() const
+	{
+		return Priority;
+	}
+
+	/**
+	 *	Sets the priority reported by GetPriority. Called when the owning task is set up.
+	**/
+	void SetPriority(ETaskPriority::Type InPriority)
+	{
+		Priority = InPriority;
+	}
 private:
 	friend class TRefCountPtr<FGraphEvent>;
 	friend class TLockFreeClassAllocator<FGraphEvent>;
@@ -409,6 +473,7 @@ private:
 	 *	Hidden Constructor
 	**/
 	FGraphEvent()
+		: Priority(ETaskPriority::Normal)
 	{
 	}
 
@@ -461,6 +526,8 @@ private:
 	TClosableLockFreePointerList<FBaseGraphTask>		SubsequentList;
 	/** List of events to wait for until firing. This is not thread safe as it is only legal to fill it in within the context of an executing task. **/
 	FGraphEventArray									EventsToWaitFor;
+	/** Priority of the task that owns this event. **/
+	ETaskPriority::Type									Priority;
 };
 
 /** 
@@ -496,6 +563,9 @@ public:
 		MyCompletionEvent->DontCompleteUntil(TGraphTask<FSomeChildTask>::CreateTask(NULL,CurrentThread).ConstructAndDispatchWhenReady());
 	}
 };
+
+Tasks that run on AnyThread can pick a scheduling class when they are created:
+	TGraphTask<FGenericTask>::CreateTask(NULL, ENamedThreads::AnyThread, ETaskPriority::High).ConstructAndDispatchWhenReady(SomeArgument);
 **/
 
 
@@ -518,42 +588,42 @@ public:
 		FGraphEventRef ConstructAndDispatchWhenReady()
 		{
 			new ((void *)&Owner->TaskStorage) TTask();
-			return Owner->Setup(Prerequisites, CurrentThreadIfKnown);
+			return Owner->Setup(Prerequisites, CurrentThreadIfKnown, Priority);
 		}
 		/** Passthrough internal task constructor and dispatch. Note! Generally speaking references will not pass through; use pointers */
 		template<typename T>
 		FGraphEventRef ConstructAndDispatchWhenReady(const T& Arg)
 		{
 			new ((void *)&Owner->TaskStorage) TTask(Arg);
-			return Owner->Setup(Prerequisites, CurrentThreadIfKnown);
+			return Owner->Setup(Prerequisites, CurrentThreadIfKnown, Priority);
 		}
 		/** Passthrough internal task constructor and dispatch. Note! Generally speaking references will not pass through; use pointers */
 		template<typename T1,typename T2>
 		FGraphEventRef ConstructAndDispatchWhenReady(const T1& Arg1, const T2& Arg2)
 		{
 			new ((void *)&Owner->TaskStorage) TTask(Arg1,Arg2);
-			return Owner->Setup(Prerequisites, CurrentThreadIfKnown);
+			return Owner->Setup(Prerequisites, CurrentThreadIfKnown, Priority);
 		}
 		/** Passthrough internal task constructor and dispatch. Note! Generally speaking references will not pass through; use pointers */
 		template<typename T1,typename T2, typename T3>
 		FGraphEventRef ConstructAndDispatchWhenReady(const T1& Arg1, const T2& Arg2, const T3& Arg3)
 		{
 			new ((void *)&Owner->TaskStorage) TTask(Arg1,Arg2,Arg3);
-			return Owner->Setup(Prerequisites, CurrentThreadIfKnown);
+			return Owner->Setup(Prerequisites, CurrentThreadIfKnown, Priority);
 		}
 		/** Passthrough internal task constructor and dispatch. Note! Generally speaking references will not pass through; use pointers */
 		template<typename T1,typename T2, typename T3, typename T4>
 		FGraphEventRef ConstructAndDispatchWhenReady(const T1& Arg1, const T2& Arg2, const T3& Arg3, const T4& Arg4)
 		{
 			new ((void *)&Owner->TaskStorage) TTask(Arg1,Arg2,Arg3,Arg4);
-			return Owner->Setup(Prerequisites, CurrentThreadIfKnown);
+			return Owner->Setup(Prerequisites, CurrentThreadIfKnown, Priority);
 		}
 		/** Passthrough internal task constructor and dispatch. Note! Generally speaking references will not pass through; use pointers */
 		template<typename T1,typename T2, typename T3, typename T4, typename T5>
 		FGraphEventRef ConstructAndDispatchWhenReady(const T1& Arg1, const T2& Arg2, const T3& Arg3, const T4& Arg4, const T5& Arg5)
 		{
 			new ((void *)&Owner->TaskStorage) TTask(Arg1,Arg2,Arg3,Arg4,Arg5);
-			return Owner->Setup(Prerequisites, CurrentThreadIfKnown);
+			return Owner->Setup(Prerequisites, CurrentThreadIfKnown, Priority);
 		}
 	private:
 		friend class TGraphTask;
@@ -564,12 +634,15 @@ public:
 		const FGraphEventArray*			Prerequisites;
 		/** If known, the current thread.  ENamedThreads::AnyThread is also fine, and if that is the value, we will determine the current thread, as needed, via TLS. **/
 		ENamedThreads::Type				CurrentThreadIfKnown;
+		/** Scheduling class of the task. **/
+		ETaskPriority::Type				Priority;
 
 		/** Constructor, simply saves off the arguments for later use after we actually construct the embeded task. **/
-		FConstructor(TGraphTask* InOwner, const FGraphEventArray* InPrerequisites, ENamedThreads::Type InCurrentThreadIfKnown)
+		FConstructor(TGraphTask* InOwner, const FGraphEventArray* InPrerequisites, ENamedThreads::Type InCurrentThreadIfKnown, ETaskPriority::Type InPriority)
 			: Owner(InOwner)
 			, Prerequisites(InPrerequisites)
 			, CurrentThreadIfKnown(InCurrentThreadIfKnown)
+			, Priority(InPriority)
 		{
 		}
 		/** Prohibited copy construction **/
@@ -588,16 +661,17 @@ public:
 	 *	Factory to create a task and return the helper object to construct the embedded task and set it up for execution.
 	 *	@param Prerequisites; the list of FGraphEvents that must be completed prior to this task executing.
 	 *	@param CurrentThreadIfKnown; provides the index of the thread we are running on. Can be ENamedThreads::AnyThread if the current thread is unknown.
+	 *	@param Priority; scheduling class of the task, only used if the task runs on ENamedThreads::AnyThread.
 	 *	@return a temporary helper class which can be used to complete the process.
 	**/
-	static FConstructor CreateTask(const FGraphEventArray* Prerequisites = NULL, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread)
+	static FConstructor CreateTask(const FGraphEventArray* Prerequisites = NULL, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread, ETaskPriority::Type Priority = ETaskPriority::Normal)
 	{
 		if (sizeof(TGraphTask) <= FBaseGraphTask::SMALL_TASK_SIZE)
 		{
 			void *Mem = FBaseGraphTask::GetSmallTaskAllocator().Allocate();
-			return FConstructor(new (Mem) TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown);
+			return FConstructor(new (Mem) TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown, Priority);
 		}
-		return FConstructor(new TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown);
+		return FConstructor(new TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown, Priority);
 	}
 
 private:
@@ -695,6 +769,7 @@ private:
 	 *	Call from FConstructor to complete the setup process
 	 *	@param Prerequisites; the list of FGraphEvents that must be completed prior to this task executing.
 	 *	@param CurrentThreadIfKnown; provides the index of the thread we are running on. Can be ENamedThreads::AnyThread if the current thread is unknown.
+	 *	@param InPriority; scheduling class of the task.
 	 *	@return A new graph event which represents the completion of this task.
 	 * 
 	 *	Create the completed event
@@ -702,12 +777,17 @@ private:
 	 *	Attempt to add myself as a subsequent to each prerequisite
 	 *	Tell the base task that I am ready to start as soon as my prerequisites are ready.
 	 **/
-	FGraphEventRef Setup(const FGraphEventArray* Prerequisites = NULL, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread)
+	FGraphEventRef Setup(const FGraphEventArray* Prerequisites = NULL, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread, ETaskPriority::Type InPriority = ETaskPriority::Normal)
 	{
 		checkThreadGraph(!TaskConstructed);
 		TaskConstructed = true;
 		TTask& Task = *(TTask*)&TaskStorage;
 		SetThreadToExecuteOn(Task.GetDesiredThread());
+		SetPriority(InPriority);
+		if (IsValidRef(Subsequents))
+		{
+			Subsequents->SetPriority(InPriority);
+		}
 		int32 AlreadyCompletedPrerequisites = 0;
 		if (Prerequisites)
 		{
@@ -731,15 +811,17 @@ private:
 	 *	@param SubsequentsToAssume; subsequents to "assume" from an existing task
 	 *	@param Prerequisites; the list of FGraphEvents that must be completed prior to dispatching my seubsequents.
 	 *	@param CurrentThreadIfKnown; provides the index of the thread we are running on. Can be ENamedThreads::AnyThread if the current thread is unknown.
+	 *	The gather task runs at the priority of the event it assumes.
 	**/
 	static FConstructor CreateTask(FGraphEventRef SubsequentsToAssume, const FGraphEventArray* Prerequisites = NULL, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread)
 	{
+		const ETaskPriority::Type Priority = SubsequentsToAssume->GetPriority();
 		if (sizeof(TGraphTask) <= FBaseGraphTask::SMALL_TASK_SIZE)
 		{
 			void *Mem = FBaseGraphTask::GetSmallTaskAllocator().Allocate();
-			return FConstructor(new (Mem) TGraphTask(SubsequentsToAssume, Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown);
+			return FConstructor(new (Mem) TGraphTask(SubsequentsToAssume, Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown, Priority);
 		}
-		return FConstructor(new TGraphTask(SubsequentsToAssume, Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown);
+		return FConstructor(new TGraphTask(SubsequentsToAssume, Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown, Priority);
 	}
 
 	/** An aligned bit of storage to hold the embedded task **/
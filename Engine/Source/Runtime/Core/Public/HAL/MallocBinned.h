@@ -11,6 +11,7 @@
 //#define USE_LOCKFREE_DELETE
 #define USE_INTERNAL_LOCKS
 #define CACHE_FREED_OS_ALLOCS
+#define CACHE_PER_THREAD_BLOCKS
 
 #ifdef USE_INTERNAL_LOCKS
 //#	define USE_COARSE_GRAIN_LOCKS
@@ -26,6 +27,13 @@
 #	define MAX_CACHED_OS_FREES_BYTE_LIMIT (4*1024*1024)
 #endif
 
+#if defined CACHE_PER_THREAD_BLOCKS
+	// Per pool, a thread may hold at most this many bytes (clamped to the block counts below) before handing a batch back
+#	define MAX_THREAD_CACHED_BYTES_PER_POOL (64*1024)
+#	define MAX_THREAD_CACHED_BLOCKS_PER_POOL (128)
+#	define MIN_THREAD_CACHED_BLOCKS_PER_POOL (2)
+#endif
+
 #if defined USE_INTERNAL_LOCKS && !defined USE_COARSE_GRAIN_LOCKS
 #	define USE_FINE_GRAIN_LOCKS
 #endif
@@ -44,6 +52,13 @@ DECLARE_MEMORY_STAT_EXTERN(TEXT("Binned CurrentAllocs"),STAT_Binned_CurrentAlloc
 DECLARE_MEMORY_STAT_EXTERN(TEXT("Binned TotalAllocs"),	STAT_Binned_TotalAllocs,STATGROUP_MemoryAllocator, CORE_API);
 DECLARE_MEMORY_STAT_EXTERN(TEXT("Binned SlackCurrent"),	STAT_Binned_SlackCurrent,STATGROUP_MemoryAllocator, CORE_API);
 
+/** Malloc binned per-thread cache stats, these show up in stat memory. */
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Binned ThreadCachedCurrent"),			STAT_Binned_ThreadCachedCurrent,STATGROUP_Memory, CORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Binned ThreadCaches"),		STAT_Binned_ThreadCaches,STATGROUP_Memory, CORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Binned ThreadCacheHits"),	STAT_Binned_ThreadCacheHits,STATGROUP_Memory, CORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Binned ThreadCacheMisses"),	STAT_Binned_ThreadCacheMisses,STATGROUP_Memory, CORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Binned ThreadCacheFlushes"),	STAT_Binned_ThreadCacheFlushes,STATGROUP_Memory, CORE_API);
+
 //
 // Optimized virtual memory allocator.
 //
@@ -215,6 +230,55 @@ private:
 		}
 	};
 
+#ifdef CACHE_PER_THREAD_BLOCKS
+	/** Free blocks of a single pool size owned by one thread, linked through FFreeMem::Next. */
+	struct FThreadCacheBin
+	{
+		FFreeMem*	FirstFree;
+		uint32		NumFree;
+	};
+
+	/**
+	 * Small block cache of a single thread. Blocks in here still belong to the shared pools, so a block
+	 * freed on a different thread than the one that allocated it simply lands in the freeing thread's cache.
+	 * Allocated straight from the OS so that creating one never recurses into Malloc.
+	 */
+	struct FThreadCache
+	{
+		FThreadCacheBin	Bins[POOL_COUNT];
+		/** Links in the list of live caches, guarded by AccessGuard. */
+		FThreadCache*	Next;
+		FThreadCache**	PrevLink;
+#if STATS
+		/** Per-thread counters so the fast path does not touch shared cache lines. Summed when stats are gathered. */
+		SIZE_T			CachedBytes;
+		uint64			Hits;
+		uint64			Misses;
+		uint64			Flushes;
+#endif
+
+		void Link( FThreadCache*& Before )
+		{
+			if( Before )
+			{
+				Before->PrevLink = &Next;
+			}
+			Next     = Before;
+			PrevLink = &Before;
+			Before   = this;
+		}
+
+		void Unlink()
+		{
+			if( Next )
+			{
+				Next->PrevLink = PrevLink;
+			}
+			*PrevLink = Next;
+		}
+	};
+#endif
+
 	/** Hash table struct for retrieving allocation book keeping information */
 	struct PoolHashBucket
 	{
@@ -302,6 +366,23 @@ private:
 	uint32			CachedTotal;
 #endif
 
+#ifdef CACHE_PER_THREAD_BLOCKS
+	/** TLS slot holding the calling thread's FThreadCache, NULL for threads that did not opt in. */
+	uint32			ThreadCacheTlsSlot;
+	/** All live thread caches. */
+	FThreadCache*	FirstThreadCache;
+	/** Maximum number of blocks a thread may cache per pool. */
+	uint32			ThreadCacheMaxBlocks[POOL_COUNT];
+	/** Number of blocks moved between a thread cache and the shared pool in one go. */
+	uint32			ThreadCacheBatchBlocks[POOL_COUNT];
+#if STATS
+	/** Counters inherited from the caches of threads that already exited. */
+	uint64			RetiredThreadCacheHits;
+	uint64			RetiredThreadCacheMisses;
+	uint64			RetiredThreadCacheFlushes;
+#endif
+#endif
+
 #if STATS
 	SIZE_T		OsCurrent;
 	SIZE_T		OsPeak;
@@ -587,38 +668,7 @@ private:
 #ifdef USE_FINE_GRAIN_LOCKS
 			FScopeLock TableLock(&Table->CriticalSection);
 #endif
-#if STATS
-			Table->ActiveRequests--;
-#endif
-			// If this pool was exhausted, move to available list.
-			if( !Pool->FirstMem )
-			{
-				Pool->Unlink();
-				Pool->Link( Table->FirstPool );
-			}
-
-			// Free a pooled allocation.
-			FFreeMem* Free		= (FFreeMem*)Ptr;
-			Free->NumFreeBlocks	= 1;
-			Free->Next			= Pool->FirstMem;
-			Pool->FirstMem		= Free;
-			STAT(UsedCurrent -= Table->BlockSize);
-
-			// Free this pool.
-			checkSlow(Pool->Taken >= 1);
-			if( --Pool->Taken == 0 )
-			{
-#if STATS
-				Table->NumActivePools--;
-#endif
-				// Free the OS memory.
-				SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
-				STAT(OsCurrent -= OsBytes);
-				STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
-				Pool->Unlink();
-				Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
-				OSFree((void*)BasePtr, OsBytes);
-			}
+			FreeBlockToPool(Table, Pool, BasePtr, Ptr);
 		}
 		else
 		{
@@ -634,6 +684,199 @@ private:
 		MEM_TIME(MemTime += FPlatformTime::Seconds());
 	}
 
+	/**
+	* Returns a pooled block to its pool, releasing the pool to the OS if it becomes empty. The caller
+	* must hold the table lock.
+	*/
+	FORCEINLINE void FreeBlockToPool( FPoolTable* Table, FPoolInfo* Pool, UPTRINT BasePtr, void* Ptr )
+	{
+#if STATS
+		Table->ActiveRequests--;
+#endif
+		// If this pool was exhausted, move to available list.
+		if( !Pool->FirstMem )
+		{
+			Pool->Unlink();
+			Pool->Link( Table->FirstPool );
+		}
+
+		// Free a pooled allocation.
+		FFreeMem* Free		= (FFreeMem*)Ptr;
+		Free->NumFreeBlocks	= 1;
+		Free->Next			= Pool->FirstMem;
+		Pool->FirstMem		= Free;
+		STAT(UsedCurrent -= Table->BlockSize);
+
+		// Free this pool.
+		checkSlow(Pool->Taken >= 1);
+		if( --Pool->Taken == 0 )
+		{
+#if STATS
+			Table->NumActivePools--;
+#endif
+			// Free the OS memory.
+			SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
+			STAT(OsCurrent -= OsBytes);
+			STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
+			Pool->Unlink();
+			Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
+			OSFree((void*)BasePtr, OsBytes);
+		}
+	}
+
+#ifdef CACHE_PER_THREAD_BLOCKS
+	FORCEINLINE FThreadCache* GetThreadCache() const
+	{
+		return ThreadCacheTlsSlot != 0xFFFFFFFF ? (FThreadCache*)FPlatformTLS::GetTlsValue(ThreadCacheTlsSlot) : NULL;
+	}
+
+	/**
+	* Moves a batch of blocks from the shared pool into an empty thread cache bin, taking the table lock once for the whole batch.
+	*/
+	void RefillThreadCacheBin( FThreadCache* Cache, uint32 PoolIndex, SIZE_T Size )
+	{
+		FPoolTable* Table = &PoolTable[PoolIndex];
+		FThreadCacheBin& Bin = Cache->Bins[PoolIndex];
+		checkSlow(!Bin.FirstFree && !Bin.NumFree);
+
+		uint32 NumBlocks = ThreadCacheBatchBlocks[PoolIndex];
+		{
+#if defined USE_FINE_GRAIN_LOCKS
+			FScopeLock TableLock(&Table->CriticalSection);
+#elif defined USE_COARSE_GRAIN_LOCKS
+			FScopeLock ScopedLock(&AccessGuard);
+#endif
+			for( uint32 BlockIndex = 0; BlockIndex < NumBlocks; BlockIndex++ )
+			{
+				TrackStats(Table, Size);
+
+				FPoolInfo* Pool = Table->FirstPool;
+				if( !Pool )
+				{
+					Pool = AllocatePoolMemory(Table, BINNED_ALLOC_POOL_SIZE, Size);
+				}
+
+				FFreeMem* Free = AllocateBlockFromPool(Table, Pool);
+				Free->Next = Bin.FirstFree;
+				Bin.FirstFree = Free;
+			}
+		}
+		Bin.NumFree = NumBlocks;
+		STAT(Cache->CachedBytes += NumBlocks * Table->BlockSize);
+		STAT(Cache->Misses++);
+	}
+
+	/**
+	* Hands the NumBlocks least recently freed blocks of a thread cache bin back to the shared pool, taking the table lock once for the whole batch.
+	*/
+	void FlushThreadCacheBin( FThreadCache* Cache, uint32 PoolIndex, uint32 NumBlocks )
+	{
+		FPoolTable* Table = &PoolTable[PoolIndex];
+		FThreadCacheBin& Bin = Cache->Bins[PoolIndex];
+		NumBlocks = FMath::Min(NumBlocks, Bin.NumFree);
+		if( !NumBlocks )
+		{
+			return;
+		}
+
+		// The bin is ordered newest first, so the oldest blocks are the tail past the ones that are kept.
+		FFreeMem* FirstFlushed = Bin.FirstFree;
+		const uint32 NumKept = Bin.NumFree - NumBlocks;
+		if( NumKept )
+		{
+			FFreeMem* LastKept = Bin.FirstFree;
+			for( uint32 BlockIndex = 1; BlockIndex < NumKept; BlockIndex++ )
+			{
+				LastKept = LastKept->Next;
+			}
+			FirstFlushed = LastKept->Next;
+			LastKept->Next = NULL;
+		}
+		else
+		{
+			Bin.FirstFree = NULL;
+		}
+
+		{
+#if defined USE_FINE_GRAIN_LOCKS
+			FScopeLock TableLock(&Table->CriticalSection);
+#elif defined USE_COARSE_GRAIN_LOCKS
+			FScopeLock ScopedLock(&AccessGuard);
+#endif
+			for( uint32 BlockIndex = 0; BlockIndex < NumBlocks; BlockIndex++ )
+			{
+				FFreeMem* Free = FirstFlushed;
+				FirstFlushed = Free->Next;
+
+				UPTRINT BasePtr;
+				FPoolInfo* Pool = FindPoolInfo((UPTRINT)Free, BasePtr);
+				checkSlow(Pool && MemSizeToPoolTable[Pool->TableIndex] == Table);
+				FreeBlockToPool(Table, Pool, BasePtr, Free);
+			}
+		}
+		Bin.NumFree -= NumBlocks;
+		STAT(Cache->CachedBytes -= NumBlocks * Table->BlockSize);
+		STAT(Cache->Flushes++);
+	}
+
+	/**
+	* Tries to put a freed block into the calling thread's cache.
+	* @return false if the block does not come from one of the small pools and must be freed the normal way
+	*/
+	FORCEINLINE bool FreeToThreadCache( FThreadCache* Cache, void* Ptr )
+	{
+		UPTRINT BasePtr;
+		FPoolInfo* Pool = FindPoolInfo((UPTRINT)Ptr, BasePtr);
+		checkSlow(Pool);
+		if( Pool->TableIndex >= BinnedSizeLimit )
+		{
+			// Page pools and OS allocations are not cached.
+			return false;
+		}
+
+		uint32 PoolIndex = MemSizeToPoolTable[Pool->TableIndex] - PoolTable;
+		FThreadCacheBin& Bin = Cache->Bins[PoolIndex];
+		FFreeMem* Free = (FFreeMem*)Ptr;
+		Free->Next = Bin.FirstFree;
+		Bin.FirstFree = Free;
+		Bin.NumFree++;
+		STAT(CurrentAllocs--);
+		STAT(Cache->CachedBytes += PoolTable[PoolIndex].BlockSize);
+
+		if( Bin.NumFree > ThreadCacheMaxBlocks[PoolIndex] )
+		{
+			// Keep the most recently freed (and likely still hot) blocks at the head and hand the oldest back.
+			FlushThreadCacheBin(Cache, PoolIndex, ThreadCacheBatchBlocks[PoolIndex]);
+		}
+		return true;
+	}
+
+	/** Sums up the counters of all live thread caches. */
+	void GatherThreadCacheStats( SIZE_T& OutCachedBytes, uint32& OutNumCaches, uint64& OutHits, uint64& OutMisses, uint64& OutFlushes )
+	{
+		OutCachedBytes = 0;
+		OutNumCaches = 0;
+#if STATS
+		FScopeLock ScopedLock( &AccessGuard );
+		OutHits = RetiredThreadCacheHits;
+		OutMisses = RetiredThreadCacheMisses;
+		OutFlushes = RetiredThreadCacheFlushes;
+		for( FThreadCache* Cache = FirstThreadCache; Cache; Cache = Cache->Next )
+		{
+			OutCachedBytes += Cache->CachedBytes;
+			OutHits += Cache->Hits;
+			OutMisses += Cache->Misses;
+			OutFlushes += Cache->Flushes;
+			OutNumCaches++;
+		}
+#else
+		OutHits = 0;
+		OutMisses = 0;
+		OutFlushes = 0;
+#endif
+	}
+#endif
+
 	void PushFreeLockless(void* Ptr)
 	{
 #ifdef USE_LOCKFREE_DELETE
@@ -779,6 +1022,15 @@ public:
 		,	FreedPageBlocksNum(0)
 		,	CachedTotal(0)
 #endif
+#ifdef CACHE_PER_THREAD_BLOCKS
+		,	ThreadCacheTlsSlot(FPlatformTLS::AllocTlsSlot())
+		,	FirstThreadCache(NULL)
+#if STATS
+		,	RetiredThreadCacheHits(0)
+		,	RetiredThreadCacheMisses(0)
+		,	RetiredThreadCacheFlushes(0)
+#endif
+#endif
 #if STATS
 		,	OsCurrent		( 0 )
 		,	OsPeak			( 0 )
@@ -851,6 +1103,10 @@ public:
 			PoolTable[i].BlockSize = BlockSizes[i];
 #if STATS
 			PoolTable[i].MinRequest = PoolTable[i].BlockSize;
+#endif
+#ifdef CACHE_PER_THREAD_BLOCKS
+			ThreadCacheMaxBlocks[i] = FMath::Clamp<uint32>(MAX_THREAD_CACHED_BYTES_PER_POOL / BlockSizes[i], MIN_THREAD_CACHED_BLOCKS_PER_POOL, MAX_THREAD_CACHED_BLOCKS_PER_POOL);
+			ThreadCacheBatchBlocks[i] = FMath::Max<uint32>(ThreadCacheMaxBlocks[i] / 2, 1);
 #endif
 		}
 
@@ -872,7 +1128,14 @@ public:
 	}
 	
 	virtual ~FMallocBinned()
-	{}
+	{
+#ifdef CACHE_PER_THREAD_BLOCKS
+		if( ThreadCacheTlsSlot != 0xFFFFFFFF )
+		{
+			FPlatformTLS::FreeTlsSlot(ThreadCacheTlsSlot);
+		}
+#endif
+	}
 
 	/**
 	 * Returns if the allocator is guaranteed to be thread-safe and therefore
@@ -910,6 +1173,28 @@ public:
 		STAT(CurrentAllocs++);
 		STAT(TotalAllocs++);
 		FFreeMem* Free;
+#ifdef CACHE_PER_THREAD_BLOCKS
+		FThreadCache* Cache = Size < BinnedSizeLimit ? GetThreadCache() : NULL;
+		if( Cache )
+		{
+			// Allocate from this thread's cache, going to the shared pool only when the bin runs dry.
+			uint32 PoolIndex = MemSizeToPoolTable[Size] - PoolTable;
+			FThreadCacheBin& Bin = Cache->Bins[PoolIndex];
+			if( Bin.FirstFree )
+			{
+				STAT(Cache->Hits++);
+			}
+			else
+			{
+				RefillThreadCacheBin(Cache, PoolIndex, Size);
+			}
+			Free = Bin.FirstFree;
+			Bin.FirstFree = Free->Next;
+			Bin.NumFree--;
+			STAT(Cache->CachedBytes -= PoolTable[PoolIndex].BlockSize);
+		}
+		else
+#endif
 		if( Size < BinnedSizeLimit )
 		{
 			// Allocate from pool.
@@ -1062,9 +1347,74 @@ public:
 			return;
 		}
 
+#ifdef CACHE_PER_THREAD_BLOCKS
+		FThreadCache* Cache = GetThreadCache();
+		if( Cache && FreeToThreadCache(Cache, Ptr) )
+		{
+			return;
+		}
+#endif
 		PushFreeLockless(Ptr);
 	}
 
+	/**
+	 * Gives the calling thread its own small block cache. Safe to call more than once.
+	 */
+	virtual void SetupTLSCachesOnCurrentThread() OVERRIDE
+	{
+#ifdef CACHE_PER_THREAD_BLOCKS
+		if( ThreadCacheTlsSlot == 0xFFFFFFFF || GetThreadCache() )
+		{
+			return;
+		}
+		FThreadCache* Cache = (FThreadCache*)FPlatformMemory::BinnedAllocFromOS(Align(sizeof(FThreadCache), PageSize));
+		if( !Cache )
+		{
+			OutOfMemory(sizeof(FThreadCache));
+		}
+		FMemory::Memzero(Cache, sizeof(FThreadCache));
+		{
+			FScopeLock ScopedLock( &AccessGuard );
+			STAT(OsPeak = FMath::Max(OsPeak, OsCurrent += Align(sizeof(FThreadCache), PageSize)));
+			STAT(WastePeak = FMath::Max(WastePeak, WasteCurrent += Align(sizeof(FThreadCache), PageSize)));
+			Cache->Link( FirstThreadCache );
+		}
+		FPlatformTLS::SetTlsValue(ThreadCacheTlsSlot, Cache);
+#endif
+	}
+
+	/**
+	 * Hands every block cached by the calling thread back to the shared pools and frees the cache.
+	 */
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() OVERRIDE
+	{
+#ifdef CACHE_PER_THREAD_BLOCKS
+		FThreadCache* Cache = GetThreadCache();
+		if( !Cache )
+		{
+			return;
+		}
+		// Disable first, so anything freed from here on goes straight to the pools.
+		FPlatformTLS::SetTlsValue(ThreadCacheTlsSlot, NULL);
+		for( uint32 PoolIndex = 0; PoolIndex < POOL_COUNT; PoolIndex++ )
+		{
+			FlushThreadCacheBin(Cache, PoolIndex, Cache->Bins[PoolIndex].NumFree);
+		}
+		{
+			FScopeLock ScopedLock( &AccessGuard );
+#if STATS
+			RetiredThreadCacheHits += Cache->Hits;
+			RetiredThreadCacheMisses += Cache->Misses;
+			RetiredThreadCacheFlushes += Cache->Flushes;
+#endif
+			STAT(OsCurrent -= Align(sizeof(FThreadCache), PageSize));
+			STAT(WasteCurrent -= Align(sizeof(FThreadCache), PageSize));
+			Cache->Unlink();
+		}
+		FPlatformMemory::BinnedFreeToOS(Cache);
+#endif
+	}
+
 	/**
 	 * If possible determine the size of the memory allocated at the given address
 	 *
@@ -1158,6 +1508,21 @@ public:
 		SET_MEMORY_STAT( STAT_Binned_CurrentAllocs, LocalCurrentAllocs );
 		SET_MEMORY_STAT( STAT_Binned_TotalAllocs, LocalTotalAllocs );
 		SET_MEMORY_STAT( STAT_Binned_SlackCurrent, LocalSlackCurrent );
+
+#ifdef CACHE_PER_THREAD_BLOCKS
+		SIZE_T	LocalThreadCachedCurrent = 0;
+		uint32	LocalThreadCaches = 0;
+		uint64	LocalThreadCacheHits = 0;
+		uint64	LocalThreadCacheMisses = 0;
+		uint64	LocalThreadCacheFlushes = 0;
+		GatherThreadCacheStats( LocalThreadCachedCurrent, LocalThreadCaches, LocalThreadCacheHits, LocalThreadCacheMisses, LocalThreadCacheFlushes );
+
+		SET_MEMORY_STAT( STAT_Binned_ThreadCachedCurrent, LocalThreadCachedCurrent );
+		SET_DWORD_STAT( STAT_Binned_ThreadCaches, LocalThreadCaches );
+		SET_DWORD_STAT( STAT_Binned_ThreadCacheHits, (uint32)LocalThreadCacheHits );
+		SET_DWORD_STAT( STAT_Binned_ThreadCacheMisses, (uint32)LocalThreadCacheMisses );
+		SET_DWORD_STAT( STAT_Binned_ThreadCacheFlushes, (uint32)LocalThreadCacheFlushes );
+#endif
 #endif
 	}
 
@@ -1252,6 +1617,16 @@ public:
 			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "%iK allocated in pools (with %iK slack and %iK waste). Efficiency %.2f%%" ), TotalMemory, TotalSlack, TotalWaste, TotalMemory ? 100.0f * (TotalMemory - TotalWaste) / TotalMemory : 100.0f );
 			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "Allocations %i Current / %i Total (in %i pools)" ), TotalActiveRequests, TotalTotalRequests, TotalPools );
 			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "" ) );
+
+#ifdef CACHE_PER_THREAD_BLOCKS
+			SIZE_T ThreadCachedBytes;
+			uint32 NumThreadCaches;
+			uint64 ThreadCacheHits, ThreadCacheMisses, ThreadCacheFlushes;
+			GatherThreadCacheStats( ThreadCachedBytes, NumThreadCaches, ThreadCacheHits, ThreadCacheMisses, ThreadCacheFlushes );
+			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "Thread caches %i holding %.2f MB (counted as used above)" ), NumThreadCaches, ThreadCachedBytes / (1024.0f * 1024.0f) );
+			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "Thread cache hits %llu, refills %llu, batched hand-backs %llu" ), ThreadCacheHits, ThreadCacheMisses, ThreadCacheFlushes );
+			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "" ) );
+#endif
 #endif
 		}
 
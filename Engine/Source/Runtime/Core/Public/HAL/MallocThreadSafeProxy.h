@@ -132,5 +132,17 @@ public:
 		check(UsedMalloc);
 		return UsedMalloc->GetDescriptiveName(); 
 	}
+
+	virtual void SetupTLSCachesOnCurrentThread() OVERRIDE
+	{
+		FScopeLock ScopeLock( &SynchronizationObject );
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() OVERRIDE
+	{
+		FScopeLock ScopeLock( &SynchronizationObject );
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
 };
 
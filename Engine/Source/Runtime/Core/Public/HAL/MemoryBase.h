@@ -167,6 +167,19 @@ public:
 		return TEXT("Unspecified allocator");
 	}
 
+	/**
+	 * Lets the allocator set up per-thread state (such as small block caches) for the calling thread.
+	 * Threads that never call this always go through the allocator's shared path.
+	 */
+	virtual void SetupTLSCachesOnCurrentThread()
+	{
+	}
+
+	/** Hands any memory cached by the calling thread back to the allocator and stops caching on this thread. */
+	virtual void ClearAndDisableTLSCachesOnCurrentThread()
+	{
+	}
+
 protected:
 	friend struct FCurrentFrameCalls;
 
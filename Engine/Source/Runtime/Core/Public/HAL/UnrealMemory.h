@@ -117,6 +117,12 @@ struct CORE_API FMemory
 
 	static SIZE_T GetAllocSize( void* Original );
 
+	/** Enables the allocator's per-thread caches (if it has any) for the calling thread. */
+	static void SetupTLSCachesOnCurrentThread();
+
+	/** Flushes the calling thread's allocator caches; must be called before a thread that set them up exits. */
+	static void ClearAndDisableTLSCachesOnCurrentThread();
+
 	/**
 	 * A helper function that will perform a series of random heap allocations to test
 	 * the internal validity of the heap. Note, this function will "leak" memory, but another call
@@ -115,6 +115,7 @@ struct CORE_API FLinuxMisc : public FGenericPlatformMisc
 
 	static int32 NumberOfCores();
 	static int32 NumberOfCoresIncludingHyperthreads();
+	static struct FAsyncIOSystemBase* GetPlatformSpecificAsyncIOSystem();
 
 	static const TCHAR* EngineDir()
 	{
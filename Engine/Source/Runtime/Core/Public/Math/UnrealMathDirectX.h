@@ -580,6 +580,20 @@ FORCEINLINE uint32 VectorAnyGreaterThan(const VectorRegister& Vec1, const Vector
 	return (uint32)XMComparisonAnyTrue( comparisonValue );
 }
 
+/**
+ * Returns an integer bit-mask (0x00 - 0x0f) based on the sign-bit for each component in a vector, usually the result of a vector comparison.
+ *
+ * @param VecMask		Vector to take the sign-bits from
+ * @return				Bit 0 = sign(VecMask.x), Bit 1 = sign(VecMask.y), Bit 2 = sign(VecMask.z), Bit 3 = sign(VecMask.w)
+ */
+FORCEINLINE uint32 VectorMaskBits(const VectorRegister& VecMask)
+{
+	using namespace DirectX;
+	XMUINT4 Bits;
+	XMStoreUInt4( &Bits, VecMask );
+	return (Bits.x >> 31) | ((Bits.y >> 31) << 1) | ((Bits.z >> 31) << 2) | ((Bits.w >> 31) << 3);
+}
+
 /**
  * Resets the floating point registers so that they can be used again.
  * Some intrinsics use these for MMX purposes (e.g. VectorLoadByte4 and VectorStoreByte4).
@@ -875,6 +875,19 @@ FORCEINLINE int32 VectorAnyGreaterThan( VectorRegister Vec1, VectorRegister Vec2
 	return (int32)buf[0]; // each byte of output corresponds to a component comparison
 }
 
+/**
+ * Returns an integer bit-mask (0x00 - 0x0f) based on the sign-bit for each component in a vector, usually the result of a vector comparison.
+ *
+ * @param VecMask		Vector to take the sign-bits from
+ * @return				Bit 0 = sign(VecMask.x), Bit 1 = sign(VecMask.y), Bit 2 = sign(VecMask.z), Bit 3 = sign(VecMask.w)
+ */
+FORCEINLINE uint32 VectorMaskBits( VectorRegister VecMask )
+{
+	uint32_t buf[4];
+	vst1q_u32( buf, (uint32x4_t)VecMask );
+	return (buf[0] >> 31) | ((buf[1] >> 31) << 1) | ((buf[2] >> 31) << 2) | ((buf[3] >> 31) << 3);
+}
+
 /**
  * Resets the floating point registers so that they can be used again.
  * Some intrinsics use these for MMX purposes (e.g. VectorLoadByte4 and VectorStoreByte4).
@@ -512,6 +512,18 @@ public:
 		return UsedMalloc->GetAllocationSize(Original,SizeOut);
 	}
 
+	virtual void SetupTLSCachesOnCurrentThread() OVERRIDE
+	{
+		FScopeLock Lock( &CriticalSection );
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() OVERRIDE
+	{
+		FScopeLock Lock( &CriticalSection );
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
 	
 	// Begin Exec Interface
 	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) OVERRIDE;
@@ -845,6 +845,26 @@ public:
 		ArIsFilterEditorOnly = InFilterEditorOnly;
 	}
 
+	/**
+	 * Indicates whether tagged properties in this archive are serialized using the untagged, per-struct serialization plan.
+	 *
+	 * @return true if properties are serialized without tags, false otherwise.
+	 */
+	FORCEINLINE bool UseUnversionedPropertySerialization() const
+	{
+		return ArUseUnversionedPropertySerialization;
+	}
+
+	/**
+	 * Sets a flag indicating that tagged properties should be serialized without tags. Only valid for cooked, editor-filtered data.
+	 *
+	 * @param InUseUnversioned - Whether to serialize properties without tags.
+	 */
+	void SetUseUnversionedPropertySerialization(bool InUseUnversioned)
+	{
+		ArUseUnversionedPropertySerialization = InUseUnversioned;
+	}
+
 	/**
 	 * Indicates whether this archive is saving or loading game state
 	 *
@@ -999,6 +1019,9 @@ public:
 	/** Whether editor only properties are being filtered from the archive (or has been filtered). */
 	bool ArIsFilterEditorOnly;
 
+	/** Whether tagged properties are serialized as a bitmask of non-default values instead of with property tags. */
+	bool ArUseUnversionedPropertySerialization;
+
 	/** Whether this archive is saving/loading game state */
 	bool ArIsSaveGame;
 
@@ -62,6 +62,8 @@ namespace FNameDefs
 	// use of FNames to store asset path and content tags
 	static const uint32 NameHashBucketCount = 65536;
 #endif
+	// Number of locks guarding inserts into the name hash. Each lock covers every NameHashLockCount'th bucket.
+	static const uint32 NameHashLockCount = 256;
 }
 
 
@@ -256,9 +258,9 @@ class TStaticIndirectArrayThreadSafeRead
 	/** Static master table to chunks of pointers **/
 	ElementType** Chunks[ChunkTableSize];
 	/** Number of elements we currently have **/
-	int32 NumElements;
+	volatile int32 NumElements;
 	/** Number of chunks we currently have **/
-	int32 NumChunks;
+	volatile int32 NumChunks;
 
 	/**
 	 * Expands the array so that Element[Index] is allocated. New pointers are all zero.
@@ -270,23 +272,25 @@ class TStaticIndirectArrayThreadSafeRead
 		int32 ChunkIndex = Index / ElementsPerChunk;
 		while (1)
 		{
-			if (ChunkIndex < NumChunks)
+			int32 LocalNumChunks = NumChunks;
+			if (ChunkIndex < LocalNumChunks)
 			{
 				break;
 			}
-			// add a chunk, and make sure nobody else tries
-			ElementType*** Chunk = &Chunks[ChunkIndex];
-			ElementType** NewChunk = (ElementType**)FMemory::Malloc(sizeof(ElementType*) * ElementsPerChunk);
-			FMemory::Memzero(NewChunk, sizeof(ElementType*) * ElementsPerChunk);
-			if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)Chunk, NewChunk, NULL))
+			// add the next chunk, unless another thread already did
+			ElementType*** Chunk = &Chunks[LocalNumChunks];
+			if (*Chunk == NULL)
 			{
-				// someone else beat us to the add, we don't support multiple concurrent adds
-				check(0)
-			}
-			else
-			{
-				NumChunks++;
+				ElementType** NewChunk = (ElementType**)FMemory::Malloc(sizeof(ElementType*) * ElementsPerChunk);
+				FMemory::Memzero(NewChunk, sizeof(ElementType*) * ElementsPerChunk);
+				if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)Chunk, NewChunk, NULL))
+				{
+					// someone else beat us to the add, use theirs
+					FMemory::Free(NewChunk);
+				}
 			}
+			// the chunk is published before the count, so readers never see a counted chunk that is NULL
+			FPlatformAtomics::InterlockedCompareExchange(&NumChunks, LocalNumChunks + 1, LocalNumChunks);
 		}
 		check(ChunkIndex < NumChunks && Chunks[ChunkIndex]); // should have a valid pointer now
 	}
@@ -347,17 +351,20 @@ public:
 	 * Add more elements to the array
 	 * @param	NumToAdd	Number of elements to add
 	 * @return	the number of elements in the container before we did the add. In other words, the add index.
-	 * Not thread safe. This should only be called by one thread, but the other methods can be called while this is going on.
+	 * Thread safe. Concurrent adds each get their own range of elements, and the chunks for a range are allocated before the range is counted.
 	**/
 	int32 AddZeroed(int32 NumToAdd)
 	{
-		int32 Result = NumElements;
-		check(NumElements + NumToAdd <= MaxTotalElements);
-		ExpandChunksToIndex(NumElements + NumToAdd - 1);
-		check(Result == NumElements);
-		NumElements += NumToAdd;
-		FPlatformMisc::MemoryBarrier();
-		return Result;
+		while (1)
+		{
+			int32 Result = NumElements;
+			check(Result + NumToAdd <= MaxTotalElements);
+			ExpandChunksToIndex(Result + NumToAdd - 1);
+			if (FPlatformAtomics::InterlockedCompareExchange(&NumElements, Result + NumToAdd, Result) == Result)
+			{
+				return Result;
+			}
+		}
 	}
 	/** 
 	 * Return a naked pointer to the fundamental data structure for debug visualizers.
@@ -766,8 +773,12 @@ private:
 		Init(StringCast<WIDECHAR>(InName).Get(), InNumber, FindType, bSplitName, HardcodeIndex);
 	}
 
-	/** Singleton to retrieve the critical section. */
-	static FCriticalSection* GetCriticalSection();
+	/**
+	 * Returns the lock that guards inserts into a hash bucket. Lookups don't lock, and buckets covered by different locks can be added to concurrently.
+	 *
+	 * @param HashIndex Index of the bucket in NameHash
+	 */
+	static FCriticalSection* GetHashBucketCriticalSection(int32 HashIndex);
 
 };
 
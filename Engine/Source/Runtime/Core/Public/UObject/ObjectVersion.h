@@ -540,6 +540,8 @@ enum EUnrealEngineObjectUE4Version
 	VER_UE4_STATIC_MESH_SCREEN_SIZE_LODS,
 	// Requires test of material coords to ensure they're saved correctly
 	VER_UE4_FIX_MATERIAL_COORDS,
+	// Cooked static mesh LODs may store their vertex and index buffers as bulk data for LOD streaming
+	VER_UE4_STATIC_MESH_LOD_STREAMING,
  
 	// -----<new versions can be added before this line>-------------------------------------------------
 	// - this needs to be the last line (see note below)
@@ -25,6 +25,28 @@ DECLARE_CYCLE_STAT(TEXT("PostLoadObjects AsyncPackage"),STAT_FAsyncPackage_PostL
 DECLARE_CYCLE_STAT(TEXT("FinishObjects AsyncPackage"),STAT_FAsyncPackage_FinishObjects,STATGROUP_AsyncLoad);
 
 DECLARE_CYCLE_STAT(TEXT("Async Loading Time"),STAT_AsyncLoadingTime,STATGROUP_AsyncLoad);
+DECLARE_CYCLE_STAT(TEXT("SerializeTables AsyncLoadingThread"),STAT_AsyncLoadingThread_SerializeTables,STATGROUP_AsyncLoad);
+
+/** Whether the tables of cooked packages are read on the async loading thread */
+static int32 GAsyncLoadingThread = 1;
+static FAutoConsoleVariableRef CVarAsyncLoadingThread(
+	TEXT("s.AsyncLoadingThread"),
+	GAsyncLoadingThread,
+	TEXT("If nonzero, the package file summary, name, import and export maps of seek free packages are read on a dedicated async loading thread,\n")
+	TEXT("and the game thread only creates, serializes and post loads the objects. Otherwise the game thread does all of it in time slices.\n")
+	TEXT("Takes effect for packages that start loading afterwards."),
+	ECVF_Default
+	);
+
+/** Largest export data the async loading thread precaches for a package */
+static int32 GAsyncLoadingThreadPrecacheLimitKB = 4096;
+static FAutoConsoleVariableRef CVarAsyncLoadingThreadPrecacheLimitKB(
+	TEXT("s.AsyncLoadingThreadPrecacheLimitKB"),
+	GAsyncLoadingThreadPrecacheLimitKB,
+	TEXT("Packages whose serialized exports fit in this many KB have all of them precached by the async loading thread in one read,\n")
+	TEXT("so that serializing them on the game thread never waits for IO. Larger packages are precached one export at a time. 0 disables it."),
+	ECVF_Default
+	);
 
 
 
@@ -45,6 +67,191 @@ void NotifyConstructedDuringAsyncLoading(UObject* Object)
 }
 
 
+/*-----------------------------------------------------------------------------
+	FAsyncLoadingThread.
+-----------------------------------------------------------------------------*/
+
+/**
+ * Reads the linker tables of async packages off the game thread. The game thread creates the package, the linker
+ * and its loader, then queues the package and leaves the linker alone until AsyncLinkerState says the thread is done
+ * with it. Everything that creates or finds objects stays on the game thread.
+ */
+class FAsyncLoadingThread : public FRunnable
+{
+public:
+
+	FAsyncLoadingThread()
+		: Thread(NULL)
+		, WorkEvent(FPlatformProcess::CreateSynchEvent())
+		, PackageFinishedEvent(FPlatformProcess::CreateSynchEvent())
+	{
+		Thread = FRunnableThread::Create(this, TEXT("AsyncLoadingThread"), 0, 0, 128 * 1024, TPri_Normal);
+	}
+
+	/** Stops the thread. Queued packages are left as they are. */
+	virtual ~FAsyncLoadingThread()
+	{
+		if (Thread != NULL)
+		{
+			Thread->Kill(true);
+			delete Thread;
+		}
+		delete WorkEvent;
+		delete PackageFinishedEvent;
+	}
+
+	/** @return the async loading thread, started on first use, or NULL if it is disabled or can't run */
+	static FAsyncLoadingThread* Get()
+	{
+		if (!GAsyncLoadingThread || !FPlatformProcess::SupportsMultithreading() || bHasShutdown)
+		{
+			return NULL;
+		}
+		if (Singleton == NULL)
+		{
+			Singleton = new FAsyncLoadingThread();
+			if (Singleton->Thread == NULL)
+			{
+				UE_LOG(LogStreaming, Warning, TEXT("Couldn't start the async loading thread, linker tables are read on the game thread."));
+				delete Singleton;
+				Singleton = NULL;
+				bHasShutdown = true;
+			}
+		}
+		return Singleton;
+	}
+
+	/** Stops the thread for good, Get returns NULL afterwards */
+	static void Shutdown()
+	{
+		delete Singleton;
+		Singleton = NULL;
+		bHasShutdown = true;
+	}
+
+	/**
+	 * Hands the linker tables of a package to the thread. Called on the game thread only.
+	 *
+	 * @param Package package whose linker has a loader, AsyncLinkerState must be Queued
+	 */
+	void QueuePackage(FAsyncPackage* Package)
+	{
+		check(Package->AsyncLinkerState.GetValue() == EAsyncLinkerState::Queued);
+		{
+			FScopeLock Lock(&QueueCritical);
+			QueuedPackages.Add(Package);
+		}
+		WorkEvent->Trigger();
+	}
+
+	/**
+	 * Blocks until the thread is done with the linker of a package. Called on the game thread only, when flushing.
+	 *
+	 * @param Package package that was handed to QueuePackage
+	 */
+	void WaitForPackage(FAsyncPackage* Package)
+	{
+		while (Package->AsyncLinkerState.GetValue() == EAsyncLinkerState::Queued)
+		{
+			// Triggered after every package the thread finishes, so this rechecks the state if it was another one
+			PackageFinishedEvent->Wait();
+		}
+	}
+
+	// Begin FRunnable interface.
+	virtual bool Init() OVERRIDE
+	{
+		return true;
+	}
+
+	virtual uint32 Run() OVERRIDE
+	{
+		while (StopTaskCounter.GetValue() == 0)
+		{
+			{
+				FScopeLock Lock(&QueueCritical);
+				WorkingPackages.Append(QueuedPackages);
+				QueuedPackages.Reset();
+			}
+
+			if (WorkingPackages.Num() == 0)
+			{
+				WorkEvent->Wait();
+				continue;
+			}
+
+			const int64 MaxExportPrecacheSize = (int64)FMath::Max(GAsyncLoadingThreadPrecacheLimitKB, 0) * 1024;
+			bool bFinishedAny = false;
+			for (int32 PackageIndex = 0; PackageIndex < WorkingPackages.Num() && StopTaskCounter.GetValue() == 0; PackageIndex++)
+			{
+				FAsyncPackage* Package = WorkingPackages[PackageIndex];
+
+				ULinkerLoad::ELinkerStatus Status;
+				{
+					SCOPE_CYCLE_COUNTER(STAT_AsyncLoadingThread_SerializeTables);
+					Status = Package->Linker->SerializeTables(MaxExportPrecacheSize);
+				}
+				if (Status == ULinkerLoad::LINKER_TimedOut)
+				{
+					continue;
+				}
+
+				// Everything written to the linker has to be visible before the game thread takes it back
+				FPlatformMisc::MemoryBarrier();
+				Package->AsyncLinkerState.Set(Status == ULinkerLoad::LINKER_Loaded ? EAsyncLinkerState::Finished : EAsyncLinkerState::Failed);
+				WorkingPackages.RemoveAt(PackageIndex--);
+				bFinishedAny = true;
+				PackageFinishedEvent->Trigger();
+			}
+
+			// Every package is waiting for IO, don't spin on it
+			if (!bFinishedAny)
+			{
+				WorkEvent->Wait(1);
+			}
+		}
+		return 0;
+	}
+
+	virtual void Stop() OVERRIDE
+	{
+		StopTaskCounter.Increment();
+		WorkEvent->Trigger();
+	}
+	// End FRunnable interface.
+
+private:
+
+	/** The running thread, NULL if it couldn't be created */
+	FRunnableThread* Thread;
+	/** Triggered when packages are queued or the thread is stopped */
+	FEvent* WorkEvent;
+	/** Triggered when the thread is done with the linker of a package, a flush on the game thread may be waiting for it */
+	FEvent* PackageFinishedEvent;
+	/** Nonzero once the thread has been asked to stop */
+	FThreadSafeCounter StopTaskCounter;
+	/** Guards QueuedPackages */
+	FCriticalSection QueueCritical;
+	/** Packages queued by the game thread, not yet picked up by the thread */
+	TArray<FAsyncPackage*> QueuedPackages;
+	/** Packages the thread is reading the tables of, in the order they were queued. Only touched by the thread. */
+	TArray<FAsyncPackage*> WorkingPackages;
+
+	/** The thread, NULL until Get is first called */
+	static FAsyncLoadingThread* Singleton;
+	/** Set once the thread has been shut down or failed to start, so it isn't started again */
+	static bool bHasShutdown;
+};
+
+FAsyncLoadingThread* FAsyncLoadingThread::Singleton = NULL;
+bool FAsyncLoadingThread::bHasShutdown = false;
+
+void ShutdownAsyncLoadingThread()
+{
+	FAsyncLoadingThread::Shutdown();
+}
+
+
 /*-----------------------------------------------------------------------------
 	FAsyncPackage implementation.
 -----------------------------------------------------------------------------*/
@@ -344,7 +551,53 @@ EAsyncPackageState::Type FAsyncPackage::FinishLinker()
 		SCOPE_CYCLE_COUNTER(STAT_FAsyncPackage_FinishLinker);
 		LastObjectWorkWasPerformedOn	= Linker->LinkerRoot;
 		LastTypeOfWorkPerformed			= TEXT("ticking linker");
-	
+
+		// Time sliced loads of seek free packages have their tables read on the async loading thread. Flushes don't
+		// bother, they would only wait for it.
+		if( AsyncLinkerState.GetValue() == EAsyncLinkerState::GameThread && bUseTimeLimit
+		&&	(Linker->LoadFlags & LOAD_SeekFree) && !Linker->bHasSerializedPackageFileSummary )
+		{
+			FAsyncLoadingThread* AsyncLoadingThread = FAsyncLoadingThread::Get();
+			if( AsyncLoadingThread )
+			{
+				// Creating the loader looks at precached packages and existing linkers, only the game thread may do that.
+				if( Linker->CreateLoader() == ULinkerLoad::LINKER_Failed )
+				{
+					UE_LOG(LogStreaming, Error, TEXT("FAsyncPackage::FinishLinker couldn't open %s."), *PackageNameToLoad);
+					bLoadHasFailed = true;
+					return EAsyncPackageState::TimeOut;
+				}
+				AsyncLinkerState.Set(EAsyncLinkerState::Queued);
+				AsyncLoadingThread->QueuePackage(this);
+			}
+		}
+
+		if( AsyncLinkerState.GetValue() == EAsyncLinkerState::Queued )
+		{
+			if( bUseTimeLimit )
+			{
+				GiveUpTimeSlice();
+				return EAsyncPackageState::TimeOut;
+			}
+
+			// Flushing, the linker can't be touched until the thread is done with it. Packages are only queued while
+			// the thread is running and it is only shut down on exit, when nothing is loading.
+			FAsyncLoadingThread* AsyncLoadingThread = FAsyncLoadingThread::Get();
+			check(AsyncLoadingThread);
+			AsyncLoadingThread->WaitForPackage(this);
+		}
+
+		if( AsyncLinkerState.GetValue() == EAsyncLinkerState::Failed )
+		{
+			UE_LOG(LogStreaming, Error, TEXT("FAsyncPackage::FinishLinker couldn't read the tables of %s."), *PackageNameToLoad);
+			bLoadHasFailed = true;
+			return EAsyncPackageState::TimeOut;
+		}
+
+		// The thread leaves the package alone, bring it up to date with the summary before anything else looks at it.
+		// LoadImports checks the flags of packages that are still being streamed in.
+		Linker->UpdateLinkerRoot();
+
 		// Operation still pending if Tick returns false
 		if( Linker->Tick( TimeLimit, bUseTimeLimit, bUseFullTimeLimit ) != ULinkerLoad::LINKER_Loaded)
 		{
@@ -762,6 +1015,9 @@ EAsyncPackageState::Type FAsyncPackage::FinishObjects()
 		{
 			Linker->LinkerRoot->MarkAsFullyLoaded();
 			Linker->LinkerRoot->SetLoadTime( FPlatformTime::Seconds() - LoadStartTime );
+
+			// Cooked content doesn't change after being loaded, so the garbage collector can handle it as a whole.
+			CreateGarbageCollectionCluster( Linker->LinkerRoot );
 		}
 
 		// Call any completion callbacks specified.
@@ -958,6 +1214,12 @@ EAsyncPackageState::Type ProcessAsyncLoading( bool bUseTimeLimit, bool bUseFullT
 	EAsyncPackageState::Type LoadingState = EAsyncPackageState::Complete;
 	EAsyncPackageState::Type CompletionState = EAsyncPackageState::Complete;
 
+	// Unreachable objects have to be unhashed before packages look for existing objects. See LoadPackage.
+	if( GObjAsyncPackages.Num() && IsIncrementalUnhashPending() )
+	{
+		UnhashUnreachableObjects( false );
+	}
+
 	// We need to loop as the function has to handle finish loading everything given no time limit
 	// like e.g. when called from FlushAsyncLoading.
 	for (int32 i = 0; LoadingState != EAsyncPackageState::TimeOut && i < GObjAsyncPackages.Num(); i++)
@@ -360,6 +360,7 @@ UStruct::UStruct( EStaticConstructor, int32 InSize, EObjectFlags InFlags )
 ,	RefLink			( NULL )
 ,	DestructorLink	( NULL )
 , PostConstructLink( NULL )
+,	UnversionedSerializationPlanSize( 0 )
 {
 }
 
@@ -373,6 +374,7 @@ UStruct::UStruct(const class FPostConstructInitializeProperties& PCIP, UStruct*
 ,	RefLink			( NULL )
 ,	DestructorLink	( NULL )
 , PostConstructLink( NULL )
+,	UnversionedSerializationPlanSize( 0 )
 {
 }
 
@@ -578,6 +580,9 @@ void UStruct::Link(FArchive& Ar, bool bRelinkExistingProperties)
 	UProperty** RefLinkPtr = (UProperty**)&RefLink;
 	UProperty** PostConstructLinkPtr = &PostConstructLink;
 
+	UnversionedSerializationPlan.Reset();
+	UnversionedSerializationPlanSize = 0;
+
 	for (TFieldIterator<UProperty> It(this); It; ++It)
 	{
 		UProperty* Property = *It;
@@ -606,6 +611,14 @@ void UStruct::Link(FArchive& Ar, bool bRelinkExistingProperties)
 			PostConstructLinkPtr = &(*PostConstructLinkPtr)->PostConstructLinkNext;
 		}
 
+		// Build the untagged serialization plan. Mirrors UProperty::ShouldSerializeValue for a persistent, editor-filtered archive,
+		// so it only contains properties that exist and are saved in cooked builds.
+		if (!Property->HasAnyPropertyFlags(CPF_Transient | CPF_NonPIETransient | CPF_Deprecated) && !Property->IsEditorOnlyProperty())
+		{
+			UnversionedSerializationPlan.Add(Property);
+			UnversionedSerializationPlanSize += Property->ArrayDim;
+		}
+
 		*PropertyLinkPtr = Property;
 		PropertyLinkPtr = &(*PropertyLinkPtr)->PropertyLinkNext;
 	}
@@ -686,6 +699,12 @@ void UStruct::SerializeTaggedProperties(FArchive& Ar, uint8* Data, UStruct* Defa
 
 	check(Ar.IsLoading() || Ar.IsSaving());
 
+	if( ShouldSerializeUnversionedProperties(Ar) )
+	{
+		SerializeUnversionedProperties(Ar, Data, DefaultsStruct, Defaults);
+		return;
+	}
+
 	UClass* DefaultsClass = Cast<UClass>(DefaultsStruct);
 	UScriptStruct* DefaultsScriptStruct = Cast<UScriptStruct>(DefaultsStruct);
 
@@ -1128,6 +1147,87 @@ void UStruct::SerializeTaggedProperties(FArchive& Ar, uint8* Data, UStruct* Defa
 		Ar << Temp;
 	}
 }
+
+bool UStruct::ShouldSerializeUnversionedProperties( FArchive& Ar )
+{
+	return Ar.UseUnversionedPropertySerialization()
+		&& Ar.IsFilterEditorOnly()
+		&& Ar.IsPersistent()
+		&& !Ar.IsSaveGame()
+		&& !Ar.IsTransacting()
+		&& !Ar.IsSerializingDefaults()
+		&& !(Ar.GetPortFlags() & (PPF_Duplicate | PPF_DuplicateForPIE));
+}
+
+void UStruct::SerializeUnversionedProperties( FArchive& Ar, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults ) const
+{
+	// The value count doubles as a cheap check that the layout matches the one the data was saved with.
+	int32 NumValues = UnversionedSerializationPlanSize;
+	Ar << NumValues;
+	if( NumValues != UnversionedSerializationPlanSize )
+	{
+		UE_LOG(LogClass, Fatal, TEXT("Unversioned property layout mismatch in %s: %i values saved, %i expected for package:  %s"), *GetFullName(), NumValues, UnversionedSerializationPlanSize, *Ar.GetArchiveName() );
+		return;
+	}
+
+	TArray<uint32, TInlineAllocator<8> > ValueMask;
+	ValueMask.AddZeroed( (NumValues + 31) / 32 );
+
+	/** If true, it means that we want to serialize all properties of this struct if any properties differ from defaults */
+	bool bUseAtomicSerialization = false;
+
+	if( Ar.IsSaving() )
+	{
+		UScriptStruct* DefaultsScriptStruct = Cast<UScriptStruct>(DefaultsStruct);
+		if (DefaultsScriptStruct)
+		{
+			bUseAtomicSerialization = DefaultsScriptStruct->ShouldSerializeAtomically(Ar);
+		}
+
+		// Same delta rules as the tagged path: only values that differ from the defaults are written.
+		const bool bSaveAllValues = (!IsA(UClass::StaticClass()) && !Defaults) || !Ar.DoDelta();
+		int32 ValueIndex = 0;
+		for( int32 PlanIndex = 0; PlanIndex < UnversionedSerializationPlan.Num(); PlanIndex++ )
+		{
+			UProperty* Property = UnversionedSerializationPlan[PlanIndex];
+			for( int32 Idx = 0; Idx < Property->ArrayDim; Idx++, ValueIndex++ )
+			{
+				uint8* DataPtr = Property->ContainerPtrToValuePtr<uint8>(Data, Idx);
+				uint8* DefaultValue = Property->ContainerPtrToValuePtrForDefaults<uint8>(DefaultsStruct, Defaults, Idx);
+				if( bSaveAllValues || !Property->Identical( DataPtr, DefaultValue, Ar.GetPortFlags()) )
+				{
+					ValueMask[ValueIndex >> 5] |= 1u << (ValueIndex & 31);
+				}
+			}
+		}
+	}
+
+	for( int32 WordIndex = 0; WordIndex < ValueMask.Num(); WordIndex++ )
+	{
+		Ar << ValueMask[WordIndex];
+	}
+
+	// Replay the plan. Values that were not saved keep whatever the object was constructed with, as with tagged loading.
+	UProperty* OldSerializedProperty = GSerializedProperty;
+	int32 ValueIndex = 0;
+	for( int32 PlanIndex = 0; PlanIndex < UnversionedSerializationPlan.Num(); PlanIndex++ )
+	{
+		UProperty* Property = UnversionedSerializationPlan[PlanIndex];
+		for( int32 Idx = 0; Idx < Property->ArrayDim; Idx++, ValueIndex++ )
+		{
+			if( ValueMask[ValueIndex >> 5] & (1u << (ValueIndex & 31)) )
+			{
+				uint8* DataPtr = Property->ContainerPtrToValuePtr<uint8>(Data, Idx);
+				uint8* DefaultValue = (Ar.IsSaving() && !bUseAtomicSerialization) ? Property->ContainerPtrToValuePtrForDefaults<uint8>(DefaultsStruct, Defaults, Idx) : NULL;
+
+				GSerializedProperty = Property;
+				Property->SerializeItem( Ar, DataPtr, 0, DefaultValue );
+			}
+		}
+	}
+	GSerializedProperty = OldSerializedProperty;
+}
+
 void UStruct::FinishDestroy()
 {
 	Script.Empty();
@@ -3068,6 +3168,8 @@ void UClass::PurgeClass(bool bRecompilingOnLoad)
 	RefLink = NULL;
 	PropertyLink = NULL;
 	DestructorLink = NULL;
+	UnversionedSerializationPlan.Empty();
+	UnversionedSerializationPlanSize = 0;
 	ClassAddReferencedObjects = NULL;
 
 	ScriptObjectReferences.Empty();
@@ -27,6 +27,35 @@ int32		GObjectCountDuringLastMarkPhase			= 0;
 int32		GPurgedObjectCountSinceLastMarkPhase	= 0;
 /** Whether incremental object purge is in progress										*/
 static bool GObjIncrementalPurgeIsInProgress = false;
+/** Unreachable objects found by the last reachability analysis that still need BeginDestroy routed to them. */
+static TArray<UObject*> GUnreachableObjects;
+/** Index of the next object in GUnreachableObjects to route BeginDestroy to. */
+static int32 GUnreachableObjectIndex = 0;
+/**
+ * A group of objects loaded from the same cooked package that is marked reachable as a whole.
+ * Created by CreateGarbageCollectionCluster.
+ */
+struct FGCCluster
+{
+	/** Object the cluster is marked through; the package its members were loaded from. NULL for free entries. */
+	UObject* Root;
+	/** Objects that belong to the cluster, excluding the root. */
+	TArray<UObject*> Objects;
+	/** Objects outside of the cluster that are referenced by the root or any of the members. */
+	TArray<UObject*> ReferencedObjects;
+};
+/** All garbage collection clusters, including free entries. */
+static TArray<FGCCluster> GGCClusters;
+/** Indices of free entries in GGCClusters. */
+static TArray<int32> GGCFreeClusterIndices;
+/** Cluster index for each object in GUObjectArray, INDEX_NONE if the object isn't part of a cluster. Only grown when a cluster is created. */
+static TArray<int32> GObjectClusterIndex;
+/** Number of objects marked reachable through their cluster during the last reachability analysis, without being traversed. */
+static FThreadSafeCounter GObjectsSkippedByClusters;
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GC Clusters"),STAT_GCClusters,STATGROUP_Object);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("GC Objects Skipped By Clusters"),STAT_GCObjectsSkippedByClusters,STATGROUP_Object);
+
 /** Whether FinishDestroy has already been routed to all unreachable objects. */
 static bool GObjFinishDestroyHasBeenRoutedToAllObjects	= false;
 /** 
@@ -156,6 +185,55 @@ void SerializeRootSet( FArchive& Ar, EObjectFlags KeepFlags )
 	}
 }
 
+/**
+ * Returns the index of the cluster the object belongs to, INDEX_NONE if it isn't part of any cluster.
+ */
+static FORCEINLINE int32 GetObjectClusterIndex( const UObject* Object )
+{
+	const int32 ObjectIndex = Object->GetUniqueID();
+	return ObjectIndex < GObjectClusterIndex.Num() ? GObjectClusterIndex[ObjectIndex] : INDEX_NONE;
+}
+
+/**
+ * Clears RF_Unreachable on an object.
+ *
+ * @return true if this call marked the object as reachable, false if it already was
+ */
+static FORCEINLINE bool MarkObjectReachable( UObject* Object )
+{
+	if( GIsRunningParallelReachability )
+	{
+		return Object->ThisThreadAtomicallyClearedRFUnreachable();
+	}
+	else if( Object->HasAnyFlags( RF_Unreachable ) )
+	{
+		Object->ClearFlags( RF_Unreachable );
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Adds an object that has just been marked reachable to the list of objects to serialize. Cluster members are
+ * never serialized individually; their cluster root is marked and serialized instead.
+ */
+static FORCEINLINE void AddReachableObject( TArray<UObject*>& ObjectsToSerialize, UObject* Object )
+{
+	const int32 ClusterIndex = GetObjectClusterIndex( Object );
+	if( ClusterIndex == INDEX_NONE )
+	{
+		ObjectsToSerialize.Add( Object );
+	}
+	else
+	{
+		UObject* ClusterRoot = GGCClusters[ClusterIndex].Root;
+		if( ClusterRoot == Object || MarkObjectReachable( ClusterRoot ) )
+		{
+			ObjectsToSerialize.Add( ClusterRoot );
+		}
+	}
+}
+
 /**
  * Handles object reference, potentially NULL'ing
  *
@@ -188,7 +266,7 @@ static FORCEINLINE void HandleObjectReference( TArray<UObject*>& ObjectsToSerial
 					if (Object->ThisThreadAtomicallyClearedRFUnreachable())
 					{
 						// Add it to the list of objects to serialize.
-						ObjectsToSerialize.Add( Object );
+						AddReachableObject( ObjectsToSerialize, Object );
 					}
 				}
 				else if ( ObjectToAdd )
@@ -206,7 +284,7 @@ static FORCEINLINE void HandleObjectReference( TArray<UObject*>& ObjectsToSerial
 					// Mark it as reachable.
 					Object->ClearFlags( RF_Unreachable );
 					// Add it to the list of objects to serialize.
-					ObjectsToSerialize.Add( Object );
+					AddReachableObject( ObjectsToSerialize, Object );
 				}
 			}
 #if PERF_DETAILED_PER_CLASS_GC_STATS
@@ -398,6 +476,13 @@ public:
 	/**
 	 * Performs reachability analysis.
 	 *
+	 * This always runs to completion in one go and is not bound by the incremental purge time limit. Splitting it over
+	 * several frames would need a write barrier on every UObject reference assignment, so that an object stored into an
+	 * already marked object while the mark is suspended gets marked too. UObject references are plain pointers written
+	 * directly by native code and by the property system, so there is no place to put one. Everything after the mark
+	 * (BeginDestroy, FinishDestroy and deletion) is spread over frames by IncrementalPurgeGarbage instead, and clusters
+	 * keep the mark itself short for cooked content.
+	 *
 	 * @param KeepFlags		Objects with these flags will be kept regardless of being referenced or not
 	 */
 	void PerformReachabilityAnalysis( EObjectFlags KeepFlags, bool bForceSingleThreaded = false )
@@ -409,6 +494,7 @@ public:
 
 		// Reset object count.
 		GObjectCountDuringLastMarkPhase = 0;
+		GObjectsSkippedByClusters.Reset();
 
 		// Presize array and add a bit of extra slack for prefetching.
 		ObjectsToSerialize.Empty( GUObjectArray.GetObjectArrayNumMinusPermanent() + 2 );
@@ -496,6 +582,35 @@ public:
 	{
 	}
 
+	/**
+	 * Marks all members of a reachable cluster and the objects the cluster references. Members that were added on their
+	 * own, e.g. because they are part of the root set, only mark the cluster root.
+	 */
+	void ProcessCluster(TArray<UObject*>& NewObjectsToSerialize, UObject* CurrentObject, FGCCluster& Cluster)
+	{
+		if (CurrentObject != Cluster.Root)
+		{
+			if (MarkObjectReachable(Cluster.Root))
+			{
+				NewObjectsToSerialize.Add(Cluster.Root);
+			}
+			return;
+		}
+
+		for (int32 MemberIndex = 0; MemberIndex < Cluster.Objects.Num(); MemberIndex++)
+		{
+			MarkObjectReachable(Cluster.Objects[MemberIndex]);
+		}
+		GObjectsSkippedByClusters.Add(Cluster.Objects.Num());
+
+		// References can't be eliminated as they were gathered when the cluster was created. Clusters holding on to pending kill
+		// objects have been dissolved before reachability analysis started.
+		for (int32 ReferenceIndex = 0; ReferenceIndex < Cluster.ReferencedObjects.Num(); ReferenceIndex++)
+		{
+			HandleObjectReference(NewObjectsToSerialize, Cluster.Root, Cluster.ReferencedObjects[ReferenceIndex], false);
+		}
+	}
+
 	void ProcessObjectArray(TArray<UObject*>& InObjectsToSerializeArray, FGraphEventRef& MyCompletionGraphEvent)
 	{		
 		UObject* CurrentObject = NULL;
@@ -538,6 +653,14 @@ public:
 					FPlatformMisc::PrefetchBlock(NextObject, NextObject->GetClass()->GetPropertiesSize());
 				}
 
+				// Cluster roots mark their members and references without traversing them.
+				const int32 ClusterIndex = GetObjectClusterIndex( CurrentObject );
+				if( ClusterIndex != INDEX_NONE )
+				{
+					ProcessCluster( NewObjectsToSerialize, CurrentObject, GGCClusters[ClusterIndex] );
+					continue;
+				}
+
 				//@todo rtgc: we need to handle object references in struct defaults
 
 				// Make sure that token stream has been assembled at this point as the below code relies on it.
@@ -772,12 +895,21 @@ void IncrementalPurgeGarbage( bool bUseTimeLimit, float TimeLimit )
 	// Set 'I'm garbage collecting' flag - might be checked inside UObject::Destroy etc.
 	TGuardValue<bool> GuardIsGarbageCollecting(GIsGarbageCollecting, true);
 
-	// Incremental purge is now in progress.
-	GObjIncrementalPurgeIsInProgress						= true;
-
 	// Keep track of start time to enforce time limit unless bForceFullPurge is true;
 	const double		StartTime							= FPlatformTime::Seconds();
 	bool		bTimeLimitReached							= false;
+
+	// BeginDestroy has to be routed to all unreachable objects before any of them can be purged.
+	if( IsIncrementalUnhashPending() )
+	{
+		if( !UnhashUnreachableObjects( bUseTimeLimit, TimeLimit ) || (bUseTimeLimit && (FPlatformTime::Seconds() - StartTime) > TimeLimit) )
+		{
+			return;
+		}
+	}
+
+	// Incremental purge is now in progress.
+	GObjIncrementalPurgeIsInProgress						= true;
 	// Depending on platform FPlatformTime::Seconds might take a noticeable amount of time if called thousands of times so we avoid
 	// enforcing the time limit too often, especially as neither Destroy nor actual deletion should take significant
 	// amounts of time.
@@ -1008,6 +1140,44 @@ bool IsIncrementalPurgePending()
 	return GObjIncrementalPurgeIsInProgress || GObjPurgeIsRequired;
 }
 
+bool IsIncrementalUnhashPending()
+{
+	return GUnreachableObjectIndex < GUnreachableObjects.Num();
+}
+
+bool UnhashUnreachableObjects( bool bUseTimeLimit, float TimeLimit )
+{
+	// Set 'I'm garbage collecting' flag - might be checked inside BeginDestroy.
+	TGuardValue<bool> GuardIsGarbageCollecting(GIsGarbageCollecting, true);
+
+	const double StartTime = FPlatformTime::Seconds();
+	// BeginDestroy can be expensive (e.g. releasing rendering resources), so poll the time limit often.
+	const int32	TimeLimitEnforcementGranularityForBeginDestroy = 10;
+	int32 TimePollCounter = 0;
+
+	while( GUnreachableObjectIndex < GUnreachableObjects.Num() )
+	{
+		UObject* Object = GUnreachableObjects[GUnreachableObjectIndex++];
+		if( Object->HasAnyFlags( RF_Unreachable ) )
+		{
+			// Begin the object's asynchronous destruction.
+			Object->ConditionalBeginDestroy();
+		}
+
+		// Only check time limit every so often to avoid calling FPlatformTime::Seconds too often.
+		const bool bPollTimeLimit = ((++TimePollCounter) % TimeLimitEnforcementGranularityForBeginDestroy == 0);
+		if( bUseTimeLimit && bPollTimeLimit && GUnreachableObjectIndex < GUnreachableObjects.Num() && ((FPlatformTime::Seconds() - StartTime) > TimeLimit) )
+		{
+			return false;
+		}
+	}
+
+	// Release memory, leaving some slack space for the next collection.
+	GUnreachableObjects.Empty( 256 );
+	GUnreachableObjectIndex = 0;
+	return true;
+}
+
 /** Callback used by the editor to */
 typedef void (*EditorPostReachabilityAnalysisCallbackType)();
 COREUOBJECT_API EditorPostReachabilityAnalysisCallbackType EditorPostReachabilityAnalysisCallback = NULL;
@@ -1016,6 +1186,200 @@ COREUOBJECT_API EditorPostReachabilityAnalysisCallbackType EditorPostReachabilit
 static const auto CVarAllowParallelGC = 
 	IConsoleManager::Get().RegisterConsoleVariable( TEXT("AllowParallelGC"), 1, TEXT("Used to control parallel GC.") )->AsVariableInt();
 
+// Allow BeginDestroy of unreachable objects to be spread over the following frames' incremental purge instead of running right after reachability analysis.
+static const auto CVarIncrementalBeginDestroyGC = 
+	IConsoleManager::Get().RegisterConsoleVariable( TEXT("IncrementalBeginDestroyGC"), 1, TEXT("If non-zero, BeginDestroy is routed to unreachable objects incrementally, using the incremental purge time limit.") )->AsVariableInt();
+
+// Allow loaded cooked packages to be turned into garbage collection clusters.
+static const auto CVarCreateGCClusters = 
+	IConsoleManager::Get().RegisterConsoleVariable( TEXT("CreateGCClusters"), 1, TEXT("If non-zero, objects loaded from cooked packages are grouped into clusters that are marked reachable as a whole.") )->AsVariableInt();
+
+/**
+ * Reference collector gathering the references of a cluster's objects to objects outside of the cluster.
+ */
+class FGCClusterReferenceCollector : public FReferenceCollector
+{
+	UObject* ClusterRoot;
+	TSet<UObject*>& ReferencedObjects;
+
+public:
+
+	FGCClusterReferenceCollector( UObject* InClusterRoot, TSet<UObject*>& InReferencedObjects )
+		: ClusterRoot( InClusterRoot )
+		, ReferencedObjects( InReferencedObjects )
+	{
+	}
+
+	virtual void HandleObjectReference( UObject*& Object, const UObject* ReferencingObject, const UObject* ReferencingProperty ) OVERRIDE
+	{
+		if( Object && Object != ClusterRoot && !GUObjectAllocator.ResidesInPermanentPool(Object) && !Object->IsIn(ClusterRoot) )
+		{
+			ReferencedObjects.Add( Object );
+		}
+	}
+	virtual bool IsIgnoringArchetypeRef() const OVERRIDE
+	{
+		return false;
+	}
+	virtual bool IsIgnoringTransient() const OVERRIDE
+	{
+		return false;
+	}
+};
+
+void CreateGarbageCollectionCluster( UPackage* Package )
+{
+	check( IsInGameThread() );
+
+	// Only cooked content is immutable enough to be clustered. Maps contain actors which change their references all the time.
+	if( !FPlatformProperties::RequiresCookedData() || GIsEditor || GIsGarbageCollecting || CVarCreateGCClusters->GetValueOnGameThread() == 0 ||
+		Package == NULL || Package->HasAnyFlags( RF_PendingKill | RF_Unreachable ) || GUObjectAllocator.ResidesInPermanentPool( Package ) ||
+		(Package->PackageFlags & (PKG_ContainsMap | PKG_CompiledIn | PKG_PlayInEditor)) || GetObjectClusterIndex( Package ) != INDEX_NONE )
+	{
+		return;
+	}
+
+	TArray<UObject*> Objects;
+	GetObjectsWithOuter( Package, Objects, true );
+	if( Objects.Num() == 0 )
+	{
+		return;
+	}
+
+	// Classes, structs and functions are referenced through native token stream entries that script serialization doesn't see.
+	for( int32 ObjectIndex = 0; ObjectIndex < Objects.Num(); ObjectIndex++ )
+	{
+		UObject* Object = Objects[ObjectIndex];
+		if( Object->IsA( UField::StaticClass() ) ||
+			Object->HasAnyFlags( RF_ClassDefaultObject | RF_PendingKill | RF_AsyncLoading | RF_NeedLoad | RF_NeedPostLoad ) ||
+			GUObjectAllocator.ResidesInPermanentPool( Object ) ||
+			GetObjectClusterIndex( Object ) != INDEX_NONE ||
+			!Object->CanBeInCluster() )
+		{
+			return;
+		}
+	}
+
+	// Gather the references to objects outside of the package, the same way FReferenceFinder does, plus the class
+	// which is referenced by the token stream.
+	TSet<UObject*> ReferencedObjects;
+	FGCClusterReferenceCollector Collector( Package, ReferencedObjects );
+	Objects.Add( Package );
+	for( int32 ObjectIndex = 0; ObjectIndex < Objects.Num(); ObjectIndex++ )
+	{
+		UObject* Object = Objects[ObjectIndex];
+		{
+			FSimpleObjectReferenceCollectorArchive CollectorArchive( Object, Collector );
+			Object->SerializeScriptProperties( CollectorArchive );
+		}
+		Object->CallAddReferencedObjects( Collector );
+
+		UObject* Class = Object->GetClass();
+		Collector.HandleObjectReference( Class, Object, NULL );
+	}
+	Objects.Pop();
+
+	int32 ClusterIndex = INDEX_NONE;
+	if( GGCFreeClusterIndices.Num() )
+	{
+		ClusterIndex = GGCFreeClusterIndices.Pop();
+	}
+	else
+	{
+		ClusterIndex = GGCClusters.AddZeroed();
+	}
+	FGCCluster& Cluster = GGCClusters[ClusterIndex];
+	Cluster.Root = Package;
+	Exchange( Cluster.Objects, Objects );
+	Cluster.ReferencedObjects = ReferencedObjects.Array();
+
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	if( GObjectClusterIndex.Num() < NumObjects )
+	{
+		const int32 FirstNewIndex = GObjectClusterIndex.Num();
+		GObjectClusterIndex.AddUninitialized( NumObjects - FirstNewIndex );
+		for( int32 ObjectIndex = FirstNewIndex; ObjectIndex < NumObjects; ObjectIndex++ )
+		{
+			GObjectClusterIndex[ObjectIndex] = INDEX_NONE;
+		}
+	}
+	GObjectClusterIndex[Package->GetUniqueID()] = ClusterIndex;
+	for( int32 MemberIndex = 0; MemberIndex < Cluster.Objects.Num(); MemberIndex++ )
+	{
+		GObjectClusterIndex[Cluster.Objects[MemberIndex]->GetUniqueID()] = ClusterIndex;
+	}
+
+	SET_DWORD_STAT( STAT_GCClusters, GGCClusters.Num() - GGCFreeClusterIndices.Num() );
+}
+
+/**
+ * Turns the members of a cluster back into regular objects and returns the entry to the free list.
+ */
+static void DissolveCluster( int32 ClusterIndex )
+{
+	FGCCluster& Cluster = GGCClusters[ClusterIndex];
+	GObjectClusterIndex[Cluster.Root->GetUniqueID()] = INDEX_NONE;
+	for( int32 MemberIndex = 0; MemberIndex < Cluster.Objects.Num(); MemberIndex++ )
+	{
+		GObjectClusterIndex[Cluster.Objects[MemberIndex]->GetUniqueID()] = INDEX_NONE;
+	}
+	Cluster.Root = NULL;
+	Cluster.Objects.Empty();
+	Cluster.ReferencedObjects.Empty();
+	GGCFreeClusterIndices.Add( ClusterIndex );
+}
+
+/**
+ * Dissolves the clusters that contain or reference a pending kill object. Cluster references are never eliminated,
+ * so such a cluster would keep the object alive; once dissolved, its members are traversed and their references to
+ * the object are cleared like everybody else's.
+ */
+static void DissolveClustersWithPendingKillObjects()
+{
+	for( int32 ClusterIndex = 0; ClusterIndex < GGCClusters.Num(); ClusterIndex++ )
+	{
+		FGCCluster& Cluster = GGCClusters[ClusterIndex];
+		if( !Cluster.Root )
+		{
+			continue;
+		}
+		bool bHasPendingKillObject = Cluster.Root->IsPendingKill();
+		for( int32 MemberIndex = 0; !bHasPendingKillObject && MemberIndex < Cluster.Objects.Num(); MemberIndex++ )
+		{
+			bHasPendingKillObject = Cluster.Objects[MemberIndex]->IsPendingKill();
+		}
+		for( int32 ReferenceIndex = 0; !bHasPendingKillObject && ReferenceIndex < Cluster.ReferencedObjects.Num(); ReferenceIndex++ )
+		{
+			bHasPendingKillObject = Cluster.ReferencedObjects[ReferenceIndex]->IsPendingKill();
+		}
+		if( bHasPendingKillObject )
+		{
+			DissolveCluster( ClusterIndex );
+		}
+	}
+	SET_DWORD_STAT( STAT_GCClusters, GGCClusters.Num() - GGCFreeClusterIndices.Num() );
+}
+
+/**
+ * Frees the clusters whose root was found unreachable. Their members are unreachable as well and get purged with the root.
+ */
+static void FreeUnreachableClusters()
+{
+	for( int32 ClusterIndex = 0; ClusterIndex < GGCClusters.Num(); ClusterIndex++ )
+	{
+		FGCCluster& Cluster = GGCClusters[ClusterIndex];
+		if( Cluster.Root && Cluster.Root->HasAnyFlags( RF_Unreachable ) )
+		{
+			for( int32 MemberIndex = 0; MemberIndex < Cluster.Objects.Num(); MemberIndex++ )
+			{
+				checkSlow( Cluster.Objects[MemberIndex]->HasAnyFlags( RF_Unreachable ) );
+			}
+			DissolveCluster( ClusterIndex );
+		}
+	}
+	SET_DWORD_STAT( STAT_GCClusters, GGCClusters.Num() - GGCFreeClusterIndices.Num() );
+}
+
 /** 
  * Deletes all unreferenced objects, keeping objects that have any of the passed in KeepFlags set
  *
@@ -1113,14 +1477,20 @@ void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
 		true;
 #endif	//PLATFORM_SUPPORTS_MULTITHREADED_GC
 
+	// Clusters can't clear their references, so they must not be holding on to anything that is about to go away.
+	DissolveClustersWithPendingKillObjects();
+
 	// Perform reachability analysis.
 	{
 		const double StartTime = FPlatformTime::Seconds();
 		FArchiveRealtimeGC TagUsedRealtimeGC;
 		TagUsedRealtimeGC.PerformReachabilityAnalysis( KeepFlags, bForceSingleThreadedGC );
-		UE_LOG(LogGarbage, Log, TEXT("%f ms for GC"), (FPlatformTime::Seconds() - StartTime) * 1000 );
+		UE_LOG(LogGarbage, Log, TEXT("%f ms for GC (%i objects skipped by clusters)"), (FPlatformTime::Seconds() - StartTime) * 1000, GObjectsSkippedByClusters.GetValue() );
+		SET_DWORD_STAT( STAT_GCObjectsSkippedByClusters, GObjectsSkippedByClusters.GetValue() );
 	}
 
+	FreeUnreachableClusters();
+
 #if WITH_EDITOR
 	if ( GIsEditor && EditorPostReachabilityAnalysisCallback )
 	{
@@ -1128,8 +1498,12 @@ void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
 	}
 #endif // WITH_EDITOR
 
-	// Unhash all unreachable objects.
+	// Gather all unreachable objects. Unreachable objects are skipped by object iterators and FindObject, so
+	// routing BeginDestroy to them can be deferred to the incremental purge.
 	const double StartTime = FPlatformTime::Seconds();
+	check( !IsIncrementalUnhashPending() );
+	GUnreachableObjects.Reset();
+	GUnreachableObjectIndex = 0;
 	for ( FRawObjectIterator It(true); It; ++It )
 	{
 		//@todo UE4 - A prefetch was removed here. Re-add it. It wasn't right anyway, since it was ten items ahead and the consoles on have 8 prefetch slots
@@ -1137,17 +1511,26 @@ void CollectGarbage( EObjectFlags KeepFlags, bool bPerformFullPurge )
 		UObject* Object = *It;
 		if( Object->HasAnyFlags( RF_Unreachable ) )
 		{
-			// Begin the object's asynchronous destruction.
-			Object->ConditionalBeginDestroy();
+			GUnreachableObjects.Add( Object );
 		}
 	}
-	UE_LOG(LogGarbage, Log, TEXT("%f ms for unhashing unreachable objects"), (FPlatformTime::Seconds() - StartTime) * 1000 );
 
 	// Set flag to indicate that we are relying on a purge to be performed.
 	GObjPurgeIsRequired = true;
 	// Reset purged count.
 	GPurgedObjectCountSinceLastMarkPhase = 0;
 
+	// Unhash all unreachable objects now unless the incremental purge is going to take care of it.
+	if( bPerformFullPurge || GIsEditor || CVarIncrementalBeginDestroyGC->GetValueOnGameThread() == 0 )
+	{
+		UnhashUnreachableObjects( false );
+		UE_LOG(LogGarbage, Log, TEXT("%f ms for unhashing unreachable objects"), (FPlatformTime::Seconds() - StartTime) * 1000 );
+	}
+	else
+	{
+		UE_LOG(LogGarbage, Log, TEXT("%f ms for gathering %i unreachable objects"), (FPlatformTime::Seconds() - StartTime) * 1000, GUnreachableObjects.Num() );
+	}
+
 	// Perform a full purge by not using a time limit for the incremental purge. The Editor always does a full purge.
 	if( bPerformFullPurge || GIsEditor )
 	{
@@ -972,23 +972,12 @@ ULinkerLoad::ELinkerStatus ULinkerLoad::SerializePackageFileSummary()
 			}
 		}
 
-		UPackage* LinkerRootPackage = LinkerRoot;
-		if( LinkerRootPackage )
+		// The package may be looked at by the game thread while the async loading thread reads the summary, it is
+		// updated once the game thread takes the linker back.
+		bHasPendingLinkerRootUpdate = true;
+		if( IsInGameThread() )
 		{
-			// Preserve PIE package flag
-			uint32 PIEFlag = (LinkerRootPackage->PackageFlags & PKG_PlayInEditor);
-			
-			// Propagate package flags
-			LinkerRootPackage->PackageFlags = (Summary.PackageFlags | PIEFlag);
-
-			// Propagate package folder name
-			LinkerRootPackage->SetFolderName(*Summary.FolderName);
-
-			// Propagate streaming install ChunkID
-			LinkerRootPackage->SetChunkIDs(Summary.ChunkIDs);
-			
-			// Propagate package file size
-			LinkerRootPackage->FileSize = TotalSize();
+			UpdateLinkerRoot();
 		}
 		
 		// Propagate fact that package cannot use lazy loading to archive (aka this).
@@ -1019,6 +1008,38 @@ ULinkerLoad::ELinkerStatus ULinkerLoad::SerializePackageFileSummary()
 	return !IsTimeLimitExceeded( TEXT("serializing package file summary") ) ? LINKER_Loaded : LINKER_TimedOut;
 }
 
+/**
+ * Propagates what the package file summary says about the package to LinkerRoot.
+ */
+void ULinkerLoad::UpdateLinkerRoot()
+{
+	check( IsInGameThread() );
+	if( !bHasPendingLinkerRootUpdate )
+	{
+		return;
+	}
+	bHasPendingLinkerRootUpdate = false;
+
+	UPackage* LinkerRootPackage = LinkerRoot;
+	if( LinkerRootPackage )
+	{
+		// Preserve PIE package flag
+		uint32 PIEFlag = (LinkerRootPackage->PackageFlags & PKG_PlayInEditor);
+
+		// Propagate package flags
+		LinkerRootPackage->PackageFlags = (Summary.PackageFlags | PIEFlag);
+
+		// Propagate package folder name
+		LinkerRootPackage->SetFolderName(*Summary.FolderName);
+
+		// Propagate streaming install ChunkID
+		LinkerRootPackage->SetChunkIDs(Summary.ChunkIDs);
+
+		// Propagate package file size
+		LinkerRootPackage->FileSize = TotalSize();
+	}
+}
+
 /**
  * Serializes the name table.
  */
@@ -1309,6 +1330,70 @@ ULinkerLoad::ELinkerStatus ULinkerLoad::SerializeExportMap()
 	return ((ExportMapIndex == Summary.ExportCount) && !IsTimeLimitExceeded( TEXT("serializing export map") )) ? LINKER_Loaded : LINKER_TimedOut;
 }
 
+/**
+ * Reads the package file summary, name, import and export maps and precaches the serialized exports, without
+ * touching anything but the linker and its loader.
+ */
+ULinkerLoad::ELinkerStatus ULinkerLoad::SerializeTables( int64 MaxExportPrecacheSize )
+{
+	// Single pass without a time limit, the caller comes back while we wait for IO.
+	TickStartTime		= FPlatformTime::Seconds();
+	bTimeLimitExceeded	= false;
+	bUseTimeLimit		= false;
+	bUseFullTimeLimit	= false;
+
+	// The loader already exists, this only waits for the package file summary to be precached.
+	ELinkerStatus Status = CreateLoader();
+
+	if( Status == LINKER_Loaded )
+	{
+		Status = SerializePackageFileSummary();
+	}
+
+	if( Status == LINKER_Loaded )
+	{
+		Status = SerializeNameMap();
+	}
+
+	if( Status == LINKER_Loaded )
+	{
+		Status = SerializeImportMap();
+	}
+
+	if( Status == LINKER_Loaded )
+	{
+		Status = SerializeExportMap();
+	}
+
+	// Compressed packages are precached one chunk at a time, they can't hold all of their exports at once.
+	if( Status == LINKER_Loaded && MaxExportPrecacheSize > 0 && !(Summary.PackageFlags & PKG_StoreCompressed) )
+	{
+		int64 ExportDataStart = MAX_int64;
+		int64 ExportDataEnd = 0;
+		for( int32 ExportIndex = 0; ExportIndex < ExportMap.Num(); ExportIndex++ )
+		{
+			const FObjectExport& Export = ExportMap[ExportIndex];
+			if( Export.SerialSize > 0 )
+			{
+				ExportDataStart = FMath::Min<int64>( ExportDataStart, Export.SerialOffset );
+				ExportDataEnd = FMath::Max<int64>( ExportDataEnd, Export.SerialOffset + Export.SerialSize );
+			}
+		}
+
+		// Exports are stored back to back, so this is a single read that every Preload of this package hits.
+		if( ExportDataEnd > ExportDataStart && ExportDataEnd - ExportDataStart <= MaxExportPrecacheSize )
+		{
+			SCOPE_CYCLE_COUNTER(STAT_LinkerPrecache);
+			if( !Loader->Precache( ExportDataStart, ExportDataEnd - ExportDataStart ) )
+			{
+				Status = LINKER_TimedOut;
+			}
+		}
+	}
+
+	return Status;
+}
+
 ULinkerLoad::ELinkerStatus ULinkerLoad::RemapImports()
 {
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
@@ -2014,6 +2014,7 @@ void RebindPackages( TArray<UPackage*> InPackages, TArray<FName> DependentModule
    Command line.
 -----------------------------------------------------------------------------*/
 #include "ClassTree.h"
+#include "ParallelFor.h"
 
 static void ShowIntrinsicClasses( FOutputDevice& Ar )
 {
@@ -2057,6 +2058,107 @@ static void ShowClasses( UClass* Class, FOutputDevice& Ar, int32 Indent )
 	}
 }
 
+//
+// Time the object hash lookups over every object that is currently loaded, serially and from the task graph workers.
+//
+static void ShowObjectHashBenchmark( FOutputDevice& Ar, int32 NumIterations )
+{
+	TArray<UObject*> HashedObjects;
+	TArray<UObject*> Packages;
+	TArray<UClass*> Classes;
+	for( FRawObjectIterator It; It; ++It )
+	{
+		UObject* Object = static_cast<UObject*>(*It);
+		if( Object->GetFName() == NAME_None || Object->HasAnyFlags(RF_Unreachable) )
+		{
+			continue;
+		}
+		if( Object->GetOuter() )
+		{
+			HashedObjects.Add(Object);
+		}
+		else if( Object->IsA(UPackage::StaticClass()) )
+		{
+			Packages.Add(Object);
+		}
+		if( Object->IsA(UClass::StaticClass()) )
+		{
+			Classes.Add(static_cast<UClass*>(Object));
+		}
+	}
+	Ar.Logf( TEXT("Object hash benchmark: %d objects, %d packages, %d classes, %d iterations"), HashedObjects.Num(), Packages.Num(), Classes.Num(), NumIterations );
+
+	int32 NumMisses = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for( int32 Iteration = 0; Iteration < NumIterations; Iteration++ )
+	{
+		for( int32 Index = 0; Index < HashedObjects.Num(); Index++ )
+		{
+			UObject* Object = HashedObjects[Index];
+			if( StaticFindObjectFastInternal( NULL, Object->GetOuter(), Object->GetFName(), false, false, RF_NoFlags ) == NULL )
+			{
+				NumMisses++;
+			}
+		}
+	}
+	double Elapsed = FPlatformTime::Seconds() - StartTime;
+	Ar.Logf( TEXT("  StaticFindObjectFast: %.2f ms (%.1f ns per lookup, %d misses)"), Elapsed * 1000.0, Elapsed * 1.0e9 / FMath::Max(HashedObjects.Num() * NumIterations, 1), NumMisses );
+
+	FThreadSafeCounter NumParallelMisses;
+	StartTime = FPlatformTime::Seconds();
+	for( int32 Iteration = 0; Iteration < NumIterations; Iteration++ )
+	{
+		ParallelFor( HashedObjects.Num(), [&HashedObjects, &NumParallelMisses](int32 Index)
+		{
+			UObject* Object = HashedObjects[Index];
+			if( StaticFindObjectFastInternal( NULL, Object->GetOuter(), Object->GetFName(), false, false, RF_NoFlags ) == NULL )
+			{
+				NumParallelMisses.Increment();
+			}
+		}, EParallelForFlags::AllowNamedThreadCaller );
+	}
+	Elapsed = FPlatformTime::Seconds() - StartTime;
+	Ar.Logf( TEXT("  StaticFindObjectFast (ParallelFor): %.2f ms (%.1f ns per lookup, %d misses)"), Elapsed * 1000.0, Elapsed * 1.0e9 / FMath::Max(HashedObjects.Num() * NumIterations, 1), NumParallelMisses.GetValue() );
+
+	int32 NumResults = 0;
+	TArray<UObject*> Results;
+	StartTime = FPlatformTime::Seconds();
+	for( int32 Iteration = 0; Iteration < NumIterations; Iteration++ )
+	{
+		for( int32 Index = 0; Index < Packages.Num(); Index++ )
+		{
+			Results.Reset();
+			GetObjectsWithOuter( Packages[Index], Results, true );
+			NumResults += Results.Num();
+		}
+	}
+	Elapsed = FPlatformTime::Seconds() - StartTime;
+	Ar.Logf( TEXT("  GetObjectsWithOuter (nested, per package): %.2f ms (%d results)"), Elapsed * 1000.0, NumResults );
+
+	NumResults = 0;
+	StartTime = FPlatformTime::Seconds();
+	for( int32 Iteration = 0; Iteration < NumIterations; Iteration++ )
+	{
+		for( int32 Index = 0; Index < Classes.Num(); Index++ )
+		{
+			Results.Reset();
+			GetObjectsOfClass( Classes[Index], Results, true );
+			NumResults += Results.Num();
+		}
+	}
+	Elapsed = FPlatformTime::Seconds() - StartTime;
+	Ar.Logf( TEXT("  GetObjectsOfClass (derived, per class): %.2f ms (%d results)"), Elapsed * 1000.0, NumResults );
+
+	StartTime = FPlatformTime::Seconds();
+	for( int32 Iteration = 0; Iteration < NumIterations; Iteration++ )
+	{
+		Results.Reset();
+		GetObjectsOfClass( UObject::StaticClass(), Results, true );
+	}
+	Elapsed = FPlatformTime::Seconds() - StartTime;
+	Ar.Logf( TEXT("  GetObjectsOfClass (UObject, derived): %.2f ms per call (%d results)"), Elapsed * 1000.0 / FMath::Max(NumIterations, 1), Results.Num() );
+}
+
 void UObject::OutputReferencers( FOutputDevice& Ar, FReferencerInformationList* Referencers/*=NULL*/ )
 {
 	bool bTempReferencers = false;
@@ -3243,6 +3345,13 @@ bool StaticExec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar )
 			ShowIntrinsicClasses(Ar);
 			return true;
 		}
+		else if( FParse::Command(&Str,TEXT("HASHBENCHMARK")) )
+		{
+			int32 NumIterations = 1;
+			FParse::Value(Str, TEXT("ITERATIONS="), NumIterations);
+			ShowObjectHashBenchmark(Ar, FMath::Max(NumIterations, 1));
+			return true;
+		}
 		else if( FParse::Command(&Str,TEXT("DEPENDENCIES")) )
 		{
 			UPackage* Pkg;
@@ -3642,6 +3751,10 @@ void OnCultureChangedUObjectCallback()
 void StaticExit()
 {
 	check(GObjLoaded.Num()==0);
+
+	// Nothing is loaded from here on.
+	ShutdownAsyncLoadingThread();
+
 	if (UObjectInitialized() == false)
 	{
 		return;
@@ -2560,6 +2560,9 @@ bool UPackage::SavePackage( UPackage* InOuter, UObject* Base, EObjectFlags TopLe
 
 				bool bSaveUnversioned = !!(SaveFlags & SAVE_Unversioned);
 
+				/** If true, properties are saved without tags. Requires editor-only data to be filtered, as the layout has to match cooked builds. */
+				bool bSaveUnversionedProperties = !!(SaveFlags & SAVE_UnversionedProperties) && FilterEditorOnly;
+
 				ULinkerSave* Linker = NULL;
 				
 				if (bCompressFromMemory || bSaveAsync)
@@ -2578,6 +2581,11 @@ bool UPackage::SavePackage( UPackage* InOuter, UObject* Base, EObjectFlags TopLe
 
 				Linker->SetPortFlags(ComparisonFlags);
 				Linker->SetFilterEditorOnly( FilterEditorOnly );
+				if (bSaveUnversionedProperties)
+				{
+					Linker->Summary.PackageFlags |= PKG_UnversionedProperties;
+					Linker->SetUseUnversionedPropertySerialization(true);
+				}
 				Linker->SetCookingTarget(TargetPlatform);
 
 				if ( EndSavingIfCancelled( Linker, TempFilename ) ) { return false; }
@@ -3433,6 +3441,10 @@ bool UPackage::SavePackage( UPackage* InOuter, UObject* Base, EObjectFlags TopLe
 				
 				// Update package flags from package, in case serialization has modified package flags.
 				Linker->Summary.PackageFlags  = Linker->LinkerRoot->PackageFlags;
+				if (bSaveUnversionedProperties)
+				{
+					Linker->Summary.PackageFlags |= PKG_UnversionedProperties;
+				}
 
 				Linker->Seek(0);
 				*Linker << Linker->Summary;
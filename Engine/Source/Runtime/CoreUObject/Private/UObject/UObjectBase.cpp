@@ -234,8 +234,11 @@ void UObjectBase::AddObject(FName InName)
 void UObjectBase::LowLevelRename(FName NewName,UObject *NewOuter)
 {
 	STAT(StatID = TStatId();) // reset the stat id since this thing now has a different name
-	UnhashObject(this);
 	check(InternalIndex >= 0);
+	const FName OldName = GetFName();
+	UObject* OldOuter = Outer;
+	// hash under the new name before unhashing the old one, so that lookups on other threads never miss the object
+	HashObjectForRename(this, NewName, NewOuter ? NewOuter : OldOuter);
 #if EXTERNAL_OBJECT_NAMES
 	NameAnnotation.AddAnnotation(InternalIndex,NewName);
 #else
@@ -245,7 +248,7 @@ void UObjectBase::LowLevelRename(FName NewName,UObject *NewOuter)
 	{
 		Outer = NewOuter;
 	}
-	HashObject(this);
+	UnhashObjectAfterRename(this, OldName, OldOuter);
 }
 
 void UObjectBase::SetClass(UClass* NewClass)
@@ -773,6 +773,13 @@ UPackage* LoadPackage( UPackage* InOuter, const TCHAR* InLongPackageName, uint32
 	TGuardValue<bool> IsEditorLoadingPackage(GIsEditorLoadingPackage, (GIsEditor ? true : GIsEditorLoadingPackage));
 #endif
 
+	// Objects found unreachable by the last garbage collection may still be hashed. Unhash them before the
+	// linker starts looking for existing objects, so that a package being reloaded doesn't find its old linker.
+	if( IsIncrementalUnhashPending() )
+	{
+		UnhashUnreachableObjects( false );
+	}
+
 	// Try to load.
 	BeginLoad();
 
@@ -853,6 +860,9 @@ UPackage* LoadPackage( UPackage* InOuter, const TCHAR* InLongPackageName, uint32
 		if( Result && !IsLoading() && !(LoadFlags & LOAD_Verify) )
 		{
 			Result->SetLoadTime( FPlatformTime::Seconds() - StartTime );
+
+			// Cooked content doesn't change after being loaded, so the garbage collector can handle it as a whole.
+			CreateGarbageCollectionCluster( Result );
 		}
 
 		// @todo: the next two conditions should check the file limit
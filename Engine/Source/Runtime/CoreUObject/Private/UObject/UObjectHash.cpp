@@ -22,8 +22,51 @@ DEFINE_LOG_CATEGORY_STATIC(LogUObjectHash, Log, All);
 */
 #define OBJECT_HASH_BINS (1024*1024)
 
-static TMultiMap<int32,class UObjectBase*> ObjectHash;
-static TMultiMap<int32,class UObjectBase*> ObjectHashOuter;
+/**
+ * The number of stripes the name hashes are split into, each with its own lock.
+ *
+ * NOTE: This must be power of 2 so that (count - 1) turns on all bits!
+ */
+#define OBJECT_HASH_LOCK_COUNT 64
+
+/** Name hashes, split into stripes by the low bits of the hash so that lookups of different names don't contend. */
+static TMultiMap<int32,class UObjectBase*> ObjectHash[OBJECT_HASH_LOCK_COUNT];
+static TMultiMap<int32,class UObjectBase*> ObjectHashOuter[OBJECT_HASH_LOCK_COUNT];
+
+/**
+ * Locks guarding the hash tables in this file. Objects are hashed and looked up from the async loading thread and
+ * from task graph workers as well as from the game thread. A lock is only held while its own table is accessed;
+ * no two are ever held at the same time and none is held while logging or building path names.
+ */
+struct FUObjectHashLocks
+{
+	/** One per ObjectHash stripe. */
+	FCriticalSection NameHash[OBJECT_HASH_LOCK_COUNT];
+	/** One per ObjectHashOuter stripe. */
+	FCriticalSection OuterHash[OBJECT_HASH_LOCK_COUNT];
+	/** Guards ObjectOuterMap. */
+	FCriticalSection OuterMap;
+	/** Guards ClassToObjectListMap and ClassToChildListMap. */
+	FCriticalSection ClassMap;
+};
+
+static FUObjectHashLocks& GetObjectHashLocks()
+{
+	static FUObjectHashLocks* Locks = NULL;
+	if (Locks == NULL)
+	{
+		// first called while registering the intrinsic classes, before any other thread can hash objects
+		check(IsInGameThread());
+		Locks = new FUObjectHashLocks();
+	}
+	return *Locks;
+}
+
+/** @return the index of the ObjectHash or ObjectHashOuter stripe that holds the given hash */
+static FORCEINLINE int32 GetObjectHashStripe(int32 Hash)
+{
+	return Hash & (OBJECT_HASH_LOCK_COUNT - 1);
+}
 
 /**
  * Calculates the object's hash just using the object's name index
@@ -64,30 +107,37 @@ UObject* StaticFindObjectFastExplicit( UClass* ObjectClass, FName ObjectName, co
 	checkSlow(FPackageName::IsShortPackageName(ObjectName)); //@Package name transition, we aren't checking the name here because we know this is only used for texture
 	// Find an object with the specified name and (optional) class, in any package; if bAnyPackage is false, only matches top-level packages
 	int32 Hash = GetObjectHash( ObjectName );
-	for(TMultiMap<int32,class UObjectBase*>::TConstKeyIterator HashIt(ObjectHash,Hash); HashIt; ++HashIt)
+	const int32 Stripe = GetObjectHashStripe( Hash );
+	TArray<UObject*, TInlineAllocator<8> > Candidates;
 	{
-		UObject *Object = (UObject *)HashIt.Value();
-		if
-		(	(Object->GetFName()==ObjectName)
-
-		/* Don't return objects that have any of the exclusive flags set */
-		&&	!Object->HasAnyFlags(ExcludeFlags)
+		FScopeLock HashLock(&GetObjectHashLocks().NameHash[Stripe]);
+		for(TMultiMap<int32,class UObjectBase*>::TConstKeyIterator HashIt(ObjectHash[Stripe],Hash); HashIt; ++HashIt)
+		{
+			UObject *Object = (UObject *)HashIt.Value();
+			if
+			(	(Object->GetFName()==ObjectName)
 
-		/** If a class was specified, check that the object is of the correct class */
-		&&	(ObjectClass==NULL || (bExactClass ? Object->GetClass()==ObjectClass : Object->IsA(ObjectClass)))
-		)
+			/* Don't return objects that have any of the exclusive flags set, or unreachable objects still waiting to be unhashed */
+			&&	!Object->HasAnyFlags(ExcludeFlags | RF_Unreachable)
 
-		{
-			FString ObjectPath = Object->GetPathName();
-			/** Finally check the explicit path */
-			if (ObjectPath == ObjectPathName)
+			/** If a class was specified, check that the object is of the correct class */
+			&&	(ObjectClass==NULL || (bExactClass ? Object->GetClass()==ObjectClass : Object->IsA(ObjectClass)))
+			)
 			{
-				checkf( !Object->HasAnyFlags(RF_Unreachable), TEXT("%s"), *Object->GetFullName() );
-				return Object;
+				Candidates.Add(Object);
 			}
 		}
 	}
 
+	/** Finally check the explicit path, outside of the lock as building it walks the outer chain */
+	for (int32 Index = 0; Index < Candidates.Num(); Index++)
+	{
+		if (Candidates[Index]->GetPathName() == ObjectPathName)
+		{
+			return Candidates[Index];
+		}
+	}
+
 	return NULL;
 }
 
@@ -95,20 +145,23 @@ UObject* StaticFindObjectFastInternal( UClass* ObjectClass, UObject* ObjectPacka
 {
 	INC_DWORD_STAT(STAT_FindObjectFast);
 	check(ObjectPackage != ANY_PACKAGE); // this could never have returned anything but NULL
+	// Matches are gathered under the lock and checked for ambiguity after it has been released
+	TArray<UObject*, TInlineAllocator<4> > Matches;
 	// If they specified an outer use that during the hashing
-	UObject* Result = NULL;
 	if (ObjectPackage != NULL)
 	{
 		int32 Hash = GetObjectOuterHash( ObjectName, (PTRINT)ObjectPackage );
-		for(TMultiMap<int32,class UObjectBase*>::TConstKeyIterator HashIt(ObjectHashOuter,Hash); HashIt; ++HashIt)
+		const int32 Stripe = GetObjectHashStripe( Hash );
+		FScopeLock HashLock(&GetObjectHashLocks().OuterHash[Stripe]);
+		for(TMultiMap<int32,class UObjectBase*>::TConstKeyIterator HashIt(ObjectHashOuter[Stripe],Hash); HashIt; ++HashIt)
 		{
 			UObject *Object = (UObject *)HashIt.Value();
 			if
 			/* check that the name matches the name we're searching for */
 			(	(Object->GetFName()==ObjectName)
 
-			/* Don't return objects that have any of the exclusive flags set */
-			&&	!Object->HasAnyFlags(ExcludeFlags)
+			/* Don't return objects that have any of the exclusive flags set, or unreachable objects still waiting to be unhashed */
+			&&	!Object->HasAnyFlags(ExcludeFlags | RF_Unreachable)
 
 			/* check that the object has the correct Outer */
 			&&	Object->GetOuter() == ObjectPackage
@@ -116,15 +169,7 @@ UObject* StaticFindObjectFastInternal( UClass* ObjectClass, UObject* ObjectPacka
 			/** If a class was specified, check that the object is of the correct class */
 			&&	(ObjectClass==NULL || (bExactClass ? Object->GetClass()==ObjectClass : Object->IsA(ObjectClass))) )
 			{
-				checkf( !Object->HasAnyFlags(RF_Unreachable), TEXT("%s"), *Object->GetFullName() );
-				if (Result)
-				{
-					UE_LOG(LogUObjectHash, Warning, TEXT("Ambiguous search, could be %s or %s"), *GetFullNameSafe(Result), *GetFullNameSafe(Object));
-				}
-				else
-				{
-					Result = Object;
-				}
+				Matches.Add(Object);
 #if (UE_BUILD_SHIPPING || UE_BUILD_TEST)
 				break;
 #endif
@@ -143,44 +188,52 @@ UObject* StaticFindObjectFastInternal( UClass* ObjectClass, UObject* ObjectPacka
 			ActualObjectName = FName(*ObjectNameString.Mid(DotIndex + 1));
 		}
 		const int32 Hash = GetObjectHash( ActualObjectName );
-		for(TMultiMap<int32,class UObjectBase*>::TConstKeyIterator HashIt(ObjectHash,Hash); HashIt; ++HashIt)
+		const int32 Stripe = GetObjectHashStripe( Hash );
+		TArray<UObject*, TInlineAllocator<8> > Candidates;
 		{
-			UObject *Object = (UObject *)HashIt.Value();
-			if
-			(	(Object->GetFName()==ActualObjectName)
-
-			/* Don't return objects that have any of the exclusive flags set */
-			&&	!Object->HasAnyFlags(ExcludeFlags)
+			FScopeLock HashLock(&GetObjectHashLocks().NameHash[Stripe]);
+			for(TMultiMap<int32,class UObjectBase*>::TConstKeyIterator HashIt(ObjectHash[Stripe],Hash); HashIt; ++HashIt)
+			{
+				UObject *Object = (UObject *)HashIt.Value();
+				if
+				(	(Object->GetFName()==ActualObjectName)
 
-			/*If there is no package (no InObjectPackage specified, and InName's package is "")
-				and the caller specified any_package, then accept it, regardless of its package.
-				Or, if the object is a top-level package then accept it immediately.*/
-			&&	(bAnyPackage ||	!Object->GetOuter())
-			
+				/* Don't return objects that have any of the exclusive flags set, or unreachable objects still waiting to be unhashed */
+				&&	!Object->HasAnyFlags(ExcludeFlags | RF_Unreachable)
 
-			/** If a class was specified, check that the object is of the correct class */
-			&&	(ObjectClass==NULL || (bExactClass ? Object->GetClass()==ObjectClass : Object->IsA(ObjectClass))) 
+				/*If there is no package (no InObjectPackage specified, and InName's package is "")
+					and the caller specified any_package, then accept it, regardless of its package.
+					Or, if the object is a top-level package then accept it immediately.*/
+				&&	(bAnyPackage ||	!Object->GetOuter())
+				
 
-			/** Ensure that the partial path provided matches the object found */
-			&&  (Object->GetPathName().EndsWith(ObjectNameString)) )
-			{
-				checkf( !Object->HasAnyFlags(RF_Unreachable), TEXT("%s"), *Object->GetFullName() );
-				if (Result)
+				/** If a class was specified, check that the object is of the correct class */
+				&&	(ObjectClass==NULL || (bExactClass ? Object->GetClass()==ObjectClass : Object->IsA(ObjectClass))) )
 				{
-					UE_LOG(LogUObjectHash, Warning, TEXT("Ambiguous search, could be %s or %s"), *GetFullNameSafe(Result), *GetFullNameSafe(Object));
-				}
-				else
-				{
-					Result = Object;
+					Candidates.Add(Object);
 				}
+			}
+		}
+
+		/** Ensure that the partial path provided matches the object found, outside of the lock as building it walks the outer chain */
+		for (int32 Index = 0; Index < Candidates.Num(); Index++)
+		{
+			if (Candidates[Index]->GetPathName().EndsWith(ObjectNameString))
+			{
+				Matches.Add(Candidates[Index]);
 #if (UE_BUILD_SHIPPING || UE_BUILD_TEST)
 				break;
 #endif
 			}
 		}
 	}
-	// Not found.
-	return Result;
+
+	for (int32 Index = 1; Index < Matches.Num(); Index++)
+	{
+		UE_LOG(LogUObjectHash, Warning, TEXT("Ambiguous search, could be %s or %s"), *GetFullNameSafe(Matches[0]), *GetFullNameSafe(Matches[Index]));
+	}
+	// NULL if not found.
+	return Matches.Num() ? Matches[0] : NULL;
 }
 
 /** Map of object to their outers, used to avoid an object iterator to find such things. **/
@@ -188,9 +241,10 @@ static TMap<UObjectBase*, TSet<UObjectBase*> > ObjectOuterMap;
 static TMap<UClass*, TSet<UObjectBase*> > ClassToObjectListMap;
 static TMap<UClass*, TSet<UClass*> > ClassToChildListMap;
 
-static void AddToOuterMap(UObjectBase* Object)
+static void AddToOuterMap(UObjectBase* Object, UObjectBase* Outer)
 {
-	TSet<UObjectBase*>& Inners = ObjectOuterMap.FindOrAdd(Object->GetOuter());
+	FScopeLock OuterMapLock(&GetObjectHashLocks().OuterMap);
+	TSet<UObjectBase*>& Inners = ObjectOuterMap.FindOrAdd(Outer);
 	bool bIsAlreadyInSetPtr = false;
 	Inners.Add(Object, &bIsAlreadyInSetPtr);
 	check(!bIsAlreadyInSetPtr); // if it already exists, something is wrong with the external code
@@ -198,82 +252,120 @@ static void AddToOuterMap(UObjectBase* Object)
 
 static void AddToClassMap(UObjectBase* Object)
 {
+	check(Object->GetClass());
+	UObjectBaseUtility* ObjectWithUtility = static_cast<UObjectBaseUtility*>(Object);
+	UClass* SuperClass = ObjectWithUtility->IsA(UClass::StaticClass()) ? static_cast<UClass*>(ObjectWithUtility)->GetSuperClass() : NULL;
+
+	FScopeLock ClassMapLock(&GetObjectHashLocks().ClassMap);
 	{
-		check(Object->GetClass());
 		TSet<UObjectBase*>& ObjectList = ClassToObjectListMap.FindOrAdd(Object->GetClass());
 		bool bIsAlreadyInSetPtr = false;
 		ObjectList.Add(Object, &bIsAlreadyInSetPtr);
 		check(!bIsAlreadyInSetPtr); // if it already exists, something is wrong with the external code
 	}
 
-	UObjectBaseUtility* ObjectWithUtility = static_cast<UObjectBaseUtility*>(Object);
-	if ( ObjectWithUtility->IsA(UClass::StaticClass()) )
+	if ( SuperClass )
 	{
-		UClass* Class = static_cast<UClass*>(ObjectWithUtility);
-		UClass* SuperClass = Class->GetSuperClass();
-		if ( SuperClass )
-		{
-			TSet<UClass*>& ChildList = ClassToChildListMap.FindOrAdd(SuperClass);
-			bool bIsAlreadyInSetPtr = false;
-			ChildList.Add(Class, &bIsAlreadyInSetPtr);
-			check(!bIsAlreadyInSetPtr); // if it already exists, something is wrong with the external code
-		}
+		TSet<UClass*>& ChildList = ClassToChildListMap.FindOrAdd(SuperClass);
+		bool bIsAlreadyInSetPtr = false;
+		ChildList.Add(static_cast<UClass*>(ObjectWithUtility), &bIsAlreadyInSetPtr);
+		check(!bIsAlreadyInSetPtr); // if it already exists, something is wrong with the external code
 	}
 }
 
-static void RemoveFromOuterMap(UObjectBase* Object)
+static void RemoveFromOuterMap(UObjectBase* Object, UObjectBase* Outer)
 {
-	TSet<UObjectBase*>& Inners = ObjectOuterMap.FindOrAdd(Object->GetOuter());
-	int32 NumRemoved = Inners.Remove(Object);
-    if (NumRemoved != 1)
+	int32 NumRemoved = 0;
 	{
-		UE_LOG(LogUObjectHash, Error, TEXT("Internal Error: RemoveFromOuterMap NumRemoved = %d  for %s"), NumRemoved, *GetFullNameSafe((UObjectBaseUtility*)Object));
+		FScopeLock OuterMapLock(&GetObjectHashLocks().OuterMap);
+		TSet<UObjectBase*>& Inners = ObjectOuterMap.FindOrAdd(Outer);
+		NumRemoved = Inners.Remove(Object);
+		if (!Inners.Num())
+		{
+			ObjectOuterMap.Remove(Outer);
+		}
 	}
-	check(NumRemoved == 1); // must have existed, else something is wrong with the external code
-	if (!Inners.Num())
+	if (NumRemoved != 1)
 	{
-		ObjectOuterMap.Remove(Object->GetOuter());
+		UE_LOG(LogUObjectHash, Error, TEXT("Internal Error: RemoveFromOuterMap NumRemoved = %d  for %s"), NumRemoved, *GetFullNameSafe((UObjectBaseUtility*)Object));
 	}
+	check(NumRemoved == 1); // must have existed, else something is wrong with the external code
 }
 
 static void RemoveFromClassMap(UObjectBase* Object)
 {
 	UObjectBaseUtility* ObjectWithUtility = static_cast<UObjectBaseUtility*>(Object);
+	UClass* SuperClass = ObjectWithUtility->IsA(UClass::StaticClass()) ? static_cast<UClass*>(ObjectWithUtility)->GetSuperClass() : NULL;
 
+	int32 NumRemovedFromObjectList = 0;
+	int32 NumRemovedFromChildList = 1;
 	{
+		FScopeLock ClassMapLock(&GetObjectHashLocks().ClassMap);
 		TSet<UObjectBase*>& ObjectList = ClassToObjectListMap.FindOrAdd(Object->GetClass());
-		int32 NumRemoved = ObjectList.Remove(Object);
-		if (NumRemoved != 1)
-		{
-			UE_LOG(LogUObjectHash, Error, TEXT("Internal Error: RemoveFromClassMap NumRemoved = %d from object list for %s"), NumRemoved, *GetFullNameSafe(ObjectWithUtility));
-		}
-		check(NumRemoved == 1); // must have existed, else something is wrong with the external code
+		NumRemovedFromObjectList = ObjectList.Remove(Object);
 		if (!ObjectList.Num())
 		{
 			ClassToObjectListMap.Remove(Object->GetClass());
 		}
-	}
 
-	if ( ObjectWithUtility->IsA(UClass::StaticClass()) )
-	{
-		UClass* Class = static_cast<UClass*>(ObjectWithUtility);
-		UClass* SuperClass = Class->GetSuperClass();
 		if ( SuperClass )
 		{
 			// Remove the class from the SuperClass' child list
 			TSet<UClass*>& ChildList = ClassToChildListMap.FindOrAdd(SuperClass);
-			int32 NumRemoved = ChildList.Remove(Class);
-			if (NumRemoved != 1)
-			{
-				UE_LOG(LogUObjectHash, Error, TEXT("Internal Error: RemoveFromClassMap NumRemoved = %d from child list for %s"), NumRemoved, *GetFullNameSafe(ObjectWithUtility));
-			}
-			check(NumRemoved == 1); // must have existed, else something is wrong with the external code
+			NumRemovedFromChildList = ChildList.Remove(static_cast<UClass*>(ObjectWithUtility));
 			if (!ChildList.Num())
 			{
 				ClassToChildListMap.Remove(SuperClass);
 			}
 		}
 	}
+
+	if (NumRemovedFromObjectList != 1)
+	{
+		UE_LOG(LogUObjectHash, Error, TEXT("Internal Error: RemoveFromClassMap NumRemoved = %d from object list for %s"), NumRemovedFromObjectList, *GetFullNameSafe(ObjectWithUtility));
+	}
+	check(NumRemovedFromObjectList == 1); // must have existed, else something is wrong with the external code
+	if (NumRemovedFromChildList != 1)
+	{
+		UE_LOG(LogUObjectHash, Error, TEXT("Internal Error: RemoveFromClassMap NumRemoved = %d from child list for %s"), NumRemovedFromChildList, *GetFullNameSafe(ObjectWithUtility));
+	}
+	check(NumRemovedFromChildList == 1); // must have existed, else something is wrong with the external code
+}
+
+/** Adds an object to the name hash stripe for Hash. */
+static void AddToObjectHash(UObjectBase* Object, int32 Hash)
+{
+	const int32 Stripe = GetObjectHashStripe(Hash);
+	FScopeLock HashLock(&GetObjectHashLocks().NameHash[Stripe]);
+	checkSlow(!ObjectHash[Stripe].FindPair(Hash,Object));  // if it already exists, something is wrong with the external code
+	ObjectHash[Stripe].Add(Hash,Object);
+}
+
+/** Adds an object to the name and outer hash stripe for Hash. */
+static void AddToObjectHashOuter(UObjectBase* Object, int32 Hash)
+{
+	const int32 Stripe = GetObjectHashStripe(Hash);
+	FScopeLock HashLock(&GetObjectHashLocks().OuterHash[Stripe]);
+	checkSlow(!ObjectHashOuter[Stripe].FindPair(Hash,Object));  // if it already exists, something is wrong with the external code
+	ObjectHashOuter[Stripe].Add(Hash,Object);
+}
+
+/** Removes an object from the name hash stripe for Hash. */
+static void RemoveFromObjectHash(UObjectBase* Object, int32 Hash)
+{
+	const int32 Stripe = GetObjectHashStripe(Hash);
+	FScopeLock HashLock(&GetObjectHashLocks().NameHash[Stripe]);
+	int32 NumRemoved = ObjectHash[Stripe].RemoveSingle(Hash,Object);
+	check(NumRemoved == 1); // must have existed, else something is wrong with the external code
+}
+
+/** Removes an object from the name and outer hash stripe for Hash. */
+static void RemoveFromObjectHashOuter(UObjectBase* Object, int32 Hash)
+{
+	const int32 Stripe = GetObjectHashStripe(Hash);
+	FScopeLock HashLock(&GetObjectHashLocks().OuterHash[Stripe]);
+	int32 NumRemoved = ObjectHashOuter[Stripe].RemoveSingle(Hash,Object);
+	check(NumRemoved == 1); // must have existed, else something is wrong with the external code
 }
 
 void GetObjectsWithOuter(const class UObjectBase* Outer, TArray<UObject *>& Results, bool bIncludeNestedObjects, EObjectFlags ExclusionFlags)
@@ -285,6 +377,7 @@ void GetObjectsWithOuter(const class UObjectBase* Outer, TArray<UObject *>& Resu
 		ExclusionFlags = EObjectFlags(ExclusionFlags | RF_AsyncLoading);
 	}
 	int32 StartNum = Results.Num();
+	FScopeLock OuterMapLock(&GetObjectHashLocks().OuterMap);
 	TSet<UObjectBase*> const* Inners = ObjectOuterMap.Find(Outer);
 	if (Inners)
 	{
@@ -338,6 +431,7 @@ UObjectBase* FindObjectWithOuter(class UObjectBase* Outer, class UClass* ClassTo
 	}
 
 	UObject *Result = NULL;
+	FScopeLock OuterMapLock(&GetObjectHashLocks().OuterMap);
 	TSet<UObjectBase*> const* Inners = ObjectOuterMap.Find(Outer);
 	if (Inners)
 	{
@@ -360,21 +454,30 @@ UObjectBase* FindObjectWithOuter(class UObjectBase* Outer, class UClass* ClassTo
 	return Result;
 }
 
-/** Helper function that returns all the children of the specified class recursively */
-static void RecursivelyPopulateDerivedClasses(UClass* ParentClass, TSet<UClass*>& OutAllDerivedClass)
+/**
+ * Appends every class derived from ParentClass to OutDerivedClasses, walking the child lists breadth first.
+ * Every class has a single super class, so the child lists form a tree and no class can be reached twice.
+ * Must be called with the class map lock held.
+ */
+template<typename AllocatorType>
+static void GetDerivedClassesInternal(UClass* ParentClass, TArray<UClass*, AllocatorType>& OutDerivedClasses)
 {
-	TSet<UClass*>* ChildSet = ClassToChildListMap.Find(ParentClass);
-	if ( ChildSet )
+	int32 NextIndex = OutDerivedClasses.Num();
+	UClass* Class = ParentClass;
+	for (;;)
 	{
-		for ( auto ChildIt = ChildSet->CreateConstIterator(); ChildIt; ++ChildIt )
+		if (TSet<UClass*> const* ChildSet = ClassToChildListMap.Find(Class))
 		{
-			UClass* ChildClass = *ChildIt;
-			if ( !OutAllDerivedClass.Contains(ChildClass) )
+			for (auto ChildIt = ChildSet->CreateConstIterator(); ChildIt; ++ChildIt)
 			{
-				OutAllDerivedClass.Add(ChildClass);
-				RecursivelyPopulateDerivedClasses(ChildClass, OutAllDerivedClass);
+				OutDerivedClasses.Add(*ChildIt);
 			}
 		}
+		if (NextIndex == OutDerivedClasses.Num())
+		{
+			break;
+		}
+		Class = OutDerivedClasses[NextIndex++];
 	}
 }
 
@@ -388,20 +491,24 @@ void GetObjectsOfClass(UClass* ClassToLookFor, TArray<UObject *>& Results, bool
 	}
 	ExclusionFlags |= AdditionalExcludeFlags;
 
-	TSet<UClass*> ClassesToSearch;
+	FScopeLock ClassMapLock(&GetObjectHashLocks().ClassMap);
+
+	TArray<UClass*, TInlineAllocator<64> > ClassesToSearch;
 	ClassesToSearch.Add(ClassToLookFor);
 	if ( bIncludeDerivedClasses )
 	{
-		RecursivelyPopulateDerivedClasses(ClassToLookFor, ClassesToSearch);
+		GetDerivedClassesInternal(ClassToLookFor, ClassesToSearch);
 	}
 
+	// The per class lists are maintained by HashObject and UnhashObject, so this only visits instances of the requested classes
 	const int32 MaxResults = GUObjectArray.GetObjectArrayNum();
-	for ( auto ClassIt = ClassesToSearch.CreateConstIterator(); ClassIt; ++ClassIt )
+	for ( int32 ClassIndex = 0; ClassIndex < ClassesToSearch.Num(); ClassIndex++ )
 	{
-		TSet<UObjectBase*> const* List = ClassToObjectListMap.Find(*ClassIt);
+		TSet<UObjectBase*> const* List = ClassToObjectListMap.Find(ClassesToSearch[ClassIndex]);
 
 		if ( List )
 		{
+			Results.Reserve(Results.Num() + List->Num());
 			for( auto ObjectIt = List->CreateConstIterator(); ObjectIt; ++ObjectIt )
 			{
 				UObject *Object = static_cast<UObject *>(*ObjectIt);
@@ -418,11 +525,10 @@ void GetObjectsOfClass(UClass* ClassToLookFor, TArray<UObject *>& Results, bool
 
 void GetDerivedClasses(UClass* ClassToLookFor, TArray<UClass *>& Results, bool bRecursive)
 {
+	FScopeLock ClassMapLock(&GetObjectHashLocks().ClassMap);
 	if ( bRecursive )
 	{
-		TSet<UClass*> AllDerivedClasses;
-		RecursivelyPopulateDerivedClasses(ClassToLookFor, AllDerivedClasses);
-		Results.Append( AllDerivedClasses.Array() );
+		GetDerivedClassesInternal(ClassToLookFor, Results);
 	}
 	else
 	{
@@ -447,15 +553,9 @@ void HashObject(UObjectBase* Object)
 		return;
 	}
 
-	int32 Hash = GetObjectHash( Name );
-	checkSlow(!ObjectHash.FindPair(Hash,Object));  // if it already exists, something is wrong with the external code
-	ObjectHash.Add(Hash,Object);
-
-	Hash = GetObjectOuterHash(Name,(PTRINT)Object->GetOuter());
-	checkSlow(!ObjectHashOuter.FindPair(Hash,Object));  // if it already exists, something is wrong with the external code
-	ObjectHashOuter.Add(Hash,Object);
-
-	AddToOuterMap(Object);
+	AddToObjectHash(Object, GetObjectHash(Name));
+	AddToObjectHashOuter(Object, GetObjectOuterHash(Name,(PTRINT)Object->GetOuter()));
+	AddToOuterMap(Object, Object->GetOuter());
 	AddToClassMap(Object);
 }
 
@@ -472,14 +572,77 @@ void UnhashObject(UObjectBase* Object)
 		return;
 	}
 
-	int32 Hash = GetObjectHash( Name );
-	int32 NumRemoved = ObjectHash.RemoveSingle(Hash,Object);
-	check(NumRemoved == 1); // must have existed, else something is wrong with the external code
+	RemoveFromObjectHash(Object, GetObjectHash(Name));
+	RemoveFromObjectHashOuter(Object, GetObjectOuterHash(Name,(PTRINT)Object->GetOuter()));
+	RemoveFromOuterMap(Object, Object->GetOuter());
+	RemoveFromClassMap(Object);
+}
 
-	Hash = GetObjectOuterHash(Name,(PTRINT)Object->GetOuter());
-	NumRemoved = ObjectHashOuter.RemoveSingle(Hash,Object);
-	check(NumRemoved == 1); // must have existed, else something is wrong with the external code
+void HashObjectForRename(UObjectBase* Object, FName NewName, UObjectBase* NewOuter)
+{
+	const FName OldName = Object->GetFName();
+	UObjectBase* OldOuter = Object->GetOuter();
+	if (NewName == NAME_None)
+	{
+		return;
+	}
+	if (OldName == NAME_None)
+	{
+		// not hashed yet, so there is nothing to keep consistent
+		AddToObjectHash(Object, GetObjectHash(NewName));
+		AddToObjectHashOuter(Object, GetObjectOuterHash(NewName,(PTRINT)NewOuter));
+		AddToOuterMap(Object, NewOuter);
+		AddToClassMap(Object);
+		return;
+	}
 
-	RemoveFromOuterMap(Object);
-	RemoveFromClassMap(Object);
+	// entries whose key doesn't change stay where they are, lookups compare the current name and outer anyway
+	const int32 NewHash = GetObjectHash(NewName);
+	if (NewHash != GetObjectHash(OldName))
+	{
+		AddToObjectHash(Object, NewHash);
+	}
+	const int32 NewOuterHash = GetObjectOuterHash(NewName,(PTRINT)NewOuter);
+	if (NewOuterHash != GetObjectOuterHash(OldName,(PTRINT)OldOuter))
+	{
+		AddToObjectHashOuter(Object, NewOuterHash);
+	}
+	if (NewOuter != OldOuter)
+	{
+		AddToOuterMap(Object, NewOuter);
+	}
+}
+
+void UnhashObjectAfterRename(UObjectBase* Object, FName OldName, UObjectBase* OldOuter)
+{
+	const FName NewName = Object->GetFName();
+	UObjectBase* NewOuter = Object->GetOuter();
+	if (OldName == NAME_None)
+	{
+		return;
+	}
+	if (NewName == NAME_None)
+	{
+		// no longer hashed at all
+		RemoveFromObjectHash(Object, GetObjectHash(OldName));
+		RemoveFromObjectHashOuter(Object, GetObjectOuterHash(OldName,(PTRINT)OldOuter));
+		RemoveFromOuterMap(Object, OldOuter);
+		RemoveFromClassMap(Object);
+		return;
+	}
+
+	const int32 OldHash = GetObjectHash(OldName);
+	if (OldHash != GetObjectHash(NewName))
+	{
+		RemoveFromObjectHash(Object, OldHash);
+	}
+	const int32 OldOuterHash = GetObjectOuterHash(OldName,(PTRINT)OldOuter);
+	if (OldOuterHash != GetObjectOuterHash(NewName,(PTRINT)NewOuter))
+	{
+		RemoveFromObjectHashOuter(Object, OldOuterHash);
+	}
+	if (NewOuter != OldOuter)
+	{
+		RemoveFromOuterMap(Object, OldOuter);
+	}
 }
@@ -6,12 +6,30 @@
 
 #pragma once
 
+/** Where the tables of an async package's linker are read */
+namespace EAsyncLinkerState
+{
+	enum Type
+	{
+		/** Not handed to the async loading thread, the game thread reads them */
+		GameThread,
+		/** Queued on or being read by the async loading thread */
+		Queued,
+		/** Read by the async loading thread, the game thread finishes the linker */
+		Finished,
+		/** The async loading thread failed to read them */
+		Failed,
+	};
+}
+
 /**
  * Structure containing intermediate data required for async loading of all imports and exports of a
  * ULinkerLoad.
  */
 struct FAsyncPackage : public FGCObject
 {
+	friend class FAsyncLoadingThread;
+
 	/**
 	 * Constructor
 	 */
@@ -21,6 +39,7 @@ struct FAsyncPackage : public FGCObject
 	,	PackageGuid					( InPackageGuid != NULL ? *InPackageGuid : FGuid(0,0,0,0) )
 	,	PackageType					( InPackageType			)
 	,	Linker						( NULL					)
+	,	AsyncLinkerState			( EAsyncLinkerState::GameThread )
 	, DependencyRefCount	( 0						)
 	, LoadImportIndex			( 0						)
 	,	ImportIndex					( 0						)
@@ -156,6 +175,8 @@ private:
 	FName						PackageType;
 	/** Linker which is going to have its exports and imports loaded									*/
 	ULinkerLoad*				Linker;
+	/** EAsyncLinkerState of Linker. The async loading thread owns Linker while this is Queued.			*/
+	FThreadSafeCounter			AsyncLinkerState;
 	/** Call backs called when we finished loading this package											*/
 	TArray<FLoadPackageAsyncDelegate>	CompletionCallbacks;
 	/** Pending Import packages - we wait until all of them have been fully loaded. */
@@ -363,4 +384,8 @@ private:
 #endif // PERF_TRACK_DETAILED_ASYNC_STATS
 };
 
-
+/**
+ * Stops the async loading thread. Packages it hasn't finished reading the tables of can't complete afterwards,
+ * so this is only called on exit.
+ */
+void ShutdownAsyncLoadingThread();
@@ -217,6 +217,10 @@ public:
 	UProperty* DestructorLink;
 	/** In memory only: Linked list of properties requiring post constructor initialization.**/
 	UProperty* PostConstructLink;
+	/** In memory only: Properties written by untagged (unversioned) serialization, in PropertyLink order. Built by Link. **/
+	TArray<UProperty*> UnversionedSerializationPlan;
+	/** In memory only: Number of values in UnversionedSerializationPlan, counting every element of static arrays. **/
+	int32 UnversionedSerializationPlanSize;
 
 	/** Array of object references embedded in script code. Mirrored for easy access by realtime garbage collection code */
 	TArray<UObject*> ScriptObjectReferences;
@@ -273,6 +277,24 @@ public:
 
 	virtual void SerializeTaggedProperties( FArchive& Ar, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults ) const;
 
+	/**
+	 * Whether SerializeTaggedProperties can use the untagged serialization plan with this archive. Only cooked,
+	 * editor-filtered packages saved with PKG_UnversionedProperties qualify; everything else keeps using property tags.
+	 */
+	static bool ShouldSerializeUnversionedProperties( FArchive& Ar );
+
+	/**
+	 * Serializes the properties that reside in Data using the untagged serialization plan: a bitmask marking the
+	 * values that differ from Defaults, followed by those values in plan order. No names or types are stored, so
+	 * the property layout must match the one the data was saved with.
+	 *
+	 * @param	Ar				the archive to use for serialization
+	 * @param	Data			pointer to the location of the beginning of the property data
+	 * @param	DefaultsStruct	the struct corresponding to the block of memory located at Defaults
+	 * @param	Defaults		pointer to the location of the beginning of the data that should be compared against
+	 */
+	void SerializeUnversionedProperties( FArchive& Ar, uint8* Data, UStruct* DefaultsStruct, uint8* Defaults ) const;
+
 	virtual EExprToken SerializeExpr(int32& iCode, FArchive& Ar);
 	virtual void TagSubobjects(EObjectFlags NewFlags) OVERRIDE;
 
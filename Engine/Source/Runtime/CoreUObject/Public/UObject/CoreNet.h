@@ -313,16 +313,19 @@ class FLifetimeProperty
 public:
 	uint16				RepIndex;
 	ELifetimeCondition	Condition;
+	bool				bIsPushBased;		// Only compared after being marked dirty, see FNetPushModel
 
-	FLifetimeProperty() : RepIndex( 0 ), Condition( COND_None ) {}
-	FLifetimeProperty( int32 InRepIndex ) : RepIndex( InRepIndex ), Condition( COND_None ) { check( InRepIndex <= 65535 ); }
-	FLifetimeProperty( int32 InRepIndex, ELifetimeCondition InCondition ) : RepIndex( InRepIndex ), Condition( InCondition ) { check( InRepIndex <= 65535 ); }
+	FLifetimeProperty() : RepIndex( 0 ), Condition( COND_None ), bIsPushBased( false ) {}
+	FLifetimeProperty( int32 InRepIndex ) : RepIndex( InRepIndex ), Condition( COND_None ), bIsPushBased( false ) { check( InRepIndex <= 65535 ); }
+	FLifetimeProperty( int32 InRepIndex, ELifetimeCondition InCondition ) : RepIndex( InRepIndex ), Condition( InCondition ), bIsPushBased( false ) { check( InRepIndex <= 65535 ); }
+	FLifetimeProperty( int32 InRepIndex, ELifetimeCondition InCondition, bool bInIsPushBased ) : RepIndex( InRepIndex ), Condition( InCondition ), bIsPushBased( bInIsPushBased ) { check( InRepIndex <= 65535 ); }
 
 	inline bool operator==( const FLifetimeProperty & Other ) const
 	{
 		if ( RepIndex == Other.RepIndex )
 		{
 			check( Condition == Other.Condition );		// Can't have different conditions if the RepIndex matches, doesn't make sense
+			check( bIsPushBased == Other.bIsPushBased );
 			return true;
 		}
 
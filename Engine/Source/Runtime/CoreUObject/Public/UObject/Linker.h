@@ -1150,6 +1150,7 @@ class ULinkerLoad : public ULinker, public FArchiveUObject
 	friend class UObject;
 	friend class UPackageMap;
 	friend struct FAsyncPackage;
+	friend class FAsyncLoadingThread;
 
 	/** Linker loading status. */
 	enum ELinkerStatus
@@ -1236,6 +1237,8 @@ private:
 
 	/** Whether we already serialized the package file summary.																*/
 	bool					bHasSerializedPackageFileSummary;
+	/** Whether the summary was serialized off the game thread and LinkerRoot hasn't been updated from it yet.				*/
+	bool					bHasPendingLinkerRootUpdate;
 	/** Whether we already fixed up import map.																				*/
 	bool					bHasFixedUpImportMap;
 	/** Whether we already matched up existing exports.																		*/
@@ -1676,10 +1679,17 @@ private:
 	ELinkerStatus CreateLoader();
 
 	/**
-	 * Serializes the package file summary.
+	 * Serializes the package file summary. LinkerRoot is only updated from it on the game thread, see UpdateLinkerRoot.
 	 */
 	ELinkerStatus SerializePackageFileSummary();
 
+	/**
+	 * Propagates the package flags, folder name, chunk IDs and file size from the package file summary to LinkerRoot.
+	 * Called on the game thread, right away when it serialized the summary or once it takes the linker back from the
+	 * async loading thread. Does nothing if the summary hasn't been serialized or LinkerRoot is already up to date.
+	 */
+	void UpdateLinkerRoot();
+
 	/**
 	 * Serializes the name map.
 	 */
@@ -1705,6 +1715,17 @@ private:
 	 */
 	ELinkerStatus SerializeExportMap();
 
+	/**
+	 * Reads the package file summary, name, import and export maps, then precaches the serialized exports so that
+	 * Preload doesn't block on IO. These steps only touch the linker and its loader, so the async loading thread runs
+	 * them once CreateLoader has succeeded on the game thread. LinkerRoot is left alone, the game thread calls
+	 * UpdateLinkerRoot when it takes the linker back. Does a single pass and returns LINKER_TimedOut while waiting
+	 * for IO. Tick carries on from wherever this stopped.
+	 *
+	 * @param	MaxExportPrecacheSize	Largest export data to precache in one request, 0 to not precache exports
+	 */
+	ELinkerStatus SerializeTables( int64 MaxExportPrecacheSize );
+
 #if WITH_ENGINE
 	/**
 	 * Kicks off async memory allocations for all textures that will be loaded from this package.
@@ -59,6 +59,7 @@ enum ESaveFlags
 	SAVE_Async			= 0x00000010,	// Save to a memory writer, then actually write to disk async
 	SAVE_Unversioned	= 0x00000020,	// Save all versions as zero. Upon load this is changed to the current version. This is only reasonable to use with full cooked builds for distribution.
 	SAVE_CutdownPackage	= 0x00000040,	// Saving cutdown packages in a temp location WITHOUT renaming the package.
+	SAVE_UnversionedProperties = 0x00000080,	// Save properties of editor-filtered packages without tags, as a bitmask of non-default values. Only reasonable for cooked builds.
 };
 
 //
@@ -78,7 +79,7 @@ enum EPackageFlags
 	PKG_DisallowLazyLoading			= 0x00080000,	// Set if the archive serializing this package cannot use lazy loading
 	PKG_PlayInEditor				= 0x00100000,	// Set if the package was created for the purpose of PIE
 	PKG_ContainsScript				= 0x00200000,	// Package is allowed to contain UClass objects
-//	PKG_Unused						= 0x00400000,
+	PKG_UnversionedProperties		= 0x00400000,	// Package properties were saved without tags, using the per-struct serialization plan
 //	PKG_Unused						= 0x00800000,
 //	PKG_Unused						= 0x01000000,	
 	PKG_StoreCompressed				= 0x02000000,	// Package is being stored compressed, requires archive support for compression
@@ -431,6 +431,13 @@ public:
 	/** Returns true if this object is safe to add to the root set. */
 	virtual bool IsSafeForRootSet() const;
 
+	/**
+	 * Returns true if this object can be part of a garbage collection cluster. Cluster members are not traversed individually
+	 * by the garbage collector; their references are gathered once when the cluster is created, so only classes that never
+	 * change their object references after being loaded may return true. Defaults to false.
+	 */
+	virtual bool CanBeInCluster() const { return false; }
+
 	/** 
 	 * Tags objects that are part of the same asset with the specified object flag, used for GC checking
 	 *
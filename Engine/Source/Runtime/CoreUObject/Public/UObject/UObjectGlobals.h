@@ -292,6 +292,7 @@ COREUOBJECT_API float GetAsyncLoadPercentage( const FString& PackageName );
 
 /** 
  * Deletes all unreferenced objects, keeping objects that have any of the passed in KeepFlags set
+ * The mark pass always completes within this call; only the work after it is left to IncrementalPurgeGarbage when bPerformFullPurge is false.
  *
  * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
  * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
@@ -317,6 +318,34 @@ COREUOBJECT_API bool IsIncrementalPurgePending();
  */
 COREUOBJECT_API void IncrementalPurgeGarbage( bool bUseTimeLimit, float TimeLimit = 0.002 );
 
+/**
+ * Returns whether unreachable objects found by the last reachability analysis still need BeginDestroy routed to them.
+ *
+ * @return	true if unreachable objects are still hashed and waiting for BeginDestroy, false otherwise.
+ */
+COREUOBJECT_API bool IsIncrementalUnhashPending();
+
+/**
+ * Routes BeginDestroy to the unreachable objects found by the last reachability analysis, unhashing them.
+ * Called by IncrementalPurgeGarbage before any object is purged, and by loading code so that unreachable
+ * objects are gone before a package looks for existing objects.
+ *
+ * @param	bUseTimeLimit	whether the time limit parameter should be used
+ * @param	TimeLimit		soft time limit for this function call
+ *
+ * @return	true if BeginDestroy has been routed to all unreachable objects, false if the time limit was reached first.
+ */
+COREUOBJECT_API bool UnhashUnreachableObjects( bool bUseTimeLimit, float TimeLimit = 0.0f );
+
+/**
+ * Turns a fully loaded cooked package into a garbage collection cluster: the package and all objects inside it are
+ * marked reachable as a whole and only the references they had when the cluster was created are followed. Does nothing
+ * for uncooked, map or script packages, or if any object in the package returns false from UObject::CanBeInCluster.
+ *
+ * @param	Package		package that has just finished loading
+ */
+COREUOBJECT_API void CreateGarbageCollectionCluster( UPackage* Package );
+
 /**
  * Create a unique name by combining a base name and an arbitrary number string.
  * The object name returned is guaranteed not to exist.
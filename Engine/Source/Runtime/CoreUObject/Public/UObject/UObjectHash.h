@@ -83,5 +83,25 @@ void HashObject(class UObjectBase* Object);
  */
 void UnhashObject(class UObjectBase* Object);
 
+/**
+ * First half of moving an object to the hash buckets of a new name and outer: adds it under the new ones.
+ * Must be called while the object still has its old name and outer, followed by UnhashObjectAfterRename once they have been changed.
+ * Because the object is only removed from its old buckets after the new ones are in place, concurrent lookups find it under
+ * either name throughout the rename, never under neither.
+ *
+ * @param	Object		Object that is about to be renamed
+ * @param	NewName		Name the object is about to get
+ * @param	NewOuter	Outer the object is about to get
+ */
+void HashObjectForRename(class UObjectBase* Object, FName NewName, class UObjectBase* NewOuter);
+/**
+ * Second half of moving an object to the hash buckets of a new name and outer: removes it from the old ones.
+ *
+ * @param	Object		Object that has just been renamed
+ * @param	OldName		Name the object had before the rename
+ * @param	OldOuter	Outer the object had before the rename
+ */
+void UnhashObjectAfterRename(class UObjectBase* Object, FName OldName, class UObjectBase* OldOuter);
+
 #endif	// __UOBJECTHASH_H__
 
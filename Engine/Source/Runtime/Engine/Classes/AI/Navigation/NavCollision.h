@@ -79,6 +79,7 @@ class ENGINE_API UNavCollision : public UObject
 	virtual void Serialize(FArchive& Ar) OVERRIDE;
 	virtual void PostLoad() OVERRIDE;
 	virtual SIZE_T GetResourceSize(EResourceSizeMode::Type Mode) OVERRIDE;
+	virtual bool CanBeInCluster() const OVERRIDE { return true; }
 	// End UObject interface.
 
 	FGuid GetGuid() const;
@@ -0,0 +1,26 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+//
+// Connection of a demo net driver, writing its packets to the demo file instead of a socket
+//
+
+#pragma once
+#include "DemoNetConnection.generated.h"
+
+UCLASS(transient, config=Engine)
+class ENGINE_API UDemoNetConnection : public UNetConnection
+{
+	GENERATED_UCLASS_BODY()
+
+	// Begin UNetConnection interface.
+	virtual void InitConnection(UNetDriver* InDriver, EConnectionState InState, const FURL& InURL, int32 InConnectionSpeed=0) OVERRIDE;
+	virtual FString LowLevelGetRemoteAddress(bool bAppendPort=false) OVERRIDE;
+	virtual FString LowLevelDescribe() OVERRIDE;
+	virtual void LowLevelSend( void* Data, int32 Count ) OVERRIDE;
+	virtual int32 IsNetReady(bool Saturate) OVERRIDE
+	{
+		// Nothing is throttled when writing to a file
+		return 1;
+	}
+	// End UNetConnection interface.
+};
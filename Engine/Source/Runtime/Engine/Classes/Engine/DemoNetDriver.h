@@ -0,0 +1,205 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+//
+// Net driver that records the replication stream of a world to a file, and plays it back as if it came from a server
+//
+
+#pragma once
+#include "DemoNetDriver.generated.h"
+
+/** Position of a checkpoint record in a demo file, used to seek backwards */
+struct FDemoCheckpoint
+{
+	float	Time;			// Demo time the checkpoint was taken at
+	int64	Offset;			// Offset of the checkpoint record in the file
+};
+
+UCLASS(transient, config=Engine)
+class ENGINE_API UDemoNetDriver : public UNetDriver
+{
+	GENERATED_UCLASS_BODY()
+
+	/** File being recorded to or played back from, NULL when not open */
+	FArchive* FileAr;
+
+	/** Name of the file being recorded to or played back from */
+	FString DemoFilename;
+
+	/** Map the demo was recorded on */
+	FString DemoMapName;
+
+	/** Size of the packets in the demo */
+	int32 DemoMaxPacket;
+
+	/** True when recording, false when playing back */
+	bool bIsRecording;
+
+	/** Time into the demo, advanced by the playback rate when playing back */
+	float DemoCurrentTime;
+
+	/** Length of the demo, only known when playing back */
+	float DemoTotalTime;
+
+	/** Speed of playback, 1 is real time */
+	float PlaybackRate;
+
+	/** DemoCurrentTime of the last recorded frame */
+	float LastRecordTime;
+
+	/** DemoCurrentTime of the last recorded checkpoint */
+	float LastCheckpointTime;
+
+	/** Time to seek to on the next tick, negative if no seek is pending */
+	float PendingSeekTime;
+
+	/** Whether a frame marker has to be written before the next recorded packet */
+	bool bFrameMarkerPending;
+
+	/** Whether the frame marker at PendingFrameTime was read, but its packets were not played yet */
+	bool bHasPendingFrame;
+
+	/** Time of the frame marker that was read but not played yet */
+	float PendingFrameTime;
+
+	/** Offset of the first record, after the header */
+	int64 DemoDataStart;
+
+	/** Offset of the end of the last complete record, playback stops there */
+	int64 DemoValidEnd;
+
+	/** Checkpoints found in the demo when playing back, in time order */
+	TArray<FDemoCheckpoint> Checkpoints;
+
+	/** Buffer packets are read into when playing back */
+	TArray<uint8> PacketBuffer;
+
+	/** Packets of the checkpoint being recorded */
+	TArray<uint8> CheckpointBuffer;
+
+	/** Connection a checkpoint is being recorded through, NULL when not recording one */
+	class UDemoNetConnection* CheckpointConnection;
+
+	/** Controller of the local player watching the demo */
+	UPROPERTY()
+	class APlayerController* SpectatorController;
+
+	// Begin UNetDriver interface.
+	virtual bool IsAvailable() const OVERRIDE
+	{
+		return true;
+	}
+	virtual bool InitBase(bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error) OVERRIDE;
+	virtual bool InitConnect( FNetworkNotify* InNotify, const FURL& ConnectURL, FString& Error ) OVERRIDE;
+	virtual bool InitListen( FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error ) OVERRIDE;
+	virtual void ProcessRemoteFunction(class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject * SubObject = NULL) OVERRIDE;
+	virtual void TickDispatch( float DeltaSeconds ) OVERRIDE;
+	virtual void TickFlush( float DeltaSeconds ) OVERRIDE;
+	virtual int32 ServerReplicateActors( float DeltaSeconds ) OVERRIDE;
+	virtual FString LowLevelGetNetworkNumber() OVERRIDE;
+	virtual void LowLevelDestroy() OVERRIDE;
+	virtual class ISocketSubsystem* GetSocketSubsystem() OVERRIDE
+	{
+		return NULL;
+	}
+	virtual bool IsNetResourceValid(void) OVERRIDE
+	{
+		return FileAr != NULL;
+	}
+	// End UNetDriver interface.
+
+	/** @return true if recording a demo, false if playing one back or closed */
+	bool IsRecording() const
+	{
+		return FileAr != NULL && bIsRecording;
+	}
+
+	/** @return true if playing a demo back, false if recording one or closed */
+	bool IsPlaying() const
+	{
+		return FileAr != NULL && !bIsRecording;
+	}
+
+	/**
+	 * Writes a packet sent through one of the demo connections of this driver.
+	 *
+	 * @param Connection the connection that sent the packet
+	 * @param Data the packet data
+	 * @param Count the size of the packet
+	 */
+	void WriteDemoPacket( class UDemoNetConnection* Connection, void* Data, int32 Count );
+
+	/**
+	 * Jumps to another time of the demo being played back, on the next tick.
+	 *
+	 * @param Time the time to jump to, clamped to the length of the demo
+	 */
+	void GotoTime( float Time );
+
+	/**
+	 * Changes the speed of playback.
+	 *
+	 * @param Rate the new speed, 1 is real time, 0 pauses playback
+	 */
+	void SetPlaybackRate( float Rate );
+
+	/**
+	 * Checks that seeking back to each checkpoint of the demo being played back gives the same actors as playing the demo from the
+	 * start up to the same time. Restores the current time when done.
+	 *
+	 * @param Ar the device to log mismatches to
+	 * @return the number of checkpoints that gave different actors
+	 */
+	int32 TestCheckpoints( FOutputDevice& Ar );
+
+protected:
+
+	/**
+	 * Reads the frames of the demo up to DemoCurrentTime and hands their packets to the server connection.
+	 *
+	 * @return false if the end of the demo was reached
+	 */
+	bool ReadDemoFrames();
+
+	/**
+	 * Reads the next packet of the demo into PacketBuffer and hands it to the server connection.
+	 *
+	 * @param PacketSize the size of the packet, already read from the file
+	 */
+	void PlayDemoPacket( int32 PacketSize );
+
+	/** Builds Checkpoints, DemoTotalTime and DemoValidEnd from the records of the demo. */
+	void ScanDemoRecords();
+
+	/** Records the state of every channel of the demo connection in a checkpoint, so that playback can seek back to it. */
+	void RecordCheckpoint();
+
+	/**
+	 * Jumps to another time of the demo being played back.
+	 *
+	 * @param Time the time to jump to
+	 */
+	void SeekTo( float Time );
+
+	/** Destroys the actors spawned by the demo, so that a checkpoint or the start of the demo can be played again. */
+	void ResetPlaybackState();
+
+	/**
+	 * Describes the actor of every open actor channel of the server connection, used to compare playback states.
+	 *
+	 * @param OutActors receives a description of the actor for each channel index
+	 */
+	void GetPlaybackSnapshot( TMap<int32, FString>& OutActors );
+
+	/** Gives the local player a controller to watch the demo with, once the demo map is loaded. */
+	void SpawnSpectatorController();
+
+	/**
+	 * Sends the destruction of startup actors the connection has not been told about.
+	 *
+	 * @param Connection the connection to send through
+	 */
+	void ReplicateDestroyedActorsToConnection( class UNetConnection* Connection );
+
+	/** Closes the file being recorded to or played back from */
+	void CloseDemoFile();
+};
@@ -2292,6 +2292,16 @@ public:
 
 	virtual bool HandleReconnectCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld );
 
+	virtual bool HandleDemoRecordCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld );
+
+	virtual bool HandleDemoPlayCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld );
+
+	virtual bool HandleDemoStopCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld );
+
+	virtual bool HandleDemoSeekCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld );
+
+	virtual bool HandleDemoSpeedCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld );
+
 	
 	/**
 	 * The proper way to disconnect a given World and NetDriver. Travels world if necessary, cleans up pending connects if necessary.
@@ -258,6 +258,8 @@ public:
 	float						JoinInProgressStandbyWaitTime;
 	/** Used to track whether a given actor was replicated by the net driver recently */
 	int32						NetTag;
+	/** Spatial index of the actors considered for replication, rebuilt by ServerReplicateActors every update */
+	TSharedPtr<class FNetRelevancyGrid>	RelevancyGrid;
 	/** Dumps next net update's relevant actors when true*/
 	bool						DebugRelevantActors;
 
@@ -540,7 +542,10 @@ public:
 protected:
 
 	/** Adds (fully initialized, ready to go) client connection to the ClientConnections list + any other game related setup */
-	ENGINE_API void	AddClientConnection(UNetConnection * NewConnection);
+	ENGINE_API virtual void	AddClientConnection(UNetConnection * NewConnection);
+
+	/** Removes a client connection from the ClientConnections list. Called when the connection is cleaned up. */
+	ENGINE_API virtual void	RemoveClientConnection(UNetConnection * ClientConnectionToRemove);
 
 	/** Register all TickDispatch, TickFlush, PostTickFlush to tick in World */
 	ENGINE_API void RegisterTickEvents(class UWorld* InWorld) const;
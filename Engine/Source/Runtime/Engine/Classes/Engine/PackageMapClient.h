@@ -83,6 +83,9 @@ class UPackageMapClient : public UPackageMap
 
 	virtual bool PrintExportBatch() OVERRIDE;
 
+	/** Forgets which NetGUIDs the connection has acked, so that each one is exported again the next time it is referenced. Used by demo checkpoints. */
+	void ResetAckState();
+
 protected:
 
 	bool	ExportNetGUID( FNetworkGUID NetGUID, const UObject * Object, FString PathName, UObject * ObjOuter );
@@ -96,6 +96,9 @@ public:
 
 	void	InitNetDriver();
 
+	/** Opens the demo named by URL.Map for playback, in place of connecting to a server */
+	void	InitDemoNetDriver();
+
 	// Begin FNetworkNotify interface.
 	virtual EAcceptConnection::Type NotifyAcceptingConnection() OVERRIDE;
 	virtual void NotifyAcceptedConnection( class UNetConnection* Connection ) OVERRIDE;
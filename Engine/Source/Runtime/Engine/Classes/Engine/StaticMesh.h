@@ -375,6 +375,13 @@ class UStaticMesh : public UObject, public IInterface_CollisionDataProvider, pub
 	UPROPERTY(EditAnywhere, AdvancedDisplay, Category=Navigation)
 	uint32 bHasNavigationData:1;
 
+	/** If true, every LOD but the lowest is cooked for streaming and only loaded while static mesh components need it. */
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category=StaticMesh)
+	uint32 bAllowLODStreaming:1;
+
+	/** Set at runtime for meshes rendered by users that always draw LOD 0, such as mesh particles. Every streamable LOD is then loaded and kept resident. */
+	uint32 bForceAllLODsResident:1;
+
 	/**
 	 * Allows artists to adjust the distance where textures using UV 0 are streamed in/out.
 	 * 1.0 is the default, whereas a higher value increases the streamed-in resolution.
@@ -473,6 +480,7 @@ public:
 	ENGINE_API virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const OVERRIDE;
 	ENGINE_API virtual FString GetDesc() OVERRIDE;
 	ENGINE_API virtual SIZE_T GetResourceSize(EResourceSizeMode::Type Mode) OVERRIDE;
+	virtual bool CanBeInCluster() const OVERRIDE { return true; }
 	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 	// End UObject interface.
 
@@ -511,7 +519,7 @@ public:
 	ENGINE_API int32 GetNumLODs() const;
 
 	/**
-	 * Returns the number of LODs used by the mesh.
+	 * Returns true if the buffers of LOD 0 are resident. For a mesh that streams its LODs, set bForceAllLODsResident to have them loaded.
 	 */
 	ENGINE_API bool HasValidRenderData() const;
 
@@ -627,6 +627,7 @@ public:
 	virtual void BeginDestroy() OVERRIDE;
 	virtual bool IsReadyForFinishDestroy() OVERRIDE;
 	virtual void FinishDestroy() OVERRIDE;
+	virtual bool CanBeInCluster() const OVERRIDE { return true; }
 	// End UObject interface.
 
 	/**
@@ -488,6 +488,10 @@ class ENGINE_API UWorld : public UObject, public FNetworkNotify
 	UPROPERTY(Transient)
 	class UNetDriver*							NetDriver;
 
+	/** The NAME_DemoNetDriver driver recording a replay of this world, NULL when not recording */
+	UPROPERTY(Transient)
+	class UDemoNetDriver*						DemoNetDriver;
+
 	/** Line Batchers. All lines to be drawn in the world. */
 	UPROPERTY(Transient)
 	class ULineBatchComponent*					LineBatcher;
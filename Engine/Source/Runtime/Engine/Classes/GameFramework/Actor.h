@@ -1327,9 +1327,12 @@ public:
 	* @param Time			Time since actor was last replicated
 	* @param bLowBandwidth True if low bandwith of viewer
 	* @return				Priority of this actor for replication
+	*
+	* Called from task threads for several connections at once when net.ParallelConnectionPrioritize is set, so it should only read actor state.
 	 */
 	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, class APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth);
 
+	/** Returns whether the actor should go dormant on a channel. Called from task threads when net.ParallelConnectionPrioritize is set, like GetNetPriority. */
 	virtual bool GetNetDormancy(const FVector& ViewPos, const FVector& ViewDir, class APlayerController* Viewer, UActorChannel* InChannel, float Time, bool bLowBandwidth);
 
 	/** 
@@ -1473,6 +1476,9 @@ public:
 	  * @param SrcLocation - is the viewing location
 	  *
 	  * @return bool - true if this actor is network relevant to the client associated with RealViewer 
+	  *
+	  * Called from task threads for several connections at once when net.ParallelConnectionPrioritize is set, so it should only read actor
+	  * state. AWorldSettings::ReplicationViewers is not set to the connection being checked then.
 	  */
 	virtual bool IsNetRelevantFor(class APlayerController* RealViewer, AActor* Viewer, const FVector& SrcLocation);
 
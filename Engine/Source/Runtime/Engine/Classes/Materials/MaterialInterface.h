@@ -134,6 +134,7 @@ public:
 	ENGINE_API virtual bool IsReadyForFinishDestroy() OVERRIDE;
 	ENGINE_API virtual void PostLoad() OVERRIDE;
 	ENGINE_API virtual void PostDuplicate(bool bDuplicateForPIE) OVERRIDE;
+	virtual bool CanBeInCluster() const OVERRIDE { return true; }
 #if WITH_EDITOR
 	ENGINE_API virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) OVERRIDE;
 #endif // WITH_EDITOR
@@ -480,6 +480,7 @@ public:
 	virtual void PostLoad() OVERRIDE;
 	virtual void PostInitProperties() OVERRIDE;
 	virtual SIZE_T GetResourceSize(EResourceSizeMode::Type Mode) OVERRIDE;
+	virtual bool CanBeInCluster() const OVERRIDE { return true; }
 	// End UObject interface.
 
 	//
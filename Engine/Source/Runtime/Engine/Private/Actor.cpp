@@ -2772,6 +2772,13 @@ int32 AActor::GetFunctionCallspace( UFunction* Function, void* Parameters, FFram
 			return FunctionCallspace::Absorbed;
 		}
 
+		// Multicasts are also recorded when a demo is being recorded
+		if ((Function->FunctionFlags & FUNC_NetMulticast) && RemoteRole != ROLE_None && World->DemoNetDriver != NULL)
+		{
+			DEBUG_CALLSPACE(TEXT("GetFunctionCallspace Multicast Recorded: %s"), *Function->GetName());
+			return FunctionCallspace::Local | FunctionCallspace::Remote;
+		}
+
 		// Call local
 		return FunctionCallspace::Local;
 	}
@@ -2887,14 +2894,29 @@ int32 AActor::GetFunctionCallspace( UFunction* Function, void* Parameters, FFram
 
 bool AActor::CallRemoteFunction( UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack )
 {
+	bool bProcessed = false;
+
+	UWorld* World = GetWorld();
+	if (World != NULL && World->DemoNetDriver != NULL)
+	{
+		// Evaluating script parameters steps the stack, rewind it so the game net driver can evaluate them as well
+		uint8* SavedCode = Stack ? Stack->Code : NULL;
+		World->DemoNetDriver->ProcessRemoteFunction(this, Function, Parameters, OutParms, Stack, NULL);
+		if (Stack)
+		{
+			Stack->Code = SavedCode;
+		}
+		bProcessed = true;
+	}
+
 	UNetDriver* NetDriver = GetNetDriver();
 	if (NetDriver)
 	{
 		NetDriver->ProcessRemoteFunction(this, Function, Parameters, OutParms, Stack, NULL);
-		return true;
+		bProcessed = true;
 	}
 
-	return false;
+	return bProcessed;
 }
 
 void AActor::DispatchPhysicsCollisionHit(const FRigidBodyCollisionInfo& MyInfo, const FRigidBodyCollisionInfo& OtherInfo, const FCollisionImpactData& RigidCollisionData)
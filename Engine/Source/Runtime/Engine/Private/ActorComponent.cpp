@@ -333,14 +333,29 @@ bool UActorComponent::CallRemoteFunction( UFunction* Function, void* Parameters,
 		return false;
 	}
 	
+	bool bProcessed = false;
+
+	UWorld* World = Owner->GetWorld();
+	if (World != NULL && World->DemoNetDriver != NULL)
+	{
+		// Evaluating script parameters steps the stack, rewind it so the game net driver can evaluate them as well
+		uint8* SavedCode = Stack ? Stack->Code : NULL;
+		World->DemoNetDriver->ProcessRemoteFunction(Owner, Function, Parameters, OutParms, Stack, this);
+		if (Stack)
+		{
+			Stack->Code = SavedCode;
+		}
+		bProcessed = true;
+	}
+
 	UNetDriver* NetDriver = Owner->GetNetDriver();
 	if (NetDriver)
 	{
 		NetDriver->ProcessRemoteFunction(Owner, Function, Parameters, OutParms, Stack, this);
-		return true;
+		bProcessed = true;
 	}
 
-	return false;
+	return bProcessed;
 }
 
 /** FComponentReregisterContexts for components which have had PreEditChange called but not PostEditChange. */
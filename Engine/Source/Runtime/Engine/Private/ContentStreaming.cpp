@@ -6,6 +6,7 @@
 
 #include "EnginePrivate.h"
 #include "GenericPlatformMemoryPoolStats.h"
+#include "ParallelFor.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogContentStreaming, Log, All);
 
@@ -119,6 +120,15 @@ static TAutoConsoleVariable<float> CVarStreamingMipBias(
 	ECVF_Scalability
 	);
 
+static TAutoConsoleVariable<int32> CVarMeshStreaming(
+	TEXT("r.MeshStreaming"),
+	1,
+	TEXT("Whether static mesh LODs cooked for streaming are loaded on demand. Only read at startup.\n")
+	TEXT("0: load all LODs with their mesh\n")
+	TEXT("1: stream LODs based on screen size (default)"),
+	ECVF_ReadOnly
+	);
+
 static TAutoConsoleVariable<float> CVarStreamingBoost(
 	TEXT("r.Streaming.Boost"),
 	1.0f,
@@ -128,6 +138,28 @@ static TAutoConsoleVariable<float> CVarStreamingBoost(
 	ECVF_Default
 	);
 
+static TAutoConsoleVariable<int32> CVarStreamingNumUpdateStages(
+	TEXT("r.Streaming.NumUpdateStages"),
+	2,
+	TEXT("Number of frames one texture streaming update is spread over. The last frame waits for the priorities and starts streaming.\n")
+	TEXT("1: update all textures, compute priorities and stream on the same frame\n")
+	TEXT("2: update all textures, then stream on the next frame while the priorities are computed in between (default)\n")
+	TEXT(">2: spread the texture updates over more frames, trading reaction time for game thread cost"),
+	ECVF_Default
+	);
+
+int32 GStreamingParallelPriorities = 1;
+
+static FAutoConsoleVariableRef CVarStreamingParallelPriorities(
+	TEXT("r.Streaming.ParallelPriorities"),
+	GStreamingParallelPriorities,
+	TEXT("If true, the wanted mips and priorities of streaming textures are computed in parallel chunks over the task graph workers."),
+	ECVF_Default
+	);
+
+/** Number of textures in each chunk of the parallel priority computation. */
+#define TEXTURE_PRIORITY_CHUNK_SIZE	256
+
 /** Streaming priority: Linear distance factor from 0 to MAX_STREAMINGDISTANCE. */
 #define MAX_STREAMINGDISTANCE	10000.0f
 #define MAX_MIPDELTA			5.0f
@@ -1038,6 +1070,18 @@ public:
 			WantedOutSize = 0;
 			NumWantingTextures = 0;
 		}
+		/** Adds in the statistics from another chunk of textures. */
+		void AddStats( const FThreadStats& Other )
+		{
+			TotalResidentSize += Other.TotalResidentSize;
+			STAT( TotalRequiredSize += Other.TotalRequiredSize );
+			TempStreamingSize += Other.TempStreamingSize;
+			PendingStreamInSize += Other.PendingStreamInSize;
+			PendingStreamOutSize += Other.PendingStreamOutSize;
+			WantedInSize += Other.WantedInSize;
+			WantedOutSize += Other.WantedOutSize;
+			NumWantingTextures += Other.NumWantingTextures;
+		}
 		/** Total number of bytes currently in memory */
 		int32 TotalResidentSize;
 		/** Total number of bytes required, using PerfectWantedMips */
@@ -1076,24 +1120,112 @@ public:
 
 private:
 	friend class FAsyncTask<FAsyncTextureStreaming>;
+
+	/** Results for one chunk of the StreamingTextures array. Each chunk has its own, so chunks can be processed in parallel and merged afterwards. */
+	struct FTextureChunk
+	{
+		FTextureChunk( const FStreamingContext& InContext )
+		:	Context( InContext )
+		{
+		}
+		/** Frame stats for the textures in this chunk. */
+		FStreamingContext			Context;
+		/** Streaming statistics for the textures in this chunk. */
+		FThreadStats				Stats;
+		/** Priorities for the textures in this chunk that want to stream in or out. */
+		TArray<FTexturePriority>	PrioritizedTextures;
+	};
+
 	/** Performs the async work. */
 	void DoWork()
 	{
-		PrioritizedTextures.Empty( StreamingManager.StreamingTextures.Num() );
+		TArray<FStreamingTexture>& StreamingTextures = StreamingManager.StreamingTextures;
+		const int32 NumTextures = StreamingTextures.Num();
+		const int32 NumChunks = (NumTextures + TEXTURE_PRIORITY_CHUNK_SIZE - 1) / TEXTURE_PRIORITY_CHUNK_SIZE;
+
+		// ThreadContext was reset on the game thread, so copying it gives each chunk zeroed stats without querying the RHI again.
+		TArray<FTextureChunk> Chunks;
+		Chunks.Empty( NumChunks );
+		for ( int32 ChunkIndex=0; ChunkIndex < NumChunks; ++ChunkIndex )
+		{
+			new (Chunks) FTextureChunk( ThreadContext );
+		}
 
 		// Calculate DynamicWantedMips and DynamicMinDistanceSq for all dynamic textures.
 		//@TODO: This is not thread-safe because it looks up UTexture2D to get to the FStreamingTexture...
 //		StreamingManager.CalcDynamicWantedMips();
 
-		// Number of textures that want more mips.
-		ThreadStats.NumWantingTextures = 0;
+		ParallelFor( NumChunks, [&]( int32 ChunkIndex )
+		{
+			const int32 StartIndex = ChunkIndex * TEXTURE_PRIORITY_CHUNK_SIZE;
+			const int32 EndIndex = FMath::Min( StartIndex + TEXTURE_PRIORITY_CHUNK_SIZE, NumTextures );
+			ProcessTextures( StartIndex, EndIndex, Chunks[ ChunkIndex ] );
+		}, GStreamingParallelPriorities ? EParallelForFlags::AllowNamedThreadCaller : EParallelForFlags::ForceSingleThread );
+
+		// Texture tracking logs through global state, so it runs here rather than on the workers. It also reports the boost factor, so reset it afterwards.
+		// The boost factor is reset even when aborting, so that a boost never carries over to the next update.
+		const bool bTrackTextures = !IsAborted();
+		for ( int32 Index=0; Index < NumTextures; ++Index )
+		{
+			FStreamingTexture& StreamingTexture = StreamingTextures[ Index ];
+			if ( bTrackTextures && StreamingTexture.bReadyForStreaming )
+			{
+				TrackTextureEvent( &StreamingTexture, StreamingTexture.Texture, StreamingTexture.bForceFullyLoad, &StreamingManager );
+			}
+			StreamingTexture.BoostFactor = 1.0f;
+		}
+
+		// Merge the chunks.
+		int32 NumPrioritizedTextures = 0;
+		for ( int32 ChunkIndex=0; ChunkIndex < NumChunks; ++ChunkIndex )
+		{
+			NumPrioritizedTextures += Chunks[ ChunkIndex ].PrioritizedTextures.Num();
+		}
+		PrioritizedTextures.Empty( NumPrioritizedTextures );
+		for ( int32 ChunkIndex=0; ChunkIndex < NumChunks; ++ChunkIndex )
+		{
+			const FTextureChunk& Chunk = Chunks[ ChunkIndex ];
+			ThreadContext.AddStats( Chunk.Context );
+			ThreadStats.AddStats( Chunk.Stats );
+			PrioritizedTextures.Append( Chunk.PrioritizedTextures );
+		}
+
+		// Sort the candidates.
+		struct FCompareTexturePriority
+		{
+			FORCEINLINE bool operator()( const FTexturePriority& A, const FTexturePriority& B ) const
+			{
+				if ( A.Priority > B.Priority )
+				{
+					return true;
+				}
+				else if ( A.Priority == B.Priority )
+				{
+					return ( A.TextureIndex < B.TextureIndex );
+				}
+				return false;
+			}
+		};
+		PrioritizedTextures.Sort( FCompareTexturePriority() );
+	}
 
-		for ( int32 Index=0; Index < StreamingManager.StreamingTextures.Num() && !IsAborted(); ++Index )
+	/**
+	 * Calculates the wanted mips and priorities for a range of streaming textures. Only writes to those textures
+	 * and to the chunk, so different ranges can be processed concurrently.
+	 *
+	 * @param StartIndex	First index into StreamingTextures to process
+	 * @param EndIndex		One past the last index to process
+	 * @param Chunk			Receives the stats and priorities for the range
+	 */
+	void ProcessTextures( int32 StartIndex, int32 EndIndex, FTextureChunk& Chunk )
+	{
+		FThreadStats& Stats = Chunk.Stats;
+		for ( int32 Index=StartIndex; Index < EndIndex && !IsAborted(); ++Index )
 		{
 			FStreamingTexture& StreamingTexture = StreamingManager.StreamingTextures[ Index ];
 
 			int32 ResidentTextureSize = StreamingTexture.GetSize( StreamingTexture.ResidentMips );
-			ThreadStats.TotalResidentSize += ResidentTextureSize;
+			Stats.TotalResidentSize += ResidentTextureSize;
 
 			StreamingTexture.bUsesStaticHeuristics = false;
 			StreamingTexture.bUsesDynamicHeuristics = (StreamingTexture.DynamicScreenSize > 0.0f) ? true : false;
@@ -1111,15 +1243,13 @@ private:
 
 				if ( StreamingTexture.WantedMips > StreamingTexture.ResidentMips )
 				{
-					ThreadStats.NumWantingTextures++;
+					Stats.NumWantingTextures++;
 				}
 
-				bool bTrackedTexture = TrackTextureEvent( &StreamingTexture, StreamingTexture.Texture, StreamingTexture.bForceFullyLoad, &StreamingManager );
-
 				// Add to sort list, if it wants to stream in or could potentially stream out.
 				if ( StreamingTexture.WantedMips > StreamingTexture.ResidentMips || StreamingTexture.ResidentMips > StreamingTexture.MinAllowedMips )
 				{
-					FTexturePriority* TexturePriority = new (PrioritizedTextures) FTexturePriority( StreamingTexture.CalcPriority(), Index );
+					new (Chunk.PrioritizedTextures) FTexturePriority( StreamingTexture.CalcPriority(), Index );
 				}
 
 				// Accumulate streaming numbers.
@@ -1127,55 +1257,34 @@ private:
 				if ( StreamingTexture.bInFlight )
 				{
 					int32 RequestedTextureSize = StreamingTexture.GetSize( StreamingTexture.RequestedMips );
-					ThreadStats.TempStreamingSize += ResidentTextureSize;	//@TODO: 0 for in-place reallocations.
+					Stats.TempStreamingSize += ResidentTextureSize;	//@TODO: 0 for in-place reallocations.
 					if ( StreamingTexture.RequestedMips > StreamingTexture.ResidentMips )
 					{
-						ThreadStats.PendingStreamInSize += FMath::Abs(RequestedTextureSize - ResidentTextureSize);
+						Stats.PendingStreamInSize += FMath::Abs(RequestedTextureSize - ResidentTextureSize);
 					}
 					else
 					{
-						ThreadStats.PendingStreamOutSize += FMath::Abs(RequestedTextureSize - ResidentTextureSize);
+						Stats.PendingStreamOutSize += FMath::Abs(RequestedTextureSize - ResidentTextureSize);
 					}
 				}
 				else
 				{
 					if ( StreamingTexture.WantedMips > StreamingTexture.ResidentMips )
 					{
-						ThreadStats.WantedInSize += FMath::Abs(WantedTextureSize - ResidentTextureSize);
+						Stats.WantedInSize += FMath::Abs(WantedTextureSize - ResidentTextureSize);
 					}
 					else
 					{
 						// Counting on shrinking reallocation.
-						ThreadStats.WantedOutSize += FMath::Abs(WantedTextureSize - ResidentTextureSize);
+						Stats.WantedOutSize += FMath::Abs(WantedTextureSize - ResidentTextureSize);
 					}
 				}
 			}
 
 			STAT( int32 PerfectWantedTextureSize = StreamingTexture.GetSize( StreamingTexture.PerfectWantedMips ) );
-			STAT( ThreadStats.TotalRequiredSize += PerfectWantedTextureSize );
-			StreamingManager.UpdateFrameStats( ThreadContext, StreamingTexture, Index );
-
-			// Reset the boost factor
-			StreamingTexture.BoostFactor = 1.0f;
+			STAT( Stats.TotalRequiredSize += PerfectWantedTextureSize );
+			StreamingManager.UpdateFrameStats( Chunk.Context, StreamingTexture, Index );
 		}
-
-		// Sort the candidates.
-		struct FCompareTexturePriority
-		{
-			FORCEINLINE bool operator()( const FTexturePriority& A, const FTexturePriority& B ) const
-			{
-				if ( A.Priority > B.Priority )
-				{
-					return true;
-				}
-				else if ( A.Priority == B.Priority )
-				{
-					return ( A.TextureIndex < B.TextureIndex );
-				}
-				return false;
-			}
-		};
-		PrioritizedTextures.Sort( FCompareTexturePriority() );
 	}
 
 	/**
@@ -1550,6 +1659,7 @@ FStreamingManagerCollection::FStreamingManagerCollection()
 ,	DisableResourceStreamingCount(0)
 ,	LoadMapTimeLimit( 5.0f )
 ,   TextureStreamingManager( NULL )
+,	StaticMeshStreamingManager( NULL )
 {
 #if PLATFORM_SUPPORTS_TEXTURE_STREAMING
 	// Disable texture streaming if that was requested (needs to happen before the call to ProcessNewlyLoadedUObjects, as that can load textures)
@@ -1561,6 +1671,13 @@ FStreamingManagerCollection::FStreamingManagerCollection()
 #endif
 
 	AddOrRemoveTextureStreamingManagerIfNeeded(true);
+
+	// Mesh LOD streaming can't be toggled at runtime, as meshes decide how to load their streamable LODs when they are initialized.
+	if( CVarMeshStreaming.GetValueOnGameThread() != 0 && FPlatformProperties::RequiresCookedData() && !IsRunningDedicatedServer() )
+	{
+		StaticMeshStreamingManager = new FStreamingManagerStaticMesh();
+		AddStreamingManager( StaticMeshStreamingManager );
+	}
 }
 
 /**
@@ -1750,6 +1867,17 @@ ITextureStreamingManager& FStreamingManagerCollection::GetTextureStreamingManage
 	return *TextureStreamingManager;
 }
 
+bool FStreamingManagerCollection::IsStaticMeshStreamingEnabled() const
+{
+	return StaticMeshStreamingManager != 0;
+}
+
+IStaticMeshStreamingManager& FStreamingManagerCollection::GetStaticMeshStreamingManager() const
+{
+	check(StaticMeshStreamingManager != 0);
+	return *StaticMeshStreamingManager;
+}
+
 /** Don't stream world resources for the next NumFrames. */
 void FStreamingManagerCollection::SetDisregardWorldResourcesForFrames(int32 NumFrames )
 {
@@ -2037,7 +2165,7 @@ FStreamingManagerTexture::FStreamingManagerTexture()
 ,	bTriggerInvestigateTexture( false )
 ,	AsyncWork( NULL )
 ,	ProcessingStage( 0 )
-,	NumTextureProcessingStages(5)
+,	NumTextureProcessingStages(FMath::Max(CVarStreamingNumUpdateStages.GetValueOnGameThread(), 1))
 ,	MaxTempMemoryUsed( 5*1024*1024 )
 ,	bUseDynamicStreaming( false )
 ,	BoostPlayerTextures( 3.0f )
@@ -2161,6 +2289,7 @@ FStreamingManagerTexture::FStreamingManagerTexture()
 		FTextureLODSettings::FTextureLODGroup& TexGroup = GSystemSettings.TextureLODSettings.GetTextureLODGroup( LODGroup );
 		ThreadSettings.NumStreamedMips[LODGroup] = TexGroup.NumStreamedMips;
 	}
+	ThreadSettings.bOnlyStreamInTextures = false;
 
 	// setup the streaming resource flush function pointer
 	GFlushStreamingFunc = &FlushResourceStreaming;
@@ -2561,6 +2690,9 @@ void FStreamingManagerTexture::UpdateThreadData()
 	
 	ThreadSettings.MipBias = FMath::Max(CVarStreamingMipBias.GetValueOnGameThread(), 0.0f);
 
+	static const auto CVarOnlyStreamInTextures = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("r.OnlyStreamInTextures"));
+	ThreadSettings.bOnlyStreamInTextures = CVarOnlyStreamInTextures->GetValueOnGameThread() != 0;
+
 	// Update the thread-safe cache information for dynamic primitives.
 	UpdateDynamicPrimitiveCache();
 }
@@ -3729,6 +3861,12 @@ void FStreamingManagerTexture::UpdateResourceStreaming( float DeltaTime, bool bP
 	}
 #endif
 
+	// Only pick up a new number of stages between updates, since an update in progress depends on it.
+	if ( ProcessingStage == 0 )
+	{
+		NumTextureProcessingStages = FMath::Max( CVarStreamingNumUpdateStages.GetValueOnGameThread(), 1 );
+	}
+
 	int32 OldNumTextureProcessingStages = NumTextureProcessingStages;
 	if ( bProcessEverything || IndividualStreamingTexture )
 	{
@@ -3964,8 +4102,7 @@ void FStreamingManagerTexture::CalcMinMaxMips( FStreamingTexture& StreamingTextu
 	// Don't stream in all referenced textures but rather only those that have been rendered in the last 5 minutes if
 	// we only stream in textures. This means you still might see texture popping, but the option is designed to avoid
 	// hitching due to CPU overhead, which is still taken care off by the 5 minute rule.
-	static auto CVarOnlyStreamInTextures = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("r.OnlyStreamInTextures"));
-	if( CVarOnlyStreamInTextures->GetValueOnAnyThread() != 0 )
+	if( ThreadSettings.bOnlyStreamInTextures )
 	{
 		float SecondsSinceLastRender = StreamingTexture.LastRenderTime;
 		if( SecondsSinceLastRender < 300 )
@@ -0,0 +1,899 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	DemoNetDriver.cpp: Net driver recording the replication stream of a world to a file, and playing it back.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/UnrealNetwork.h"
+
+/** Identifies demo files */
+#define DEMO_MAGIC				( 0x2CF5A13D )
+/** Version of the demo file format, bumped whenever it changes */
+#define DEMO_VERSION			( 1 )
+/** Size of the packets recorded in a demo */
+#define DEMO_MAX_PACKET			( 1024 )
+/** Largest packet size accepted from a demo file */
+#define DEMO_MAX_PACKET_LIMIT	( 65536 )
+
+/**
+ * A demo is a header followed by records. Each record starts with an int32, which is either the size of a packet
+ * followed by its data, or one of these tags.
+ */
+enum EDemoRecordTag
+{
+	/** Followed by the float time of the frame the next packets were recorded on */
+	DEMO_RECORD_Frame		= 0,
+	/** Followed by the float time of the checkpoint, the int32 size of its packets, and the packets as size and data pairs */
+	DEMO_RECORD_Checkpoint	= -1,
+};
+
+/** Rate demos are recorded at */
+static float GDemoRecordHz = 8.0f;
+static FAutoConsoleVariableRef CVarDemoRecordHz(
+	TEXT("demo.RecordHz"),
+	GDemoRecordHz,
+	TEXT("Number of times per second actors are recorded to a demo. Each actor is still limited by its NetUpdateFrequency. 0 records every frame."),
+	ECVF_Default
+	);
+
+/** Seconds between demo checkpoints */
+static float GDemoCheckpointInterval = 30.0f;
+static FAutoConsoleVariableRef CVarDemoCheckpointInterval(
+	TEXT("demo.CheckpointInterval"),
+	GDemoCheckpointInterval,
+	TEXT("Seconds between the checkpoints recorded in a demo. Seeking backwards restarts playback from the closest checkpoint. 0 disables checkpoints."),
+	ECVF_Default
+	);
+
+/** @return the file a demo with the given name is recorded to */
+static FString GetDemoFilename( const FString& DemoName )
+{
+	return FPaths::GameSavedDir() / TEXT("Demos") / DemoName + TEXT(".demo");
+}
+
+/*-----------------------------------------------------------------------------
+	UDemoNetDriver.
+-----------------------------------------------------------------------------*/
+
+UDemoNetDriver::UDemoNetDriver(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+	, FileAr(NULL)
+	, DemoMaxPacket(DEMO_MAX_PACKET)
+	, bIsRecording(false)
+	, DemoCurrentTime(0.f)
+	, DemoTotalTime(0.f)
+	, PlaybackRate(1.f)
+	, LastRecordTime(0.f)
+	, LastCheckpointTime(0.f)
+	, PendingSeekTime(-1.f)
+	, bFrameMarkerPending(false)
+	, bHasPendingFrame(false)
+	, PendingFrameTime(0.f)
+	, DemoDataStart(0)
+	, DemoValidEnd(0)
+	, CheckpointConnection(NULL)
+	, SpectatorController(NULL)
+{
+}
+
+bool UDemoNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error)
+{
+	if (!Super::InitBase(bInitAsClient, InNotify, URL, bReuseAddressAndPort, Error))
+	{
+		return false;
+	}
+
+#if DO_ENABLE_NET_TEST
+	// Simulated lag would be baked into the demo, and simulated loss would drop packets of it
+	PacketSimulationSettings = FPacketSimulationSettings();
+#endif
+
+	return true;
+}
+
+bool UDemoNetDriver::InitConnect( FNetworkNotify* InNotify, const FURL& ConnectURL, FString& Error )
+{
+	if (!InitBase(true, InNotify, ConnectURL, false, Error))
+	{
+		return false;
+	}
+
+	DemoFilename = GetDemoFilename(ConnectURL.Map);
+	FileAr = IFileManager::Get().CreateFileReader(*DemoFilename);
+	if (FileAr == NULL)
+	{
+		Error = FString::Printf(TEXT("Couldn't open demo file %s"), *DemoFilename);
+		return false;
+	}
+	bIsRecording = false;
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint32 NetVersion = 0;
+	*FileAr << Magic << Version << NetVersion << DemoMaxPacket;
+
+	if (FileAr->IsError() || Magic != DEMO_MAGIC || Version != DEMO_VERSION)
+	{
+		Error = FString::Printf(TEXT("%s is not a demo, or was recorded by an incompatible version"), *DemoFilename);
+		CloseDemoFile();
+		return false;
+	}
+
+	// Replication layouts depend on the net version, the demo can't be read by any other
+	if (NetVersion != GEngineNetVersion)
+	{
+		Error = FString::Printf(TEXT("Demo %s was recorded with net version %u, expected %u"), *DemoFilename, NetVersion, GEngineNetVersion);
+		CloseDemoFile();
+		return false;
+	}
+
+	if (DemoMaxPacket <= 0 || DemoMaxPacket > DEMO_MAX_PACKET_LIMIT)
+	{
+		Error = FString::Printf(TEXT("Demo %s has an invalid packet size %i"), *DemoFilename, DemoMaxPacket);
+		CloseDemoFile();
+		return false;
+	}
+
+	*FileAr << DemoMapName;
+	DemoDataStart = FileAr->Tell();
+
+	if (FileAr->IsError() || DemoMapName.IsEmpty())
+	{
+		Error = FString::Printf(TEXT("Demo %s has an invalid header"), *DemoFilename);
+		CloseDemoFile();
+		return false;
+	}
+
+	ScanDemoRecords();
+
+	PacketBuffer.Empty(DemoMaxPacket);
+	PacketBuffer.AddUninitialized(DemoMaxPacket);
+
+	// Packets read from the demo are received through the server connection, as if they came from a server
+	ServerConnection = ConstructObject<UDemoNetConnection>(UDemoNetConnection::StaticClass());
+	ServerConnection->InitConnection(this, USOCK_Open, ConnectURL, 1000000);
+
+	// Create channel zero, the connection doesn't accept any other channel before it exists.
+	ServerConnection->CreateChannel( CHTYPE_Control, 1, 0 );
+
+	UE_LOG(LogNet, Log, TEXT("Playing demo %s of map %s, %.1f seconds with %i checkpoints"), *DemoFilename, *DemoMapName, DemoTotalTime, Checkpoints.Num());
+
+	return true;
+}
+
+bool UDemoNetDriver::InitListen( FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error )
+{
+	if (!InitBase(false, InNotify, ListenURL, bReuseAddressAndPort, Error))
+	{
+		return false;
+	}
+
+	check(World != NULL);
+
+	DemoFilename = GetDemoFilename(ListenURL.Map);
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(DemoFilename), true);
+	FileAr = IFileManager::Get().CreateFileWriter(*DemoFilename);
+	if (FileAr == NULL)
+	{
+		Error = FString::Printf(TEXT("Couldn't open demo file %s for writing"), *DemoFilename);
+		return false;
+	}
+	bIsRecording = true;
+
+	uint32 Magic = DEMO_MAGIC;
+	uint32 Version = DEMO_VERSION;
+	uint32 NetVersion = GEngineNetVersion;
+	DemoMaxPacket = DEMO_MAX_PACKET;
+	DemoMapName = World->URL.Map;
+	*FileAr << Magic << Version << NetVersion << DemoMaxPacket << DemoMapName;
+	DemoDataStart = FileAr->Tell();
+
+	// Everything sent to this connection is written to the demo, it stands for every client watching the demo later
+	UDemoNetConnection* Connection = ConstructObject<UDemoNetConnection>(UDemoNetConnection::StaticClass());
+	Connection->InitConnection(this, USOCK_Open, ListenURL, 1000000);
+	Connection->ClientWorldPackageName = World->GetOutermost()->GetFName();
+	AddClientConnection(Connection);
+
+	UE_LOG(LogNet, Log, TEXT("Recording demo %s of map %s"), *DemoFilename, *DemoMapName);
+
+	return true;
+}
+
+FString UDemoNetDriver::LowLevelGetNetworkNumber()
+{
+	return FString(TEXT(""));
+}
+
+void UDemoNetDriver::LowLevelDestroy()
+{
+	if (FileAr != NULL)
+	{
+		UE_LOG(LogNet, Log, TEXT("%s demo %s at %.1f seconds"), bIsRecording ? TEXT("Stopped recording") : TEXT("Stopped playing"), *DemoFilename, DemoCurrentTime);
+	}
+
+	CloseDemoFile();
+
+	Super::LowLevelDestroy();
+}
+
+void UDemoNetDriver::CloseDemoFile()
+{
+	if (FileAr != NULL)
+	{
+		FileAr->Close();
+		delete FileAr;
+		FileAr = NULL;
+	}
+}
+
+void UDemoNetDriver::TickDispatch( float DeltaSeconds )
+{
+	Super::TickDispatch( DeltaSeconds );
+
+	// Nothing is ever received from the other end of a demo, keep the connections from timing out
+	for (int32 i = 0; i < ClientConnections.Num(); i++)
+	{
+		ClientConnections[i]->LastReceiveTime = Time;
+	}
+	if (ServerConnection != NULL)
+	{
+		ServerConnection->LastReceiveTime = Time;
+	}
+
+	if (IsRecording())
+	{
+		DemoCurrentTime += DeltaSeconds;
+		bFrameMarkerPending = true;
+		return;
+	}
+
+	// Packets are only played once the demo map is loaded
+	if (!IsPlaying() || World == NULL || ServerConnection == NULL)
+	{
+		return;
+	}
+
+	SpawnSpectatorController();
+
+	if (PendingSeekTime >= 0.f)
+	{
+		const float SeekTime = PendingSeekTime;
+		PendingSeekTime = -1.f;
+		SeekTo(SeekTime);
+	}
+
+	DemoCurrentTime = FMath::Min(DemoCurrentTime + DeltaSeconds * PlaybackRate, DemoTotalTime);
+
+	ReadDemoFrames();
+}
+
+void UDemoNetDriver::TickFlush( float DeltaSeconds )
+{
+	Super::TickFlush( DeltaSeconds );
+
+	if (IsRecording() && ClientConnections.Num() > 0 && GDemoCheckpointInterval > 0.f && DemoCurrentTime - LastCheckpointTime >= GDemoCheckpointInterval)
+	{
+		RecordCheckpoint();
+		LastCheckpointTime = DemoCurrentTime;
+	}
+}
+
+void UDemoNetDriver::ProcessRemoteFunction(class AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, class UObject * SubObject )
+{
+	// Only multicast functions are recorded, there is no one to call client or server functions on
+	if (!IsRecording() || ClientConnections.Num() == 0 || !(Function->FunctionFlags & FUNC_NetMulticast) || Actor->bOnlyRelevantToOwner)
+	{
+		return;
+	}
+
+	// Unlike the game net driver, skip actors of levels that aren't recorded rather than count them against the connection
+	UNetConnection* Connection = ClientConnections[0];
+	if (IsLevelInitializedForActor(Actor, Connection))
+	{
+		InternalProcessRemoteFunction( Actor, SubObject, Connection, Function, Parameters, OutParms, Stack, true );
+	}
+}
+
+int32 UDemoNetDriver::ServerReplicateActors( float DeltaSeconds )
+{
+	if (!IsRecording() || ClientConnections.Num() == 0 || World == NULL)
+	{
+		return 0;
+	}
+
+	// Record at a fixed rate rather than every frame, actors are interpolated on playback anyway
+	if (GDemoRecordHz > 0.f && DemoCurrentTime - LastRecordTime < 1.f / GDemoRecordHz)
+	{
+		return 0;
+	}
+	LastRecordTime = DemoCurrentTime;
+
+	// Bump the replication frame, so that compares and serialized properties aren't reused from the last recorded frame
+	ReplicationFrame++;
+
+	UNetConnection* Connection = ClientConnections[0];
+	int32 Updated = 0;
+
+	// Record every actor the game could replicate, as seen by a spectator that is relevant to everything
+	for (int32 i = 0; i < World->NetworkActors.Num(); i++)
+	{
+		AActor* Actor = World->NetworkActors[i];
+
+		if (Actor->IsPendingKill() || Actor->GetRemoteRole() == ROLE_None)
+		{
+			continue;
+		}
+
+		if (Actor->NetDriverName != NAME_GameNetDriver && Actor->NetDriverName != NetDriverName)
+		{
+			continue;
+		}
+
+		// The demo has no owner to send owner only actors to, such as player controllers
+		if (Actor->bOnlyRelevantToOwner)
+		{
+			continue;
+		}
+
+		// Don't send actors that may still be streaming in
+		ULevel* Level = Actor->GetLevel();
+		if (Level->HasVisibilityRequestPending() || Level->bIsAssociatingLevel)
+		{
+			continue;
+		}
+
+		if (Actor->NetDormancy == DORM_Initial && Actor->IsNetStartupActor())
+		{
+			continue;
+		}
+
+		if (Actor->bNetTemporary && Connection->SentTemporaries.Contains(Actor))
+		{
+			continue;
+		}
+
+		UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+		if (Channel == NULL)
+		{
+			if (Actor->bTearOff || !IsLevelInitializedForActor(Actor, Connection))
+			{
+				continue;
+			}
+
+			if (!Connection->PackageMap->SupportsObject(Actor->GetClass()) || !Connection->PackageMap->SupportsObject(Actor->IsNetStartupActor() ? Actor : Actor->GetArchetype()))
+			{
+				continue;
+			}
+		}
+		else if (Actor->NetUpdateFrequency * (Time - Channel->LastUpdateTime) < 1.f)
+		{
+			// Updated recently enough for its update frequency
+			continue;
+		}
+
+		Actor->PreReplication( *FindOrCreateRepChangedPropertyTracker( Actor ).Get() );
+
+		if (Channel == NULL)
+		{
+			Channel = (UActorChannel*)Connection->CreateChannel( CHTYPE_Actor, 1 );
+			if (Channel == NULL)
+			{
+				UE_LOG(LogNet, Warning, TEXT("Demo %s ran out of channels, %s is not recorded"), *DemoFilename, *Actor->GetName());
+				continue;
+			}
+			Channel->SetChannelActor( Actor );
+		}
+
+		if (Channel->ReplicateActor())
+		{
+			Updated++;
+		}
+	}
+
+	ReplicateDestroyedActorsToConnection(Connection);
+
+	return Updated;
+}
+
+void UDemoNetDriver::ReplicateDestroyedActorsToConnection( UNetConnection* Connection )
+{
+	for (auto It = Connection->DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
+	{
+		FActorDestructionInfo& DestructionInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
+
+		// Streaming levels aren't recorded, so their actors were never known to the demo
+		if (DestructionInfo.StreamingLevelName != NAME_None)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		UActorChannel* Channel = (UActorChannel*)Connection->CreateChannel( CHTYPE_Actor, 1 );
+		if (Channel == NULL)
+		{
+			break;
+		}
+
+		// Send a close bunch on the new channel
+		Channel->SetChannelActorForDestroy( &DestructionInfo );
+		It.RemoveCurrent();
+	}
+}
+
+void UDemoNetDriver::WriteDemoPacket( UDemoNetConnection* Connection, void* Data, int32 Count )
+{
+	check(Count > 0 && Count <= DemoMaxPacket);
+
+	if (Connection == CheckpointConnection && CheckpointConnection != NULL)
+	{
+		FMemoryWriter Writer(CheckpointBuffer);
+		Writer.Seek(CheckpointBuffer.Num());
+		Writer << Count;
+		Writer.Serialize(Data, Count);
+		return;
+	}
+
+	// Only the packets of the demo connection are recorded, playback discards whatever it sends
+	if (!IsRecording() || ClientConnections.Num() == 0 || Connection != ClientConnections[0])
+	{
+		return;
+	}
+
+	if (bFrameMarkerPending)
+	{
+		int32 Tag = DEMO_RECORD_Frame;
+		*FileAr << Tag << DemoCurrentTime;
+		bFrameMarkerPending = false;
+	}
+
+	*FileAr << Count;
+	FileAr->Serialize(Data, Count);
+}
+
+void UDemoNetDriver::RecordCheckpoint()
+{
+	UNetConnection* Connection = ClientConnections[0];
+
+	// Everything recorded before the checkpoint has to be in the file ahead of it
+	Connection->FlushNet();
+
+	CheckpointConnection = ConstructObject<UDemoNetConnection>(UDemoNetConnection::StaticClass());
+	CheckpointConnection->InitConnection(this, USOCK_Open, Connection->URL, Connection->CurrentNetSpeed);
+	CheckpointConnection->ClientWorldPackageName = Connection->ClientWorldPackageName;
+	AddClientConnection(CheckpointConnection);
+
+	// The checkpoint has to serialize the current values of everything, not what was serialized for the last frame
+	ReplicationFrame++;
+
+	// Open every channel of the demo connection at the same index, so that the frames following the checkpoint find their actors.
+	// Demo connections derive bunch sequences on receive, so the mirrored channels line up with the demo connection's.
+	for (auto It = Connection->ActorChannels.CreateIterator(); It; ++It)
+	{
+		UActorChannel* Channel = It.Value();
+		AActor* Actor = Channel->Actor;
+		if (Actor == NULL || Actor->IsPendingKill() || Actor->bNetTemporary || Channel->Closing)
+		{
+			continue;
+		}
+
+		UActorChannel* CheckpointChannel = (UActorChannel*)CheckpointConnection->CreateChannel( CHTYPE_Actor, 1, Channel->ChIndex );
+		CheckpointChannel->SetChannelActor( Actor );
+		CheckpointChannel->ReplicateActor();
+	}
+
+	// AddClientConnection handed the connection every startup actor destroyed so far
+	ReplicateDestroyedActorsToConnection(CheckpointConnection);
+
+	CheckpointConnection->FlushNet();
+
+	int32 Tag = DEMO_RECORD_Checkpoint;
+	int32 NumBytes = CheckpointBuffer.Num();
+	*FileAr << Tag << DemoCurrentTime << NumBytes;
+	FileAr->Serialize(CheckpointBuffer.GetData(), NumBytes);
+
+	UE_LOG(LogNet, Log, TEXT("Recorded demo checkpoint at %.1f seconds, %i bytes"), DemoCurrentTime, NumBytes);
+
+	CheckpointBuffer.Reset();
+
+	// The frames after the checkpoint need a marker of their own, playback may start right after it
+	bFrameMarkerPending = true;
+
+	// Playback that starts at this checkpoint only knows the NetGUIDs the checkpoint exported, not everything the demo connection
+	// exported before it, so the frames after it have to export whatever they reference again
+	UPackageMapClient* PackageMapClient = Cast<UPackageMapClient>(Connection->PackageMap);
+	if (PackageMapClient != NULL)
+	{
+		PackageMapClient->ResetAckState();
+	}
+
+	// Discard whatever the connection sends while it is cleaned up
+	UDemoNetConnection* FinishedConnection = CheckpointConnection;
+	CheckpointConnection = NULL;
+	FinishedConnection->CleanUp();
+}
+
+void UDemoNetDriver::ScanDemoRecords()
+{
+	Checkpoints.Empty();
+	DemoTotalTime = 0.f;
+	DemoValidEnd = DemoDataStart;
+
+	const int64 FileSize = FileAr->TotalSize();
+	FileAr->Seek(DemoDataStart);
+
+	// A demo that wasn't closed properly may end with a partial record, stop at the last complete one
+	while (FileAr->Tell() + (int64)sizeof(int32) <= FileSize)
+	{
+		const int64 RecordStart = FileAr->Tell();
+
+		int32 Tag = 0;
+		*FileAr << Tag;
+
+		if (Tag == DEMO_RECORD_Frame)
+		{
+			if (FileAr->Tell() + (int64)sizeof(float) > FileSize)
+			{
+				break;
+			}
+
+			float FrameTime = 0.f;
+			*FileAr << FrameTime;
+			DemoTotalTime = FMath::Max(DemoTotalTime, FrameTime);
+		}
+		else if (Tag == DEMO_RECORD_Checkpoint)
+		{
+			if (FileAr->Tell() + (int64)(sizeof(float) + sizeof(int32)) > FileSize)
+			{
+				break;
+			}
+
+			FDemoCheckpoint Checkpoint;
+			Checkpoint.Offset = RecordStart;
+			int32 NumBytes = 0;
+			*FileAr << Checkpoint.Time << NumBytes;
+
+			if (NumBytes < 0 || FileAr->Tell() + NumBytes > FileSize)
+			{
+				break;
+			}
+
+			FileAr->Seek(FileAr->Tell() + NumBytes);
+			Checkpoints.Add(Checkpoint);
+		}
+		else if (Tag > 0 && Tag <= DemoMaxPacket)
+		{
+			if (FileAr->Tell() + Tag > FileSize)
+			{
+				break;
+			}
+
+			FileAr->Seek(FileAr->Tell() + Tag);
+		}
+		else
+		{
+			UE_LOG(LogNet, Warning, TEXT("Demo %s has an invalid record at offset %lld, playback stops there"), *DemoFilename, RecordStart);
+			break;
+		}
+
+		if (FileAr->IsError())
+		{
+			break;
+		}
+
+		DemoValidEnd = FileAr->Tell();
+	}
+
+	FileAr->Seek(DemoDataStart);
+}
+
+bool UDemoNetDriver::ReadDemoFrames()
+{
+	while (ServerConnection != NULL && ServerConnection->State != USOCK_Closed)
+	{
+		// Play the packets of a frame once playback reaches it
+		if (bHasPendingFrame)
+		{
+			if (PendingFrameTime > DemoCurrentTime)
+			{
+				return true;
+			}
+			bHasPendingFrame = false;
+		}
+
+		if (FileAr->Tell() >= DemoValidEnd)
+		{
+			return false;
+		}
+
+		int32 Tag = 0;
+		*FileAr << Tag;
+
+		if (Tag == DEMO_RECORD_Frame)
+		{
+			*FileAr << PendingFrameTime;
+			bHasPendingFrame = true;
+		}
+		else if (Tag == DEMO_RECORD_Checkpoint)
+		{
+			// The frames before the checkpoint already brought everything it holds up to date
+			float CheckpointTime = 0.f;
+			int32 NumBytes = 0;
+			*FileAr << CheckpointTime << NumBytes;
+			FileAr->Seek(FileAr->Tell() + NumBytes);
+		}
+		else
+		{
+			PlayDemoPacket(Tag);
+		}
+	}
+
+	return false;
+}
+
+void UDemoNetDriver::PlayDemoPacket( int32 PacketSize )
+{
+	FileAr->Serialize(PacketBuffer.GetData(), PacketSize);
+	ServerConnection->ReceivedRawPacket(PacketBuffer.GetData(), PacketSize);
+}
+
+void UDemoNetDriver::GotoTime( float InTime )
+{
+	if (IsPlaying())
+	{
+		PendingSeekTime = FMath::Clamp(InTime, 0.f, DemoTotalTime);
+	}
+}
+
+void UDemoNetDriver::SetPlaybackRate( float Rate )
+{
+	PlaybackRate = FMath::Max(Rate, 0.f);
+}
+
+void UDemoNetDriver::SeekTo( float InTime )
+{
+	if (InTime >= DemoCurrentTime)
+	{
+		// Play the frames in between, that keeps everything they exported
+		DemoCurrentTime = InTime;
+		ReadDemoFrames();
+		return;
+	}
+
+	// Start over from the last checkpoint before the time, or from the start of the demo
+	int32 CheckpointIndex = INDEX_NONE;
+	for (int32 i = Checkpoints.Num() - 1; i >= 0; i--)
+	{
+		if (Checkpoints[i].Time <= InTime)
+		{
+			CheckpointIndex = i;
+			break;
+		}
+	}
+
+	ResetPlaybackState();
+
+	bHasPendingFrame = false;
+
+	if (CheckpointIndex != INDEX_NONE)
+	{
+		FileAr->Seek(Checkpoints[CheckpointIndex].Offset);
+
+		int32 Tag = 0;
+		float CheckpointTime = 0.f;
+		int32 NumBytes = 0;
+		*FileAr << Tag << CheckpointTime << NumBytes;
+		check(Tag == DEMO_RECORD_Checkpoint);
+
+		const int64 CheckpointEnd = FileAr->Tell() + NumBytes;
+		while (FileAr->Tell() + (int64)sizeof(int32) <= CheckpointEnd && ServerConnection != NULL)
+		{
+			int32 PacketSize = 0;
+			*FileAr << PacketSize;
+			if (PacketSize <= 0 || PacketSize > DemoMaxPacket || FileAr->Tell() + PacketSize > CheckpointEnd)
+			{
+				UE_LOG(LogNet, Warning, TEXT("Demo %s has an invalid checkpoint at %.1f seconds"), *DemoFilename, CheckpointTime);
+				break;
+			}
+			PlayDemoPacket(PacketSize);
+		}
+
+		FileAr->Seek(CheckpointEnd);
+	}
+	else
+	{
+		FileAr->Seek(DemoDataStart);
+	}
+
+	DemoCurrentTime = InTime;
+	ReadDemoFrames();
+}
+
+int32 UDemoNetDriver::TestCheckpoints( FOutputDevice& Ar )
+{
+	if (!IsPlaying() || ServerConnection == NULL)
+	{
+		return 0;
+	}
+
+	const float OriginalTime = DemoCurrentTime;
+	int32 NumFailed = 0;
+
+	for (int32 i = 0; i < Checkpoints.Num(); i++)
+	{
+		// Halfway to the next checkpoint, so that the frames recorded after the checkpoint are played as well
+		const float NextTime = (i + 1 < Checkpoints.Num()) ? Checkpoints[i + 1].Time : DemoTotalTime;
+		const float TestTime = (Checkpoints[i].Time + NextTime) * 0.5f;
+
+		// Play from the start of the demo without going through any checkpoint
+		ResetPlaybackState();
+		bHasPendingFrame = false;
+		FileAr->Seek(DemoDataStart);
+		DemoCurrentTime = 0.f;
+		SeekTo(TestTime);
+
+		TMap<int32, FString> PlayedActors;
+		GetPlaybackSnapshot(PlayedActors);
+
+		// Seek back to the same time from the end, which starts over from this checkpoint
+		SeekTo(DemoTotalTime);
+		SeekTo(TestTime);
+
+		TMap<int32, FString> SeekedActors;
+		GetPlaybackSnapshot(SeekedActors);
+
+		bool bMatches = PlayedActors.Num() == SeekedActors.Num();
+		for (TMap<int32, FString>::TConstIterator It(PlayedActors); It; ++It)
+		{
+			const FString* Seeked = SeekedActors.Find(It.Key());
+			if (Seeked == NULL || *Seeked != It.Value())
+			{
+				Ar.Logf(TEXT("Checkpoint %i: channel %i is %s when played, %s when seeked"), i, It.Key(), *It.Value(), Seeked != NULL ? **Seeked : TEXT("closed"));
+				bMatches = false;
+			}
+		}
+		for (TMap<int32, FString>::TConstIterator It(SeekedActors); It; ++It)
+		{
+			if (!PlayedActors.Contains(It.Key()))
+			{
+				Ar.Logf(TEXT("Checkpoint %i: channel %i is closed when played, %s when seeked"), i, It.Key(), *It.Value());
+				bMatches = false;
+			}
+		}
+
+		Ar.Logf(TEXT("Checkpoint %i at %.2f seconds: %s (%i channels)"), i, Checkpoints[i].Time, bMatches ? TEXT("ok") : TEXT("FAILED"), PlayedActors.Num());
+		if (!bMatches)
+		{
+			NumFailed++;
+		}
+	}
+
+	SeekTo(DemoTotalTime);
+	SeekTo(OriginalTime);
+
+	return NumFailed;
+}
+
+void UDemoNetDriver::GetPlaybackSnapshot( TMap<int32, FString>& OutActors )
+{
+	OutActors.Empty();
+
+	for (int32 i = 0; i < ServerConnection->OpenChannels.Num(); i++)
+	{
+		UActorChannel* Channel = Cast<UActorChannel>(ServerConnection->OpenChannels[i]);
+		if (Channel == NULL)
+		{
+			continue;
+		}
+
+		// Names of spawned actors depend on the order they were spawned in, only the class and the replicated location are compared
+		AActor* Actor = Channel->Actor;
+		if (Actor == NULL)
+		{
+			OutActors.Add(Channel->ChIndex, TEXT("unresolved"));
+		}
+		else
+		{
+			const FVector Location = Actor->GetActorLocation();
+			OutActors.Add(Channel->ChIndex, FString::Printf(TEXT("%s (%.0f,%.0f,%.0f)"), *Actor->GetClass()->GetPathName(), Location.X, Location.Y, Location.Z));
+		}
+	}
+}
+
+void UDemoNetDriver::ResetPlaybackState()
+{
+	for (int32 i = ServerConnection->OpenChannels.Num() - 1; i >= 0; i--)
+	{
+		UActorChannel* Channel = Cast<UActorChannel>(ServerConnection->OpenChannels[i]);
+		if (Channel == NULL)
+		{
+			continue;
+		}
+
+		// Startup actors belong to the map, detach them so they survive the channel and the demo brings them up to date again
+		if (Channel->Actor != NULL && Channel->Actor->IsNetStartupActor())
+		{
+			ServerConnection->ActorChannels.Remove(Channel->Actor);
+			Channel->Actor = NULL;
+		}
+
+		// Destroys the actor spawned by the channel
+		Channel->ConditionalCleanUp();
+	}
+
+	// Forget the guids of the destroyed actors, the demo assigns them again when it spawns them
+	CleanPackageMaps();
+}
+
+void UDemoNetDriver::SpawnSpectatorController()
+{
+	if (SpectatorController == NULL)
+	{
+		ULocalPlayer* LocalPlayer = GEngine->GetFirstGamePlayer(World);
+		if (LocalPlayer == NULL)
+		{
+			return;
+		}
+
+		// Take over the placeholder controller LoadMap spawned for the player, no controller is ever replicated from a demo
+		SpectatorController = LocalPlayer->PlayerController;
+		if (SpectatorController == NULL || SpectatorController->GetWorld() != World)
+		{
+			FActorSpawnParameters SpawnInfo;
+			SpawnInfo.bNoCollisionFail = true;
+			SpectatorController = World->SpawnActor<APlayerController>(APlayerController::StaticClass(), SpawnInfo);
+			if (SpectatorController == NULL)
+			{
+				return;
+			}
+		}
+
+		SpectatorController->SetPlayer(LocalPlayer);
+	}
+
+	// The spectator pawn can only be spawned once the game state arrived from the demo
+	if (World->GameState != NULL && SpectatorController->IsInState(NAME_Spectating) && SpectatorController->GetSpectatorPawn() == NULL)
+	{
+		SpectatorController->ReceivedPlayer();
+	}
+}
+
+/*-----------------------------------------------------------------------------
+	UDemoNetConnection.
+-----------------------------------------------------------------------------*/
+
+UDemoNetConnection::UDemoNetConnection(const class FPostConstructInitializeProperties& PCIP)
+	: Super(PCIP)
+{
+}
+
+void UDemoNetConnection::InitConnection(UNetDriver* InDriver, EConnectionState InState, const FURL& InURL, int32 InConnectionSpeed)
+{
+	// Demo packets are never lost or reordered, so they are acked internally and carry no packet or bunch sequences
+	InternalAck = true;
+
+	// Each packet of a demo is preceded by its size
+	InitBase(InDriver, NULL, InURL, InState, CastChecked<UDemoNetDriver>(InDriver)->DemoMaxPacket, sizeof(int32));
+
+	if (InConnectionSpeed)
+	{
+		CurrentNetSpeed = InConnectionSpeed;
+	}
+
+	InitSendBuffer();
+}
+
+FString UDemoNetConnection::LowLevelGetRemoteAddress(bool bAppendPort)
+{
+	return FString(TEXT(""));
+}
+
+FString UDemoNetConnection::LowLevelDescribe()
+{
+	return FString::Printf(TEXT("Demo %s"), Driver ? *CastChecked<UDemoNetDriver>(Driver)->DemoFilename : TEXT(""));
+}
+
+void UDemoNetConnection::LowLevelSend( void* Data, int32 Count )
+{
+	CastChecked<UDemoNetDriver>(Driver)->WriteDemoPacket(this, Data, Count);
+}
@@ -531,6 +531,10 @@ bool UWorld::DestroyActor( AActor* ThisActor, bool bNetForce, bool bShouldModify
 	{
 		NetDriver->NotifyActorDestroyed( ThisActor );
 	}
+	if( DemoNetDriver )
+	{
+		DemoNetDriver->NotifyActorDestroyed( ThisActor );
+	}
 
 	// Remove the actor from the actor list.
 	RemoveActor( ThisActor, bShouldModifyLevel );
@@ -70,11 +70,16 @@ DEFINE_STAT(STAT_FinishAsyncTraceTickTime);
 DEFINE_STAT(STAT_NetBroadcastTickTime);
 DEFINE_STAT(STAT_NetServerRepActorsTime);
 DEFINE_STAT(STAT_NetConsiderActorsTime);
+DEFINE_STAT(STAT_NetBuildRelevancyGridTime);
+DEFINE_STAT(STAT_NetGatherConnectionActorsTime);
 DEFINE_STAT(STAT_NetInitialDormantCheckTime);
 DEFINE_STAT(STAT_NetPrioritizeActorsTime);
 DEFINE_STAT(STAT_NetReplicateActorsTime);
 DEFINE_STAT(STAT_NetReplicateDynamicPropTime);
 DEFINE_STAT(STAT_NetSkippedDynamicProps);
+DEFINE_STAT(STAT_NetSharedSerializationHits);
+DEFINE_STAT(STAT_NetSharedSerializationMisses);
+DEFINE_STAT(STAT_NetSharedSerializationBytes);
 DEFINE_STAT(STAT_NetSerializeItemDeltaTime);
 DEFINE_STAT(STAT_NetReplicateStaticPropTime);
 DEFINE_STAT(STAT_NetBroadcastPostTickTime);
@@ -249,7 +249,7 @@ void UNetConnection::CleanUp()
 		else
 		{
 			check(Driver->ServerConnection == NULL);
-			verify(Driver->ClientConnections.Remove(this) == 1);
+			Driver->RemoveClientConnection(this);
 		}
 	}
 
@@ -516,8 +516,8 @@ void UNetConnection::FlushNet(bool bIgnoreSimulation)
 	LastEnd = FBitWriterMark();
 	TimeSensitive = 0;
 
-	// If there is any pending data to send, send it.
-	if( SendBuffer.GetNumBits() || Driver->Time-LastSendTime>Driver->KeepAliveTime )
+	// If there is any pending data to send, send it. Internally acked connections have no one to keep alive.
+	if( SendBuffer.GetNumBits() || ( !InternalAck && Driver->Time-LastSendTime>Driver->KeepAliveTime ) )
 	{
 		// If sending keepalive packet, still write the packet id
 		if ( SendBuffer.GetNumBits() == 0 )
@@ -676,8 +676,8 @@ void UNetConnection::ReceivedPacket( FBitReader& Reader )
 	// Update receive time to avoid timeout.
 	LastReceiveTime = Driver->Time;
 
-	// Check packet ordering.
-	const int32 PacketId = MakeRelative(Reader.ReadInt(MAX_PACKETID),InPacketId,MAX_PACKETID);
+	// Check packet ordering. Internally acked connections never lose or reorder packets, so they don't send the packet id.
+	const int32 PacketId = InternalAck ? InPacketId + 1 : MakeRelative(Reader.ReadInt(MAX_PACKETID),InPacketId,MAX_PACKETID);
 	if( PacketId > InPacketId )
 	{
 		const int32 PacketsLost = PacketId - InPacketId - 1;
@@ -845,12 +845,12 @@ void UNetConnection::ReceivedPacket( FBitReader& Reader )
 			if ( Bunch.bReliable )
 			{
 				// If this is a reliable bunch, use the last processed reliable sequence to read the new reliable sequence
-				Bunch.ChSequence = MakeRelative( Reader.ReadInt( MAX_CHSEQUENCE ), InReliable[Bunch.ChIndex], MAX_CHSEQUENCE );
+				Bunch.ChSequence = InternalAck ? InReliable[Bunch.ChIndex] + 1 : MakeRelative( Reader.ReadInt( MAX_CHSEQUENCE ), InReliable[Bunch.ChIndex], MAX_CHSEQUENCE );
 			} 
 			else if ( Bunch.bPartial )
 			{
 				// If this is a partial bunch, use the last processed partial sequence to read the new partial sequence
-				Bunch.ChSequence = MakeRelative( Reader.ReadInt( MAX_CHSEQUENCE ), LastPartialPacketId, MAX_CHSEQUENCE );
+				Bunch.ChSequence = InternalAck ? LastPartialPacketId + 1 : MakeRelative( Reader.ReadInt( MAX_CHSEQUENCE ), LastPartialPacketId, MAX_CHSEQUENCE );
 				if ( Bunch.ChSequence > LastPartialPacketId )
 				{
 					LastPartialPacketId = Bunch.ChSequence;
@@ -1069,7 +1069,7 @@ int32 UNetConnection::WriteBitsToSendBuffer(
 	LastStart = FBitWriterMark( SendBuffer );
 
 	// If this is the start of the queue, make sure to add the packet id
-	if ( SendBuffer.GetNumBits() == 0 )
+	if ( SendBuffer.GetNumBits() == 0 && !InternalAck )
 	{
 		SendBuffer.WriteIntWrapped( OutPacketId, MAX_PACKETID );
 		ValidateSendBuffer();
@@ -1190,7 +1190,11 @@ int32 UNetConnection::SendRawBunch( FOutBunch& Bunch, bool InAllowMerge )
 	Header.WriteBit( Bunch.bPartial );
 	if (Bunch.bReliable || Bunch.bPartial)
 	{
-		Header.WriteIntWrapped(Bunch.ChSequence, MAX_CHSEQUENCE);
+		// Internally acked connections deliver every bunch in order, the receiver derives the sequence instead
+		if (!InternalAck)
+		{
+			Header.WriteIntWrapped(Bunch.ChSequence, MAX_CHSEQUENCE);
+		}
 		if (Bunch.bPartial)
 		{
 			Header.WriteBit( Bunch.bPartialInitial );
@@ -1357,6 +1361,10 @@ void UNetConnection::Tick()
 			It->OpenAcked = 1;
 			It->ReceivedAcks();
 		}
+		if ( PackageMap != NULL )
+		{
+			PackageMap->ReceivedAck( OutPacketId - 1 );
+		}
 	}
 
 	// Update stats.
@@ -1432,7 +1440,7 @@ void UNetConnection::Tick()
 
 	// Flush.
 	PurgeAcks();
-	if( TimeSensitive || Driver->Time-LastSendTime>Driver->KeepAliveTime )
+	if( TimeSensitive || ( !InternalAck && Driver->Time-LastSendTime>Driver->KeepAliveTime ) )
 	{
 		FlushNet();
 	}
@@ -0,0 +1,76 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetRelevancyGrid.cpp: Spatial index of network actors for relevancy checks.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/NetRelevancyGrid.h"
+
+FNetRelevancyGrid::FNetRelevancyGrid()
+	: CellSize(1.0f)
+	, InvCellSize(1.0f)
+	, QueryRadius(0.0f)
+{
+}
+
+void FNetRelevancyGrid::Reset(float InCellSize, float InQueryRadius)
+{
+	check(InCellSize > 0.0f);
+	CellSize = InCellSize;
+	InvCellSize = 1.0f / InCellSize;
+	QueryRadius = InQueryRadius;
+	FirstInCell.Reset();
+	NextInCell.Reset();
+}
+
+void FNetRelevancyGrid::Add(int32 Index, const FVector& Location)
+{
+	check(Index >= 0);
+	if (Index >= NextInCell.Num())
+	{
+		const int32 FirstNewIndex = NextInCell.Num();
+		NextInCell.AddUninitialized(Index + 1 - FirstNewIndex);
+		for (int32 NewIndex = FirstNewIndex; NewIndex < NextInCell.Num(); NewIndex++)
+		{
+			NextInCell[NewIndex] = INDEX_NONE;
+		}
+	}
+
+	// push onto the front of the cell's list
+	const FIntPoint Cell = GetCell(Location.X, Location.Y);
+	int32* First = FirstInCell.Find(Cell);
+	if (First)
+	{
+		NextInCell[Index] = *First;
+		*First = Index;
+	}
+	else
+	{
+		NextInCell[Index] = INDEX_NONE;
+		FirstInCell.Add(Cell, Index);
+	}
+}
+
+int32 FNetRelevancyGrid::MarkActorsNear(const FVector& Location, TBitArray<>& InOutMarks) const
+{
+	int32 NumFound = 0;
+	const FIntPoint MinCell = GetCell(Location.X - QueryRadius, Location.Y - QueryRadius);
+	const FIntPoint MaxCell = GetCell(Location.X + QueryRadius, Location.Y + QueryRadius);
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			const int32* First = FirstInCell.Find(FIntPoint(CellX, CellY));
+			if (First)
+			{
+				for (int32 Index = *First; Index != INDEX_NONE; Index = NextInCell[Index])
+				{
+					InOutMarks[Index] = true;
+					NumFound++;
+				}
+			}
+		}
+	}
+	return NumFound;
+}
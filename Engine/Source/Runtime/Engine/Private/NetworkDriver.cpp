@@ -9,6 +9,8 @@
 #include "Net/NetworkProfiler.h"
 #include "NavigationPathBuilder.h"
 #include "OnlineSubsystemUtils.h"
+#include "Net/NetRelevancyGrid.h"
+#include "ParallelFor.h"
 
 // Default net driver stats
 DEFINE_STAT(STAT_Ping);
@@ -22,6 +24,7 @@ DEFINE_STAT(STAT_OutBunches);
 DEFINE_STAT(STAT_OutLoss);
 DEFINE_STAT(STAT_InLoss);
 DEFINE_STAT(STAT_NumConsideredActors);
+DEFINE_STAT(STAT_NumRelevancyGridCandidates);
 DEFINE_STAT(STAT_PrioritizedActors);
 DEFINE_STAT(STAT_NumRelevantActors);
 DEFINE_STAT(STAT_NumRelevantDeletedActors);
@@ -1316,6 +1319,7 @@ void UNetDriver::NotifyActorDestroyed( AActor* ThisActor, bool IsSeamlessTravel
 {
 	// Remove the actor from the property tracker map
 	RepChangedPropertyTrackerMap.Remove(ThisActor);
+	FNetPushModel::RemoveObject(ThisActor);
 #if WITH_SERVER_CODE
 
 	FActorDestructionInfo* DestructionInfo = NULL;
@@ -1694,6 +1698,37 @@ FActorPriority::FActorPriority(class UNetConnection* InConnection, struct FActor
 	}
 }
 
+/** Sorts actor priorities, highest first */
+struct FCompareFActorPriority
+{
+	FORCEINLINE bool operator()( const FActorPriority& A, const FActorPriority& B ) const
+	{
+		return B.Priority < A.Priority;
+	}
+};
+
+/** The actors one connection should replicate this frame, prioritized in parallel with the other connections */
+struct FConnectionPriorities
+{
+	/** Prioritized actors and deletion entries */
+	TArray<FActorPriority> PriorityList;
+	/** Entries of PriorityList sorted by priority, highest first */
+	TArray<FActorPriority*> PriorityActors;
+	/** Channels that should start becoming dormant, applied in connection order after prioritizing */
+	TArray<UActorChannel*> ChannelsToMakeDormant;
+	/** Actors dormant on the connection that net.DormancyValidate=2 checks */
+	TArray<AActor*> DormantActorsToValidate;
+	/** Number of considered actors checked */
+	int32 NumCandidates;
+	/** Number of deletion entries in PriorityList */
+	int32 DeletedCount;
+
+	FConnectionPriorities()
+		: NumCandidates(0)
+		, DeletedCount(0)
+	{}
+};
+
 int GNetAllowConnectionSkipping = 0;
 
 static FAutoConsoleVariableRef CVarNetRemoteRoleOnCloseTest(
@@ -1703,6 +1738,107 @@ static FAutoConsoleVariableRef CVarNetRemoteRoleOnCloseTest(
 	ECVF_Default
 	);
 
+int32 GNetUseRelevancyGrid = 1;
+
+static FAutoConsoleVariableRef CVarNetUseRelevancyGrid(
+	TEXT("net.UseRelevancyGrid"),
+	GNetUseRelevancyGrid,
+	TEXT("If true, connections only check the relevancy of the considered actors near their viewers, found with a grid built every update.\n")
+	TEXT("Only used with distance based relevancy. Turn it off for games with actors that are relevant beyond their NetCullDistance for reasons other than ownership."),
+	ECVF_Default
+	);
+
+float GNetRelevancyGridCellSize = 10000.f;
+
+static FAutoConsoleVariableRef CVarNetRelevancyGridCellSize(
+	TEXT("net.RelevancyGridCellSize"),
+	GNetRelevancyGridCellSize,
+	TEXT("Width of a relevancy grid cell."),
+	ECVF_Default
+	);
+
+float GNetRelevancyGridMaxCullDistance = 30000.f;
+
+static FAutoConsoleVariableRef CVarNetRelevancyGridMaxCullDistance(
+	TEXT("net.RelevancyGridMaxCullDistance"),
+	GNetRelevancyGridMaxCullDistance,
+	TEXT("Actors with a larger NetCullDistance are checked by every connection rather than put in the relevancy grid."),
+	ECVF_Default
+	);
+
+int32 GNetParallelConnectionGather = 1;
+
+static FAutoConsoleVariableRef CVarNetParallelConnectionGather(
+	TEXT("net.ParallelConnectionGather"),
+	GNetParallelConnectionGather,
+	TEXT("If true, the actors each connection should consider are gathered in parallel across connections before they are prioritized and replicated."),
+	ECVF_Default
+	);
+
+int32 GNetParallelConnectionPrioritize = 0;
+
+static FAutoConsoleVariableRef CVarNetParallelConnectionPrioritize(
+	TEXT("net.ParallelConnectionPrioritize"),
+	GNetParallelConnectionPrioritize,
+	TEXT("If true, the considered actors of each connection are checked for relevancy and prioritized in parallel across connections.\n")
+	TEXT("IsNetRelevantFor, GetNetPriority and GetNetDormancy are then called from task threads and AWorldSettings::ReplicationViewers is not set to the connection being checked.\n")
+	TEXT("Only turn it on if the game's overrides of those functions read nothing but actor state."),
+	ECVF_Default
+	);
+
+/**
+ * Returns whether an actor can only be relevant to viewers within its NetCullDistance, or to viewers it is owned by, instigated by or
+ * controlled by (see GetRelevancyOwners). Those are the actors the relevancy grid can leave out for connections with no viewer nearby.
+ */
+static bool IsRelevancySpatial(AActor* Actor, float MaxCullDistanceSquared)
+{
+	if (Actor->bAlwaysRelevant || Actor->NetCullDistanceSquared > MaxCullDistanceSquared)
+	{
+		return false;
+	}
+	// actors that are relevant whenever their owner or what they are attached to is
+	if (Actor->bNetUseOwnerRelevancy && Actor->GetOwner())
+	{
+		return false;
+	}
+	USceneComponent* RootComponent = Actor->GetRootComponent();
+	if (!RootComponent || RootComponent->AttachParent)
+	{
+		return false;
+	}
+	APawn* Pawn = Cast<APawn>(Actor);
+	if (Pawn)
+	{
+		UPrimitiveComponent* MovementBase = Pawn->GetMovementBase();
+		AActor* BaseActor = MovementBase ? MovementBase->GetOwner() : NULL;
+		if (BaseActor && (Cast<USkeletalMeshComponent>(MovementBase) || BaseActor == Pawn->GetOwner()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Collects the viewers a spatial actor is relevant to whatever the distance: itself, its owners, its instigator and, for pawns, their controller.
+ * Pawns are also relevant to viewers they are based on and viewers based on them, but those are always close by.
+ */
+static void GetRelevancyOwners(AActor* Actor, TArray<AActor*, TInlineAllocator<8> >& OutOwners)
+{
+	for (AActor* Owner = Actor; Owner; Owner = Owner->GetOwner())
+	{
+		OutOwners.AddUnique(Owner);
+	}
+	if (Actor->Instigator)
+	{
+		OutOwners.AddUnique(Actor->Instigator);
+	}
+	APawn* Pawn = Cast<APawn>(Actor);
+	if (Pawn && Pawn->Controller)
+	{
+		OutOwners.AddUnique(Pawn->Controller);
+	}
+}
 
 int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 {
@@ -2005,263 +2141,438 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 	SET_DWORD_STAT(STAT_NumInitiallyDormantActors,NumInitiallyDormant);
 	SET_DWORD_STAT(STAT_NumConsideredActors,ConsiderList.Num());
 
-	for( int32 i=0; i < ClientConnections.Num(); i++ )
+	// Split the considered actors into the ones every connection checks, and the ones only checked by connections that have a viewer
+	// nearby, that own them, or that already have a channel for them.
+	const bool bUseRelevancyGrid = GNetUseRelevancyGrid && GetDefault<AGameNetworkManager>()->bUseDistanceBasedRelevancy;
+	TArray<int32> NonSpatialConsiderIndices;
+	TMap<AActor*, int32> SpatialConsiderIndices;
+	TMultiMap<AActor*, int32> SpatialConsiderIndicesByOwner;
+	if (bUseRelevancyGrid)
 	{
-		UNetConnection* Connection = ClientConnections[i];
-		check(Connection);
-		int32 ActorUpdatesThisConnection = 0;
-		int32 ActorUpdatesThisConnectionSent = 0;
+		SCOPE_CYCLE_COUNTER(STAT_NetBuildRelevancyGridTime);
 
-		// if this client shouldn't be ticked this frame
-		if (i >= NumClientsToTick)
+		if (!RelevancyGrid.IsValid())
 		{
-			//UE_LOG(LogNet, Log, TEXT("skipping update to %s"),*Connection->GetName());
-			// then mark each considered actor as bPendingNetUpdate so that they will be considered again the next frame when the connection is actually ticked
-			for (int32 ConsiderIdx = 0; ConsiderIdx < ConsiderList.Num(); ConsiderIdx++)
+			RelevancyGrid = MakeShareable(new FNetRelevancyGrid());
+		}
+		// every actor in the grid is within its NetCullDistance of the viewers it is relevant to by distance, so that is as far as connections need to look
+		const float MaxCullDistance = FMath::Max(GNetRelevancyGridMaxCullDistance, 0.f);
+		RelevancyGrid->Reset(FMath::Max(GNetRelevancyGridCellSize, 1.f), MaxCullDistance);
+
+		TArray<AActor*, TInlineAllocator<8> > RelevancyOwners;
+		for (int32 ConsiderIdx = 0; ConsiderIdx < ConsiderList.Num(); ConsiderIdx++)
+		{
+			AActor* Actor = ConsiderList[ConsiderIdx];
+			if (IsRelevancySpatial(Actor, FMath::Square(MaxCullDistance)))
 			{
-				AActor *Actor = ConsiderList[ConsiderIdx];
-				// if the actor hasn't already been flagged by another connection,
-				if (Actor != NULL && !Actor->bPendingNetUpdate)
+				RelevancyGrid->Add(ConsiderIdx, Actor->GetActorLocation());
+				SpatialConsiderIndices.Add(Actor, ConsiderIdx);
+
+				RelevancyOwners.Reset();
+				GetRelevancyOwners(Actor, RelevancyOwners);
+				for (int32 OwnerIdx = 0; OwnerIdx < RelevancyOwners.Num(); OwnerIdx++)
 				{
-					// find the channel
-					UActorChannel *Channel = Connection->ActorChannels.FindRef(Actor);
-					// and if the channel last update time doesn't match the last net update time for the actor
-					if (Channel != NULL && Channel->LastUpdateTime < Actor->LastNetUpdateTime)
-					{
-						//UE_LOG(LogNet, Log, TEXT("flagging %s for a future update"),*Actor->GetName());
-						// flag it for a pending update
-						Actor->bPendingNetUpdate = true;
-					}
+					SpatialConsiderIndicesByOwner.Add(RelevancyOwners[OwnerIdx], ConsiderIdx);
 				}
 			}
-			// clear the time sensitive flag to avoid sending an extra packet to this connection
-			Connection->TimeSensitive = false;
+			else
+			{
+				NonSpatialConsiderIndices.Add(ConsiderIdx);
+			}
+		}
+	}
 
-			Connection->OwnedConsiderList.Empty();
+	// Work out the viewers of every connection ticked this frame
+	TArray< TArray<FNetViewer> > ConnectionViewerLists;
+	ConnectionViewerLists.Empty(ClientConnections.Num());
+	for (int32 ConnIdx = 0; ConnIdx < ClientConnections.Num(); ConnIdx++)
+	{
+		UNetConnection* Connection = ClientConnections[ConnIdx];
+		TArray<FNetViewer>& Viewers = *new(ConnectionViewerLists) TArray<FNetViewer>();
+		if (ConnIdx < NumClientsToTick && Connection->Viewer)
+		{
+			Connection->TickCount++;
+			new(Viewers) FNetViewer(Connection, DeltaSeconds);
 			for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
 			{
-				if (Connection->Children[ChildIdx])
+				if (Connection->Children[ChildIdx]->Viewer != NULL)
 				{
-					Connection->Children[ChildIdx]->OwnedConsiderList.Empty();
+					new(Viewers) FNetViewer(Connection->Children[ChildIdx], DeltaSeconds);
 				}
 			}
 		}
-		else if (Connection->Viewer)
-		{
-			int32 j;
-			int32 ConsiderCount	= 0;
-			int32 DeletedCount = 0;
-			
-			int32 NetRelevantCount = 0;
-			FActorPriority* PriorityList = NULL;
-			FActorPriority** PriorityActors = NULL;
-
-			TArray<FNetViewer>& ConnectionViewers = WorldSettings->ReplicationViewers;
+	}
 
-			float PruneActors = 0.f;
-			CLOCK_CYCLES(PruneActors);
-			FMemMark RelevantActorMark(FMemStack::Get());
+	// Narrow the considered actors down to the ones that may be relevant to each connection, leaving out the ones that are dormant on it.
+	// This only reads the grid, the lookup maps and the channel and dormancy maps of the connection, so connections are gathered in parallel.
+	// Replicating the actors changes state shared between connections (channels, the package map and the change trackers) and stays serial below.
+	static const auto DormancyEnableCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyEnable"));
+	static const auto DormancyValidateCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyValidate"));
+	const bool bDormancyEnabled = !DormancyEnableCVar || DormancyEnableCVar->GetValueOnGameThread() == 1;
+	const bool bValidateDormantActors = DormancyValidateCVar && DormancyValidateCVar->GetValueOnGameThread() == 2;
+	const bool bSkipDormantActors = bDormancyEnabled && !bValidateDormantActors;
+	TArray< TBitArray<> > ConsiderMasks;
+	ConsiderMasks.Empty(ClientConnections.Num());
+	for (int32 ConnIdx = 0; ConnIdx < ClientConnections.Num(); ConnIdx++)
+	{
+		new(ConsiderMasks) TBitArray<>();
+	}
+	{
+		SCOPE_CYCLE_COUNTER(STAT_NetGatherConnectionActorsTime);
 
-			// Prioritize actors for this connection
+		ParallelFor(ClientConnections.Num(), [&](int32 ConnIdx)
+		{
+			const TArray<FNetViewer>& Viewers = ConnectionViewerLists[ConnIdx];
+			if (Viewers.Num() == 0)
 			{
-				SCOPE_CYCLE_COUNTER(STAT_NetPrioritizeActorsTime);
+				return;
+			}
 
-				// send ClientAdjustment if necessary
-				// we do this here so that we send a maximum of one per packet to that client; there is no value in stacking additional corrections
-				if (Connection->PlayerController)
+			UNetConnection* Connection = ClientConnections[ConnIdx];
+			TBitArray<>& ConsiderMask = ConsiderMasks[ConnIdx];
+			if (bUseRelevancyGrid)
+			{
+				ConsiderMask.Init(false, ConsiderList.Num());
+				for (int32 NonSpatialIdx = 0; NonSpatialIdx < NonSpatialConsiderIndices.Num(); NonSpatialIdx++)
 				{
-					Connection->PlayerController->SendClientAdjustment();
+					ConsiderMask[NonSpatialConsiderIndices[NonSpatialIdx]] = true;
 				}
-				
-				for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+				for (int32 ViewerIdx = 0; ViewerIdx < Viewers.Num(); ViewerIdx++)
 				{
-					if (Connection->Children[ChildIdx]->PlayerController != NULL)
+					const FNetViewer& NetViewer = Viewers[ViewerIdx];
+					RelevancyGrid->MarkActorsNear(NetViewer.ViewLocation, ConsiderMask);
+					for (TMultiMap<AActor*, int32>::TConstKeyIterator It(SpatialConsiderIndicesByOwner, NetViewer.InViewer); It; ++It)
+					{
+						ConsiderMask[It.Value()] = true;
+					}
+					for (TMultiMap<AActor*, int32>::TConstKeyIterator It(SpatialConsiderIndicesByOwner, NetViewer.Viewer); It; ++It)
 					{
-						Connection->Children[ChildIdx]->PlayerController->SendClientAdjustment();
+						ConsiderMask[It.Value()] = true;
 					}
 				}
-
-				// Get list of visible/relevant actors.
-				
-				NetTag++;
-				Connection->TickCount++;
-
-				// Set up to skip all sent temporary actors
-				for( j=0; j<Connection->SentTemporaries.Num(); j++ )
+				// actors with a channel are considered whether or not they are still relevant, so that the channel is updated or closed
+				for (auto It = Connection->ActorChannels.CreateConstIterator(); It; ++It)
 				{
-					Connection->SentTemporaries[j]->NetTag = NetTag;
+					const int32* ConsiderIdx = SpatialConsiderIndices.Find(It.Key().Get());
+					if (ConsiderIdx)
+					{
+						ConsiderMask[*ConsiderIdx] = true;
+					}
 				}
+			}
+			else
+			{
+				ConsiderMask.Init(true, ConsiderList.Num());
+			}
 
-				// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
-				ConnectionViewers.Reset();
-				new(ConnectionViewers) FNetViewer(Connection, DeltaSeconds);
-				for (j = 0; j < Connection->Children.Num(); j++)
+			if (bSkipDormantActors && Connection->DormantActors.Num() > 0)
+			{
+				for (int32 ConsiderIdx = 0; ConsiderIdx < ConsiderMask.Num(); ConsiderIdx++)
 				{
-					if (Connection->Children[j]->Viewer != NULL)
+					if (ConsiderMask[ConsiderIdx] && Connection->DormantActors.Contains(ConsiderList[ConsiderIdx]))
 					{
-						new(ConnectionViewers) FNetViewer(Connection->Children[j], DeltaSeconds);
+						ConsiderMask[ConsiderIdx] = false;
 					}
 				}
+			}
+		}, GNetParallelConnectionGather ? EParallelForFlags::AllowNamedThreadCaller : EParallelForFlags::ForceSingleThread);
+	}
 
-				// Make list of all actors to consider.
-				check(World == Connection->OwningActor->GetWorld());
-				
-				NetRelevantCount = World->GetNetRelevantActorCount() + DestroyedStartupOrDormantActors.Num();
-				PriorityList = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority;
-				PriorityActors = new(FMemStack::Get(),NetRelevantCount+2)FActorPriority*;
+	// Check the relevancy of the considered actors and prioritize them for every connection ticked this frame, in parallel across
+	// connections. Each connection only reads the actors and its own channels, and keeps the channels that should go dormant in its own
+	// result, which the serial loop below applies in connection order. Client adjustments go out through the channels, so they are sent first.
+	AGameMode const* const GameMode = World->GetAuthGameMode();
+	for (int32 ConnIdx = 0; ConnIdx < ClientConnections.Num(); ConnIdx++)
+	{
+		if (ConnectionViewerLists[ConnIdx].Num() == 0)
+		{
+			continue;
+		}
 
-				// determine whether we should priority sort the list of relevant actors based on the saturation/bandwidth of the current connection
-				//@note - if the server is currently CPU saturated then do not sort until framerate improves
-				check(World == Connection->Viewer->GetWorld());
-				AGameMode const* const GameMode = World->GetAuthGameMode();
-				bool bLowNetBandwidth = !bCPUSaturated && (Connection->CurrentNetSpeed / float(GameMode->NumPlayers + GameMode->NumBots) < 500.f );
+		// send ClientAdjustment if necessary
+		// we do this here so that we send a maximum of one per packet to that client; there is no value in stacking additional corrections
+		UNetConnection* Connection = ClientConnections[ConnIdx];
+		if (Connection->PlayerController)
+		{
+			Connection->PlayerController->SendClientAdjustment();
+		}
 
-				for( j=0; j<ConsiderList.Num(); j++ )
-				{
-					AActor* Actor = ConsiderList[j];
-					UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+		for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+		{
+			if (Connection->Children[ChildIdx]->PlayerController != NULL)
+			{
+				Connection->Children[ChildIdx]->PlayerController->SendClientAdjustment();
+			}
+		}
+	}
 
-					// Skip Actor if dormant
-					static const auto CVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyEnable"));
-					if ( !CVar || CVar->GetValueOnGameThread() == 1 )
-					{
-						// If actor is already dormant on this channel, then skip replication entirely
-						if ( Connection->DormantActors.Contains( Actor ) )
-						{
-							// net.DormancyValidate can be set to 2 to validate dormant actor properties on every replicate
-							// (this could be moved to be done every tick instead of every net update if necessary, but seems excessive)
-							static const auto ValidateCVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.DormancyValidate"));
-							if ( ValidateCVar && ValidateCVar->GetValueOnGameThread() == 2 )
-							{
-								TSharedRef< FObjectReplicator > * Replicator = Connection->DormantReplicatorMap.Find( Actor );
+	// Overrides of IsNetRelevantFor may look at the replication viewers, which are shared by all connections, so they are only set to the
+	// connection being prioritized when the connections are prioritized one at a time on this thread
+	const bool bParallelPrioritize = GNetParallelConnectionPrioritize != 0;
+	TArray<FConnectionPriorities> ConnectionPriorities;
+	ConnectionPriorities.Empty(ClientConnections.Num());
+	for (int32 ConnIdx = 0; ConnIdx < ClientConnections.Num(); ConnIdx++)
+	{
+		new(ConnectionPriorities) FConnectionPriorities();
+	}
+	{
+		SCOPE_CYCLE_COUNTER(STAT_NetPrioritizeActorsTime);
 
-								if ( Replicator != NULL )
-								{
-									Replicator->Get().ValidateAgainstState( Actor );
-								}
-							}
+		ParallelFor(ClientConnections.Num(), [&](int32 ConnIdx)
+		{
+			const TArray<FNetViewer>& Viewers = ConnectionViewerLists[ConnIdx];
+			if (Viewers.Num() == 0)
+			{
+				return;
+			}
 
-							continue;
-						}
+			UNetConnection* Connection = ClientConnections[ConnIdx];
+			FConnectionPriorities& Result = ConnectionPriorities[ConnIdx];
+			check(World == Connection->OwningActor->GetWorld());
+			check(World == Connection->Viewer->GetWorld());
 
-						// If actor might need to go dormant on this channel, then check
-						if (Actor->NetDormancy > DORM_Awake && Channel && !Channel->bPendingDormancy && !Channel->Dormant )
-						{
-							bool ShouldGoDormant = true;
-							if (Actor->NetDormancy == DORM_DormantPartial)
-							{
-								float Time  = Channel ? (Connection->Driver->Time - Channel->LastUpdateTime) : Connection->Driver->SpawnPrioritySeconds;
-								for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
-								{
-									if (!Actor->GetNetDormancy(ConnectionViewers[viewerIdx].ViewLocation, ConnectionViewers[viewerIdx].ViewDir, ConnectionViewers[viewerIdx].InViewer, Channel, Time, bLowNetBandwidth))
-									{
-										ShouldGoDormant = false;
-										break;
-									}
-								}
-							}
+			if (!bParallelPrioritize)
+			{
+				// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
+				WorldSettings->ReplicationViewers = Viewers;
+			}
 
-							if (ShouldGoDormant)
-							{
-								// Channel is marked to go dormant now once all properties have been replicated (but is not dormant yet)
-								Channel->StartBecomingDormant();
-							}
-						}
-					}
+			// determine whether we should priority sort the list of relevant actors based on the saturation/bandwidth of the current connection
+			//@note - if the server is currently CPU saturated then do not sort until framerate improves
+			const bool bLowNetBandwidth = !bCPUSaturated && (Connection->CurrentNetSpeed / float(GameMode->NumPlayers + GameMode->NumBots) < 500.f );
 
+			// Actors that must not be prioritized again for this connection: temporary actors it was already sent, and once the owned
+			// actors are added, everything prioritized so far
+			TSet<AActor*> SkippedActors;
+			for (int32 TempIdx = 0; TempIdx < Connection->SentTemporaries.Num(); TempIdx++)
+			{
+				SkippedActors.Add(Connection->SentTemporaries[TempIdx]);
+			}
 
-					// Skip actor if not relevant and theres no channel already.
-					// Historically Relevancy checks were deferred until after prioritization because they were expensive (line traces).
-					// Relevancy is now cheap and we are dealing with larger lists of considered actors, so we want to keep the list of
-					// prioritized actors low.
-					if (!Channel)
+			const TBitArray<>& ConsiderMask = ConsiderMasks[ConnIdx];
+			for (TConstSetBitIterator<> ConsiderIt(ConsiderMask); ConsiderIt; ++ConsiderIt)
+			{
+				AActor* Actor = ConsiderList[ConsiderIt.GetIndex()];
+				UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+				Result.NumCandidates++;
+
+				// Skip Actor if dormant
+				if (bDormancyEnabled)
+				{
+					// If actor is already dormant on this channel, then skip replication entirely
+					if ( Connection->DormantActors.Contains( Actor ) )
 					{
-						if ( !IsLevelInitializedForActor(Actor, Connection) )
+						// net.DormancyValidate can be set to 2 to validate dormant actor properties on every replicate
+						// (this could be moved to be done every tick instead of every net update if necessary, but seems excessive)
+						if (bValidateDormantActors)
 						{
-							// If the level this actor belongs to isn't loaded on client, don't bother sending
-							continue;
+							Result.DormantActorsToValidate.Add(Actor);
 						}
-						bool Relevant = false;
-						for (int32 viewerIdx = 0; viewerIdx < ConnectionViewers.Num(); viewerIdx++)
+						continue;
+					}
+
+					// If actor might need to go dormant on this channel, then check
+					if (Actor->NetDormancy > DORM_Awake && Channel && !Channel->bPendingDormancy && !Channel->Dormant )
+					{
+						bool ShouldGoDormant = true;
+						if (Actor->NetDormancy == DORM_DormantPartial)
 						{
-							if(Actor->IsNetRelevantFor(ConnectionViewers[viewerIdx].InViewer, ConnectionViewers[viewerIdx].Viewer, ConnectionViewers[viewerIdx].ViewLocation))
+							float Time = Connection->Driver->Time - Channel->LastUpdateTime;
+							for (int32 viewerIdx = 0; viewerIdx < Viewers.Num(); viewerIdx++)
 							{
-								Relevant = true;
-								break;
+								if (!Actor->GetNetDormancy(Viewers[viewerIdx].ViewLocation, Viewers[viewerIdx].ViewDir, Viewers[viewerIdx].InViewer, Channel, Time, bLowNetBandwidth))
+								{
+									ShouldGoDormant = false;
+									break;
+								}
 							}
 						}
-						if (!Relevant)
+
+						if (ShouldGoDormant)
 						{
-							continue;
+							// Channel is marked to go dormant once all properties have been replicated, after prioritization
+							Result.ChannelsToMakeDormant.Add(Channel);
 						}
 					}
+				}
 
-					if( Actor->NetTag!=NetTag ) // Do not consider actor for this connection if this connection has it marked dormant
+				// Skip actor if not relevant and theres no channel already.
+				// Historically Relevancy checks were deferred until after prioritization because they were expensive (line traces).
+				// Relevancy is now cheap and we are dealing with larger lists of considered actors, so we want to keep the list of
+				// prioritized actors low.
+				if (!Channel)
+				{
+					if ( !IsLevelInitializedForActor(Actor, Connection) )
 					{
-						UE_LOG(LogNetTraffic, Log, TEXT("Consider %s alwaysrelevant %d frequency %f "),*Actor->GetName(), Actor->bAlwaysRelevant, Actor->NetUpdateFrequency);
-						Actor->NetTag                 = NetTag;
-						PriorityList  [ConsiderCount] = FActorPriority(Connection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
-						PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-						ConsiderCount++;
-
-						if (DebugRelevantActors)
+						// If the level this actor belongs to isn't loaded on client, don't bother sending
+						continue;
+					}
+					bool Relevant = false;
+					for (int32 viewerIdx = 0; viewerIdx < Viewers.Num(); viewerIdx++)
+					{
+						if(Actor->IsNetRelevantFor(Viewers[viewerIdx].InViewer, Viewers[viewerIdx].Viewer, Viewers[viewerIdx].ViewLocation))
 						{
-							LastPrioritizedActors.Add(Actor);
+							Relevant = true;
+							break;
 						}
 					}
+					if (!Relevant)
+					{
+						continue;
+					}
 				}
 
-				// Add in deleted actors
-				for (auto It = Connection->DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
+				// the considered actors are unique, only the temporaries have to be skipped here
+				if (SkippedActors.Num() == 0 || !SkippedActors.Contains(Actor))
 				{
-					FActorDestructionInfo &DInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
-					PriorityList  [ConsiderCount] = FActorPriority(Connection, &DInfo, ConnectionViewers);
-					PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-					ConsiderCount++;
-					DeletedCount++;
+					UE_LOG(LogNetTraffic, Log, TEXT("Consider %s alwaysrelevant %d frequency %f "),*Actor->GetName(), Actor->bAlwaysRelevant, Actor->NetUpdateFrequency);
+					new(Result.PriorityList) FActorPriority(Connection, Channel, Actor, Viewers, bLowNetBandwidth);
 				}
+			}
 
-				UNetConnection* NextConnection = Connection;
-				int32 ChildIndex = 0;
-				while (NextConnection != NULL)
+			// Add in deleted actors
+			for (auto It = Connection->DestroyedStartupOrDormantActors.CreateIterator(); It; ++It)
+			{
+				FActorDestructionInfo &DInfo = DestroyedStartupOrDormantActors.FindChecked(*It);
+				new(Result.PriorityList) FActorPriority(Connection, &DInfo, Viewers);
+				Result.DeletedCount++;
+			}
+
+			UNetConnection* NextConnection = Connection;
+			int32 ChildIndex = 0;
+			bool bSkippingPrioritized = false;
+			while (NextConnection != NULL)
+			{
+				if (NextConnection->OwnedConsiderList.Num() > 0 && !bSkippingPrioritized)
 				{
-					for (int32 j = 0; j < NextConnection->OwnedConsiderList.Num(); j++)
+					for (int32 PriorityIdx = 0; PriorityIdx < Result.PriorityList.Num(); PriorityIdx++)
 					{
-						AActor* Actor = NextConnection->OwnedConsiderList[j];
-						UE_LOG(LogNetTraffic, Log, TEXT("Consider owned %s always relevant %d frequency %f  "),*Actor->GetName(), Actor->bAlwaysRelevant,Actor->NetUpdateFrequency);
-						if (Actor->NetTag != NetTag)
+						if (Result.PriorityList[PriorityIdx].Actor != NULL)
 						{
-							UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
-							Actor->NetTag                 = NetTag;
-							PriorityList  [ConsiderCount] = FActorPriority(NextConnection, Channel, Actor, ConnectionViewers, bLowNetBandwidth);
-							PriorityActors[ConsiderCount] = PriorityList + ConsiderCount;
-							ConsiderCount++;
-
-							if (DebugRelevantActors)
-							{
-								LastPrioritizedActors.Add(Actor);
-							}
+							SkippedActors.Add(Result.PriorityList[PriorityIdx].Actor);
 						}
 					}
-					NextConnection->OwnedConsiderList.Empty();
+					bSkippingPrioritized = true;
+				}
 
-					NextConnection = (ChildIndex < Connection->Children.Num()) ? Connection->Children[ChildIndex++] : NULL;
+				for (int32 j = 0; j < NextConnection->OwnedConsiderList.Num(); j++)
+				{
+					AActor* Actor = NextConnection->OwnedConsiderList[j];
+					UE_LOG(LogNetTraffic, Log, TEXT("Consider owned %s always relevant %d frequency %f  "),*Actor->GetName(), Actor->bAlwaysRelevant,Actor->NetUpdateFrequency);
+					if (!SkippedActors.Contains(Actor))
+					{
+						SkippedActors.Add(Actor);
+						UActorChannel* Channel = Connection->ActorChannels.FindRef(Actor);
+						new(Result.PriorityList) FActorPriority(NextConnection, Channel, Actor, Viewers, bLowNetBandwidth);
+					}
 				}
+				NextConnection->OwnedConsiderList.Empty();
 
-				SET_DWORD_STAT(STAT_PrioritizedActors,ConsiderCount);
-				SET_DWORD_STAT(STAT_NumRelevantDeletedActors,DeletedCount);
+				NextConnection = (ChildIndex < Connection->Children.Num()) ? Connection->Children[ChildIndex++] : NULL;
+			}
 
-				// Sort by priority
-				struct FCompareFActorPriority
+			// Sort by priority
+			Result.PriorityActors.Empty(Result.PriorityList.Num());
+			for (int32 PriorityIdx = 0; PriorityIdx < Result.PriorityList.Num(); PriorityIdx++)
+			{
+				Result.PriorityActors.Add(&Result.PriorityList[PriorityIdx]);
+			}
+			Sort( Result.PriorityActors.GetTypedData(), Result.PriorityActors.Num(), FCompareFActorPriority() );
+		}, bParallelPrioritize ? EParallelForFlags::AllowNamedThreadCaller : EParallelForFlags::ForceSingleThread);
+	}
+
+	for( int32 i=0; i < ClientConnections.Num(); i++ )
+	{
+		UNetConnection* Connection = ClientConnections[i];
+		check(Connection);
+		int32 ActorUpdatesThisConnection = 0;
+		int32 ActorUpdatesThisConnectionSent = 0;
+
+		// if this client shouldn't be ticked this frame
+		if (i >= NumClientsToTick)
+		{
+			//UE_LOG(LogNet, Log, TEXT("skipping update to %s"),*Connection->GetName());
+			// then mark each considered actor as bPendingNetUpdate so that they will be considered again the next frame when the connection is actually ticked
+			for (int32 ConsiderIdx = 0; ConsiderIdx < ConsiderList.Num(); ConsiderIdx++)
+			{
+				AActor *Actor = ConsiderList[ConsiderIdx];
+				// if the actor hasn't already been flagged by another connection,
+				if (Actor != NULL && !Actor->bPendingNetUpdate)
 				{
-					FORCEINLINE bool operator()( const FActorPriority& A, const FActorPriority& B ) const
+					// find the channel
+					UActorChannel *Channel = Connection->ActorChannels.FindRef(Actor);
+					// and if the channel last update time doesn't match the last net update time for the actor
+					if (Channel != NULL && Channel->LastUpdateTime < Actor->LastNetUpdateTime)
 					{
-						return B.Priority < A.Priority;
+						//UE_LOG(LogNet, Log, TEXT("flagging %s for a future update"),*Actor->GetName());
+						// flag it for a pending update
+						Actor->bPendingNetUpdate = true;
 					}
-				};
-				Sort( PriorityActors, ConsiderCount, FCompareFActorPriority() );
+				}
+			}
+			// clear the time sensitive flag to avoid sending an extra packet to this connection
+			Connection->TimeSensitive = false;
 
-			} // END PRIORITIZE
+			Connection->OwnedConsiderList.Empty();
+			for (int32 ChildIdx = 0; ChildIdx < Connection->Children.Num(); ChildIdx++)
+			{
+				if (Connection->Children[ChildIdx])
+				{
+					Connection->Children[ChildIdx]->OwnedConsiderList.Empty();
+				}
+			}
+		}
+		else if (Connection->Viewer)
+		{
+			int32 j;
+			FConnectionPriorities& Priorities = ConnectionPriorities[i];
+			const int32 ConsiderCount = Priorities.PriorityActors.Num();
+			const int32 DeletedCount = Priorities.DeletedCount;
+			const int32 NetRelevantCount = World->GetNetRelevantActorCount() + DestroyedStartupOrDormantActors.Num();
+			FActorPriority** PriorityActors = Priorities.PriorityActors.GetTypedData();
+
+			TArray<FNetViewer>& ConnectionViewers = WorldSettings->ReplicationViewers;
+
+			float PruneActors = 0.f;
+			CLOCK_CYCLES(PruneActors);
+
+			// Apply what prioritizing found for this connection
+			{
+				// set the replication viewers to the current connection (and children) so that actors can determine who is currently being considered for relevancy checks
+				ConnectionViewers = ConnectionViewerLists[i];
+
+				for (int32 ValidateIdx = 0; ValidateIdx < Priorities.DormantActorsToValidate.Num(); ValidateIdx++)
+				{
+					AActor* Actor = Priorities.DormantActorsToValidate[ValidateIdx];
+					TSharedRef< FObjectReplicator > * Replicator = Connection->DormantReplicatorMap.Find( Actor );
+
+					if ( Replicator != NULL )
+					{
+						Replicator->Get().ValidateAgainstState( Actor );
+					}
+				}
+
+				for (int32 DormantIdx = 0; DormantIdx < Priorities.ChannelsToMakeDormant.Num(); DormantIdx++)
+				{
+					// Channel is marked to go dormant now once all properties have been replicated (but is not dormant yet)
+					Priorities.ChannelsToMakeDormant[DormantIdx]->StartBecomingDormant();
+				}
+
+				if (DebugRelevantActors)
+				{
+					for (int32 PriorityIdx = 0; PriorityIdx < Priorities.PriorityList.Num(); PriorityIdx++)
+					{
+						if (Priorities.PriorityList[PriorityIdx].Actor != NULL)
+						{
+							LastPrioritizedActors.Add(Priorities.PriorityList[PriorityIdx].Actor);
+						}
+					}
+				}
+
+				INC_DWORD_STAT_BY(STAT_NumRelevancyGridCandidates, Priorities.NumCandidates);
+				SET_DWORD_STAT(STAT_PrioritizedActors,ConsiderCount);
+				SET_DWORD_STAT(STAT_NumRelevantDeletedActors,DeletedCount);
+			}
 
 			// Update all relevant actors in sorted order.
 			bool bNewSaturated = !Connection->IsNetReady(0);
@@ -2471,7 +2782,6 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 					}
 				}
 			}
-			RelevantActorMark.Pop();
 			UE_LOG(LogNetTraffic, Log, TEXT("Potential %04i ConsiderList %03i ConsiderCount %03i Prune=%01.4f "),NetRelevantCount, 
 						ConsiderList.Num(), ConsiderCount, FPlatformTime::ToMilliseconds(PruneActors) );
 
@@ -2666,6 +2976,11 @@ void UNetDriver::AddClientConnection(UNetConnection * NewConnection)
 	}
 }
 
+void UNetDriver::RemoveClientConnection(UNetConnection * ClientConnectionToRemove)
+{
+	verify(ClientConnections.Remove(ClientConnectionToRemove) == 1);
+}
+
 bool UNetDriver::VerifyPackageInfo(FPackageInfo& Info)
 {
 	check(IsServer());
@@ -3040,3 +3355,123 @@ static bool NetDriverExec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar)
 
 /** Our entry point for all net driver related exec routing */
 FStaticSelfRegisteringExec NetDriverExecRegistration(NetDriverExec);
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Exec handler for the relevancy benchmark. Synthetic clients look for relevant actors among synthetic actors, once by checking every
+ * actor and once through the relevancy grid, the way ServerReplicateActors does for each connection. Needs no world or sockets, so it
+ * runs on a headless server.
+ */
+static class FNetRelevancyBenchExec : private FSelfRegisteringExec
+{
+	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) OVERRIDE
+	{
+		if (FParse::Command(&Cmd, TEXT("NETRELEVANCYBENCH")))
+		{
+			int32 NumActors = 20000;
+			int32 NumConnections = 100;
+			int32 NumRuns = 10;
+			float WorldSize = 400000.f;
+			FParse::Value(Cmd, TEXT("ACTORS="), NumActors);
+			FParse::Value(Cmd, TEXT("CONNECTIONS="), NumConnections);
+			FParse::Value(Cmd, TEXT("RUNS="), NumRuns);
+			FParse::Value(Cmd, TEXT("SIZE="), WorldSize);
+			NumActors = FMath::Max(NumActors, 1);
+			NumConnections = FMath::Max(NumConnections, 1);
+			NumRuns = FMath::Max(NumRuns, 1);
+
+			// Actors with the default NetCullDistance, a few of them always relevant, and clients spread over the same area.
+			const float NetCullDistanceSquared = FMath::Square(15000.f);
+			FRandomStream RandomStream(0x5eed);
+			TArray<FVector> ActorLocations;
+			TArray<bool> ActorAlwaysRelevant;
+			for (int32 ActorIdx = 0; ActorIdx < NumActors; ActorIdx++)
+			{
+				ActorLocations.Add(FVector(RandomStream.FRandRange(0.f, WorldSize), RandomStream.FRandRange(0.f, WorldSize), RandomStream.FRandRange(-2000.f, 2000.f)));
+				ActorAlwaysRelevant.Add(RandomStream.FRand() < 0.02f);
+			}
+			TArray<FVector> ViewLocations;
+			for (int32 ConnIdx = 0; ConnIdx < NumConnections; ConnIdx++)
+			{
+				ViewLocations.Add(FVector(RandomStream.FRandRange(0.f, WorldSize), RandomStream.FRandRange(0.f, WorldSize), 200.f));
+			}
+
+			FNetRelevancyGrid Grid;
+			TArray<int32> NonSpatialIndices;
+			TBitArray<> ConsiderMask;
+			double BruteForceTime = 0.0;
+			double BuildTime = 0.0;
+			double GridTime = 0.0;
+			int64 NumBruteForceRelevant = 0;
+			int64 NumGridRelevant = 0;
+			int64 NumCandidates = 0;
+			for (int32 Run = 0; Run < NumRuns; Run++)
+			{
+				double StartTime = FPlatformTime::Seconds();
+				for (int32 ConnIdx = 0; ConnIdx < NumConnections; ConnIdx++)
+				{
+					for (int32 ActorIdx = 0; ActorIdx < NumActors; ActorIdx++)
+					{
+						if (ActorAlwaysRelevant[ActorIdx] || (ViewLocations[ConnIdx] - ActorLocations[ActorIdx]).SizeSquared() < NetCullDistanceSquared)
+						{
+							NumBruteForceRelevant++;
+						}
+					}
+				}
+				BruteForceTime += FPlatformTime::Seconds() - StartTime;
+
+				StartTime = FPlatformTime::Seconds();
+				Grid.Reset(FMath::Max(GNetRelevancyGridCellSize, 1.f), FMath::Sqrt(NetCullDistanceSquared));
+				NonSpatialIndices.Reset();
+				for (int32 ActorIdx = 0; ActorIdx < NumActors; ActorIdx++)
+				{
+					if (ActorAlwaysRelevant[ActorIdx])
+					{
+						NonSpatialIndices.Add(ActorIdx);
+					}
+					else
+					{
+						Grid.Add(ActorIdx, ActorLocations[ActorIdx]);
+					}
+				}
+				BuildTime += FPlatformTime::Seconds() - StartTime;
+
+				StartTime = FPlatformTime::Seconds();
+				for (int32 ConnIdx = 0; ConnIdx < NumConnections; ConnIdx++)
+				{
+					ConsiderMask.Init(false, NumActors);
+					for (int32 NonSpatialIdx = 0; NonSpatialIdx < NonSpatialIndices.Num(); NonSpatialIdx++)
+					{
+						ConsiderMask[NonSpatialIndices[NonSpatialIdx]] = true;
+					}
+					Grid.MarkActorsNear(ViewLocations[ConnIdx], ConsiderMask);
+					for (TConstSetBitIterator<> It(ConsiderMask); It; ++It)
+					{
+						const int32 ActorIdx = It.GetIndex();
+						NumCandidates++;
+						if (ActorAlwaysRelevant[ActorIdx] || (ViewLocations[ConnIdx] - ActorLocations[ActorIdx]).SizeSquared() < NetCullDistanceSquared)
+						{
+							NumGridRelevant++;
+						}
+					}
+				}
+				GridTime += FPlatformTime::Seconds() - StartTime;
+			}
+
+			const double NumConnectionUpdates = double(NumRuns) * NumConnections;
+			Ar.Logf(TEXT("Net relevancy bench: %d actors, %d connections, %d runs, %d grid cells"), NumActors, NumConnections, NumRuns, Grid.GetNumCells());
+			Ar.Logf(TEXT("  every actor:    %.2fus per connection, %.1f relevant"), BruteForceTime * 1000000.0 / NumConnectionUpdates, NumBruteForceRelevant / NumConnectionUpdates);
+			Ar.Logf(TEXT("  relevancy grid: %.2fus per connection, %.1f candidates, %.1f relevant, %.2fms to build"),
+				GridTime * 1000000.0 / NumConnectionUpdates, NumCandidates / NumConnectionUpdates, NumGridRelevant / NumConnectionUpdates, BuildTime * 1000.0 / NumRuns);
+			if (NumGridRelevant != NumBruteForceRelevant)
+			{
+				Ar.Logf(TEXT("  The relevancy grid missed %d relevant actors!"), int32(NumBruteForceRelevant - NumGridRelevant));
+			}
+			return true;
+		}
+		return false;
+	}
+} NetRelevancyBenchExec;
+
+#endif // !UE_BUILD_SHIPPING
@@ -1386,6 +1386,13 @@ void UPackageMapClient::ResetPackageMap()
 	PendingAckGUIDs.Empty();
 }
 
+void UPackageMapClient::ResetAckState()
+{
+	check( CurrentExportNetGUIDs.Num() == 0 );	// not in the middle of an export
+	NetGUIDAckStatus.Empty();
+	PendingAckGUIDs.Empty();
+}
+
 /**	
  *	Returns stats for NetGUID usage
  */
@@ -605,9 +605,16 @@ void UParticleLODLevel::UpdateModuleLists()
 	if (TypeDataModule /**&& (Level == 0)**/)
 	{
 		UParticleModuleTypeDataMesh* MeshTD = Cast<UParticleModuleTypeDataMesh>(TypeDataModule);
+		if (MeshTD && MeshTD->Mesh)
+		{
+			// Mesh particles always render LOD 0, so a mesh that streams its LODs has to keep all of them resident
+			MeshTD->Mesh->bForceAllLODsResident = true;
+		}
 		if (MeshTD
 			&& MeshTD->Mesh
-			&& MeshTD->Mesh->HasValidRenderData())
+			&& MeshTD->Mesh->RenderData
+			&& MeshTD->Mesh->RenderData->LODResources.Num() > 0
+			&& MeshTD->Mesh->RenderData->LODResources[0].Sections.Num() > 0)
 		{
 			UParticleSpriteEmitter* SpriteEmitter = Cast<UParticleSpriteEmitter>(GetOuter());
 			if (SpriteEmitter && (MeshTD->bOverrideMaterial == false))
@@ -65,6 +65,33 @@ void UPendingNetGame::InitNetDriver()
 	}
 }
 
+void UPendingNetGame::InitDemoNetDriver()
+{
+	if (GEngine->CreateNamedNetDriver(this, NAME_PendingNetDriver, NAME_DemoNetDriver))
+	{
+		NetDriver = GEngine->FindNamedNetDriver(this, NAME_PendingNetDriver);
+	}
+	check(NetDriver);
+
+	if( NetDriver->InitConnect( this, URL, ConnectionError ) )
+	{
+		// There is no server to welcome us, travel straight to the map the demo was recorded on
+		URL.Map = CastChecked<UDemoNetDriver>(NetDriver)->DemoMapName;
+		bSuccessfullyConnected = true;
+	}
+	else
+	{
+		UE_LOG(LogNet, Log, TEXT("error opening the demo"));
+		GEngine->DestroyNamedNetDriver(this, NetDriver->NetDriverName);
+		NetDriver = NULL;
+
+		if ( ConnectionError.Len() == 0 )
+		{
+			ConnectionError = NSLOCTEXT("Engine", "DemoInit", "Error opening demo.").ToString();
+		}
+	}
+}
+
 void UPendingNetGame::Serialize( FArchive& Ar )
 {
 	Super::Serialize(Ar);
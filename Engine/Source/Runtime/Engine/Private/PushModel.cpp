@@ -0,0 +1,59 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	PushModel.cpp: Dirty tracking for push based replicated properties.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/PushModel.h"
+
+/** Dirty state of every object that had a property marked, only accessed on the game thread */
+static TMap< TWeakObjectPtr< UObject >, FNetPushModel::FObjectState > GPushModelObjectStates;
+
+/** Drops the states of objects that were garbage collected without being removed */
+static void PurgeStalePushModelObjectStates()
+{
+	for ( auto It = GPushModelObjectStates.CreateIterator(); It; ++It )
+	{
+		if ( !It.Key().IsValid() )
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FNetPushModel::MarkPropertyDirty( UObject * Object, int32 RepIndex )
+{
+	check( IsInGameThread() );
+	check( Object != NULL && RepIndex >= 0 );
+
+	if ( GPushModelObjectStates.Num() == 0 )
+	{
+		static bool bRegisteredPurge = false;
+		if ( !bRegisteredPurge )
+		{
+			FCoreDelegates::PostGarbageCollect.AddStatic( &PurgeStalePushModelObjectStates );
+			bRegisteredPurge = true;
+		}
+	}
+
+	FObjectState & State = GPushModelObjectStates.FindOrAdd( Object );
+
+	if ( RepIndex >= State.PropertyDirtyCounts.Num() )
+	{
+		State.PropertyDirtyCounts.AddZeroed( RepIndex + 1 - State.PropertyDirtyCounts.Num() );
+	}
+
+	State.DirtyCount++;
+	State.PropertyDirtyCounts[RepIndex] = State.DirtyCount;
+}
+
+const FNetPushModel::FObjectState * FNetPushModel::FindObjectState( UObject * Object )
+{
+	return GPushModelObjectStates.Find( Object );
+}
+
+void FNetPushModel::RemoveObject( UObject * Object )
+{
+	GPushModelObjectStates.Remove( Object );
+}
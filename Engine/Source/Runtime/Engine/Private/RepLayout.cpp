@@ -8,11 +8,14 @@
 #include "Net/RepLayout.h"
 #include "Net/DataReplication.h"
 #include "Net/NetworkProfiler.h"
+#include "Net/PushModel.h"
 
 static TAutoConsoleVariable<int32> CVarAllowPropertySkipping( TEXT( "net.AllowPropertySkipping" ), 1, TEXT( "Allow skipping of properties that haven't changed for other clients" ) );
 
 static TAutoConsoleVariable<int32> CVarDoPropertyChecksum( TEXT( "net.DoPropertyChecksum" ), 0, TEXT( "" ) );
 
+static TAutoConsoleVariable<int32> CVarShareSerializedProperties( TEXT( "net.ShareSerializedProperties" ), 1, TEXT( "Serialize a changed property once per frame, and copy the bits to every other connection that sends it that frame" ) );
+
 FAutoConsoleVariable CVarDoReplicationContextString( TEXT( "net.ContextDebug" ), 0, TEXT( "" ) );
 
 #define ENABLE_PROPERTY_CHECKSUMS
@@ -296,7 +299,8 @@ bool FRepLayout::CompareProperties(
 	const uint8 * RESTRICT				CompareData,
 	const uint8 * RESTRICT				Data, 
 	TArray< FRepChangedParent > &		OutChangedParents,
-	const TArray< uint16 > &			PropertyList ) const
+	const TArray< uint16 > &			PropertyList,
+	const FRepPushModelFilter *			PushModelFilter ) const
 {
 	bool PropertyChanged = false;
 
@@ -316,6 +320,11 @@ bool FRepLayout::CompareProperties(
 
 		check( Changed.Num() == 0 );
 
+		if ( PushModelFilter != NULL && ( ParentCmd.Flags & PARENT_IsPushBased ) && !PushModelFilter->IsDirty( *pLifeProp ) )
+		{
+			continue;		// Game code didn't touch this property since we last compared it
+		}
+
 		// Loop over the block of child properties that are children of this parent
 		for ( int32 i = ParentCmd.CmdStart; i < ParentCmd.CmdEnd; i++ )
 		{
@@ -477,10 +486,19 @@ bool FRepLayout::ReplicateProperties(
 
 		RepState->RepFlags.Value		= RepFlags.Value;
 		RepState->ActiveStatusChanged	= ChangeTracker->ActiveStatusChanged;
+
+		// Properties that just became active weren't compared while inactive, so look at all of them once
+		RepState->bComparedPushBasedProperties = false;
 	}
 
 	bool PropertyChanged = false;
 
+	// Push based properties are only compared once game code marked them dirty, but the first compare has to catch
+	// everything that differs from the defaults the shadow state started out with
+	const FNetPushModel::FObjectState * PushModelState = bHasPushBasedParents ? FNetPushModel::FindObjectState( Object ) : NULL;
+	const FRepPushModelFilter PushModelFilter( PushModelState != NULL ? &PushModelState->PropertyDirtyCounts : NULL, RepState->PushModelDirtyCount );
+	const FRepPushModelFilter * PushModelFilterPtr = bHasPushBasedParents && RepState->bComparedPushBasedProperties ? &PushModelFilter : NULL;
+
 #ifdef ENABLE_SUPER_CHECKSUMS
 	const bool bIsAllAcked = AllAcked( RepState );
 
@@ -525,7 +543,7 @@ bool FRepLayout::ReplicateProperties(
 			}
 
 			// Loop over all unconditional lifetime properties
-			ChangeTracker->UnconditionalPropChanged = CompareProperties( RepState, CompareData, Data, ChangeTracker->Parents, UnconditionalLifetime );
+			ChangeTracker->UnconditionalPropChanged = CompareProperties( RepState, CompareData, Data, ChangeTracker->Parents, UnconditionalLifetime, PushModelFilterPtr );
 		}
 
 		// Remember the last frame this FRepState was replicated, so we can note above when the FRepState replication group changes
@@ -537,10 +555,14 @@ bool FRepLayout::ReplicateProperties(
 		}
 
 		// Loop over all the conditional properties
-		if ( CompareProperties( RepState, CompareData, Data, ChangeTracker->Parents, RepState->ConditionalLifetime ) )
+		if ( CompareProperties( RepState, CompareData, Data, ChangeTracker->Parents, RepState->ConditionalLifetime, PushModelFilterPtr ) )
 		{
 			PropertyChanged = true;
 		}
+
+		// Connections sharing the compare above are in the same replication group, so they have compared up to the same dirty count
+		RepState->PushModelDirtyCount			= PushModelState != NULL ? PushModelState->DirtyCount : 0;
+		RepState->bComparedPushBasedProperties	= true;
 	}
 #ifdef ENABLE_SUPER_CHECKSUMS
 	else
@@ -853,6 +875,33 @@ static bool ShouldSendProperty( FRepWriterState & WriterState, const uint16 Hand
 	return false;
 }
 
+/** Returns true if a property serializes to the same bits for every connection, so the bits can be shared between them */
+static bool CanShareSerializedProperty( const FRepLayoutCmd & Cmd )
+{
+	switch ( Cmd.Type )
+	{
+		// Object references, names and generic structs go through the package map of the connection
+		case REPCMD_PropertyBool:
+		case REPCMD_PropertyFloat:
+		case REPCMD_PropertyInt:
+		case REPCMD_PropertyByte:
+		case REPCMD_PropertyUInt32:
+		case REPCMD_PropertyUInt64:
+		case REPCMD_PropertyVector:
+		case REPCMD_PropertyRotator:
+		case REPCMD_PropertyPlane:
+		case REPCMD_PropertyVector100:
+		case REPCMD_RepMovement:
+		case REPCMD_PropertyVectorNormal:
+		case REPCMD_PropertyVector10:
+		case REPCMD_PropertyVectorQ:
+		case REPCMD_PropertyString:
+			return true;
+		default:
+			return false;
+	}
+}
+
 void FRepLayout::SendProperties_DynamicArray_r( 
 	FRepState *	RESTRICT		RepState, 
 	const FReplicationFlags &	RepFlags,
@@ -890,12 +939,18 @@ void FRepLayout::SendProperties_DynamicArray_r(
 
 	uint16 LocalHandle = 0;
 
+	// Every element shares the cmds of the array, so the serialized properties of the cmds can't be shared
+	TArray< FRepSerializedPropertyCache > * SerializedProperties = WriterState.SerializedProperties;
+	WriterState.SerializedProperties = NULL;
+
 	for ( int32 i = 0; i < Array->Num(); i++ )
 	{
 		const int32 ElementOffset = i * Cmd.ElementSize;
 		LocalHandle = SendProperties_r( RepState, RepFlags, WriterState, CmdIndex + 1, Cmd.EndCmd - 1, StoredData + ElementOffset, Data + ElementOffset, LocalUnmapped, LocalHandle );
 	}
 
+	WriterState.SerializedProperties = SerializedProperties;
+
 	check( WriterState.CurrentChanged - OldChangedIndex == ArrayChangedCount );	// Make sure we read correct amount
 	check( WriterState.Changed[WriterState.CurrentChanged] == 0 );				// Make sure we are at the end
 
@@ -952,10 +1007,42 @@ uint16						Handle ) const
 #endif
 
 			const int32 NumStartBits = WriterState.Writer.GetNumBits();
-			
-			// This property changed, so send it
-			WriterState.Writer.PackageMap->ResetUnAckedObject();	// Set this to false so floats, ints, etc don't trigger it
-			bool bMapped = Cmd.Property->NetSerializeItem( WriterState.Writer, WriterState.Writer.PackageMap, (void*)( Data + Cmd.Offset ) );
+
+			// RemoteRole is downgraded per connection while replicating, so its value isn't the same for everyone
+			FRepSerializedPropertyCache * SerializedProperty = NULL;
+			if ( WriterState.SerializedProperties != NULL && Cmd.ParentIndex != RemoteRoleIndex && CanShareSerializedProperty( Cmd ) )
+			{
+				SerializedProperty = &(*WriterState.SerializedProperties)[CmdIndex];
+			}
+
+			bool bMapped = true;
+
+			if ( SerializedProperty != NULL && SerializedProperty->NumBits != INDEX_NONE && SerializedProperty->ReplicationFrame == WriterState.ReplicationFrame )
+			{
+				// Another connection already sent this property this frame, copy its bits
+				WriterState.Writer.SerializeBits( SerializedProperty->Bits.GetTypedData(), SerializedProperty->NumBits );
+
+				INC_DWORD_STAT( STAT_NetSharedSerializationHits );
+				INC_DWORD_STAT_BY( STAT_NetSharedSerializationBytes, ( SerializedProperty->NumBits + 7 ) >> 3 );
+			}
+			else
+			{
+				FBitWriterMark Mark( WriterState.Writer );
+
+				// This property changed, so send it
+				WriterState.Writer.PackageMap->ResetUnAckedObject();	// Set this to false so floats, ints, etc don't trigger it
+				bMapped = Cmd.Property->NetSerializeItem( WriterState.Writer, WriterState.Writer.PackageMap, (void*)( Data + Cmd.Offset ) );
+
+				if ( SerializedProperty != NULL && !WriterState.Writer.IsError() )
+				{
+					// Keep the bits for the other connections sending this property this frame
+					Mark.Copy( WriterState.Writer, SerializedProperty->Bits );
+					SerializedProperty->NumBits				= WriterState.Writer.GetNumBits() - Mark.GetNumBits();
+					SerializedProperty->ReplicationFrame	= WriterState.ReplicationFrame;
+
+					INC_DWORD_STAT( STAT_NetSharedSerializationMisses );
+				}
+			}
 
 			const int32 NumEndBits = WriterState.Writer.GetNumBits();
 
@@ -1075,6 +1162,14 @@ void FRepLayout::SendProperties(
 
 	FRepWriterState WriterState( Writer, Changed, bDoChecksum );
 
+	FRepChangedPropertyTracker * ChangeTracker = RepState->RepChangedPropertyTracker.Get();
+
+	if ( ChangeTracker != NULL && ChangeTracker->SerializedProperties.Num() == Cmds.Num() && CVarShareSerializedProperties.GetValueOnGameThread() > 0 )
+	{
+		WriterState.SerializedProperties	= &ChangeTracker->SerializedProperties;
+		WriterState.ReplicationFrame		= OwningChannel->Connection->Driver->ReplicationFrame;
+	}
+
 #ifdef ENABLE_PROPERTY_CHECKSUMS
 	Writer.WriteBit( bDoChecksum ? 1 : 0 );
 #endif
@@ -2148,6 +2243,7 @@ void FRepLayout::InitFromObjectClass( UClass * InObjectClass )
 	RoleIndex				= -1;
 	RemoteRoleIndex			= -1;
 	FirstNonCustomParent	= -1;
+	bHasPushBasedParents	= false;
 
 	int32 RelativeHandle	= 0;
 	int32 LastOffset		= -1;
@@ -2247,6 +2343,12 @@ void FRepLayout::InitFromObjectClass( UClass * InObjectClass )
 
 			Parents[LifetimeProps[i].RepIndex].Flags |= PARENT_IsLifetime;
 
+			if ( LifetimeProps[i].bIsPushBased && LifetimeProps[i].RepIndex != RemoteRoleIndex )
+			{
+				Parents[LifetimeProps[i].RepIndex].Flags |= PARENT_IsPushBased;
+				bHasPushBasedParents = true;
+			}
+
 			if ( LifetimeProps[i].RepIndex == RemoteRoleIndex )
 			{
 				// We handle remote role specially, since it can change between connections when downgraded
@@ -2561,6 +2663,7 @@ void FRepLayout::RebuildConditionalProperties( FRepState * RESTRICT	RepState, co
 void FRepLayout::InitChangedTracker( FRepChangedPropertyTracker * ChangedTracker ) const
 {
 	ChangedTracker->Parents.SetNum( Parents.Num() );
+	ChangedTracker->SerializedProperties.SetNum( Cmds.Num() );
 
 	for ( int32 i = 0; i < Parents.Num(); i++ )
 	{
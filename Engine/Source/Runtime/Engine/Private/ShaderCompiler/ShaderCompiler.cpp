@@ -9,6 +9,7 @@
 #include "GlobalShader.h"
 #include "TargetPlatform.h"
 #include "DerivedDataCacheInterface.h"
+#include "ShaderDerivedDataVersion.h"
 
 DEFINE_LOG_CATEGORY(LogShaderCompilers);
 
@@ -29,6 +30,14 @@ static FAutoConsoleVariableRef CVarDumpShaderDebugInfo(
 	TEXT("On iOS, if the PowerVR graphics SDK is installed to the default path, the PowerVR shader compiler will be called and errors will be reported during the cook.")
 	);
 
+int32 GShaderCompileJobCache = 1;
+static FAutoConsoleVariableRef CVarShaderCompileJobCache(
+	TEXT("r.ShaderCompileJobCache"),
+	GShaderCompileJobCache,
+	TEXT("When set to 1, the output of every shader compile job is stored in the derived data cache, keyed by the job's complete input,\n")
+	TEXT("and jobs whose input was compiled before are resolved from there instead of being sent to ShaderCompileWorker.")
+	);
+
 // Serialize Queued Job information
 static void DoWriteTasks(TArray<FShaderCompileJob*>& QueuedJobs, FArchive& TransferFile)
 {
@@ -100,6 +109,60 @@ static void DoReadTaskResults(TArray<FShaderCompileJob*>& QueuedJobs, FArchive&
 }
 
 #if PLATFORM_SUPPORTS_NAMED_PIPES
+/** Number of times a worker may die while compiling the same job before that job is failed instead of being sent again */
+static const int32 MaxWorkerCrashesPerJob = 3;
+
+/** File that ShaderCompileWorker writes its crash report to from its exception handler when it talks through a named pipe */
+static const TCHAR* WorkerCrashFileName = TEXT("WorkerCrash.out");
+
+/**
+ * Reads the crash report a worker talking through a named pipe left behind, and deletes it so that it isn't read again.
+ *
+ * @param CrashFileNameAndPath	the worker's crash file
+ * @param OutReport				the exception and callstack the worker reported
+ * @return false if the worker didn't leave a report behind
+ */
+static bool ReadWorkerCrashReport(const FString& CrashFileNameAndPath, FString& OutReport)
+{
+	OutReport.Empty();
+	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*CrashFileNameAndPath))
+	{
+		return false;
+	}
+
+	FArchive* CrashFilePtr = IFileManager::Get().CreateFileReader(*CrashFileNameAndPath, FILEREAD_Silent);
+	if (CrashFilePtr)
+	{
+		// Same layout as the start of an output file, see DoReadTaskResults
+		FArchive& CrashFile = *CrashFilePtr;
+		int32 OutputVersion = 0;
+		int32 ErrorCode = 0;
+		int32 CallstackLength = 0;
+		int32 ExceptionInfoLength = 0;
+		CrashFile << OutputVersion << ErrorCode << CallstackLength << ExceptionInfoLength;
+
+		// The worker was crashing when it wrote this, so don't trust the lengths past the end of the file
+		const int64 StringsSize = ((int64)CallstackLength + ExceptionInfoLength) * sizeof(TCHAR);
+		if (!CrashFile.IsError() && OutputVersion == 1 && ErrorCode == 1 && CallstackLength >= 0 && ExceptionInfoLength >= 0
+			&& StringsSize <= CrashFile.TotalSize() - CrashFile.Tell())
+		{
+			TArray<TCHAR> Callstack;
+			Callstack.AddZeroed(CallstackLength + 1);
+			CrashFile.Serialize(Callstack.GetData(), CallstackLength * sizeof(TCHAR));
+
+			TArray<TCHAR> ExceptionInfo;
+			ExceptionInfo.AddZeroed(ExceptionInfoLength + 1);
+			CrashFile.Serialize(ExceptionInfo.GetData(), ExceptionInfoLength * sizeof(TCHAR));
+
+			OutReport = FString(ExceptionInfo.GetData()) + TEXT("\n") + Callstack.GetData();
+		}
+		delete CrashFilePtr;
+	}
+
+	IFileManager::Get().Delete(*CrashFileNameAndPath, false, true);
+	return OutReport.Len() > 0;
+}
+
 struct FShaderPipeConfig
 {
 	bool	bUseNamedPipes;
@@ -136,13 +199,19 @@ struct FPipeWorkerInfo
 	// Holds the serialized data for queued jobs to send to the worker process
 	TArray<uint8> WorkJobBuffer;
 
+	// Whether WorkJobBuffer holds a batch that hasn't been written to the pipe yet
+	bool bJobDataPending;
+
 	enum EState
 	{
 		State_Idle,
 		State_Connecting,
+		// Job data was sent, the next step reads the size of a result
 		State_SendingJobData,
 		State_ReceivingResultSize,
 		State_ReceivingResults,
+		// Still connected to a worker that finished its last batch and is waiting for the next one
+		State_Connected,
 	};
 
 	EState State;
@@ -154,12 +223,17 @@ struct FPipeWorkerInfo
 	TArray<uint8> ResultsBuffer;
 
 	FPipeWorkerInfo() :
+		bJobDataPending(false),
 		State(State_Idle),
 		ResultsTransferSize(0)
 	{
 	}
 
-	// Updates the state based off async communication with the pipe
+	/**
+	 * Updates the state based off async communication with the pipe.
+	 * The worker sends the result of each job as soon as it has compiled it, so this returns true every time
+	 * the result of one job has been received into ResultsBuffer, and should be called again to receive the next one.
+	 */
 	bool UpdateResultsState()
 	{
 		bool bAgain = false;
@@ -179,11 +253,19 @@ struct FPipeWorkerInfo
 					bAgain = true;
 					break;
 
+				case State_Connected:
+					if (!bJobDataPending)
+					{
+						return false;
+					}
+					// Fall through, the connection is ready to send the next batch
+
 				case State_Connecting:
 					if (NamedPipe.IsReadyForRW())
 					{
 						if (NamedPipe.WriteBytes(WorkJobBuffer.Num(), WorkJobBuffer.GetData()))
 						{
+							bJobDataPending = false;
 							State = State_SendingJobData;
 						}
 						else if (NamedPipe.HasFailed())
@@ -231,7 +313,8 @@ struct FPipeWorkerInfo
 				case State_ReceivingResults:
 					if (NamedPipe.IsReadyForRW())
 					{
-						State = State_Idle;
+						// Wait for the next result, FinishBatch ends this once every job has been received
+						State = State_SendingJobData;
 						return true;
 					}
 					break;
@@ -269,6 +352,27 @@ struct FPipeWorkerInfo
 //FPlatformMisc::LowLevelOutputDebugStringf(TEXT("*** Destroying Pipe %s\n"), *NamedPipe.GetName());
 		NamedPipe.Destroy();
 		State = State_Idle;
+		bJobDataPending = false;
+	}
+
+	/** Whether the pipe is still connected to a worker that is waiting for its next batch. */
+	bool IsConnectedAndIdle() const
+	{
+		return State == State_Connected && NamedPipe.IsCreated();
+	}
+
+	/** Called once the results of every job in the batch have been received. */
+	void FinishBatch(bool bKeepConnection)
+	{
+		if (bKeepConnection)
+		{
+			// The worker keeps reading batches from the same connection, so skip the reconnect
+			State = State_Connected;
+		}
+		else
+		{
+			DestroyPipe();
+		}
 	}
 
 	void WriteTasksForPipe( TArray<FShaderCompileJob*>& QueuedJobs ) 
@@ -287,6 +391,7 @@ struct FPipeWorkerInfo
 			TransferWriter.Serialize(Buffer.GetData(), Buffer.Num());
 		}
 		TransferWriter.Close();
+		bJobDataPending = true;
 	}
 };
 #endif	// PLATFORM_SUPPORTS_NAMED_PIPES
@@ -319,6 +424,24 @@ struct FShaderCompileWorkerInfo
 	/** Jobs that this worker is responsible for compiling. */
 	TArray<FShaderCompileJob*> QueuedJobs;
 
+	/** Number of QueuedJobs whose results have been received. Results arrive in order, so these are the first NumJobsReceived jobs. */
+	int32 NumJobsReceived;
+
+	/** Number of QueuedJobs that have already been handed to the manager. Those may be deleted by the main thread at any time. */
+	int32 NumJobsReported;
+
+	/** Names of the reported jobs, only gathered when the batch may be logged. */
+	FString ReportedJobNames;
+
+	/** Whether QueuedJobs have been looked up in the job cache. */
+	bool bCheckedJobCache;
+
+	/** Number of received jobs that don't need to be stored in the job cache anymore, either because they were or because they came from there. */
+	int32 NumJobsCached;
+
+	/** Number of times the worker died while compiling the job at NumJobsReceived. */
+	int32 NumCrashesOnNextJob;
+
 	FShaderCompileWorkerInfo() :
 		WorkerAppId(0),
 		bIssuedTasksToWorker(false),		
@@ -327,16 +450,40 @@ struct FShaderCompileWorkerInfo
 #if PLATFORM_SUPPORTS_NAMED_PIPES
 		bWorkerForPipeWasLaunched(false),
 #endif
-		StartTime(0)
+		StartTime(0),
+		NumJobsReceived(0),
+		NumJobsReported(0),
+		bCheckedJobCache(false),
+		NumJobsCached(0),
+		NumCrashesOnNextJob(0)
 	{
 	}
 
+	/** Gathers the jobs which still have to be compiled, i.e. the ones past NumJobsReceived. */
+	void GetJobsToCompile(TArray<FShaderCompileJob*>& OutJobs) const
+	{
+		OutJobs.Empty(QueuedJobs.Num() - NumJobsReceived);
+		OutJobs.Append(QueuedJobs.GetData() + NumJobsReceived, QueuedJobs.Num() - NumJobsReceived);
+	}
+
 	void CreatePipeAndNewTask(uint32 WorkerIndex, uint32 ProcessId)
 	{
 #if PLATFORM_SUPPORTS_NAMED_PIPES
 		check(GShaderPipeConfig.bUseNamedPipes);
-		if (QueuedJobs.Num() > 0)
+		if (QueuedJobs.Num() > NumJobsReceived)
 		{
+			// Only send the jobs that haven't come back yet, in case this is a resend after the worker died part way through the batch
+			TArray<FShaderCompileJob*> JobsToSend;
+			GetJobsToCompile(JobsToSend);
+
+			if (bWorkerForPipeWasLaunched && PipeWorker.IsConnectedAndIdle() && FShaderCompilingManager::IsShaderCompilerWorkerRunning(WorkerAppId))
+			{
+				// The worker is still connected and waiting, so hand it the next batch over the same connection
+				PipeWorker.WriteTasksForPipe(JobsToSend);
+				return;
+			}
+			PipeWorker.DestroyPipe();
+
 			// Open the pipe; figure out if the worker is still listening, which means we can recycle the pipe
 			bool bAllocNameForPipe = (PipeWorker.PipeName.Len() == 0);
 			bAllocNameForPipe |= !GShaderPipeConfig.bReuseNamedPipeAndProcess;
@@ -358,7 +505,29 @@ struct FShaderCompileWorkerInfo
 				bWorkerForPipeWasLaunched = false;
 			}
 			PipeWorker.CreatePipe(WorkerIndex, ProcessId, bAllocNameForPipe);
-			PipeWorker.WriteTasksForPipe(QueuedJobs);
+			PipeWorker.WriteTasksForPipe(JobsToSend);
+		}
+#else
+		check(0);
+#endif	// PLATFORM_SUPPORTS_NAMED_PIPES
+	}
+
+	/** Deserializes the result that was just received from the pipe into the next job of the batch. */
+	void ReceiveResultFromPipe()
+	{
+#if PLATFORM_SUPPORTS_NAMED_PIPES
+		check(NumJobsReceived < QueuedJobs.Num());
+		TArray<FShaderCompileJob*> ReceivedJob;
+		ReceivedJob.Add(QueuedJobs[NumJobsReceived]);
+		FMemoryReader ResultReader(PipeWorker.ResultsBuffer);
+		DoReadTaskResults(ReceivedJob, ResultReader);
+		NumJobsReceived++;
+		NumCrashesOnNextJob = 0;
+
+		if (NumJobsReceived == QueuedJobs.Num())
+		{
+			bComplete = true;
+			PipeWorker.FinishBatch(GShaderPipeConfig.bReuseNamedPipeAndProcess && !GShaderPipeConfig.bSingleJobPerNamedPipeProcess);
 		}
 #else
 		check(0);
@@ -369,59 +538,48 @@ struct FShaderCompileWorkerInfo
 	{
 #if PLATFORM_SUPPORTS_NAMED_PIPES
 		check(GShaderPipeConfig.bUseNamedPipes);
-		if (QueuedJobs.Num() == 0 || !bWorkerForPipeWasLaunched)
+		if (QueuedJobs.Num() == 0 || !bWorkerForPipeWasLaunched || bComplete)
 		{
 			return;
 		}
 
 		check(PipeWorker.NamedPipe.IsCreated());
 
-		bool bError = false;
-		do
+		while (!bComplete)
 		{
 			PipeWorker.NamedPipe.BlockForAsyncIO();
 			if (PipeWorker.NamedPipe.HasFailed())
 			{
-				bError = true;
+				// Close pipe
+				PipeWorker.DestroyPipe();
 				break;
 			}
-		}
-		while (!PipeWorker.UpdateResultsState());
 
-		if (!bError)
-		{
-			FMemoryReader ResultReader(PipeWorker.ResultsBuffer);
-			DoReadTaskResults(QueuedJobs, ResultReader);
-			bComplete = true;
+			while (!bComplete && PipeWorker.UpdateResultsState())
+			{
+				ReceiveResultFromPipe();
+			}
 		}
-
-		// Close pipe
-		PipeWorker.DestroyPipe();
 #else
 		check(0);
 #endif	// PLATFORM_SUPPORTS_NAMED_PIPES
 	}
 
-	void ReadResultsFromPipe()
+	/** Receives every result that has arrived from the pipe so far. @return the number of results received. */
+	int32 ReadAvailableResultsFromPipe()
 	{
+		int32 NumReceived = 0;
 #if PLATFORM_SUPPORTS_NAMED_PIPES
-		check(PipeWorker.NamedPipe.IsCreated());
-
-		PipeWorker.NamedPipe.BlockForAsyncIO();
-		if (PipeWorker.UpdateResultsState())
+		while (!bComplete && PipeWorker.UpdateResultsState())
 		{
-			FMemoryReader ResultReader(PipeWorker.ResultsBuffer);
-			DoReadTaskResults(QueuedJobs, ResultReader);
-			bComplete = true;
+			ReceiveResultFromPipe();
+			NumReceived++;
 		}
-
-		// Close pipe
-		PipeWorker.DestroyPipe();
 #else
 		check(0);
 #endif	// PLATFORM_SUPPORTS_NAMED_PIPES
+		return NumReceived;
 	}
-
 };
 
 FShaderCompileThreadRunnable::FShaderCompileThreadRunnable(FShaderCompilingManager* InManager) :
@@ -553,6 +711,12 @@ int32 FShaderCompileThreadRunnable::PullTasksFromQueue()
 					CurrentWorkerInfo.bIssuedTasksToWorker = false;					
 					CurrentWorkerInfo.bLaunchedWorker = false;
 					CurrentWorkerInfo.StartTime = FPlatformTime::Seconds();
+					CurrentWorkerInfo.NumJobsReceived = 0;
+					CurrentWorkerInfo.NumJobsReported = 0;
+					CurrentWorkerInfo.ReportedJobNames.Empty();
+					CurrentWorkerInfo.bCheckedJobCache = false;
+					CurrentWorkerInfo.NumJobsCached = 0;
+					CurrentWorkerInfo.NumCrashesOnNextJob = 0;
 					NumActiveThreads++;
 					Manager->CompileQueue.RemoveAt(0, JobIndex);
 				}
@@ -564,39 +728,45 @@ int32 FShaderCompileThreadRunnable::PullTasksFromQueue()
 					NumActiveThreads++;
 				}
 
-				// Add completed jobs to the output queue, which is ShaderMapJobs
-				if (CurrentWorkerInfo.bComplete)
+				// Add finished jobs to the output queue, which is ShaderMapJobs
+				// Workers that stream their results back finish jobs one at a time, so hand them over without waiting for the rest of the batch
+				const double CurrentTime = FPlatformTime::Seconds();
+				const bool bMayLogBatch = Manager->bLogJobCompletionTimes || CurrentTime - CurrentWorkerInfo.StartTime > 30.0;
+				const int32 FirstJobToReport = CurrentWorkerInfo.NumJobsReported;
+				while (CurrentWorkerInfo.NumJobsReported < CurrentWorkerInfo.QueuedJobs.Num() && CurrentWorkerInfo.QueuedJobs[CurrentWorkerInfo.NumJobsReported]->bFinalized)
 				{
-					for (int32 JobIndex = 0; JobIndex < CurrentWorkerInfo.QueuedJobs.Num(); JobIndex++)
+					FShaderCompileJob& Job = *CurrentWorkerInfo.QueuedJobs[CurrentWorkerInfo.NumJobsReported];
+					if (bMayLogBatch)
 					{
-						FShaderMapCompileResults& ShaderMapResults = Manager->ShaderMapJobs.FindChecked(CurrentWorkerInfo.QueuedJobs[JobIndex]->Id);
-						ShaderMapResults.FinishedJobs.Add(CurrentWorkerInfo.QueuedJobs[JobIndex]);
-						ShaderMapResults.bAllJobsSucceeded = ShaderMapResults.bAllJobsSucceeded && CurrentWorkerInfo.QueuedJobs[JobIndex]->bSucceeded;
+						// Gather the name now, the main thread may delete the job as soon as it has been reported
+						CurrentWorkerInfo.ReportedJobNames += FString(Job.ShaderType->GetName()) + TEXT(" Instructions = ") + FString::FromInt(Job.Output.NumInstructions) + TEXT(", ");
 					}
 
-					const float ElapsedTime = FPlatformTime::Seconds() - CurrentWorkerInfo.StartTime;
+					FShaderMapCompileResults& ShaderMapResults = Manager->ShaderMapJobs.FindChecked(Job.Id);
+					ShaderMapResults.FinishedJobs.Add(&Job);
+					ShaderMapResults.bAllJobsSucceeded = ShaderMapResults.bAllJobsSucceeded && Job.bSucceeded;
+					CurrentWorkerInfo.NumJobsReported++;
+				}
+
+				// Using atomics to update NumOutstandingJobs since it is read outside of the critical section
+				FPlatformAtomics::InterlockedAdd(&Manager->NumOutstandingJobs, FirstJobToReport - CurrentWorkerInfo.NumJobsReported);
+
+				if (CurrentWorkerInfo.bComplete)
+				{
+					check(CurrentWorkerInfo.NumJobsReported == CurrentWorkerInfo.QueuedJobs.Num());
+					const float ElapsedTime = CurrentTime - CurrentWorkerInfo.StartTime;
 
 					Manager->WorkersBusyTime += ElapsedTime;
 
 					// Log if requested or if there was an exceptionally slow batch, to see the offender easily
 					if (Manager->bLogJobCompletionTimes || ElapsedTime > 30.0f)
 					{
-						FString JobNames;
-
-						for (int32 JobIndex = 0; JobIndex < CurrentWorkerInfo.QueuedJobs.Num(); JobIndex++)
-						{
-							const FShaderCompileJob& Job = *CurrentWorkerInfo.QueuedJobs[JobIndex];
-							JobNames += FString(Job.ShaderType->GetName()) + TEXT(" Instructions = ") + FString::FromInt(Job.Output.NumInstructions) + TEXT(", ");
-						}
-
-						UE_LOG(LogShaders, Display, TEXT("Finished batch of %u jobs in %.3fs, %s"), CurrentWorkerInfo.QueuedJobs.Num(), ElapsedTime, *JobNames);
+						UE_LOG(LogShaders, Display, TEXT("Finished batch of %u jobs in %.3fs, %s"), CurrentWorkerInfo.QueuedJobs.Num(), ElapsedTime, *CurrentWorkerInfo.ReportedJobNames);
 					}
 
-					// Using atomics to update NumOutstandingJobs since it is read outside of the critical section
-					FPlatformAtomics::InterlockedAdd(&Manager->NumOutstandingJobs, -CurrentWorkerInfo.QueuedJobs.Num());
-
 					CurrentWorkerInfo.bComplete = false;
 					CurrentWorkerInfo.QueuedJobs.Empty();
+					CurrentWorkerInfo.ReportedJobNames.Empty();
 				}
 			}
 		}
@@ -610,8 +780,8 @@ void FShaderCompileThreadRunnable::WriteNewTasks()
 	{
 		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
 
-		// Only write tasks once
-		if (!CurrentWorkerInfo.bIssuedTasksToWorker && CurrentWorkerInfo.QueuedJobs.Num() > 0)
+		// Only write tasks once, and only if some weren't resolved from the job cache
+		if (!CurrentWorkerInfo.bIssuedTasksToWorker && CurrentWorkerInfo.QueuedJobs.Num() > 0 && !CurrentWorkerInfo.bComplete)
 		{
 			CurrentWorkerInfo.bIssuedTasksToWorker = true;
 
@@ -662,7 +832,9 @@ void FShaderCompileThreadRunnable::WriteNewTasks()
 				}
 				check(TransferFile);
 
-				DoWriteTasks(CurrentWorkerInfo.QueuedJobs, *TransferFile);
+				TArray<FShaderCompileJob*> JobsToSend;
+				CurrentWorkerInfo.GetJobsToCompile(JobsToSend);
+				DoWriteTasks(JobsToSend, *TransferFile);
 				delete TransferFile;
 
 #if PLATFORM_MAC			
@@ -678,7 +850,7 @@ void FShaderCompileThreadRunnable::WriteNewTasks()
 void FShaderCompileThreadRunnable::LaunchWorkerIfNeeded(FShaderCompileWorkerInfo& CurrentWorkerInfo, uint32 WorkerIndex)
 {
 #if PLATFORM_SUPPORTS_NAMED_PIPES
-	if (CurrentWorkerInfo.QueuedJobs.Num() == 0)
+	if (CurrentWorkerInfo.QueuedJobs.Num() == 0 || CurrentWorkerInfo.bComplete)
 	{
 		return;
 	}
@@ -701,6 +873,42 @@ void FShaderCompileThreadRunnable::LaunchWorkerIfNeeded(FShaderCompileWorkerInfo
 			CurrentWorkerInfo.PipeWorker.DestroyPipe();
 			CurrentWorkerInfo.bWorkerForPipeWasLaunched = false;
 
+			// Results arrive in order, so the worker died on the first job it hasn't sent back
+			check(CurrentWorkerInfo.NumJobsReceived < CurrentWorkerInfo.QueuedJobs.Num());
+			FShaderCompileJob& CrashedJob = *CurrentWorkerInfo.QueuedJobs[CurrentWorkerInfo.NumJobsReceived];
+			CurrentWorkerInfo.NumCrashesOnNextJob++;
+
+			const FString CrashFileNameAndPath = Manager->AbsoluteShaderBaseWorkingDirectory + FString::FromInt(WorkerIndex) + TEXT("/") + WorkerCrashFileName;
+			FString CrashReport;
+			if (ReadWorkerCrashReport(CrashFileNameAndPath, CrashReport))
+			{
+				UE_LOG(LogShaderCompilers, Error, TEXT("ShaderCompileWorker %u crashed compiling %s (%s), attempt %d of %d:\n%s"),
+					WorkerIndex, CrashedJob.ShaderType->GetName(), *CrashedJob.Input.SourceFilename, CurrentWorkerInfo.NumCrashesOnNextJob, MaxWorkerCrashesPerJob, *CrashReport);
+			}
+			else
+			{
+				UE_LOG(LogShaderCompilers, Error, TEXT("ShaderCompileWorker %u terminated unexpectedly compiling %s (%s), attempt %d of %d."),
+					WorkerIndex, CrashedJob.ShaderType->GetName(), *CrashedJob.Input.SourceFilename, CurrentWorkerInfo.NumCrashesOnNextJob, MaxWorkerCrashesPerJob);
+			}
+
+			if (CurrentWorkerInfo.NumCrashesOnNextJob >= MaxWorkerCrashesPerJob)
+			{
+				// Sending it again would only crash the next worker too, so fail the job and carry on with the rest of the batch
+				check(!CrashedJob.bFinalized);
+				CrashedJob.Output.bSucceeded = false;
+				new(CrashedJob.Output.Errors) FShaderCompilerError(*FString::Printf(TEXT("ShaderCompileWorker crashed %d times compiling this shader. %s"), CurrentWorkerInfo.NumCrashesOnNextJob, *CrashReport));
+				CrashedJob.bSucceeded = false;
+				CrashedJob.bFinalized = true;
+				CurrentWorkerInfo.NumJobsReceived++;
+				CurrentWorkerInfo.NumCrashesOnNextJob = 0;
+
+				if (CurrentWorkerInfo.NumJobsReceived == CurrentWorkerInfo.QueuedJobs.Num())
+				{
+					CurrentWorkerInfo.bComplete = true;
+					return;
+				}
+			}
+
 			check(GShaderPipeConfig.bUseNamedPipes && !GShaderPipeConfig.bSingleJobPerNamedPipeProcess);
 			CurrentWorkerInfo.CreatePipeAndNewTask(WorkerIndex, GShaderCompilingManager->ProcessId);
 		}
@@ -710,6 +918,9 @@ void FShaderCompileThreadRunnable::LaunchWorkerIfNeeded(FShaderCompileWorkerInfo
 	{
 		const FString WorkingDirectory = Manager->ShaderBaseWorkingDirectory + FString::FromInt(WorkerIndex) + TEXT("/");
 
+		// A report left behind by an earlier worker would be blamed on this one
+		IFileManager::Get().Delete(*(Manager->AbsoluteShaderBaseWorkingDirectory + FString::FromInt(WorkerIndex) + TEXT("/") + WorkerCrashFileName), false, true);
+
 		// Store the Id with this thread so that we will know not to launch it again
 		const FString& PipeName = CurrentWorkerInfo.PipeWorker.NamedPipe.GetName();
 		CurrentWorkerInfo.WorkerAppId = Manager->LaunchWorker(WorkingDirectory, Manager->ProcessId, WorkerIndex, PipeName, PipeName, true, !GShaderPipeConfig.bReuseNamedPipeAndProcess);		
@@ -736,9 +947,9 @@ bool FShaderCompileThreadRunnable::LaunchWorkersIfNeeded()
 	for (int32 WorkerIndex = 0; WorkerIndex < WorkerInfos.Num(); WorkerIndex++)
 	{
 		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
-		if (CurrentWorkerInfo.QueuedJobs.Num() == 0 )
+		if (CurrentWorkerInfo.QueuedJobs.Num() == 0 || CurrentWorkerInfo.bComplete)
 		{
-			// Skip if nothing to do
+			// Skip if nothing to do, or if the whole batch was resolved from the job cache
 			continue;
 		}
 
@@ -795,14 +1006,15 @@ bool FShaderCompileThreadRunnable::LaunchWorkersIfNeeded()
 	return bAbandonWorkers;
 }
 
-void FShaderCompileThreadRunnable::ReadAvailableResults()
+int32 FShaderCompileThreadRunnable::ReadAvailableResults()
 {
+	int32 NumJobsReceived = 0;
 	for (int32 WorkerIndex = 0; WorkerIndex < WorkerInfos.Num(); WorkerIndex++)
 	{
 		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
 
 		// Check for available result files
-		if (CurrentWorkerInfo.QueuedJobs.Num() > 0)
+		if (CurrentWorkerInfo.QueuedJobs.Num() > 0 && !CurrentWorkerInfo.bComplete)
 		{
 #if PLATFORM_SUPPORTS_NAMED_PIPES
 			if (GShaderPipeConfig.bUseNamedPipes && !GShaderPipeConfig.bSingleJobPerNamedPipeProcess)
@@ -812,13 +1024,7 @@ void FShaderCompileThreadRunnable::ReadAvailableResults()
 					continue;
 				}
 
-				if (CurrentWorkerInfo.PipeWorker.UpdateResultsState())
-				{
-					FMemoryReader ResultReader(CurrentWorkerInfo.PipeWorker.ResultsBuffer);
-					DoReadTaskResults(CurrentWorkerInfo.QueuedJobs, ResultReader);
-					CurrentWorkerInfo.bComplete = true;
-					CurrentWorkerInfo.PipeWorker.DestroyPipe();
-				}
+				NumJobsReceived += CurrentWorkerInfo.ReadAvailableResultsFromPipe();
 			}
 			else
 #endif // PLATFORM_SUPPORTS_NAMED_PIPES
@@ -838,7 +1044,9 @@ void FShaderCompileThreadRunnable::ReadAvailableResults()
 					if (OutputFilePtr)
 					{
 						FArchive& OutputFile = *OutputFilePtr;
-						DoReadTaskResults(CurrentWorkerInfo.QueuedJobs, OutputFile);
+						TArray<FShaderCompileJob*> JobsToRead;
+						CurrentWorkerInfo.GetJobsToCompile(JobsToRead);
+						DoReadTaskResults(JobsToRead, OutputFile);
 
 						// Close the output file.
 						delete OutputFilePtr;
@@ -855,12 +1063,15 @@ void FShaderCompileThreadRunnable::ReadAvailableResults()
 						}
 						checkf(bDeletedOutput, TEXT("Failed to delete %s!"), *OutputFileNameAndPath);
 
+						NumJobsReceived += JobsToRead.Num();
+						CurrentWorkerInfo.NumJobsReceived = CurrentWorkerInfo.QueuedJobs.Num();
 						CurrentWorkerInfo.bComplete = true;
 					}
 				}
 			}
 		}
 	}
+	return NumJobsReceived;
 }
 
 void FShaderCompileThreadRunnable::CompileDirectlyThroughDll()
@@ -869,9 +1080,10 @@ void FShaderCompileThreadRunnable::CompileDirectlyThroughDll()
 	{
 		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
 
-		if (CurrentWorkerInfo.QueuedJobs.Num() > 0)
+		if (CurrentWorkerInfo.QueuedJobs.Num() > 0 && !CurrentWorkerInfo.bComplete)
 		{
-			for (int32 JobIndex = 0; JobIndex < CurrentWorkerInfo.QueuedJobs.Num(); JobIndex++)
+			// Skip the jobs that were resolved from the job cache
+			for (int32 JobIndex = CurrentWorkerInfo.NumJobsReceived; JobIndex < CurrentWorkerInfo.QueuedJobs.Num(); JobIndex++)
 			{
 				FShaderCompileJob& CurrentJob = *CurrentWorkerInfo.QueuedJobs[JobIndex];
 
@@ -908,16 +1120,140 @@ void FShaderCompileThreadRunnable::CompileDirectlyThroughDll()
 				}
 			}
 
+			CurrentWorkerInfo.NumJobsReceived = CurrentWorkerInfo.QueuedJobs.Num();
 			CurrentWorkerInfo.bComplete = true;
 		}
 	}
 }
 
+/** Builds the job cache key for a job from its complete input. */
+static FString GetShaderCompileJobCacheKey(FShaderCompileJob& Job)
+{
+	// The workers preprocess the shader files themselves, so those are covered by SourceHash rather than by their preprocessed contents
+	TArray<uint8> InputData;
+	FMemoryWriter Ar(InputData, true);
+	Ar << Job.Input;
+	Ar << Job.SourceHash;
+
+	FSHAHash InputHash;
+	FSHA1::HashBuffer(InputData.GetData(), InputData.Num(), InputHash.Hash);
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("SCJ"), SHADERCOMPILEJOB_DERIVEDDATA_VER, *InputHash.ToString());
+}
+
+void FShaderCompileThreadRunnable::ResolveJobsFromCache()
+{
+	for (int32 WorkerIndex = 0; WorkerIndex < WorkerInfos.Num(); WorkerIndex++)
+	{
+		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
+
+		// Only look up batches that were just pulled from the queue
+		if (CurrentWorkerInfo.QueuedJobs.Num() == 0 || CurrentWorkerInfo.bCheckedJobCache)
+		{
+			continue;
+		}
+
+		CurrentWorkerInfo.bCheckedJobCache = true;
+		check(CurrentWorkerInfo.NumJobsReceived == 0 && !CurrentWorkerInfo.bComplete);
+
+		TArray<FShaderCompileJob*>& Jobs = CurrentWorkerInfo.QueuedJobs;
+		for (int32 JobIndex = 0; JobIndex < Jobs.Num(); JobIndex++)
+		{
+			// Jobs which dump debug info have to be compiled to produce it
+			const bool bUseCache = GShaderCompileJobCache && Jobs[JobIndex]->Input.DumpDebugInfoPath.IsEmpty();
+			Jobs[JobIndex]->CacheKey = bUseCache ? GetShaderCompileJobCacheKey(*Jobs[JobIndex]) : FString();
+		}
+
+		if (!GShaderCompileJobCache)
+		{
+			continue;
+		}
+
+		FDerivedDataCacheInterface& DDC = GetDerivedDataCacheRef();
+
+		// Issue the lookups for the whole batch before waiting on any of them
+		TArray<uint32> Handles;
+		Handles.AddZeroed(Jobs.Num());
+		for (int32 JobIndex = 0; JobIndex < Jobs.Num(); JobIndex++)
+		{
+			if (!Jobs[JobIndex]->CacheKey.IsEmpty())
+			{
+				Handles[JobIndex] = DDC.GetAsynchronous(*Jobs[JobIndex]->CacheKey);
+			}
+		}
+
+		int32 NumLookups = 0;
+		int32 NumHits = 0;
+		TArray<uint8> CachedData;
+		for (int32 JobIndex = 0; JobIndex < Jobs.Num(); JobIndex++)
+		{
+			FShaderCompileJob& CurrentJob = *Jobs[JobIndex];
+			if (CurrentJob.CacheKey.IsEmpty())
+			{
+				continue;
+			}
+
+			NumLookups++;
+			DDC.WaitAsynchronousCompletion(Handles[JobIndex]);
+			if (DDC.GetAsynchronousResults(Handles[JobIndex], CachedData))
+			{
+				check(!CurrentJob.bFinalized);
+				CurrentJob.bFinalized = true;
+
+				FMemoryReader Ar(CachedData, true);
+				Ar << CurrentJob.Output;
+				CurrentJob.Output.GenerateOutputHash();
+				CurrentJob.bSucceeded = CurrentJob.Output.bSucceeded;
+
+				// Received jobs are the first ones of the batch, everything before NumHits has already been looked up
+				Jobs.Swap(NumHits, JobIndex);
+				NumHits++;
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_ShaderCompiling_NumJobCacheHits, NumHits);
+		INC_DWORD_STAT_BY(STAT_ShaderCompiling_NumJobCacheMisses, NumLookups - NumHits);
+
+		// Hits don't have to be stored again
+		CurrentWorkerInfo.NumJobsReceived = NumHits;
+		CurrentWorkerInfo.NumJobsCached = NumHits;
+		CurrentWorkerInfo.bComplete = NumHits == Jobs.Num();
+	}
+}
+
+void FShaderCompileThreadRunnable::CacheReceivedJobs()
+{
+	for (int32 WorkerIndex = 0; WorkerIndex < WorkerInfos.Num(); WorkerIndex++)
+	{
+		FShaderCompileWorkerInfo& CurrentWorkerInfo = *WorkerInfos[WorkerIndex];
+
+		for (; CurrentWorkerInfo.NumJobsCached < CurrentWorkerInfo.NumJobsReceived; CurrentWorkerInfo.NumJobsCached++)
+		{
+			FShaderCompileJob& CurrentJob = *CurrentWorkerInfo.QueuedJobs[CurrentWorkerInfo.NumJobsCached];
+
+			// Only store successful compiles, failed ones are retried after the source has been edited and should report their errors again
+			if (GShaderCompileJobCache && !CurrentJob.CacheKey.IsEmpty() && CurrentJob.bSucceeded)
+			{
+				TArray<uint8> SaveData;
+				FMemoryWriter Ar(SaveData, true);
+				Ar << CurrentJob.Output;
+
+				GetDerivedDataCacheRef().Put(*CurrentJob.CacheKey, SaveData);
+			}
+		}
+	}
+}
+
 int32 FShaderCompileThreadRunnable::CompilingLoop()
 {
+	// Store the jobs received in the last pass before they are handed over, the main thread may delete them after that
+	CacheReceivedJobs();
+
 	// Grab more shader compile jobs from the input queue, and move completed jobs to Manager->ShaderMapJobs
 	const int32 NumActiveThreads = PullTasksFromQueue();
 
+	// Jobs which have been compiled before don't need to go to the workers
+	ResolveJobsFromCache();
+
 	if (NumActiveThreads == 0 && Manager->bAllowAsynchronousShaderCompiling)
 	{
 		// Yield while there's nothing to do
@@ -956,7 +1292,13 @@ int32 FShaderCompileThreadRunnable::CompilingLoop()
 			else
 			{
 				// Read files which are outputs from the shader compile workers
-				ReadAvailableResults();
+				const int32 NumJobsReceived = ReadAvailableResults();
+
+				if (NumJobsReceived == 0 && NumActiveThreads > 0)
+				{
+					// Yield briefly while the workers are busy, once per pass rather than once per worker
+					FPlatformProcess::Sleep(.001f);
+				}
 			}
 		}
 	}
@@ -1070,6 +1412,25 @@ void FShaderCompilingManager::AddJobs(TArray<FShaderCompileJob*>& NewJobs, bool
 {
 	check(!FPlatformProperties::RequiresCookedData());
 
+	static ITargetPlatformManagerModule& TPM = GetTargetPlatformManagerRef();
+
+	// The shader file hashes can only be read on the game thread, so gather what the job cache key needs besides the input here
+	for (int32 JobIndex = 0; JobIndex < NewJobs.Num(); JobIndex++)
+	{
+		FShaderCompileJob& Job = *NewJobs[JobIndex];
+		const uint16 FormatVersion = TPM.ShaderFormatVersion(Job.Input.ShaderFormat);
+
+		FSHA1 HashState;
+		HashState.Update(GetShaderFileHash(Job.ShaderType->GetShaderFilename()).Hash, sizeof(FSHAHash));
+		if (Job.VFType)
+		{
+			HashState.Update(GetShaderFileHash(Job.VFType->GetShaderFilename()).Hash, sizeof(FSHAHash));
+		}
+		HashState.Update((const uint8*)&FormatVersion, sizeof(FormatVersion));
+		HashState.Final();
+		HashState.GetHash(Job.SourceHash.Hash);
+	}
+
 	// Lock CompileQueueSection so we can access the input and output queues
 	FScopeLock Lock(&CompileQueueSection);
 
@@ -11,3 +11,4 @@
 
 #define GLOBALSHADERMAP_DERIVEDDATA_VER			TEXT("af1606fcec114373844d2b6cf9df71c8")
 #define MATERIALSHADERMAP_DERIVEDDATA_VER		TEXT("e1c1e89ee9ae4f3ca7b8e0f1c49b34eb")
+#define SHADERCOMPILEJOB_DERIVEDDATA_VER		TEXT("bfd644bd54b14fa9b9bbc323858ab120")
@@ -264,6 +264,27 @@ FArchive& operator<<(FArchive& Ar, FStaticMeshSection& Section)
 	return Ar;
 }
 
+/**
+ * Serializes the vertex and index buffers of a LOD, either inline or into the payload of a streamable LOD.
+ */
+static void SerializeLODBuffers(FArchive& Ar, FStaticMeshLODResources& LOD, bool bNeedsCPUAccess, bool bWithWireframe, bool bWithAdjacency)
+{
+	LOD.PositionVertexBuffer.Serialize( Ar, bNeedsCPUAccess );
+	LOD.VertexBuffer.Serialize( Ar, bNeedsCPUAccess );
+	LOD.ColorVertexBuffer.Serialize( Ar, bNeedsCPUAccess );
+	LOD.IndexBuffer.Serialize( Ar, bNeedsCPUAccess );
+	LOD.DepthOnlyIndexBuffer.Serialize(Ar, bNeedsCPUAccess);
+	if( bWithWireframe )
+	{
+		LOD.WireframeIndexBuffer.Serialize(Ar, bNeedsCPUAccess);
+	}
+	if ( bWithAdjacency )
+	{
+		LOD.AdjacencyIndexBuffer.Serialize( Ar, bNeedsCPUAccess );
+		LOD.bHasAdjacencyInfo = LOD.AdjacencyIndexBuffer.GetNumIndices() != 0;
+	}
+}
+
 void FStaticMeshLODResources::Serialize(FArchive& Ar, UObject* Owner, int32 Index)
 {
 	// On cooked platforms we never need the resource data.
@@ -284,25 +305,66 @@ void FStaticMeshLODResources::Serialize(FArchive& Ar, UObject* Owner, int32 Inde
 	Ar << Sections;
 	Ar << MaxDeviation;
 
+	if (Ar.UE4Ver() >= VER_UE4_STATIC_MESH_LOD_STREAMING)
+	{
+		// FStaticMeshRenderData::Serialize decides which LODs are streamed when cooking.
+		if (Ar.IsSaving() && (!Ar.IsCooking() || StripFlags.IsDataStrippedForServer()))
+		{
+			bIsStreamable = false;
+		}
+		Ar << bIsStreamable;
+	}
+
 	if( !StripFlags.IsDataStrippedForServer() )
 	{
-		PositionVertexBuffer.Serialize( Ar, bNeedsCPUAccess );
-			VertexBuffer.Serialize( Ar, bNeedsCPUAccess );
-				ColorVertexBuffer.Serialize( Ar, bNeedsCPUAccess );
-		IndexBuffer.Serialize( Ar, bNeedsCPUAccess );
-		DepthOnlyIndexBuffer.Serialize(Ar, bNeedsCPUAccess);
-		if( !StripFlags.IsEditorDataStripped() )
+		bool bWithWireframe = !StripFlags.IsEditorDataStripped();
+		bool bWithAdjacency = !StripFlags.IsClassDataStripped( AdjacencyDataStripFlag );
+
+		if (bIsStreamable)
 		{
-			WireframeIndexBuffer.Serialize(Ar, bNeedsCPUAccess);
+			if (Ar.IsSaving())
+			{
+				// The streamed payload records which optional buffers it contains, as the strip flags aren't available when it is loaded.
+				TArray<uint8> Payload;
+				FMemoryWriter PayloadWriter(Payload, true);
+				PayloadWriter.SetByteSwapping(Ar.ForceByteSwapping());
+				PayloadWriter << bWithWireframe;
+				PayloadWriter << bWithAdjacency;
+				SerializeLODBuffers(PayloadWriter, *this, bNeedsCPUAccess, bWithWireframe, bWithAdjacency);
+
+				StreamingBulkData.Lock(LOCK_READ_WRITE);
+				void* BulkDataPtr = StreamingBulkData.Realloc(Payload.Num());
+				FMemory::Memcpy(BulkDataPtr, Payload.GetData(), Payload.Num());
+				StreamingBulkData.Unlock();
+
+				StreamableNumVertices = VertexBuffer.GetNumVertices();
+				StreamableNumTexCoords = VertexBuffer.GetNumTexCoords();
+			}
+			Ar << StreamableNumVertices;
+			Ar << StreamableNumTexCoords;
+			StreamingBulkData.Serialize(Ar, Owner, Index);
 		}
-		if ( !StripFlags.IsClassDataStripped( AdjacencyDataStripFlag ) )
+		else
 		{
-			AdjacencyIndexBuffer.Serialize( Ar, bNeedsCPUAccess );
-			bHasAdjacencyInfo = AdjacencyIndexBuffer.GetNumIndices() != 0;
+			SerializeLODBuffers(Ar, *this, bNeedsCPUAccess, bWithWireframe, bWithAdjacency);
 		}
 	}
 }
 
+void FStaticMeshLODResources::SerializeStreamedBuffers(const uint8* Data, int32 DataSize)
+{
+	check(bIsStreamable);
+	const bool bNeedsCPUAccess = !FPlatformProperties::RequiresCookedData();
+
+	FBufferReader PayloadReader((void*)Data, DataSize, false, true);
+	bool bWithWireframe = false;
+	bool bWithAdjacency = false;
+	PayloadReader << bWithWireframe;
+	PayloadReader << bWithAdjacency;
+	bHasAdjacencyInfo = false;
+	SerializeLODBuffers(PayloadReader, *this, bNeedsCPUAccess, bWithWireframe, bWithAdjacency);
+}
+
 int32 FStaticMeshLODResources::GetNumTriangles() const
 {
 	int32 NumTriangles = 0;
@@ -315,12 +377,12 @@ int32 FStaticMeshLODResources::GetNumTriangles() const
 
 int32 FStaticMeshLODResources::GetNumVertices() const
 {
-	return VertexBuffer.GetNumVertices();
+	return bIsStreamable ? StreamableNumVertices : VertexBuffer.GetNumVertices();
 }
 
 int32 FStaticMeshLODResources::GetNumTexCoords() const
 {
-	return VertexBuffer.GetNumTexCoords();
+	return bIsStreamable ? StreamableNumTexCoords : VertexBuffer.GetNumTexCoords();
 }
 
 void FStaticMeshLODResources::InitVertexFactory(
@@ -525,7 +587,9 @@ void FStaticMeshLODResources::ReleaseResources()
 ------------------------------------------------------------------------------*/
 
 FStaticMeshRenderData::FStaticMeshRenderData()
-	: MaxStreamingTextureFactor(0.0f)
+	: NumStreamableLODs(0)
+	, CurrentFirstLODIdx(0)
+	, MaxStreamingTextureFactor(0.0f)
 	, bLODsShareStaticLighting(false)
 {
 	for (int32 LODIndex = 0; LODIndex < MAX_STATIC_MESH_LODS; ++LODIndex)
@@ -554,7 +618,29 @@ void FStaticMeshRenderData::Serialize(FArchive& Ar, UStaticMesh* Owner, bool bCo
 
 #endif // #if WITH_EDITORONLY_DATA
 
+	if (Ar.IsSaving())
+	{
+		// Every LOD but the last one of a mesh that allows it can be streamed, meshes always keep their lowest LOD resident.
+		const bool bAllowLODStreaming = Ar.IsCooking() && Owner->bAllowLODStreaming;
+		for (int32 LODIndex = 0; LODIndex < LODResources.Num(); ++LODIndex)
+		{
+			LODResources[LODIndex].bIsStreamable = bAllowLODStreaming && LODIndex < LODResources.Num() - 1;
+		}
+	}
+
 	LODResources.Serialize(Ar, Owner);
+
+	if (Ar.IsLoading())
+	{
+		// Streamable LODs start out without any vertex or index data.
+		NumStreamableLODs = 0;
+		while (NumStreamableLODs < LODResources.Num() && LODResources[NumStreamableLODs].bIsStreamable)
+		{
+			NumStreamableLODs++;
+		}
+		CurrentFirstLODIdx = NumStreamableLODs;
+	}
+
 	Ar << Bounds;
 	Ar << bLODsShareStaticLighting;
 	Ar << bReducedBySimplygon;
@@ -580,7 +666,7 @@ void FStaticMeshRenderData::InitResources(UStaticMesh* Owner)
 	ResolveSectionInfo(Owner);
 #endif // #if WITH_EDITORONLY_DATA
 
-	for (int32 LODIndex = 0; LODIndex < LODResources.Num(); ++LODIndex)
+	for (int32 LODIndex = CurrentFirstLODIdx; LODIndex < LODResources.Num(); ++LODIndex)
 	{
 		LODResources[LODIndex].InitResources(Owner);
 	}
@@ -588,12 +674,27 @@ void FStaticMeshRenderData::InitResources(UStaticMesh* Owner)
 
 void FStaticMeshRenderData::ReleaseResources()
 {
-	for (int32 LODIndex = 0; LODIndex < LODResources.Num(); ++LODIndex)
+	for (int32 LODIndex = CurrentFirstLODIdx; LODIndex < LODResources.Num(); ++LODIndex)
 	{
 		LODResources[LODIndex].ReleaseResources();
 	}
 }
 
+void FStaticMeshRenderData::LoadAllStreamableLODs(UStaticMesh* Owner)
+{
+	const int32 FirstLODIdx = CurrentFirstLODIdx;
+	for (int32 LODIndex = 0; LODIndex < FirstLODIdx; ++LODIndex)
+	{
+		FStaticMeshLODResources& LOD = LODResources[LODIndex];
+		void* LODData = NULL;
+		LOD.StreamingBulkData.GetCopy(&LODData, true);
+		LOD.SerializeStreamedBuffers((uint8*)LODData, LOD.StreamingBulkData.GetBulkDataSize());
+		FMemory::Free(LODData);
+		LOD.InitResources(Owner);
+	}
+	CurrentFirstLODIdx = 0;
+}
+
 void FStaticMeshRenderData::AllocateLODResources(int32 NumLODs)
 {
 	check(LODResources.Num() == 0);
@@ -926,7 +1027,7 @@ FArchive& operator<<(FArchive& Ar, FMeshBuildSettings& BuildSettings)
 // differences, etc.) replace the version GUID below with a new one.
 // In case of merge conflicts with DDC versions, you MUST generate a new GUID
 // and set this new GUID as the version.
-#define STATICMESH_DERIVEDDATA_VER TEXT("9E3F518AAD424921BA8F9A1C5966F0B9")
+#define STATICMESH_DERIVEDDATA_VER TEXT("8C6F2D0B4E7A4B19A5D3F1E26B90C47D")
 
 static const FString& GetStaticMeshDerivedDataVersion()
 {
@@ -1066,6 +1167,7 @@ UStaticMesh::UStaticMesh(const FPostConstructInitializeProperties& PCIP)
 	ElementToIgnoreForTexFactor = -1;
 	StreamingDistanceMultiplier=1.0f;
 	bHasNavigationData=true;
+	bForceAllLODsResident=false;
 #if WITH_EDITORONLY_DATA
 	AutoLODPixelError = 1.0f;
 	bAutoComputeLODScreenSize=true;
@@ -1081,6 +1183,20 @@ void UStaticMesh::InitResources()
 	if (RenderData)
 	{
 		RenderData->InitResources(this);
+
+		if (RenderData->NumStreamableLODs > 0)
+		{
+			// Let the streaming manager load the streamable LODs when components need them, or load them right away if there is none.
+			FStreamingManagerCollection& StreamingManager = IStreamingManager::Get();
+			if (StreamingManager.IsStaticMeshStreamingEnabled())
+			{
+				StreamingManager.GetStaticMeshStreamingManager().AddStreamingMesh(this);
+			}
+			else
+			{
+				RenderData->LoadAllStreamableLODs(this);
+			}
+		}
 	}
 
 #if STATS
@@ -1235,6 +1351,10 @@ void UStaticMesh::ReleaseResources()
 
 	if (RenderData)
 	{
+		if (RenderData->NumStreamableLODs > 0 && !IStreamingManager::HasShutdown() && IStreamingManager::Get().IsStaticMeshStreamingEnabled())
+		{
+			IStreamingManager::Get().GetStaticMeshStreamingManager().RemoveStreamingMesh(this);
+		}
 		RenderData->ReleaseResources();
 	}
 
@@ -1334,9 +1454,9 @@ void UStaticMesh::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
 	if (RenderData && RenderData->LODResources.Num() > 0)
 	{
 		const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
-		NumTriangles = LOD.IndexBuffer.GetNumIndices() / 3;
-		NumVertices = LOD.VertexBuffer.GetNumVertices();
-		NumUVChannels = LOD.VertexBuffer.GetNumTexCoords();
+		NumTriangles = LOD.GetNumTriangles();
+		NumVertices = LOD.GetNumVertices();
+		NumUVChannels = LOD.GetNumTexCoords();
 	}
 
 	int32 NumCollisionPrims = 0;
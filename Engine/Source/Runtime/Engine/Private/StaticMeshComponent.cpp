@@ -401,7 +401,7 @@ void UStaticMeshComponent::GetStreamingTextureInfo(TArray<FStreamingTexturePrimi
 		bool bHasValidLightmapCoordinates = ((StaticMesh->LightMapCoordinateIndex >= 0)
 			&& StaticMesh->RenderData
 			&& StaticMesh->RenderData->LODResources.Num() > 0
-			&& ((uint32)StaticMesh->LightMapCoordinateIndex < StaticMesh->RenderData->LODResources[0].VertexBuffer.GetNumTexCoords()));
+			&& ((uint32)StaticMesh->LightMapCoordinateIndex < StaticMesh->RenderData->LODResources[0].GetNumTexCoords()));
 
 		// We need to come up with a compensation factor for spline deformed meshes
 		float SplineDeformFactor = 1.f;
@@ -1295,7 +1295,7 @@ bool UStaticMeshComponent::HasLightmapTextureCoordinates() const
 		(StaticMesh->RenderData != NULL) &&
 		(StaticMesh->RenderData->LODResources.Num() > 0) &&
 		(StaticMesh->LightMapCoordinateIndex >= 0) &&	
-		((uint32)StaticMesh->LightMapCoordinateIndex < StaticMesh->RenderData->LODResources[0].VertexBuffer.GetNumTexCoords()))
+		((uint32)StaticMesh->LightMapCoordinateIndex < StaticMesh->RenderData->LODResources[0].GetNumTexCoords()))
 	{
 		return true;
 	}
@@ -1540,6 +1540,12 @@ void UStaticMeshComponent::ApplyComponentInstanceData(const FComponentInstanceDa
 
 void UStaticMeshComponent::CreateRenderState_Concurrent()
 {
+	// Let the mesh streaming manager know about the component before its scene proxy picks the LODs it can render.
+	if (StaticMesh != NULL && StaticMesh->RenderData != NULL && StaticMesh->RenderData->NumStreamableLODs > 0 && IStreamingManager::Get().IsStaticMeshStreamingEnabled())
+	{
+		IStreamingManager::Get().GetStaticMeshStreamingManager().AddStaticMeshComponent(this);
+	}
+
 	Super::CreateRenderState_Concurrent();
 
 	if (StaticMesh != NULL && StaticMesh->SpeedTreeWind.IsValid())
@@ -1552,6 +1558,12 @@ void UStaticMeshComponent::DestroyRenderState_Concurrent()
 {
 	Super::DestroyRenderState_Concurrent();
 
+	// The static mesh may have changed since the render state was created, so always let the manager look the component up.
+	if (!IStreamingManager::HasShutdown() && IStreamingManager::Get().IsStaticMeshStreamingEnabled())
+	{
+		IStreamingManager::Get().GetStaticMeshStreamingManager().RemoveStaticMeshComponent(this);
+	}
+
 	if (StaticMesh != NULL && StaticMesh->SpeedTreeWind.IsValid())
 	{
 		GetScene()->RemoveSpeedTreeWind(StaticMesh);
@@ -49,6 +49,7 @@ FStaticMeshSceneProxy::FStaticMeshSceneProxy(UStaticMeshComponent* InComponent):
 	BodySetup(InComponent->GetBodySetup()),
 	RenderData(InComponent->StaticMesh->RenderData),
 	ForcedLodModel(InComponent->ForcedLodModel),
+	FirstResidentLODIdx(InComponent->StaticMesh->RenderData->CurrentFirstLODIdx),
 	LevelColor(1,1,1),
 	PropertyColor(1,1,1),
 	bCastShadow(InComponent->CastShadow),
@@ -377,7 +378,7 @@ void FStaticMeshSceneProxy::DrawStaticElements(FStaticPrimitiveDrawInterface* PD
 		//check if a LOD is being forced
 		if (ForcedLodModel > 0) 
 		{
-			int32 LODIndex = FMath::Clamp(ForcedLodModel, 1, NumLODs) - 1;
+			int32 LODIndex = FMath::Max(FMath::Clamp(ForcedLodModel, 1, NumLODs) - 1, FirstResidentLODIdx);
 			const FStaticMeshLODResources& LODModel = RenderData->LODResources[LODIndex];
 			// Draw the static mesh elements.
 			for(int32 SectionIndex = 0; SectionIndex < LODModel.Sections.Num(); SectionIndex++)
@@ -401,7 +402,7 @@ void FStaticMeshSceneProxy::DrawStaticElements(FStaticPrimitiveDrawInterface* PD
 		} 
 		else //no LOD is being forced, submit them all with appropriate cull distances
 		{
-			for(int32 LODIndex = 0; LODIndex < NumLODs; LODIndex++)
+			for(int32 LODIndex = FirstResidentLODIdx; LODIndex < NumLODs; LODIndex++)
 			{
 				const FStaticMeshLODResources& LODModel = RenderData->LODResources[LODIndex];
 				float ScreenSize = GetScreenSize(LODIndex);
@@ -896,8 +897,8 @@ FStaticMeshSceneProxy::FLODInfo::FLODInfo(const UStaticMeshComponent* InComponen
 		ShadowMap = ComponentLODInfo.ShadowMap;
 		IrrelevantLights = InComponent->IrrelevantLights;
 
-		// Initialize this LOD's overridden vertex colors, if it has any
-		if( ComponentLODInfo.OverrideVertexColors )
+		// Initialize this LOD's overridden vertex colors, if it has any. LODs that aren't streamed in have no buffers to bind.
+		if( ComponentLODInfo.OverrideVertexColors && LODIndex >= RenderData->CurrentFirstLODIdx )
 		{
 			FStaticMeshLODResources& LODRenderData = RenderData->LODResources[LODIndex];
 			
@@ -1038,23 +1039,23 @@ int32 FStaticMeshSceneProxy::GetLOD(const FSceneView* View) const
 	//If a LOD is being forced, use that one
 	if (CVarForcedLODLevel >= 0)
 	{
-		return FMath::Clamp<int32>(CVarForcedLODLevel, 0, RenderData->LODResources.Num() - 1);
+		return FMath::Clamp<int32>(CVarForcedLODLevel, FirstResidentLODIdx, RenderData->LODResources.Num() - 1);
 	}
 
 	if (ForcedLodModel > 0)
 	{
-		return FMath::Clamp(ForcedLodModel, 1, RenderData->LODResources.Num()) - 1;
+		return FMath::Max(FMath::Clamp(ForcedLodModel, 1, RenderData->LODResources.Num()) - 1, FirstResidentLODIdx);
 	}
 
 #if WITH_EDITOR
 	if (View->Family && View->Family->EngineShowFlags.LOD == 0)
 	{
-		return 0;
+		return FirstResidentLODIdx;
 	}
 #endif
 
 	const FBoxSphereBounds& Bounds = GetBounds();
-	return ComputeStaticMeshLOD(RenderData, Bounds.Origin, Bounds.SphereRadius, *View);
+	return FMath::Max<int32>(ComputeStaticMeshLOD(RenderData, Bounds.Origin, Bounds.SphereRadius, *View), FirstResidentLODIdx);
 }
 
 FPrimitiveSceneProxy* UStaticMeshComponent::CreateSceneProxy()
@@ -1062,7 +1063,7 @@ FPrimitiveSceneProxy* UStaticMeshComponent::CreateSceneProxy()
 	if(StaticMesh == NULL
 		|| StaticMesh->RenderData == NULL
 		|| StaticMesh->RenderData->LODResources.Num() == 0
-		|| StaticMesh->RenderData->LODResources[0].VertexBuffer.GetNumVertices() == 0)
+		|| StaticMesh->RenderData->LODResources[StaticMesh->RenderData->CurrentFirstLODIdx].VertexBuffer.GetNumVertices() == 0)
 	{
 		return NULL;
 	}
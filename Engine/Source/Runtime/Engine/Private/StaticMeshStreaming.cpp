@@ -0,0 +1,616 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	StaticMeshStreaming.cpp: Streaming of static mesh LODs.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStaticMeshStreaming, Log, All);
+
+DEFINE_STAT(STAT_StreamingStaticMeshes);
+DEFINE_STAT(STAT_NumWantingStaticMeshes);
+DEFINE_STAT(STAT_StreamedStaticMeshLODsSize);
+DEFINE_STAT(STAT_StaticMeshStreamingUpdateTime);
+
+/** Budget for the streamable LODs that are resident or being loaded, in MB. */
+static int32 GMeshStreamingPoolSize = 64;
+static FAutoConsoleVariableRef CVarMeshStreamingPoolSize(
+	TEXT("r.MeshStreaming.PoolSize"),
+	GMeshStreamingPoolSize,
+	TEXT("Budget in MB for streamed static mesh LODs. LODs nobody wants are evicted once it is exceeded, and LODs that don't fit aren't loaded."),
+	ECVF_Default
+	);
+
+/** Maximum number of meshes to start loading LODs for in one update. */
+static int32 GMeshStreamingMaxLoadsPerUpdate = 8;
+static FAutoConsoleVariableRef CVarMeshStreamingMaxLoadsPerUpdate(
+	TEXT("r.MeshStreaming.MaxLoadsPerUpdate"),
+	GMeshStreamingMaxLoadsPerUpdate,
+	TEXT("Maximum number of meshes to start loading LODs for in a single streaming update."),
+	ECVF_Default
+	);
+
+/** Scale applied to screen sizes when picking the LODs to load, so that LODs are resident a little before they are drawn. */
+static float GMeshStreamingScreenSizeScale = 2.0f;
+static FAutoConsoleVariableRef CVarMeshStreamingScreenSizeScale(
+	TEXT("r.MeshStreaming.ScreenSizeScale"),
+	GMeshStreamingScreenSizeScale,
+	TEXT("Scale applied to the screen size of meshes when deciding which LODs to stream in. Values above 1 load LODs before they are needed."),
+	ECVF_Default
+	);
+
+/**
+ * A static mesh with streamable LODs, tracked by FStreamingManagerStaticMesh.
+ */
+struct FStreamingStaticMesh
+{
+	FStreamingStaticMesh( UStaticMesh* InStaticMesh )
+	:	StaticMesh( InStaticMesh )
+	,	WantedFirstLODIdx( InStaticMesh->RenderData->CurrentFirstLODIdx )
+	,	PendingFirstLODIdx( InStaticMesh->RenderData->CurrentFirstLODIdx )
+	,	NumComponentsRequiringAllLODs( 0 )
+	,	MaxScreenSize( 0.0f )
+	,	LastWantedTime( 0.0 )
+	{
+	}
+
+	/** Whether loads for the mesh are in flight or waiting to be finished. */
+	bool IsStreamingIn() const
+	{
+		return PendingFirstLODIdx < StaticMesh->RenderData->CurrentFirstLODIdx;
+	}
+
+	/** Whether a user of the mesh renders LOD 0 directly, so that every LOD has to be resident whatever the views. */
+	bool RequiresAllLODs() const
+	{
+		return NumComponentsRequiringAllLODs > 0 || StaticMesh->bForceAllLODsResident;
+	}
+
+	/** The mesh. */
+	UStaticMesh* StaticMesh;
+
+	/** Components that currently have render state for the mesh. */
+	TArray<const UStaticMeshComponent*> Components;
+
+	/** Most detailed LOD wanted by any view, as of the last update. */
+	int32 WantedFirstLODIdx;
+
+	/** First LOD being loaded, or the current first LOD if nothing is being loaded. */
+	int32 PendingFirstLODIdx;
+
+	/** Number of components that build their own vertex factories for every LOD, e.g. instanced or spline meshes. */
+	int32 NumComponentsRequiringAllLODs;
+
+	/** Largest screen size of the mesh in any view, used to load the most visible meshes first. */
+	float MaxScreenSize;
+
+	/** Last time all resident LODs were wanted, in seconds. */
+	double LastWantedTime;
+
+	/** Decremented by the async IO system as loads complete. */
+	FThreadSafeCounter PendingIORequests;
+
+	/** Indices of the pending IO requests, so they can be canceled. */
+	TArray<uint64> IORequestIndices;
+
+	/** Destination of the pending loads, holding LODs [PendingFirstLODIdx, CurrentFirstLODIdx) back to back. */
+	TArray<uint8> PendingLODData;
+
+	/** Fence for the release of evicted LODs, which can't be loaded again before it completes. */
+	FRenderCommandFence ReleaseFence;
+};
+
+/** Returns the size of the streamable LODs from FirstLODIdx on, in bytes. */
+static int64 GetStreamedLODsSize( const FStaticMeshRenderData* RenderData, int32 FirstLODIdx )
+{
+	int64 Size = 0;
+	for( int32 LODIndex = FirstLODIdx; LODIndex < RenderData->NumStreamableLODs; LODIndex++ )
+	{
+		Size += RenderData->LODResources[LODIndex].StreamingBulkData.GetBulkDataSize();
+	}
+	return Size;
+}
+
+/*-----------------------------------------------------------------------------
+	FStreamingManagerStaticMesh implementation.
+-----------------------------------------------------------------------------*/
+
+FStreamingManagerStaticMesh::FStreamingManagerStaticMesh()
+:	StreamedLODsSize( 0 )
+,	DisregardWorldResourcesForFrames( 0 )
+{
+}
+
+FStreamingManagerStaticMesh::~FStreamingManagerStaticMesh()
+{
+	for( TMap<UStaticMesh*, FStreamingStaticMesh*>::TIterator It(StreamingMeshes); It; ++It )
+	{
+		CancelStreamIn( *It.Value() );
+		delete It.Value();
+	}
+	for( int32 MeshIndex = 0; MeshIndex < PendingDeletion.Num(); MeshIndex++ )
+	{
+		CancelStreamIn( *PendingDeletion[MeshIndex] );
+		delete PendingDeletion[MeshIndex];
+	}
+}
+
+void FStreamingManagerStaticMesh::AddStreamingMesh( UStaticMesh* StaticMesh )
+{
+	check( IsInGameThread() );
+	FScopeLock ScopeLock( &CriticalSection );
+	if( !StreamingMeshes.Contains(StaticMesh) )
+	{
+		StreamingMeshes.Add( StaticMesh, new FStreamingStaticMesh(StaticMesh) );
+		StreamedLODsSize += GetStreamedLODsSize( StaticMesh->RenderData, StaticMesh->RenderData->CurrentFirstLODIdx );
+		INC_DWORD_STAT( STAT_StreamingStaticMeshes );
+	}
+}
+
+void FStreamingManagerStaticMesh::RemoveStreamingMesh( UStaticMesh* StaticMesh )
+{
+	check( IsInGameThread() );
+	FScopeLock ScopeLock( &CriticalSection );
+	FStreamingStaticMesh* StreamingMesh = NULL;
+	if( StreamingMeshes.RemoveAndCopyValue(StaticMesh, StreamingMesh) )
+	{
+		FStaticMeshRenderData* RenderData = StaticMesh->RenderData;
+		StreamedLODsSize -= GetStreamedLODsSize( RenderData, StreamingMesh->PendingFirstLODIdx );
+		DEC_DWORD_STAT( STAT_StreamingStaticMeshes );
+
+		for( int32 ComponentIndex = 0; ComponentIndex < StreamingMesh->Components.Num(); ComponentIndex++ )
+		{
+			ComponentMeshes.Remove( StreamingMesh->Components[ComponentIndex] );
+		}
+
+		if( StreamingMesh->PendingIORequests.GetValue() > 0 )
+		{
+			// The async IO system may still write into the pending data, so hold on to it until it's done.
+			FIOSystem::Get().CancelRequests( StreamingMesh->IORequestIndices.GetData(), StreamingMesh->IORequestIndices.Num() );
+			StreamingMesh->StaticMesh = NULL;
+			PendingDeletion.Add( StreamingMesh );
+		}
+		else
+		{
+			delete StreamingMesh;
+		}
+	}
+}
+
+void FStreamingManagerStaticMesh::AddStaticMeshComponent( const UStaticMeshComponent* Component )
+{
+	FScopeLock ScopeLock( &CriticalSection );
+	FStreamingStaticMesh** StreamingMeshPtr = StreamingMeshes.Find( Component->StaticMesh );
+	if( StreamingMeshPtr && !ComponentMeshes.Contains(Component) )
+	{
+		FStreamingStaticMesh& StreamingMesh = **StreamingMeshPtr;
+
+		// Only plain static mesh components can render a mesh whose first LODs aren't resident. The others don't create a proxy until
+		// the next update has loaded every LOD and recreated their render state.
+		if( Component->GetClass() != UStaticMeshComponent::StaticClass() )
+		{
+			StreamingMesh.NumComponentsRequiringAllLODs++;
+		}
+
+		StreamingMesh.Components.Add( Component );
+		ComponentMeshes.Add( Component, Component->StaticMesh );
+	}
+}
+
+void FStreamingManagerStaticMesh::RemoveStaticMeshComponent( const UStaticMeshComponent* Component )
+{
+	FScopeLock ScopeLock( &CriticalSection );
+	UStaticMesh* StaticMesh = NULL;
+	if( ComponentMeshes.RemoveAndCopyValue(Component, StaticMesh) )
+	{
+		FStreamingStaticMesh** StreamingMeshPtr = StreamingMeshes.Find( StaticMesh );
+		if( StreamingMeshPtr )
+		{
+			FStreamingStaticMesh& StreamingMesh = **StreamingMeshPtr;
+			StreamingMesh.Components.RemoveSingleSwap( Component );
+			if( Component->GetClass() != UStaticMeshComponent::StaticClass() )
+			{
+				StreamingMesh.NumComponentsRequiringAllLODs--;
+			}
+		}
+	}
+}
+
+void FStreamingManagerStaticMesh::UpdateWantedLOD( FStreamingStaticMesh& StreamingMesh, double CurrentTime )
+{
+	const FStaticMeshRenderData* RenderData = StreamingMesh.StaticMesh->RenderData;
+	const int32 NumLODs = RenderData->LODResources.Num();
+
+	int32 WantedLODIdx = RenderData->NumStreamableLODs;
+	float MaxScreenSize = 0.0f;
+
+	if( StreamingMesh.RequiresAllLODs() )
+	{
+		// Load these first, their users render nothing until they are resident.
+		WantedLODIdx = 0;
+		MaxScreenSize = MAX_FLT;
+	}
+
+	for( int32 ComponentIndex = 0; ComponentIndex < StreamingMesh.Components.Num() && WantedLODIdx > 0; ComponentIndex++ )
+	{
+		const UStaticMeshComponent* Component = StreamingMesh.Components[ComponentIndex];
+		if( Component->ForcedLodModel > 0 )
+		{
+			WantedLODIdx = FMath::Min( WantedLODIdx, FMath::Clamp(Component->ForcedLodModel, 1, NumLODs) - 1 );
+			continue;
+		}
+
+		const FBoxSphereBounds& Bounds = Component->Bounds;
+		for( int32 ViewIndex = 0; ViewIndex < GetNumViews(); ViewIndex++ )
+		{
+			const FStreamingViewInfo& ViewInfo = GetViewInformation( ViewIndex );
+
+			// Same metric as ComputeBoundsScreenSize, using the distance to the bounds and a 16:9 view to err towards more detail.
+			const float Distance = FMath::Max( (Bounds.Origin - ViewInfo.ViewOrigin).Size() - Bounds.SphereRadius, 1.0f );
+			const float ScreenRadius = 0.5f * ViewInfo.FOVScreenSize * Bounds.SphereRadius / Distance;
+			const float ScreenArea = ViewInfo.ScreenSize * ViewInfo.ScreenSize * 9.0f / 16.0f;
+			const float ScreenSize = PI * ScreenRadius * ScreenRadius / FMath::Max( ScreenArea, 1.0f ) * ViewInfo.BoostFactor;
+			MaxScreenSize = FMath::Max( MaxScreenSize, ScreenSize );
+		}
+	}
+
+	if( MaxScreenSize > 0.0f && WantedLODIdx > 0 )
+	{
+		// Pick the LOD the same way ComputeStaticMeshLOD does.
+		const float ScaledScreenSize = MaxScreenSize * GMeshStreamingScreenSizeScale;
+		int32 ScreenSizeLODIdx = 0;
+		for( int32 LODIndex = NumLODs - 1; LODIndex >= 0; LODIndex-- )
+		{
+			if( RenderData->ScreenSize[LODIndex] > ScaledScreenSize )
+			{
+				ScreenSizeLODIdx = LODIndex;
+				break;
+			}
+		}
+		WantedLODIdx = FMath::Min( WantedLODIdx, ScreenSizeLODIdx );
+	}
+
+	StreamingMesh.WantedFirstLODIdx = WantedLODIdx;
+	StreamingMesh.MaxScreenSize = MaxScreenSize;
+	if( WantedLODIdx <= RenderData->CurrentFirstLODIdx )
+	{
+		StreamingMesh.LastWantedTime = CurrentTime;
+	}
+}
+
+void FStreamingManagerStaticMesh::StreamIn( FStreamingStaticMesh& StreamingMesh, int32 NewFirstLODIdx )
+{
+	FStaticMeshRenderData* RenderData = StreamingMesh.StaticMesh->RenderData;
+	const int32 CurrentFirstLODIdx = RenderData->CurrentFirstLODIdx;
+	check( !StreamingMesh.IsStreamingIn() && NewFirstLODIdx < CurrentFirstLODIdx );
+
+	const int64 RequestSize = GetStreamedLODsSize( RenderData, NewFirstLODIdx ) - GetStreamedLODsSize( RenderData, CurrentFirstLODIdx );
+	StreamingMesh.PendingLODData.Empty( (int32)RequestSize );
+	StreamingMesh.PendingLODData.AddUninitialized( (int32)RequestSize );
+	StreamingMesh.IORequestIndices.Empty( CurrentFirstLODIdx - NewFirstLODIdx );
+
+	// Account for all requests up front, so that the first ones completing can't be mistaken for the whole load completing.
+	StreamingMesh.PendingIORequests.Add( CurrentFirstLODIdx - NewFirstLODIdx );
+
+	uint8* Dest = StreamingMesh.PendingLODData.GetData();
+	for( int32 LODIndex = NewFirstLODIdx; LODIndex < CurrentFirstLODIdx; LODIndex++ )
+	{
+		FByteBulkData& BulkData = RenderData->LODResources[LODIndex].StreamingBulkData;
+		check( BulkData.GetFilename().Len() );
+		if( BulkData.IsStoredCompressedOnDisk() )
+		{
+			StreamingMesh.IORequestIndices.Add( FIOSystem::Get().LoadCompressedData(
+				BulkData.GetFilename(),
+				BulkData.GetBulkDataOffsetInFile(),
+				BulkData.GetBulkDataSizeOnDisk(),
+				BulkData.GetBulkDataSize(),
+				Dest,
+				BulkData.GetDecompressionFlags(),
+				&StreamingMesh.PendingIORequests,
+				AIOP_BelowNormal
+				) );
+		}
+		else
+		{
+			StreamingMesh.IORequestIndices.Add( FIOSystem::Get().LoadData(
+				BulkData.GetFilename(),
+				BulkData.GetBulkDataOffsetInFile(),
+				BulkData.GetBulkDataSize(),
+				Dest,
+				&StreamingMesh.PendingIORequests,
+				AIOP_BelowNormal
+				) );
+		}
+		Dest += BulkData.GetBulkDataSize();
+	}
+
+	StreamingMesh.PendingFirstLODIdx = NewFirstLODIdx;
+	StreamedLODsSize += RequestSize;
+}
+
+void FStreamingManagerStaticMesh::FinishStreamIn( FStreamingStaticMesh& StreamingMesh )
+{
+	check( StreamingMesh.IsStreamingIn() && StreamingMesh.PendingIORequests.GetValue() == 0 );
+	UStaticMesh* StaticMesh = StreamingMesh.StaticMesh;
+	FStaticMeshRenderData* RenderData = StaticMesh->RenderData;
+
+	const uint8* Data = StreamingMesh.PendingLODData.GetData();
+	for( int32 LODIndex = StreamingMesh.PendingFirstLODIdx; LODIndex < RenderData->CurrentFirstLODIdx; LODIndex++ )
+	{
+		FStaticMeshLODResources& LOD = RenderData->LODResources[LODIndex];
+		const int32 LODDataSize = LOD.StreamingBulkData.GetBulkDataSize();
+		LOD.SerializeStreamedBuffers( Data, LODDataSize );
+		LOD.InitResources( StaticMesh );
+		Data += LODDataSize;
+	}
+	StreamingMesh.PendingLODData.Empty();
+	StreamingMesh.IORequestIndices.Empty();
+
+	RenderData->CurrentFirstLODIdx = StreamingMesh.PendingFirstLODIdx;
+	RecreateRenderStates( StreamingMesh );
+}
+
+void FStreamingManagerStaticMesh::StreamOut( FStreamingStaticMesh& StreamingMesh, int32 NewFirstLODIdx )
+{
+	FStaticMeshRenderData* RenderData = StreamingMesh.StaticMesh->RenderData;
+	const int32 OldFirstLODIdx = RenderData->CurrentFirstLODIdx;
+	check( !StreamingMesh.IsStreamingIn() && NewFirstLODIdx > OldFirstLODIdx && NewFirstLODIdx <= RenderData->NumStreamableLODs );
+
+	StreamedLODsSize -= GetStreamedLODsSize( RenderData, OldFirstLODIdx ) - GetStreamedLODsSize( RenderData, NewFirstLODIdx );
+
+	// The proxies using the evicted LODs are removed from their scenes before the LODs are released on the rendering thread.
+	RenderData->CurrentFirstLODIdx = NewFirstLODIdx;
+	StreamingMesh.PendingFirstLODIdx = NewFirstLODIdx;
+	RecreateRenderStates( StreamingMesh );
+
+	for( int32 LODIndex = OldFirstLODIdx; LODIndex < NewFirstLODIdx; LODIndex++ )
+	{
+		RenderData->LODResources[LODIndex].ReleaseResources();
+	}
+	StreamingMesh.ReleaseFence.BeginFence();
+}
+
+void FStreamingManagerStaticMesh::CancelStreamIn( FStreamingStaticMesh& StreamingMesh )
+{
+	if( StreamingMesh.PendingIORequests.GetValue() > 0 )
+	{
+		FIOSystem::Get().CancelRequests( StreamingMesh.IORequestIndices.GetData(), StreamingMesh.IORequestIndices.Num() );
+
+		// Requests that were already being processed can't be canceled, wait for them to complete.
+		while( StreamingMesh.PendingIORequests.GetValue() > 0 )
+		{
+			FPlatformProcess::Sleep( 0.001f );
+		}
+	}
+
+	if( StreamingMesh.StaticMesh && StreamingMesh.IsStreamingIn() )
+	{
+		FStaticMeshRenderData* RenderData = StreamingMesh.StaticMesh->RenderData;
+		StreamedLODsSize -= GetStreamedLODsSize( RenderData, StreamingMesh.PendingFirstLODIdx ) - GetStreamedLODsSize( RenderData, RenderData->CurrentFirstLODIdx );
+		StreamingMesh.PendingFirstLODIdx = RenderData->CurrentFirstLODIdx;
+	}
+	StreamingMesh.PendingLODData.Empty();
+	StreamingMesh.IORequestIndices.Empty();
+}
+
+bool FStreamingManagerStaticMesh::EvictUnwantedLODs( int64 SizeToFree )
+{
+	TArray<FStreamingStaticMesh*> UnwantedMeshes;
+	for( TMap<UStaticMesh*, FStreamingStaticMesh*>::TIterator It(StreamingMeshes); It; ++It )
+	{
+		FStreamingStaticMesh* StreamingMesh = It.Value();
+		if( !StreamingMesh->IsStreamingIn() && StreamingMesh->WantedFirstLODIdx > StreamingMesh->StaticMesh->RenderData->CurrentFirstLODIdx )
+		{
+			UnwantedMeshes.Add( StreamingMesh );
+		}
+	}
+
+	struct FCompareLastWantedTime
+	{
+		FORCEINLINE bool operator()( const FStreamingStaticMesh& A, const FStreamingStaticMesh& B ) const
+		{
+			return A.LastWantedTime < B.LastWantedTime;
+		}
+	};
+	UnwantedMeshes.Sort( FCompareLastWantedTime() );
+
+	int64 FreedSize = 0;
+	for( int32 MeshIndex = 0; MeshIndex < UnwantedMeshes.Num() && FreedSize < SizeToFree; MeshIndex++ )
+	{
+		FStreamingStaticMesh& StreamingMesh = *UnwantedMeshes[MeshIndex];
+		const int64 PreviousSize = StreamedLODsSize;
+		StreamOut( StreamingMesh, StreamingMesh.WantedFirstLODIdx );
+		FreedSize += PreviousSize - StreamedLODsSize;
+	}
+	return FreedSize >= SizeToFree;
+}
+
+void FStreamingManagerStaticMesh::RecreateRenderStates( FStreamingStaticMesh& StreamingMesh )
+{
+	// Recreating the render state removes and adds the component again, so iterate over a copy.
+	TArray<const UStaticMeshComponent*> Components = StreamingMesh.Components;
+	for( int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++ )
+	{
+		UStaticMeshComponent* Component = const_cast<UStaticMeshComponent*>( Components[ComponentIndex] );
+		if( Component->IsRenderStateCreated() )
+		{
+			Component->RecreateRenderState_Concurrent();
+		}
+	}
+}
+
+void FStreamingManagerStaticMesh::UpdateResourceStreaming( float DeltaTime, bool bProcessEverything )
+{
+	check( IsInGameThread() );
+	SCOPE_CYCLE_COUNTER( STAT_StaticMeshStreamingUpdateTime );
+	FScopeLock ScopeLock( &CriticalSection );
+
+	// Free the meshes that were removed while their loads were in flight.
+	for( int32 MeshIndex = PendingDeletion.Num() - 1; MeshIndex >= 0; MeshIndex-- )
+	{
+		if( PendingDeletion[MeshIndex]->PendingIORequests.GetValue() == 0 )
+		{
+			delete PendingDeletion[MeshIndex];
+			PendingDeletion.RemoveAtSwap( MeshIndex );
+		}
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	const bool bHasViews = GetNumViews() > 0;
+	TArray<FStreamingStaticMesh*> WantingMeshes;
+	int32 NumMeshesInFlight = 0;
+
+	for( TMap<UStaticMesh*, FStreamingStaticMesh*>::TIterator It(StreamingMeshes); It; ++It )
+	{
+		FStreamingStaticMesh& StreamingMesh = *It.Value();
+		if( StreamingMesh.IsStreamingIn() )
+		{
+			if( StreamingMesh.PendingIORequests.GetValue() > 0 )
+			{
+				NumMeshesInFlight++;
+				continue;
+			}
+			FinishStreamIn( StreamingMesh );
+		}
+
+		// Without any views there is nothing to base the wanted LODs on, so keep the previous ones unless every LOD is required.
+		if( bHasViews || StreamingMesh.RequiresAllLODs() )
+		{
+			UpdateWantedLOD( StreamingMesh, CurrentTime );
+		}
+		if( StreamingMesh.WantedFirstLODIdx < StreamingMesh.StaticMesh->RenderData->CurrentFirstLODIdx )
+		{
+			WantingMeshes.Add( &StreamingMesh );
+		}
+	}
+
+	const int64 Budget = int64(GMeshStreamingPoolSize) * 1024 * 1024;
+
+	if( DisregardWorldResourcesForFrames > 0 )
+	{
+		DisregardWorldResourcesForFrames--;
+	}
+	else
+	{
+		// Load the LODs of the meshes that are largest on screen first.
+		struct FCompareMaxScreenSize
+		{
+			FORCEINLINE bool operator()( const FStreamingStaticMesh& A, const FStreamingStaticMesh& B ) const
+			{
+				return A.MaxScreenSize > B.MaxScreenSize;
+			}
+		};
+		WantingMeshes.Sort( FCompareMaxScreenSize() );
+
+		int32 NumNewRequests = 0;
+		for( int32 MeshIndex = 0; MeshIndex < WantingMeshes.Num(); MeshIndex++ )
+		{
+			if( !bProcessEverything && NumNewRequests >= GMeshStreamingMaxLoadsPerUpdate )
+			{
+				break;
+			}
+
+			FStreamingStaticMesh& StreamingMesh = *WantingMeshes[MeshIndex];
+			const FStaticMeshRenderData* RenderData = StreamingMesh.StaticMesh->RenderData;
+			if( !StreamingMesh.ReleaseFence.IsFenceComplete() )
+			{
+				continue;
+			}
+
+			// Only LODs nobody wants are evicted to make room, wanted LODs that don't fit wait for the views to change.
+			// Meshes whose users can't render without every LOD are loaded even if that goes over budget.
+			const int64 RequestSize = GetStreamedLODsSize( RenderData, StreamingMesh.WantedFirstLODIdx ) - GetStreamedLODsSize( RenderData, RenderData->CurrentFirstLODIdx );
+			if( StreamedLODsSize + RequestSize > Budget && !EvictUnwantedLODs(StreamedLODsSize + RequestSize - Budget) && !StreamingMesh.RequiresAllLODs() )
+			{
+				continue;
+			}
+
+			StreamIn( StreamingMesh, StreamingMesh.WantedFirstLODIdx );
+			NumNewRequests++;
+		}
+	}
+
+	// Unwanted LODs stay resident as long as they fit, in case they are needed again soon.
+	if( StreamedLODsSize > Budget )
+	{
+		EvictUnwantedLODs( StreamedLODsSize - Budget );
+	}
+
+	NumWantingResources = WantingMeshes.Num() + NumMeshesInFlight;
+	NumWantingResourcesCounter++;
+
+	SET_DWORD_STAT( STAT_NumWantingStaticMeshes, NumWantingResources );
+	SET_MEMORY_STAT( STAT_StreamedStaticMeshLODsSize, StreamedLODsSize );
+}
+
+int32 FStreamingManagerStaticMesh::BlockTillAllRequestsFinished( float TimeLimit, bool bLogResults )
+{
+	check( IsInGameThread() );
+	FScopeLock ScopeLock( &CriticalSection );
+	const double StartTime = FPlatformTime::Seconds();
+
+	int32 NumPendingMeshes = 0;
+	for(;;)
+	{
+		NumPendingMeshes = 0;
+		for( TMap<UStaticMesh*, FStreamingStaticMesh*>::TIterator It(StreamingMeshes); It; ++It )
+		{
+			FStreamingStaticMesh& StreamingMesh = *It.Value();
+			if( StreamingMesh.IsStreamingIn() )
+			{
+				if( StreamingMesh.PendingIORequests.GetValue() == 0 )
+				{
+					FinishStreamIn( StreamingMesh );
+				}
+				else
+				{
+					NumPendingMeshes++;
+				}
+			}
+		}
+
+		if( NumPendingMeshes == 0 || (TimeLimit > 0.0f && FPlatformTime::Seconds() - StartTime > TimeLimit) )
+		{
+			break;
+		}
+		FPlatformProcess::Sleep( 0.001f );
+	}
+
+	if( bLogResults )
+	{
+		UE_LOG(LogStaticMeshStreaming, Log, TEXT("Blocking on static mesh LOD streaming took %.3f seconds (%d meshes still loading)."), FPlatformTime::Seconds() - StartTime, NumPendingMeshes);
+	}
+	return NumPendingMeshes;
+}
+
+void FStreamingManagerStaticMesh::SetDisregardWorldResourcesForFrames( int32 NumFrames )
+{
+	DisregardWorldResourcesForFrames = NumFrames;
+}
+
+bool FStreamingManagerStaticMesh::Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar )
+{
+#if !UE_BUILD_SHIPPING
+	if( FParse::Command(&Cmd,TEXT("ListStreamingMeshes")) )
+	{
+		FScopeLock ScopeLock( &CriticalSection );
+		Ar.Logf( TEXT("%d streaming meshes, %.2f MB of %d MB used by streamed LODs:"), StreamingMeshes.Num(), StreamedLODsSize / 1024.0f / 1024.0f, GMeshStreamingPoolSize );
+		for( TMap<UStaticMesh*, FStreamingStaticMesh*>::TIterator It(StreamingMeshes); It; ++It )
+		{
+			const FStreamingStaticMesh& StreamingMesh = *It.Value();
+			const FStaticMeshRenderData* RenderData = StreamingMesh.StaticMesh->RenderData;
+			Ar.Logf( TEXT("  %s: LODs %d-%d resident, %d wanted, %d pending, %d components, %.1f KB"),
+				*StreamingMesh.StaticMesh->GetPathName(),
+				RenderData->CurrentFirstLODIdx,
+				RenderData->LODResources.Num() - 1,
+				StreamingMesh.WantedFirstLODIdx,
+				StreamingMesh.PendingFirstLODIdx,
+				StreamingMesh.Components.Num(),
+				GetStreamedLODsSize(RenderData, RenderData->CurrentFirstLODIdx) / 1024.0f );
+		}
+		return true;
+	}
+#endif
+	return false;
+}
@@ -2050,6 +2050,26 @@ bool UEngine::Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar )
 	{
 		return HandleReconnectCommand( Cmd, Ar, InWorld );
 	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOREC")) )
+	{
+		return HandleDemoRecordCommand( Cmd, Ar, InWorld );
+	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOPLAY")) )
+	{
+		return HandleDemoPlayCommand( Cmd, Ar, InWorld );
+	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOSTOP")) )
+	{
+		return HandleDemoStopCommand( Cmd, Ar, InWorld );
+	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOSEEK")) )
+	{
+		return HandleDemoSeekCommand( Cmd, Ar, InWorld );
+	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOSPEED")) )
+	{
+		return HandleDemoSpeedCommand( Cmd, Ar, InWorld );
+	}
 	else if( FParse::Command( &Cmd, TEXT("TRAVEL") ) )
 	{
 		return HandleTravelCommand( Cmd, Ar, InWorld );
@@ -6975,6 +6995,13 @@ void UEngine::ShutdownWorldNetDriver( UWorld * World )
 			UE_LOG(LogNet, Log, TEXT("World NetDriver shutdown %s [%s]"), *NetDriver->GetName(), *NetDriver->NetDriverName.ToString());
 			DestroyNamedNetDriver(World, NetDriver->NetDriverName);
 		}
+
+		// Stop recording a demo as well
+		if (World->DemoNetDriver)
+		{
+			DestroyNamedNetDriver(World, World->DemoNetDriver->NetDriverName);
+			World->DemoNetDriver = NULL;
+		}
 	}
 }
 
@@ -7437,6 +7464,136 @@ bool UEngine::HandleReconnectCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorl
 	return true;
 }
 
+bool UEngine::HandleDemoRecordCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld )
+{
+	if (InWorld == NULL)
+	{
+		Ar.Log(TEXT("No world to record a demo of"));
+		return true;
+	}
+
+	if (InWorld->DemoNetDriver != NULL)
+	{
+		Ar.Log(TEXT("Already recording a demo, use DEMOSTOP first"));
+		return true;
+	}
+
+	// Clients can't record, they don't replicate anything
+	if (InWorld->GetNetMode() == NM_Client)
+	{
+		Ar.Log(TEXT("Demos can only be recorded on a server or in a standalone game"));
+		return true;
+	}
+
+	FString DemoName = FParse::Token(Cmd, 0);
+	if (DemoName.IsEmpty())
+	{
+		DemoName = TEXT("demo");
+	}
+
+	FURL DemoURL;
+	DemoURL.Map = DemoName;
+
+	if (!CreateNamedNetDriver(InWorld, NAME_DemoNetDriver, NAME_DemoNetDriver))
+	{
+		Ar.Log(TEXT("Couldn't create the demo net driver, is it in NetDriverDefinitions?"));
+		return true;
+	}
+
+	UDemoNetDriver* DemoNetDriver = CastChecked<UDemoNetDriver>(FindNamedNetDriver(InWorld, NAME_DemoNetDriver));
+	DemoNetDriver->SetWorld(InWorld);
+
+	FString Error;
+	if (!DemoNetDriver->InitListen(InWorld, DemoURL, false, Error))
+	{
+		Ar.Logf(TEXT("Couldn't record demo: %s"), *Error);
+		DestroyNamedNetDriver(InWorld, NAME_DemoNetDriver);
+		return true;
+	}
+
+	InWorld->DemoNetDriver = DemoNetDriver;
+	return true;
+}
+
+bool UEngine::HandleDemoPlayCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld )
+{
+	const FString DemoName = FParse::Token(Cmd, 0);
+	if (DemoName.IsEmpty())
+	{
+		Ar.Log(TEXT("Usage: DEMOPLAY <name>"));
+		return true;
+	}
+
+	FWorldContext &WorldContext = GetWorldContextFromWorldChecked(InWorld);
+
+	// Playing a demo is joining a server, the demo net driver stands in for the connection
+	if (WorldContext.PendingNetGame)
+	{
+		CancelPending(WorldContext);
+	}
+	ShutdownWorldNetDriver(InWorld);
+
+	FURL DemoURL;
+	DemoURL.Map = DemoName;
+
+	WorldContext.PendingNetGame = new UPendingNetGame(FPostConstructInitializeProperties(), DemoURL);
+	WorldContext.PendingNetGame->InitDemoNetDriver();
+	if (!WorldContext.PendingNetGame->NetDriver)
+	{
+		BroadcastTravelFailure(InWorld, ETravelFailure::PendingNetGameCreateFailure, WorldContext.PendingNetGame->ConnectionError);
+		WorldContext.PendingNetGame = NULL;
+	}
+	return true;
+}
+
+bool UEngine::HandleDemoStopCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld )
+{
+	if (InWorld->DemoNetDriver)
+	{
+		DestroyNamedNetDriver(InWorld, InWorld->DemoNetDriver->NetDriverName);
+		InWorld->DemoNetDriver = NULL;
+	}
+	else if (Cast<UDemoNetDriver>(InWorld->GetNetDriver()))
+	{
+		HandleDisconnect(InWorld, InWorld->GetNetDriver());
+	}
+	return true;
+}
+
+bool UEngine::HandleDemoSeekCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld )
+{
+	UDemoNetDriver* DemoNetDriver = Cast<UDemoNetDriver>(InWorld->GetNetDriver());
+	if (DemoNetDriver == NULL || !DemoNetDriver->IsPlaying())
+	{
+		Ar.Log(TEXT("Not playing a demo"));
+		return true;
+	}
+
+	// DEMOSEEK TEST checks every checkpoint of the demo against playing it from the start
+	if (FParse::Command(&Cmd, TEXT("TEST")))
+	{
+		const int32 NumFailed = DemoNetDriver->TestCheckpoints(Ar);
+		Ar.Logf(TEXT("%i checkpoints failed"), NumFailed);
+		return true;
+	}
+
+	DemoNetDriver->GotoTime(FCString::Atof(Cmd));
+	return true;
+}
+
+bool UEngine::HandleDemoSpeedCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld *InWorld )
+{
+	UDemoNetDriver* DemoNetDriver = Cast<UDemoNetDriver>(InWorld->GetNetDriver());
+	if (DemoNetDriver == NULL || !DemoNetDriver->IsPlaying())
+	{
+		Ar.Log(TEXT("Not playing a demo"));
+		return true;
+	}
+
+	DemoNetDriver->SetPlaybackRate(FCString::Atof(Cmd));
+	return true;
+}
+
 bool UEngine::MakeSureMapNameIsValid(FString& InOutMapName)
 {
 	// Check if the map name is long package name and if it actually exists.
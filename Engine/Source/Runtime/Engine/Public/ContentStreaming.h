@@ -54,6 +54,10 @@ DECLARE_MEMORY_STAT_POOL_EXTERN(TEXT("Static Textures In Memory"),STAT_TotalStat
 DECLARE_MEMORY_STAT_POOL_EXTERN(TEXT("LastRenderTime Textures In Memory"),STAT_TotalLastRenderHeuristicSize,STATGROUP_StreamingDetails,FPlatformMemory::MCR_TexturePool, );
 DECLARE_MEMORY_STAT_POOL_EXTERN(TEXT("Dynamic Textures In Memory"),STAT_TotalDynamicHeuristicSize,STATGROUP_StreamingDetails,FPlatformMemory::MCR_TexturePool, );
 DECLARE_MEMORY_STAT_POOL_EXTERN(TEXT("Forced Textures In Memory"),STAT_TotalForcedHeuristicSize,STATGROUP_StreamingDetails,FPlatformMemory::MCR_TexturePool, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Num Streaming Meshes"),STAT_StreamingStaticMeshes,STATGROUP_Streaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Num Pending Meshes"),STAT_NumWantingStaticMeshes,STATGROUP_Streaming, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Streamed Mesh LODs"),STAT_StreamedStaticMeshLODsSize,STATGROUP_Streaming, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mesh Streaming Update Time"),STAT_StaticMeshStreamingUpdateTime,STATGROUP_StreamingDetails, );
 
 // Forward declarations
 struct FStreamingTexture;
@@ -65,6 +69,10 @@ class AActor;
 template<typename T>
 class FAsyncTask;
 struct FStreamingManagerTexture;
+struct FStreamingStaticMesh;
+struct FStreamingManagerStaticMesh;
+class UStaticMesh;
+class UStaticMeshComponent;
 
 /*-----------------------------------------------------------------------------
 	Base streaming classes.
@@ -471,6 +479,27 @@ struct ITextureStreamingManager : public IStreamingManager
 	virtual bool IsManagedStreamingTexture(const UTexture2D* Texture2D) = 0;
 };
 
+/**
+ * Interface to add functions specifically related to static mesh LOD streaming
+ */
+struct IStaticMeshStreamingManager : public IStreamingManager
+{
+	/** Adds a static mesh with streamable LODs to the streaming manager. */
+	virtual void AddStreamingMesh(UStaticMesh* StaticMesh) = 0;
+
+	/** Removes a static mesh from the streaming manager, canceling its pending LOD loads. */
+	virtual void RemoveStreamingMesh(UStaticMesh* StaticMesh) = 0;
+
+	/**
+	 * Called before a static mesh component creates its scene proxy, possibly from a task thread.
+	 * LODs the component can't do without are queued for loading, the component renders once they are resident.
+	 */
+	virtual void AddStaticMeshComponent(const UStaticMeshComponent* Component) = 0;
+
+	/** Called after a static mesh component destroyed its scene proxy, possibly from a task thread. */
+	virtual void RemoveStaticMeshComponent(const UStaticMeshComponent* Component) = 0;
+};
+
 /**
  * Streaming manager collection, routing function calls to streaming managers that have been added
  * via AddStreamingManager.
@@ -549,6 +578,16 @@ struct FStreamingManagerCollection : public IStreamingManager
 	 */
 	ITextureStreamingManager& GetTextureStreamingManager() const;
 
+	/**
+	 * Checks whether static mesh LOD streaming is active
+	 */
+	bool IsStaticMeshStreamingEnabled() const;
+
+	/**
+	 * Gets a reference to the Static Mesh Streaming Manager interface
+	 */
+	IStaticMeshStreamingManager& GetStaticMeshStreamingManager() const;
+
 	/**
 	 * Adds a streaming manager to the array of managers to route function calls to.
 	 *
@@ -645,6 +684,9 @@ protected:
 
 	/** The currently added texture streaming manager. Can be NULL*/
 	FStreamingManagerTexture* TextureStreamingManager;
+
+	/** The static mesh streaming manager, only created for cooked data. Can be NULL */
+	FStreamingManagerStaticMesh* StaticMeshStreamingManager;
 };
 
 /*-----------------------------------------------------------------------------
@@ -1139,6 +1181,9 @@ protected:
 
 			/** from cvar, >=0 */
 			float MipBias;
+
+			/** from the r.OnlyStreamInTextures cvar, cached so the worker threads don't have to look it up. */
+			bool bOnlyStreamInTextures;
 		};
 
 		/** Thread-safe helper data for streaming information. */
@@ -1208,7 +1253,7 @@ protected:
 	/** Stages [0,N-2] is non-threaded data collection, Stage N-1 is wait-for-AsyncWork-and-finalize. */
 	int32					ProcessingStage;
 
-	/** Total number of processing stages (N). */
+	/** Total number of processing stages (N), from r.Streaming.NumUpdateStages. */
 	int32					NumTextureProcessingStages;
 
 	/** Maximum amount of temp memory used for streaming, at any given time. */
@@ -1418,3 +1463,131 @@ struct FStreamingHandlerTextureLevelForced : public FStreamingHandlerTextureBase
 	 */
 	virtual FFloatMipLevel GetWantedMips( FStreamingManagerTexture& StreamingManager, FStreamingTexture& StreamingTexture, float& MinDistance );
 };
+
+/*-----------------------------------------------------------------------------
+	Static mesh streaming.
+-----------------------------------------------------------------------------*/
+
+/**
+ * Streaming manager dealing with static mesh LODs. Keeps the LODs wanted by the components rendering a mesh resident,
+ * loads missing ones through the async IO system and evicts unwanted ones once the streamed LODs exceed their budget.
+ */
+struct FStreamingManagerStaticMesh : public IStaticMeshStreamingManager
+{
+	/** Constructor, initializing all members */
+	FStreamingManagerStaticMesh();
+
+	/** Destructor, waiting for pending loads to finish */
+	virtual ~FStreamingManagerStaticMesh();
+
+	/**
+	 * Updates streaming, taking into account all current view infos. Can be called multiple times per frame.
+	 *
+	 * @param DeltaTime				Time since last call in seconds
+	 * @param bProcessEverything	[opt] If true, process all resources with no throttling limits
+	 */
+	virtual void UpdateResourceStreaming( float DeltaTime, bool bProcessEverything=false );
+
+	/**
+	 * Blocks till all pending requests are fulfilled.
+	 *
+	 * @param TimeLimit		Optional time limit for processing, in seconds. Specifying 0 means infinite time limit.
+	 * @param bLogResults	Whether to dump the results to the log.
+	 * @return				Number of streaming requests still in flight, if the time limit was reached before they were finished.
+	 */
+	virtual int32 BlockTillAllRequestsFinished( float TimeLimit = 0.0f, bool bLogResults = false );
+
+	/** Meshes have no forced LODs to cancel. */
+	virtual void CancelForcedResources()
+	{
+	}
+
+	/** Wanted LODs only depend on the views, so level changes need no handling. */
+	virtual void NotifyLevelChange()
+	{
+	}
+
+	/** Don't stream world resources for the next NumFrames. */
+	virtual void SetDisregardWorldResourcesForFrames( int32 NumFrames );
+
+	/**
+	 * Allows the streaming manager to process exec commands.
+	 *
+	 * @param InWorld World context
+	 * @param Cmd	Exec command
+	 * @param Ar	Output device for feedback
+	 * @return		true if the command was handled
+	 */
+	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) OVERRIDE;
+
+	/** Components are tracked through their render state rather than through their level. */
+	virtual void AddPreparedLevel( class ULevel* Level )
+	{
+	}
+
+	/** Components are tracked through their render state rather than through their level. */
+	virtual void RemoveLevel( class ULevel* Level )
+	{
+	}
+
+	/** Adds a static mesh with streamable LODs to the streaming manager. */
+	virtual void AddStreamingMesh( UStaticMesh* StaticMesh );
+
+	/** Removes a static mesh from the streaming manager, canceling its pending LOD loads. */
+	virtual void RemoveStreamingMesh( UStaticMesh* StaticMesh );
+
+	/**
+	 * Called before a static mesh component creates its scene proxy, possibly from a task thread.
+	 * LODs the component can't do without are queued for loading, the component renders once they are resident.
+	 */
+	virtual void AddStaticMeshComponent( const UStaticMeshComponent* Component );
+
+	/** Called after a static mesh component destroyed its scene proxy, possibly from a task thread. */
+	virtual void RemoveStaticMeshComponent( const UStaticMeshComponent* Component );
+
+protected:
+
+	/** Updates the most detailed LOD the views want for the mesh. */
+	void UpdateWantedLOD( FStreamingStaticMesh& StreamingMesh, double CurrentTime );
+
+	/** Starts loading the LODs of the mesh up to and including NewFirstLODIdx. */
+	void StreamIn( FStreamingStaticMesh& StreamingMesh, int32 NewFirstLODIdx );
+
+	/** Initializes the loaded LODs of the mesh once their IO requests have completed. */
+	void FinishStreamIn( FStreamingStaticMesh& StreamingMesh );
+
+	/** Releases the LODs of the mesh before NewFirstLODIdx. */
+	void StreamOut( FStreamingStaticMesh& StreamingMesh, int32 NewFirstLODIdx );
+
+	/** Cancels the pending loads of the mesh and waits for the async IO system to let go of them. */
+	void CancelStreamIn( FStreamingStaticMesh& StreamingMesh );
+
+	/**
+	 * Evicts the resident LODs nobody wants anymore, least recently wanted first.
+	 *
+	 * @param SizeToFree	Number of bytes to free
+	 * @return				Whether at least SizeToFree bytes were freed
+	 */
+	bool EvictUnwantedLODs( int64 SizeToFree );
+
+	/** Recreates the render state of the components using the mesh, so their proxies pick up its new first LOD. */
+	void RecreateRenderStates( FStreamingStaticMesh& StreamingMesh );
+
+	/** Guards the meshes and their component lists, as components register from the tasks that create their render state. */
+	FCriticalSection CriticalSection;
+
+	/** Meshes with streamable LODs. */
+	TMap<UStaticMesh*, FStreamingStaticMesh*> StreamingMeshes;
+
+	/** The mesh each tracked component was using when it created its render state. */
+	TMap<const UStaticMeshComponent*, UStaticMesh*> ComponentMeshes;
+
+	/** Meshes that were removed while loads were in flight, deleted once the async IO system is done with them. */
+	TArray<FStreamingStaticMesh*> PendingDeletion;
+
+	/** Size of the streamable LODs that are resident or being loaded, in bytes. */
+	int64 StreamedLODsSize;
+
+	/** Number of frames to not stream in any LODs. */
+	int32 DisregardWorldResourcesForFrames;
+};
@@ -0,0 +1,77 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetRelevancyGrid.h: Spatial index of network actors for relevancy checks.
+=============================================================================*/
+#pragma once
+
+/**
+ * Buckets actors into square cells in the XY plane, so that a connection only has to check the relevancy of the actors
+ * in the cells around its viewers rather than every network actor. Actors are referred to by index, typically into
+ * the list of actors considered for replication this frame. The grid only narrows down candidates, the relevancy
+ * checks themselves are unchanged, so actors that may be relevant from further away than the query radius must
+ * be kept out of it.
+ */
+class ENGINE_API FNetRelevancyGrid
+{
+public:
+
+	FNetRelevancyGrid();
+
+	/**
+	 * Removes all actors, keeping the memory for the next build.
+	 *
+	 * @param InCellSize	Width of a cell
+	 * @param InQueryRadius	Distance around a location within which MarkActorsNear must find every actor
+	 */
+	void Reset(float InCellSize, float InQueryRadius);
+
+	/**
+	 * Adds an actor.
+	 *
+	 * @param Index		Index of the actor, each index may only be added once per build
+	 * @param Location	Location of the actor
+	 */
+	void Add(int32 Index, const FVector& Location);
+
+	/**
+	 * Marks every actor in the cells that overlap the query radius around a location. This can include actors a little
+	 * further away than the query radius, but never misses one that is closer.
+	 *
+	 * @param Location		Location to look around
+	 * @param InOutMarks	Receives a set bit for the index of every actor found, must have at least as many bits as the highest index added
+	 * @return the number of actors found, including ones that were already marked
+	 */
+	int32 MarkActorsNear(const FVector& Location, TBitArray<>& InOutMarks) const;
+
+	/** @return the number of cells that hold at least one actor */
+	int32 GetNumCells() const
+	{
+		return FirstInCell.Num();
+	}
+
+	/** @return the distance within which MarkActorsNear finds every actor */
+	float GetQueryRadius() const
+	{
+		return QueryRadius;
+	}
+
+private:
+
+	/** @return the cell that holds the given location */
+	FIntPoint GetCell(float X, float Y) const
+	{
+		return FIntPoint(FMath::FloorToInt(X * InvCellSize), FMath::FloorToInt(Y * InvCellSize));
+	}
+
+	/** Width of a cell. */
+	float CellSize;
+	/** 1 / CellSize. */
+	float InvCellSize;
+	/** Distance within which MarkActorsNear finds every actor. */
+	float QueryRadius;
+	/** Index of the first actor in each cell that isn't empty. */
+	TMap<FIntPoint, int32> FirstInCell;
+	/** For every added index, the index of the next actor in the same cell, or INDEX_NONE. */
+	TArray<int32> NextInCell;
+};
@@ -0,0 +1,50 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	PushModel.h: Dirty tracking for push based replicated properties.
+=============================================================================*/
+#pragma once
+
+/**
+ * Keeps track of which push based properties game code changed. Properties registered with DOREPLIFETIME_PUSH are
+ * only compared against the shadow state of a connection after they were marked dirty with MARK_PROPERTY_DIRTY,
+ * rather than every time their object is considered for replication. Other properties are always compared.
+ *
+ * Marking is counted rather than flagged, so that each connection (and each net driver) can tell what changed
+ * since it last compared the object without having to clear anything.
+ */
+class ENGINE_API FNetPushModel
+{
+public:
+
+	/** Dirty state of one object */
+	class FObjectState
+	{
+	public:
+		FObjectState() : DirtyCount( 0 ) {}
+
+		uint32				DirtyCount;				// Bumped every time a property of the object is marked dirty
+		TArray< uint32 >	PropertyDirtyCounts;	// DirtyCount at the time each property was last marked, indexed by RepIndex
+	};
+
+	/**
+	 * Notes that a push based property of an object changed.
+	 *
+	 * @param Object	The object owning the property
+	 * @param RepIndex	RepIndex of the property, plus the static array index
+	 */
+	static void MarkPropertyDirty( UObject * Object, int32 RepIndex );
+
+	/**
+	 * @param Object	The object to look up
+	 * @return the dirty state of the object, NULL if none of its properties were ever marked dirty
+	 */
+	static const FObjectState * FindObjectState( UObject * Object );
+
+	/**
+	 * Forgets the dirty state of an object that is going away.
+	 *
+	 * @param Object	The object to forget
+	 */
+	static void RemoveObject( UObject * Object );
+};
@@ -18,6 +18,20 @@ public:
 	uint32				IsConditional	: 1;
 };
 
+/** FRepSerializedPropertyCache
+ * The bits a property serialized to the last time it was sent this frame.
+ * Other connections sending the same property in the same frame copy these bits rather than serialize it again.
+ */
+class FRepSerializedPropertyCache
+{
+public:
+	FRepSerializedPropertyCache() : ReplicationFrame( 0 ), NumBits( INDEX_NONE ) {}
+
+	uint32				ReplicationFrame;		// Replication frame Bits were serialized in
+	int32				NumBits;				// Number of valid bits in Bits, INDEX_NONE if nothing was serialized yet
+	TArray< uint8 >		Bits;
+};
+
 /** FRepChangedPropertyTracker
  * This class is used to store the change list for a group of properties of a particular actor/object
  * This information is shared across connections when possible
@@ -52,6 +66,8 @@ public:
 
 	uint32						ActiveStatusChanged;
 	bool						UnconditionalPropChanged;
+
+	TArray< FRepSerializedPropertyCache >	SerializedProperties;	// Indexed by FRepLayout cmd, shared by every connection sending this object
 };
 
 class FRepLayout;
@@ -101,7 +117,9 @@ public:
 		UnmappedFrames( 0 ),
 		OpenAckedCalled( false ),
 		AwakeFromDormancy( false ),
-		ActiveStatusChanged( 0 )
+		ActiveStatusChanged( 0 ),
+		PushModelDirtyCount( 0 ),
+		bComparedPushBasedProperties( false )
 	{ }
 
 	~FRepState();
@@ -137,6 +155,9 @@ public:
 	TArray< uint16 >				ConditionalLifetime;		// Properties the need to be checked conditionally (based on net initial, role, etc)
 	FReplicationFlags				RepFlags;
 	uint32							ActiveStatusChanged;
+
+	uint32							PushModelDirtyCount;			// FNetPushModel dirty count of the object the last time its properties were compared
+	bool							bComparedPushBasedProperties;	// False until push based properties were compared once, the shadow state starts out as the defaults
 };
 
 enum ERepLayoutCmdType
@@ -170,7 +191,8 @@ enum ERepParentFlags
 	PARENT_IsLifetime			= ( 1 << 0 ),
 	PARENT_IsConditional		= ( 1 << 1 ),		// True if this property has a secondary condition to check
 	PARENT_IsConfig				= ( 1 << 2 ),		// True if this property is defaulted from a config file
-	PARENT_IsCustomDelta		= ( 1 << 3 )		// True if this property uses custom delta compression
+	PARENT_IsCustomDelta		= ( 1 << 3 ),		// True if this property uses custom delta compression
+	PARENT_IsPushBased			= ( 1 << 4 )		// True if this property is only compared after being marked dirty
 };
 
 class FRepParentCmd
@@ -215,7 +237,9 @@ public:
 		Writer( InWriter ), 
 		Changed( InChanged ),
 		CurrentChanged( 0 ),
-		bDoChecksum( bInDoChecksum )
+		bDoChecksum( bInDoChecksum ),
+		SerializedProperties( NULL ),
+		ReplicationFrame( 0 )
 	{
 	}
 
@@ -223,6 +247,27 @@ public:
 	TArray< uint16 > &	Changed;
 	int32				CurrentChanged;
 	bool				bDoChecksum;
+
+	TArray< FRepSerializedPropertyCache > *	SerializedProperties;	// Serialized properties shared across connections, NULL when they can't be used
+	uint32									ReplicationFrame;
+};
+
+class FRepPushModelFilter
+{
+public:
+	FRepPushModelFilter( const TArray< uint32 > * InPropertyDirtyCounts, uint32 InComparedDirtyCount ) : 
+		PropertyDirtyCounts( InPropertyDirtyCounts ),
+		ComparedDirtyCount( InComparedDirtyCount )
+	{}
+
+	/** Returns true if the push based parent was marked dirty since the properties were last compared */
+	FORCEINLINE bool IsDirty( const int32 ParentIndex ) const
+	{
+		return PropertyDirtyCounts != NULL && PropertyDirtyCounts->IsValidIndex( ParentIndex ) && (*PropertyDirtyCounts)[ParentIndex] > ComparedDirtyCount;
+	}
+
+	const TArray< uint32 > *	PropertyDirtyCounts;
+	uint32						ComparedDirtyCount;
 };
 
 class FRepReaderState
@@ -281,7 +326,7 @@ class FRepLayout
 	friend class FRepState;
 
 public:
-	FRepLayout() : FirstNonCustomParent( 0 ), RoleIndex( -1 ), RemoteRoleIndex( -1 ), Owner( NULL ) {}
+	FRepLayout() : FirstNonCustomParent( 0 ), RoleIndex( -1 ), RemoteRoleIndex( -1 ), bHasPushBasedParents( false ), Owner( NULL ) {}
 
 	void OpenAcked( FRepState * RepState ) const;
 
@@ -395,7 +440,8 @@ private:
 		const uint8 * RESTRICT				CompareData,
 		const uint8 * RESTRICT				Data, 
 		TArray< FRepChangedParent > &		OutChangedParents,
-		const TArray< uint16 > &			PropertyList ) const;
+		const TArray< uint16 > &			PropertyList,
+		const FRepPushModelFilter *			PushModelFilter = NULL ) const;
 
 	void SendProperties_DynamicArray_r( 
 		FRepState *	RESTRICT		RepState, 
@@ -546,5 +592,7 @@ private:
 	int32						RoleIndex;
 	int32						RemoteRoleIndex;
 
+	bool						bHasPushBasedParents;		// True if any lifetime property was registered as push based
+
 	UObject *					Owner;						// Either a UCkass or UFunction
 };
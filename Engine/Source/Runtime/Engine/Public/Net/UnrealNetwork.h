@@ -59,6 +59,7 @@ inline bool IsNetworkCompatible(bool bRequireEngineVersionMatch, int32 RemoteVer
 
 #include "DataBunch.h"		// Bunch class.
 #include "DataChannel.h"	// Channel class.
+#include "PushModel.h"		// Push based property dirty tracking.
 
 /*-----------------------------------------------------------------------------
 	Replication.
@@ -101,6 +102,38 @@ static UProperty* GetReplicatedProperty(UClass* CallingClass, UClass* PropClass,
 	}																					\
 }
 
+/**
+ * Replicates a property that is only compared against what connections last received after game code marks it
+ * dirty with MARK_PROPERTY_DIRTY. Any change that isn't marked won't replicate.
+ */
+#define DOREPLIFETIME_PUSH(c,v) \
+{ \
+	static UProperty* sp##v = GetReplicatedProperty(StaticClass(), c::StaticClass(),GET_MEMBER_NAME_CHECKED(c,v)); \
+	for ( int32 i = 0; i < sp##v->ArrayDim; i++ )											\
+	{																						\
+		OutLifetimeProps.AddUnique( FLifetimeProperty( sp##v->RepIndex + i, COND_None, true ) );	\
+	}																						\
+}
+
+#define DOREPLIFETIME_CONDITION_PUSH(c,v,cond) \
+{ \
+	static UProperty* sp##v = GetReplicatedProperty(StaticClass(), c::StaticClass(),GET_MEMBER_NAME_CHECKED(c,v)); \
+	for ( int32 i = 0; i < sp##v->ArrayDim; i++ )										\
+	{																					\
+		OutLifetimeProps.AddUnique( FLifetimeProperty( sp##v->RepIndex + i, cond, true ) );	\
+	}																					\
+}
+
+/** Marks a property registered with DOREPLIFETIME_PUSH as changed, call it from a member function of the object after changing the property */
+#define MARK_PROPERTY_DIRTY(c,v) \
+{ \
+	static UProperty* sp##v = GetReplicatedProperty(StaticClass(), c::StaticClass(),GET_MEMBER_NAME_CHECKED(c,v)); \
+	for ( int32 i = 0; i < sp##v->ArrayDim; i++ )							\
+	{																		\
+		FNetPushModel::MarkPropertyDirty( this, sp##v->RepIndex + i );		\
+	}																		\
+}
+
 #define DOREPLIFETIME_ACTIVE_OVERRIDE(c,v,active)	\
 {													\
 	static UProperty* sp##v = GetReplicatedProperty(StaticClass(), c::StaticClass(),GET_MEMBER_NAME_CHECKED(c,v)); \
@@ -28,6 +28,10 @@ public:
 	bool bSucceeded;
 	bool bOptimizeForLowLatency;
 	FShaderCompilerOutput Output;
+	/** Hash of the shader files and shader format version the job depends on besides Input, set when the job is queued. */
+	FSHAHash SourceHash;
+	/** Key of this job's output in the job cache, empty if the job doesn't use the cache. */
+	FString CacheKey;
 
 	FShaderCompileJob(
 		const uint32& InId,
@@ -100,12 +104,21 @@ private:
 	/** Used when compiling through workers, launches worker processes if needed. */
 	bool LaunchWorkersIfNeeded();
 
-	/** Used when compiling through workers, attempts to open the worker output file if the worker is done and read the results. */
-	void ReadAvailableResults();
+	/** 
+	 * Used when compiling through workers, reads the results that workers have sent back so far, either from their output files or as streamed through their pipes.
+	 * @return the number of jobs whose results were read.
+	 */
+	int32 ReadAvailableResults();
 
 	/** Used when compiling directly through the console tools dll. */
 	void CompileDirectlyThroughDll();
 
+	/** Looks up the jobs of newly queued batches in the job cache, and moves the hits to the front of the batch as already received. */
+	void ResolveJobsFromCache();
+
+	/** Stores the outputs of jobs that have been received since the last call in the job cache. */
+	void CacheReceivedJobs();
+
 	/** Main work loop. */
 	int32 CompilingLoop();
 
@@ -550,10 +550,23 @@ struct FStaticMeshLODResources
 	/** True if the adjacency index buffer contained data at init. Needed as it will not be available to the CPU afterwards. */
 	bool bHasAdjacencyInfo;
 
+	/** True if the vertex and index buffers of this LOD were cooked into StreamingBulkData instead of being serialized inline. */
+	bool bIsStreamable;
+
+	/** Serialized vertex and index buffers of a streamable LOD, loaded on demand by the static mesh streaming manager. */
+	FByteBulkData StreamingBulkData;
+
+	/** Vertex and texture coordinate counts of a streamable LOD, serialized inline so they are known while its buffers aren't resident. */
+	int32 StreamableNumVertices;
+	int32 StreamableNumTexCoords;
+
 	/** Default constructor. */
 	FStaticMeshLODResources()
 		: MaxDeviation(0.0f)
 		, bHasAdjacencyInfo(false)
+		, bIsStreamable(false)
+		, StreamableNumVertices(0)
+		, StreamableNumTexCoords(0)
 	{
 	}
 
@@ -566,12 +579,21 @@ struct FStaticMeshLODResources
 	/** Serialize. */
 	void Serialize(FArchive& Ar, UObject* Owner, int32 Idx);
 
+	/**
+	 * Deserializes the vertex and index buffers of a streamable LOD.
+	 *
+	 * @param Data		Contents of StreamingBulkData
+	 * @param DataSize	Size of Data in bytes
+	 */
+	void SerializeStreamedBuffers(const uint8* Data, int32 DataSize);
+
 	/** Return the triangle count of this LOD. */
 	ENGINE_API int32 GetNumTriangles() const;
 
-	/** Return the number of vertices in this LOD. */
+	/** Return the number of vertices in this LOD, even if its buffers are streamed out. */
 	ENGINE_API int32 GetNumVertices() const;
 
+	/** Return the number of texture coordinates in this LOD, even if its buffers are streamed out. */
 	ENGINE_API int32 GetNumTexCoords() const;
 
 	/**
@@ -599,6 +621,15 @@ public:
 	/** Screen size to switch LODs */
 	float ScreenSize[MAX_STATIC_MESH_LODS];
 
+	/** Number of leading LODs whose buffers were cooked for streaming. */
+	int32 NumStreamableLODs;
+
+	/**
+	 * Index of the first LOD whose rendering resources are initialized. LODs before it have no vertex or index data.
+	 * Only changed on the game thread, and scene proxies are recreated whenever it changes.
+	 */
+	int32 CurrentFirstLODIdx;
+
 	/** Streaming texture factors. */
 	float StreamingTextureFactors[MAX_STATIC_TEXCOORDS];
 
@@ -643,6 +674,12 @@ public:
 	/** Releases the render resources. */
 	ENGINE_API void ReleaseResources();
 
+	/**
+	 * Synchronously loads every streamable LOD that isn't resident and initializes its render resources.
+	 * Used when LOD streaming isn't available, or when a user of the mesh needs all of its LODs.
+	 */
+	void LoadAllStreamableLODs(UStaticMesh* Owner);
+
 	/** Compute the size of this resource. */
 	SIZE_T GetResourceSize() const;
 
@@ -858,6 +895,9 @@ protected:
 	 */
 	int32 ForcedLodModel;
 
+	/** The first LOD of the mesh with rendering resources when the proxy was created, LODs before it are never drawn. */
+	int32 FirstResidentLODIdx;
+
 	FVector TotalScale3D;
 
 	FLinearColor LevelColor;
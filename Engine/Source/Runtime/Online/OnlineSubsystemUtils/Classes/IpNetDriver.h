@@ -30,6 +30,12 @@ class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 	/** Underlying socket communication */
 	FSocket* Socket;
 
+	/** Thread draining Socket into a packet ring when the receive thread is enabled, NULL otherwise */
+	class FIpNetReceiveThread* ReceiveThread;
+
+	/** Client connections keyed by their remote ip and port, used to find the sender of a packet. Kept in sync by AddClientConnection and RemoveClientConnection. */
+	TMultiMap<uint64, class UIpConnection*> ConnectionsByAddress;
+
 	// Begin UNetDriver interface.
 	virtual bool IsAvailable() const OVERRIDE;
 	virtual bool InitBase(bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error) OVERRIDE;
@@ -39,6 +45,8 @@ class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 	virtual void TickDispatch( float DeltaTime ) OVERRIDE;
 	virtual FString LowLevelGetNetworkNumber() OVERRIDE;
 	virtual void LowLevelDestroy() OVERRIDE;
+	virtual void AddClientConnection(UNetConnection* NewConnection) OVERRIDE;
+	virtual void RemoveClientConnection(UNetConnection* ClientConnectionToRemove) OVERRIDE;
 	virtual class ISocketSubsystem* GetSocketSubsystem() OVERRIDE;
 	virtual bool IsNetResourceValid(void) OVERRIDE
 	{
@@ -70,4 +78,25 @@ class ONLINESUBSYSTEMUTILS_API UIpNetDriver : public UNetDriver
 
 	/** @return TCPIP connection to server */
 	class UIpConnection* GetServerConnection();
+
+protected:
+
+	/**
+	 * Hands a received packet, or a receive error, to the connection it came from.
+	 * Creates a new client connection for unknown senders if the notify accepts it.
+	 *
+	 * @param Data the packet data
+	 * @param BytesRead the size of the packet
+	 * @param FromAddr the sender of the packet
+	 * @param bOk false if the receive failed with a connection reset or port unreachable error
+	 */
+	void DispatchPacket( uint8* Data, int32 BytesRead, const FInternetAddr& FromAddr, bool bOk );
+
+	/**
+	 * Finds the client connection with the given remote address.
+	 *
+	 * @param FromAddr the address to look for
+	 * @return the connection, or NULL if no client connection has that address
+	 */
+	class UIpConnection* FindClientConnection( const FInternetAddr& FromAddr );
 };
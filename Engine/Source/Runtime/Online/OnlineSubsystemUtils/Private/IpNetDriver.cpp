@@ -19,8 +19,201 @@ Notes:
 /** Size of the network recv buffer */
 #define NETWORK_MAX_PACKET (576)
 
+/** Number of packets the receive thread can hold for the game thread, must be a power of two */
+#define NETWORK_RECEIVE_RING_SIZE (2048)
+
+/** Whether listening drivers read packets on a dedicated thread */
+static int32 GIpNetDriverReceiveThread = 1;
+static FAutoConsoleVariableRef CVarIpNetDriverReceiveThread(
+	TEXT("net.IpNetDriverReceiveThread"),
+	GIpNetDriverReceiveThread,
+	TEXT("If nonzero, listening IP net drivers read packets in batches on a dedicated thread and the game thread dispatches them from a packet ring.\n")
+	TEXT("Otherwise the game thread reads the socket one packet at a time. Takes effect when a driver starts listening."),
+	ECVF_Default
+	);
+
+/**
+ * Drains the socket of a net driver in batches into a ring of packets. The receive thread is the only
+ * writer of the ring and the game thread the only reader, so the ring needs no lock: each side only
+ * advances its own index, after it is done with the slots it passes on.
+ */
+class FIpNetReceiveThread : public FRunnable
+{
+public:
+
+	FIpNetReceiveThread(FSocket* InSocket, ISocketSubsystem* InSocketSubsystem)
+		: Socket(InSocket)
+		, SocketSubsystem(InSocketSubsystem)
+		, LastSource(InSocketSubsystem->CreateInternetAddr())
+		, Head(0)
+		, Tail(0)
+	{
+		Buffer.AddUninitialized(NETWORK_RECEIVE_RING_SIZE * NETWORK_MAX_PACKET);
+		BytesRead.AddZeroed(NETWORK_RECEIVE_RING_SIZE);
+		for (int32 Index = 0; Index < NETWORK_RECEIVE_RING_SIZE; Index++)
+		{
+			Sources.Add(SocketSubsystem->CreateInternetAddr());
+			SourcePointers.Add(&Sources[Index].Get());
+		}
+		Thread = FRunnableThread::Create(this, TEXT("IpNetDriverReceive"), 0, 0, 64 * 1024, TPri_AboveNormal);
+	}
+
+	/** Stops the thread. The socket must stay open until this returns. */
+	virtual ~FIpNetReceiveThread()
+	{
+		if (Thread != NULL)
+		{
+			Thread->Kill(true);
+			delete Thread;
+		}
+	}
+
+	/** @return whether the thread could be started */
+	bool IsRunning() const
+	{
+		return Thread != NULL;
+	}
+
+	/**
+	 * Copies the oldest packet out of the ring and hands its slot back to the receive thread. Called on the game thread only.
+	 * The packet is copied because dispatching it may destroy the net driver, and this thread and its ring with it.
+	 *
+	 * @param OutData receives the packet data, must hold NETWORK_MAX_PACKET bytes
+	 * @param OutBytesRead receives the size of the packet, or INDEX_NONE for a receive error
+	 * @param OutSource receives the sender of the packet
+	 * @return false if the ring is empty
+	 */
+	bool Pop(uint8* OutData, int32& OutBytesRead, FInternetAddr& OutSource)
+	{
+		// the slot must not be read before the index that published it, so the load has to be atomic and ordered
+		if (Head == AtomicLoad(Tail))
+		{
+			return false;
+		}
+		const int32 Slot = Head & (NETWORK_RECEIVE_RING_SIZE - 1);
+		OutBytesRead = BytesRead[Slot];
+		if (OutBytesRead > 0)
+		{
+			FMemory::Memcpy(OutData, &Buffer[Slot * NETWORK_MAX_PACKET], OutBytesRead);
+		}
+		CopyAddress(OutSource, *Sources[Slot]);
+		FPlatformAtomics::InterlockedIncrement(&Head);
+		return true;
+	}
+
+	// Begin FRunnable interface.
+	virtual uint32 Run() OVERRIDE
+	{
+		while (StopTaskCounter.GetValue() == 0)
+		{
+			// the game thread must be done with a slot before it is written again, so the load has to be atomic and ordered
+			const int32 NumFree = NETWORK_RECEIVE_RING_SIZE - int32(uint32(Tail) - uint32(AtomicLoad(Head)));
+			if (NumFree == 0)
+			{
+				// the game thread is behind, leave the packets in the socket buffer for now
+				FPlatformProcess::Sleep(0.001f);
+				continue;
+			}
+			if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(10)))
+			{
+				continue;
+			}
+
+			const int32 FirstSlot = Tail & (NETWORK_RECEIVE_RING_SIZE - 1);
+			const int32 MaxPackets = FMath::Min(NumFree, NETWORK_RECEIVE_RING_SIZE - FirstSlot);
+			int32 NumPacketsRead = 0;
+			if (Socket->RecvFromBatch(&Buffer[FirstSlot * NETWORK_MAX_PACKET], NETWORK_MAX_PACKET, MaxPackets, &BytesRead[FirstSlot], &SourcePointers[FirstSlot], NumPacketsRead))
+			{
+				CopyAddress(*LastSource, *Sources[FirstSlot + NumPacketsRead - 1]);
+				Publish(NumPacketsRead);
+				continue;
+			}
+
+			const ESocketErrors Error = SocketSubsystem->GetLastErrorCode();
+			if (Error == SE_ECONNRESET || Error == SE_UDP_ERR_PORT_UNREACH)
+			{
+				// the game thread decides what to do about the error, blaming the last sender as the synchronous path does
+				BytesRead[FirstSlot] = INDEX_NONE;
+				CopyAddress(*Sources[FirstSlot], *LastSource);
+				Publish(1);
+			}
+			else if (Error != SE_EWOULDBLOCK && Error != SE_NO_ERROR)
+			{
+				UE_LOG(LogNet, Warning, TEXT("UDP recvfrom error: %i (%s) on receive thread"), (int32)Error, SocketSubsystem->GetSocketError(Error));
+				// don't spin on an error that doesn't go away
+				FPlatformProcess::Sleep(0.01f);
+			}
+		}
+		return 0;
+	}
+
+	virtual void Stop() OVERRIDE
+	{
+		StopTaskCounter.Increment();
+	}
+	// End FRunnable interface.
+
+private:
+
+	/** Passes filled slots on to the game thread. */
+	void Publish(int32 NumPackets)
+	{
+		// the interlocked add orders the slot writes before the new index
+		FPlatformAtomics::InterlockedAdd(&Tail, NumPackets);
+	}
+
+	/**
+	 * Reads an index written by the other thread. The compare exchange never changes the value, it is only there for
+	 * its full barrier, which keeps the slot accesses that depend on the index from moving above the load.
+	 */
+	static FORCEINLINE int32 AtomicLoad(volatile int32& Index)
+	{
+		return FPlatformAtomics::InterlockedCompareExchange(&Index, 0, 0);
+	}
+
+	static void CopyAddress(FInternetAddr& Dest, const FInternetAddr& Source)
+	{
+		uint32 Ip = 0;
+		Source.GetIp(Ip);
+		Dest.SetIp(Ip);
+		Dest.SetPort(Source.GetPort());
+	}
+
+	/** Socket of the net driver */
+	FSocket* Socket;
+	/** Socket subsystem the socket came from */
+	ISocketSubsystem* SocketSubsystem;
+	/** Packet data, NETWORK_MAX_PACKET bytes per slot */
+	TArray<uint8> Buffer;
+	/** Size of the packet in each slot, INDEX_NONE for a receive error */
+	TArray<int32> BytesRead;
+	/** Sender of the packet in each slot */
+	TArray<TSharedRef<FInternetAddr> > Sources;
+	/** Sources as the raw pointers RecvFromBatch fills in */
+	TArray<FInternetAddr*> SourcePointers;
+	/** Sender of the last packet read, receive errors are blamed on it */
+	TSharedRef<FInternetAddr> LastSource;
+	/** Number of packets the game thread has popped, only written by the game thread */
+	volatile int32 Head;
+	/** Number of packets the receive thread has published, only written by the receive thread */
+	volatile int32 Tail;
+	/** Set when the thread should exit */
+	FThreadSafeCounter StopTaskCounter;
+	/** The thread draining the socket */
+	FRunnableThread* Thread;
+};
+
+/** @return key of an address in UIpNetDriver::ConnectionsByAddress */
+static FORCEINLINE uint64 GetAddressKey(const FInternetAddr& Addr)
+{
+	uint32 Ip = 0;
+	Addr.GetIp(Ip);
+	return (uint64(Ip) << 32) | uint32(Addr.GetPort());
+}
+
 UIpNetDriver::UIpNetDriver(const class FPostConstructInitializeProperties& PCIP)
 	: Super(PCIP)
+	, ReceiveThread(NULL)
 {
 }
 
@@ -158,6 +351,17 @@ bool UIpNetDriver::InitListen( FNetworkNotify* InNotify, FURL& LocalURL, bool bR
 	LocalURL.Port = LocalAddr->GetPort();
 	UE_LOG(LogNet, Log, TEXT("%s IpNetDriver listening on port %i"), *GetDescription(), LocalURL.Port );
 
+	// Servers with many clients spend a good part of the frame in recvfrom, read the socket on a thread of its own.
+	if (GIpNetDriverReceiveThread && FPlatformProcess::SupportsMultithreading())
+	{
+		ReceiveThread = new FIpNetReceiveThread(Socket, GetSocketSubsystem());
+		if (!ReceiveThread->IsRunning())
+		{
+			delete ReceiveThread;
+			ReceiveThread = NULL;
+		}
+	}
+
 	return true;
 }
 
@@ -167,6 +371,20 @@ void UIpNetDriver::TickDispatch( float DeltaTime )
 
 	ISocketSubsystem* SocketSubsystem = GetSocketSubsystem();
 
+	// Process the packets the receive thread has read.
+	if (ReceiveThread != NULL)
+	{
+		// dispatching a packet may destroy the receive thread, so each packet is copied out of the ring first
+		uint8 Data[NETWORK_MAX_PACKET];
+		TSharedRef<FInternetAddr> FromAddr = SocketSubsystem->CreateInternetAddr();
+		int32 BytesRead = 0;
+		while (ReceiveThread != NULL && ReceiveThread->Pop(Data, BytesRead, *FromAddr))
+		{
+			DispatchPacket(Data, BytesRead, *FromAddr, BytesRead != INDEX_NONE);
+		}
+		return;
+	}
+
 	// Process all incoming packets.
 	uint8 Data[NETWORK_MAX_PACKET];
 	TSharedRef<FInternetAddr> FromAddr = SocketSubsystem->CreateInternetAddr();
@@ -199,82 +417,118 @@ void UIpNetDriver::TickDispatch( float DeltaTime )
 				}
 			}
 		}
-		// Figure out which socket the received data came from.
-		UIpConnection* Connection = NULL;
-		if (GetServerConnection() && (*GetServerConnection()->RemoteAddr == *FromAddr))
-		{
-			Connection = GetServerConnection();
-		}
-		for( int32 i=0; i<ClientConnections.Num() && !Connection; i++ )
-		{
-			UIpConnection* TestConnection = (UIpConnection*)ClientConnections[i]; 
-            check(TestConnection);
-			if(*TestConnection->RemoteAddr == *FromAddr)
-			{
-				Connection = TestConnection;
-			}
-		}
+		DispatchPacket(Data, BytesRead, *FromAddr, bOk);
+	}
+}
 
-		if( bOk == false )
+void UIpNetDriver::DispatchPacket( uint8* Data, int32 BytesRead, const FInternetAddr& FromAddr, bool bOk )
+{
+	// Figure out which socket the received data came from.
+	UIpConnection* Connection = NULL;
+	if (GetServerConnection() && (*GetServerConnection()->RemoteAddr == FromAddr))
+	{
+		Connection = GetServerConnection();
+	}
+	else
+	{
+		Connection = FindClientConnection(FromAddr);
+	}
+
+	if( bOk == false )
+	{
+		if( Connection )
 		{
-			if( Connection )
+			if( Connection != GetServerConnection() )
 			{
-				if( Connection != GetServerConnection() )
+				// We received an ICMP port unreachable from the client, meaning the client is no longer running the game
+				// (or someone is trying to perform a DoS attack on the client)
+
+				// rcg08182002 Some buggy firewalls get occasional ICMP port
+				// unreachable messages from legitimate players. Still, this code
+				// will drop them unceremoniously, so there's an option in the .INI
+				// file for servers with such flakey connections to let these
+				// players slide...which means if the client's game crashes, they
+				// might get flooded to some degree with packets until they timeout.
+				// Either way, this should close up the usual DoS attacks.
+				if ((Connection->State != USOCK_Open) || (!AllowPlayerPortUnreach))
 				{
-					// We received an ICMP port unreachable from the client, meaning the client is no longer running the game
-					// (or someone is trying to perform a DoS attack on the client)
-
-					// rcg08182002 Some buggy firewalls get occasional ICMP port
-					// unreachable messages from legitimate players. Still, this code
-					// will drop them unceremoniously, so there's an option in the .INI
-					// file for servers with such flakey connections to let these
-					// players slide...which means if the client's game crashes, they
-					// might get flooded to some degree with packets until they timeout.
-					// Either way, this should close up the usual DoS attacks.
-					if ((Connection->State != USOCK_Open) || (!AllowPlayerPortUnreach))
+					if (LogPortUnreach)
 					{
-						if (LogPortUnreach)
-						{
-							UE_LOG(LogNet, Log, TEXT("Received ICMP port unreachable from client %s.  Disconnecting."),
-								*FromAddr->ToString(true));
-						}
-						Connection->CleanUp();
+						UE_LOG(LogNet, Log, TEXT("Received ICMP port unreachable from client %s.  Disconnecting."),
+							*FromAddr.ToString(true));
 					}
-				}
-			}
-			else
-			{
-				if (LogPortUnreach)
-				{
-					UE_LOG(LogNet, Log, TEXT("Received ICMP port unreachable from %s.  No matching connection found."),
-						*FromAddr->ToString(true));
+					Connection->CleanUp();
 				}
 			}
 		}
 		else
 		{
-			// If we didn't find a client connection, maybe create a new one.
-			if( !Connection )
+			if (LogPortUnreach)
 			{
-				// Determine if allowing for client/server connections
-				const bool bAcceptingConnection = Notify->NotifyAcceptingConnection() == EAcceptConnection::Accept;
-
-				if (bAcceptingConnection)
-				{
-					Connection = ConstructObject<UIpConnection>(NetConnectionClass);
-                    check(Connection);
-					Connection->InitRemoteConnection( this, Socket,  FURL(), *FromAddr, USOCK_Open);
-					Notify->NotifyAcceptedConnection( Connection );
-					AddClientConnection(Connection);
-				}
+				UE_LOG(LogNet, Log, TEXT("Received ICMP port unreachable from %s.  No matching connection found."),
+					*FromAddr.ToString(true));
 			}
+		}
+	}
+	else
+	{
+		// If we didn't find a client connection, maybe create a new one.
+		if( !Connection )
+		{
+			// Determine if allowing for client/server connections
+			const bool bAcceptingConnection = Notify->NotifyAcceptingConnection() == EAcceptConnection::Accept;
 
-			// Send the packet to the connection for processing.
-			if( Connection )
+			if (bAcceptingConnection)
 			{
-				Connection->ReceivedRawPacket( Data, BytesRead );
+				Connection = ConstructObject<UIpConnection>(NetConnectionClass);
+				check(Connection);
+				Connection->InitRemoteConnection( this, Socket,  FURL(), FromAddr, USOCK_Open);
+				Notify->NotifyAcceptedConnection( Connection );
+				AddClientConnection(Connection);
 			}
 		}
+
+		// Send the packet to the connection for processing.
+		if( Connection )
+		{
+			Connection->ReceivedRawPacket( Data, BytesRead );
+		}
+	}
+}
+
+UIpConnection* UIpNetDriver::FindClientConnection( const FInternetAddr& FromAddr )
+{
+	// Different addresses may share a key, so the addresses still need comparing.
+	for (TMultiMap<uint64, UIpConnection*>::TConstKeyIterator It(ConnectionsByAddress, GetAddressKey(FromAddr)); It; ++It)
+	{
+		UIpConnection* TestConnection = It.Value();
+		if (*TestConnection->RemoteAddr == FromAddr)
+		{
+			return TestConnection;
+		}
+	}
+	return NULL;
+}
+
+void UIpNetDriver::AddClientConnection(UNetConnection* NewConnection)
+{
+	Super::AddClientConnection(NewConnection);
+
+	UIpConnection* IpConnection = Cast<UIpConnection>(NewConnection);
+	if (IpConnection != NULL && IpConnection->RemoteAddr.IsValid())
+	{
+		ConnectionsByAddress.Add(GetAddressKey(*IpConnection->RemoteAddr), IpConnection);
+	}
+}
+
+void UIpNetDriver::RemoveClientConnection(UNetConnection* ClientConnectionToRemove)
+{
+	Super::RemoveClientConnection(ClientConnectionToRemove);
+
+	UIpConnection* IpConnection = Cast<UIpConnection>(ClientConnectionToRemove);
+	if (IpConnection != NULL && IpConnection->RemoteAddr.IsValid())
+	{
+		ConnectionsByAddress.RemoveSingle(GetAddressKey(*IpConnection->RemoteAddr), IpConnection);
 	}
 }
 
@@ -350,6 +604,14 @@ void UIpNetDriver::LowLevelDestroy()
 {
 	Super::LowLevelDestroy();
 
+	// Stop reading the socket before it goes away.
+	if (ReceiveThread != NULL)
+	{
+		delete ReceiveThread;
+		ReceiveThread = NULL;
+	}
+	ConnectionsByAddress.Empty();
+
 	// Close the socket.
 	if( Socket && !HasAnyFlags(RF_ClassDefaultObject) )
 	{
@@ -10,6 +10,14 @@
 #include "BigInt.h"
 #include "SignedArchiveReader.h"
 #include "PublicKey.inl"
+#include "ParallelFor.h"
+
+#if PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 DEFINE_LOG_CATEGORY(LogPakFile);
 
@@ -31,6 +39,16 @@ bool FPakEntry::VerifyPakEntriesMatch(const FPakEntry& FileEntryA, const FPakEnt
 		UE_LOG(LogPakFile, Error, TEXT("Pak header file compression method mismatch, got: %d, expected: %d"), FileEntryB.CompressionMethod, FileEntryA.CompressionMethod);
 		bResult = false;
 	}
+	if (FileEntryA.CompressionBlockSize != FileEntryB.CompressionBlockSize)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Pak header file compression block size mismatch, got: %u, expected: %u"), FileEntryB.CompressionBlockSize, FileEntryA.CompressionBlockSize);
+		bResult = false;
+	}
+	if (FileEntryA.CompressionBlocks != FileEntryB.CompressionBlocks)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Pak header file compression blocks do not match its index entry, got: %d blocks, expected: %d blocks"), FileEntryB.CompressionBlocks.Num(), FileEntryA.CompressionBlocks.Num());
+		bResult = false;
+	}
 	if (FMemory::Memcmp(FileEntryA.Hash, FileEntryB.Hash, sizeof(FileEntryA.Hash)) != 0)
 	{
 		UE_LOG(LogPakFile, Error, TEXT("Pak file hash does not match its index entry"));
@@ -39,10 +57,241 @@ bool FPakEntry::VerifyPakEntriesMatch(const FPakEntry& FileEntryA, const FPakEnt
 	return bResult;
 }
 
+bool FPakFileHandle::VerifyHeader()
+{
+	if (!PakEntry.Verified)
+	{
+		FPakEntry FileHeader;
+		if (MappedData != NULL)
+		{
+			if (PakEntry.Offset < 0 || PakEntry.Offset + PakEntry.GetSerializedSize(PakFile.GetInfo().Version) + PakEntry.Size > PakFile.GetMappedSize())
+			{
+				UE_LOG(LogPakFile, Error, TEXT("Pak file entry at offset %lld lies outside of the pak file."), PakEntry.Offset);
+				return false;
+			}
+			FBufferReader HeaderReader((void*)(MappedData + PakEntry.Offset), PakFile.GetMappedSize() - PakEntry.Offset, false);
+			FileHeader.Serialize(HeaderReader, PakFile.GetInfo().Version);
+		}
+		else
+		{
+			PakReader->Seek(PakEntry.Offset);
+			FileHeader.Serialize(*PakReader, PakFile.GetInfo().Version);
+		}
+		if (!FPakEntry::VerifyPakEntriesMatch(PakEntry, FileHeader))
+		{
+			return false;
+		}
+		if (bBlockCompressed)
+		{
+			// Make sure the block table describes the whole file before trusting it for seeks
+			const int64 NumBlocks = PakEntry.CompressionBlockSize > 0 ? (PakEntry.UncompressedSize + PakEntry.CompressionBlockSize - 1) / PakEntry.CompressionBlockSize : -1;
+			if (NumBlocks != PakEntry.CompressionBlocks.Num())
+			{
+				UE_LOG(LogPakFile, Error, TEXT("Pak file compression block table is corrupt, got: %d blocks, expected: %lld"), PakEntry.CompressionBlocks.Num(), NumBlocks);
+				return false;
+			}
+			// Every block has to lie within the entry's data, in order, or reads would run off the end of the mapping or the file
+			const int64 DataStart = OffsetToFile - PakEntry.Offset;
+			const int64 DataEnd = DataStart + PakEntry.Size;
+			int64 PreviousEnd = DataStart;
+			for (int32 BlockIndex = 0; BlockIndex < PakEntry.CompressionBlocks.Num(); BlockIndex++)
+			{
+				const FPakCompressedBlock& Block = PakEntry.CompressionBlocks[BlockIndex];
+				if (Block.CompressedStart < PreviousEnd || Block.CompressedEnd < Block.CompressedStart || Block.CompressedEnd > DataEnd ||
+					Block.CompressedEnd - Block.CompressedStart > GetUncompressedBlockSize(BlockIndex))
+				{
+					UE_LOG(LogPakFile, Error, TEXT("Pak file compression block %d is corrupt, range [%lld, %lld) is outside of the entry data [%lld, %lld)."), BlockIndex, Block.CompressedStart, Block.CompressedEnd, PreviousEnd, DataEnd);
+					return false;
+				}
+				PreviousEnd = Block.CompressedEnd;
+			}
+		}
+		PakEntry.Verified = true;
+	}
+	return true;
+}
+
+bool FPakFileHandle::ReadUncompressed(uint8* Destination, int64 BytesToRead)
+{
+	if (PakEntry.Size >= (ReadPos + BytesToRead))
+	{
+		if (MappedData != NULL)
+		{
+			FMemory::Memcpy(Destination, MappedData + OffsetToFile + ReadPos, BytesToRead);
+		}
+		else
+		{
+			// Read directly from Pak.
+			PakReader->Seek(OffsetToFile + ReadPos);
+			PakReader->Serialize(Destination, BytesToRead);
+		}
+		ReadPos += BytesToRead;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+const uint8* FPakFileHandle::GetMappedFileData()
+{
+	if (MappedData == NULL || bBlockCompressed || !VerifyHeader())
+	{
+		return NULL;
+	}
+	return MappedData + OffsetToFile;
+}
+
+const uint8* FPakFileHandle::GetCompressedData(int64 Start, int64 End)
+{
+	// VerifyHeader has checked the block table, this only guards against callers asking for anything else
+	if (Start < 0 || End < Start || PakEntry.Offset + End > OffsetToFile + PakEntry.Size)
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Compressed pak data range [%lld, %lld) lies outside of the entry at offset %lld."), Start, End, PakEntry.Offset);
+		return NULL;
+	}
+	if (MappedData != NULL)
+	{
+		return MappedData + PakEntry.Offset + Start;
+	}
+	CompressedBuffer.Reset();
+	CompressedBuffer.AddUninitialized(End - Start);
+	PakReader->Seek(PakEntry.Offset + Start);
+	PakReader->Serialize(CompressedBuffer.GetTypedData(), CompressedBuffer.Num());
+	return CompressedBuffer.GetTypedData();
+}
+
+bool FPakFileHandle::DecompressBlock(const FPakEntry& Entry, int32 BlockIndex, const uint8* Compressed, uint8* Destination, int64 UncompressedBlockSize)
+{
+	const FPakCompressedBlock& Block = Entry.CompressionBlocks[BlockIndex];
+	const int64 CompressedBlockSize = Block.CompressedEnd - Block.CompressedStart;
+	if (CompressedBlockSize == UncompressedBlockSize)
+	{
+		// UnrealPak stores blocks that do not shrink as they are
+		FMemory::Memcpy(Destination, Compressed, UncompressedBlockSize);
+		return true;
+	}
+	if (Entry.CompressionMethod != COMPRESS_ZLIB ||
+		!FCompression::UncompressMemory((ECompressionFlags)Entry.CompressionMethod, Destination, (int32)UncompressedBlockSize, Compressed, (int32)CompressedBlockSize))
+	{
+		UE_LOG(LogPakFile, Error, TEXT("Failed to decompress pak file block %d (compression method %d)"), BlockIndex, Entry.CompressionMethod);
+		return false;
+	}
+	return true;
+}
+
+const FPakFileHandle::FCachedBlock* FPakFileHandle::GetCachedBlock(int32 BlockIndex)
+{
+	FCachedBlock* LeastRecentlyUsed = &CachedBlocks[0];
+	for (int32 SlotIndex = 0; SlotIndex < NumCachedBlocks; SlotIndex++)
+	{
+		FCachedBlock& Slot = CachedBlocks[SlotIndex];
+		if (Slot.BlockIndex == BlockIndex)
+		{
+			Slot.LastUse = ++BlockUseCounter;
+			return &Slot;
+		}
+		if (Slot.LastUse < LeastRecentlyUsed->LastUse)
+		{
+			LeastRecentlyUsed = &Slot;
+		}
+	}
+
+	const FPakCompressedBlock& Block = PakEntry.CompressionBlocks[BlockIndex];
+	const int64 UncompressedBlockSize = GetUncompressedBlockSize(BlockIndex);
+	const uint8* CompressedData = GetCompressedData(Block.CompressedStart, Block.CompressedEnd);
+	if (CompressedData == NULL)
+	{
+		return NULL;
+	}
+
+	LeastRecentlyUsed->Data.Reset();
+	LeastRecentlyUsed->Data.AddUninitialized(UncompressedBlockSize);
+	if (!DecompressBlock(PakEntry, BlockIndex, CompressedData, LeastRecentlyUsed->Data.GetTypedData(), UncompressedBlockSize))
+	{
+		LeastRecentlyUsed->BlockIndex = INDEX_NONE;
+		LeastRecentlyUsed->LastUse = 0;
+		return NULL;
+	}
+	LeastRecentlyUsed->BlockIndex = BlockIndex;
+	LeastRecentlyUsed->LastUse = ++BlockUseCounter;
+	return LeastRecentlyUsed;
+}
+
+bool FPakFileHandle::ReadCompressed(uint8* Destination, int64 BytesToRead)
+{
+	if (BytesToRead < 0 || ReadPos + BytesToRead > PakEntry.UncompressedSize)
+	{
+		return false;
+	}
+
+	const int64 BlockSize = PakEntry.CompressionBlockSize;
+	const int32 NumBlocks = PakEntry.CompressionBlocks.Num();
+	const int64 EndPos = ReadPos + BytesToRead;
+	while (ReadPos < EndPos)
+	{
+		const int32 BlockIndex = (int32)(ReadPos / BlockSize);
+		const int64 OffsetInBlock = ReadPos - BlockIndex * BlockSize;
+
+		// Blocks covered from start to end go straight into the destination, but only when there are enough of them to be worth going wide,
+		// which holds on the game thread too since it is blocked on this read anyway.
+		// The last block of the file is shorter than the others, so it is whole if the read runs to the end of the file.
+		const int32 EndWholeBlock = EndPos == PakEntry.UncompressedSize ? NumBlocks : (int32)(EndPos / BlockSize);
+		const int32 NumWholeBlocks = OffsetInBlock == 0 ? EndWholeBlock - BlockIndex : 0;
+		if (NumWholeBlocks >= MinBlocksForParallelDecompression)
+		{
+			// One read for the compressed data of all of the blocks, since they are stored back to back
+			const int64 SpanStart = PakEntry.CompressionBlocks[BlockIndex].CompressedStart;
+			const int64 SpanEnd = PakEntry.CompressionBlocks[BlockIndex + NumWholeBlocks - 1].CompressedEnd;
+			const uint8* CompressedSpan = GetCompressedData(SpanStart, SpanEnd);
+			if (CompressedSpan == NULL)
+			{
+				return false;
+			}
+			uint8* UncompressedSpan = Destination;
+			const FPakEntry& Entry = PakEntry;
+			FThreadSafeCounter NumFailedBlocks;
+			ParallelFor(NumWholeBlocks, [&](int32 Index)
+			{
+				const int32 CurrentBlock = BlockIndex + Index;
+				const FPakCompressedBlock& Block = Entry.CompressionBlocks[CurrentBlock];
+				if (!DecompressBlock(Entry, CurrentBlock, CompressedSpan + (Block.CompressedStart - SpanStart), UncompressedSpan + Index * BlockSize, GetUncompressedBlockSize(CurrentBlock)))
+				{
+					NumFailedBlocks.Increment();
+				}
+			}, EParallelForFlags::AllowNamedThreadCaller);
+			if (NumFailedBlocks.GetValue() != 0)
+			{
+				return false;
+			}
+
+			const int64 SizeRead = FMath::Min<int64>(NumWholeBlocks * BlockSize, EndPos - ReadPos);
+			Destination += SizeRead;
+			ReadPos += SizeRead;
+		}
+		else
+		{
+			const FCachedBlock* Block = GetCachedBlock(BlockIndex);
+			if (Block == NULL)
+			{
+				return false;
+			}
+			const int64 SizeToCopy = FMath::Min<int64>(Block->Data.Num() - OffsetInBlock, EndPos - ReadPos);
+			FMemory::Memcpy(Destination, Block->Data.GetTypedData() + OffsetInBlock, SizeToCopy);
+			Destination += SizeToCopy;
+			ReadPos += SizeToCopy;
+		}
+	}
+	return true;
+}
+
 FPakFile::FPakFile(const TCHAR* Filename, bool bIsSigned)
 	: PakFilename(Filename)
 	, bSigned(bIsSigned)
 	, bIsValid(false)
+	, MappedData(NULL)
+	, MappedSize(0)
 {
 	FArchive* Reader = GetSharedReader(NULL);
 	if (Reader)
@@ -56,6 +305,8 @@ FPakFile::FPakFile(IPlatformFile* LowerLevel, const TCHAR* Filename, bool bIsSig
 	: PakFilename(Filename)
 	, bSigned(bIsSigned)
 	, bIsValid(false)
+	, MappedData(NULL)
+	, MappedSize(0)
 {
 	FArchive* Reader = GetSharedReader(LowerLevel);
 	if (Reader)
@@ -67,6 +318,59 @@ FPakFile::FPakFile(IPlatformFile* LowerLevel, const TCHAR* Filename, bool bIsSig
 
 FPakFile::~FPakFile()
 {
+#if PLATFORM_LINUX
+	if (MappedData != NULL)
+	{
+		munmap((void*)MappedData, MappedSize);
+	}
+#endif
+}
+
+bool FPakFile::Map(IPlatformFile* LowerLevel)
+{
+#if PLATFORM_LINUX
+	if (MappedData != NULL)
+	{
+		return true;
+	}
+	if (!bIsValid || Decryptor.IsValid())
+	{
+		// Signed paks have to be read through FSignedArchiveReader so that every chunk gets checked
+		return false;
+	}
+	if (LowerLevel != NULL && FCString::Strcmp(LowerLevel->GetName(), IPlatformFile::GetPhysicalTypeName()) != 0)
+	{
+		// The pak may not be a local file, let the wrapper read it
+		return false;
+	}
+
+	const int Handle = open(TCHAR_TO_UTF8(*FPaths::ConvertRelativePathToFull(PakFilename)), O_RDONLY);
+	if (Handle == -1)
+	{
+		UE_LOG(LogPakFile, Warning, TEXT("Unable to open pak \"%s\" for mapping (errno %d)."), *PakFilename, errno);
+		return false;
+	}
+	struct stat FileInfo;
+	void* Mapping = MAP_FAILED;
+	if (fstat(Handle, &FileInfo) == 0 && FileInfo.st_size > 0)
+	{
+		Mapping = mmap(NULL, FileInfo.st_size, PROT_READ, MAP_SHARED, Handle, 0);
+	}
+	// The mapping keeps the file referenced
+	close(Handle);
+	if (Mapping == MAP_FAILED)
+	{
+		UE_LOG(LogPakFile, Warning, TEXT("Unable to map pak \"%s\" (errno %d)."), *PakFilename, errno);
+		return false;
+	}
+
+	MappedData = (const uint8*)Mapping;
+	MappedSize = FileInfo.st_size;
+	UE_LOG(LogPakFile, Log, TEXT("Mapped pak \"%s\", %lld bytes."), *PakFilename, MappedSize);
+	return true;
+#else
+	return false;
+#endif
 }
 
 FArchive* FPakFile::CreatePakReader(const TCHAR* Filename)
@@ -261,6 +565,11 @@ public:
 			PlatformFile.HandlePakListCommand(Cmd, Ar);
 			return true;
 		}
+		else if (FParse::Command(&Cmd, TEXT("PakReadBench")))
+		{
+			PlatformFile.HandlePakReadBenchCommand(Cmd, Ar);
+			return true;
+		}
 		return false;
 	}
 };
@@ -285,11 +594,99 @@ void FPakPlatformFile::HandlePakListCommand(const TCHAR* Cmd, FOutputDevice& Ar)
 		Ar.Logf(TEXT("%s"), *Pak->GetFilename());
 	}	
 }
+
+void FPakPlatformFile::HandlePakReadBenchCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	// PakReadBench [PakFilename] [RUNS=n]
+	// Reads the stored bytes of every file in a pak from all task graph threads at once, through a single shared reader,
+	// through per-thread readers (what handles normally use) and through a memory mapping, and reports the best run of each.
+	FString PakFilename = FParse::Token(Cmd, false);
+	if (PakFilename.IsEmpty() || PakFilename.Contains(TEXT("=")))
+	{
+		TArray<FPakFile*> Paks;
+		GetMountedPaks(Paks);
+		PakFilename = Paks.Num() ? Paks[0]->GetFilename() : FString();
+	}
+	int32 NumRuns = 3;
+	FParse::Value(Cmd, TEXT("RUNS="), NumRuns);
+	NumRuns = FMath::Max(NumRuns, 1);
+
+	// Use a pak of our own so that the readers and mapping of the mounted paks are left alone
+	FPakFile Pak(LowerLevel, *PakFilename, bSigned);
+	if (PakFilename.IsEmpty() || !Pak.IsValid())
+	{
+		Ar.Logf(TEXT("Unable to open pak \"%s\"."), *PakFilename);
+		return;
+	}
+
+	TArray<const FPakEntry*> Entries;
+	int64 TotalSize = 0;
+	for (FPakFile::FFileIterator It(Pak); It; ++It)
+	{
+		Entries.Add(&It.Info());
+		TotalSize += It.Info().Size;
+	}
+	const int32 Version = Pak.GetInfo().Version;
+	FArchive* SharedReader = Pak.GetSharedReader(LowerLevel);
+	FCriticalSection SharedReaderCritical;
+	const bool bMapped = Pak.Map(LowerLevel);
+
+	enum EReadMode
+	{
+		ReadMode_SharedReader,
+		ReadMode_PerThreadReaders,
+		ReadMode_Mapped,
+		ReadMode_Num
+	};
+	static const TCHAR* ReadModeNames[ReadMode_Num] = { TEXT("shared reader"), TEXT("per-thread readers"), TEXT("mmap") };
+
+	Ar.Logf(TEXT("Reading %d files, %.1f MB from \"%s\", %d runs, %d worker threads."), Entries.Num(), TotalSize / (1024.0 * 1024.0), *PakFilename, NumRuns, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	for (int32 Mode = 0; Mode < ReadMode_Num; Mode++)
+	{
+		if (Mode == ReadMode_Mapped && !bMapped)
+		{
+			Ar.Logf(TEXT("  %s: not available for this pak on this platform."), ReadModeNames[Mode]);
+			continue;
+		}
+		double BestTime = 0.0;
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			ParallelFor(Entries.Num(), [&](int32 EntryIndex)
+			{
+				const FPakEntry& Entry = *Entries[EntryIndex];
+				const int64 DataOffset = Entry.Offset + Entry.GetSerializedSize(Version);
+				TArray<uint8> Buffer;
+				Buffer.AddUninitialized(Entry.Size);
+				if (Mode == ReadMode_SharedReader)
+				{
+					FScopeLock ScopedLock(&SharedReaderCritical);
+					SharedReader->Seek(DataOffset);
+					SharedReader->Serialize(Buffer.GetTypedData(), Entry.Size);
+				}
+				else if (Mode == ReadMode_PerThreadReaders)
+				{
+					FArchive* Reader = Pak.GetSharedReader(LowerLevel);
+					Reader->Seek(DataOffset);
+					Reader->Serialize(Buffer.GetTypedData(), Entry.Size);
+				}
+				else
+				{
+					FMemory::Memcpy(Buffer.GetTypedData(), Pak.GetMappedData() + DataOffset, Entry.Size);
+				}
+			}, EParallelForFlags::AllowNamedThreadCaller);
+			const double Time = FPlatformTime::Seconds() - StartTime;
+			BestTime = Run == 0 ? Time : FMath::Min(BestTime, Time);
+		}
+		Ar.Logf(TEXT("  %s: %.2f ms, %.1f MB/s"), ReadModeNames[Mode], BestTime * 1000.0, BestTime > 0.0 ? TotalSize / (1024.0 * 1024.0) / BestTime : 0.0);
+	}
+}
 #endif // !UE_BUILD_SHIPPING
 
 FPakPlatformFile::FPakPlatformFile()
 	: LowerLevel(NULL)
 	, bSigned(false)
+	, bMapPakFiles(false)
 {
 }
 
@@ -412,6 +809,7 @@ bool FPakPlatformFile::Initialize(IPlatformFile* Inner, const TCHAR* CmdLine)
 #else
 	bSigned = true;
 #endif
+	bMapPakFiles = FParse::Param(CmdLine, TEXT("MapPaks"));
 	
 	TArray<FString> PaksToLoad;
 #if !UE_BUILD_SHIPPING
@@ -466,6 +864,10 @@ bool FPakPlatformFile::Mount(const TCHAR* InPakFilename, const TCHAR* InPath /*=
 			{
 				Pak->SetMountPoint(InPath);
 			}
+			if (bMapPakFiles && !Pak->Map(LowerLevel))
+			{
+				UE_LOG(LogPakFile, Log, TEXT("Pak \"%s\" will be read without memory mapping."), InPakFilename);
+			}
 			{
 				// Add new pak file
 				FScopeLock ScopedLock(&PakListCritical);
@@ -488,7 +890,8 @@ bool FPakPlatformFile::Mount(const TCHAR* InPakFilename, const TCHAR* InPath /*=
 IFileHandle* FPakPlatformFile::CreatePakFileHandle(const TCHAR* Filename, FPakFile* PakFile, const FPakEntry* FileEntry)
 {
 	IFileHandle* Result = NULL;
-	FArchive* PakReader = PakFile->GetSharedReader(LowerLevel);
+	// Mapped paks do not need a reader, which saves looking one up under the reader map lock
+	FArchive* PakReader = PakFile->GetMappedData() == NULL ? PakFile->GetSharedReader(LowerLevel) : NULL;
 
 	// Create the handle.
 	Result = new FPakFileHandle(*PakFile, *FileEntry, PakReader, true);		
@@ -496,6 +899,23 @@ IFileHandle* FPakPlatformFile::CreatePakFileHandle(const TCHAR* Filename, FPakFi
 	return Result;
 }
 
+const uint8* FPakPlatformFile::GetMappedFileData(const TCHAR* Filename, int64& OutSize)
+{
+	FPakFile* PakFile = NULL;
+	const FPakEntry* FileEntry = FindFileInPakFiles(Filename, &PakFile);
+	if (FileEntry == NULL || PakFile->GetMappedData() == NULL)
+	{
+		return NULL;
+	}
+	FPakFileHandle Handle(*PakFile, *FileEntry, NULL, true);
+	const uint8* Data = Handle.GetMappedFileData();
+	if (Data != NULL)
+	{
+		OutSize = FileEntry->Size;
+	}
+	return Data;
+}
+
 bool FPakPlatformFile::HandleMountPakDelegate(const FString& PakFilePath)
 {
 	return Mount(*PakFilePath);
@@ -22,8 +22,9 @@ struct FPakInfo
 	{
 		PakFile_Version_Initial = 1,
 		PakFile_Version_NoTimestamps = 2,
+		PakFile_Version_CompressedBlocks = 3,
 
-		PakFile_Version_Latest = PakFile_Version_NoTimestamps
+		PakFile_Version_Latest = PakFile_Version_CompressedBlocks
 	};
 
 	/** Pak file magic value. */
@@ -80,6 +81,34 @@ struct FPakInfo
 	}
 };
 
+/**
+ * Struct which holds the location of a single compressed block of a pak entry.
+ */
+struct FPakCompressedBlock
+{
+	/** Offset of the start of the compressed block, relative to the start of the entry header. */
+	int64 CompressedStart;
+	/** Offset of the end of the compressed block, relative to the start of the entry header. */
+	int64 CompressedEnd;
+
+	bool operator == (const FPakCompressedBlock& B) const
+	{
+		return CompressedStart == B.CompressedStart && CompressedEnd == B.CompressedEnd;
+	}
+
+	bool operator != (const FPakCompressedBlock& B) const
+	{
+		return !(*this == B);
+	}
+};
+
+FORCEINLINE FArchive& operator<<(FArchive& Ar, FPakCompressedBlock& Block)
+{
+	Ar << Block.CompressedStart;
+	Ar << Block.CompressedEnd;
+	return Ar;
+}
+
 /**
  * Struct holding info about a single file stored in pak file.
  */
@@ -93,8 +122,12 @@ struct FPakEntry
 	int64 UncompressedSize;
 	/** Compression method. */
 	int32 CompressionMethod;
-	/** File SHA1 value. */
+	/** File SHA1 value, computed over the data as it is stored in the pak (compressed for compressed entries). */
 	uint8 Hash[20];
+	/** For compressed entries, the location of every compressed block. Each block holds CompressionBlockSize bytes once uncompressed, except for the last one. */
+	TArray<FPakCompressedBlock> CompressionBlocks;
+	/** For compressed entries, the uncompressed size of every block but the last. */
+	uint32 CompressionBlockSize;
 	/** Flag is set to true when FileHeader has been checked against PakHeader. It is not serialized */
 	mutable bool  Verified;
 
@@ -106,6 +139,7 @@ struct FPakEntry
 		, Size(0)
 		, UncompressedSize(0)
 		, CompressionMethod(0)
+		, CompressionBlockSize(0)
 		, Verified(false)
 	{
 		FMemory::Memset(Hash, 0, sizeof(Hash));
@@ -124,6 +158,11 @@ struct FPakEntry
 			// Timestamp
 			SerializedSize += sizeof(int64);
 		}
+		if (IsBlockCompressed(Version))
+		{
+			// Block table
+			SerializedSize += sizeof(int32) + CompressionBlocks.Num() * 2 * sizeof(int64) + sizeof(CompressionBlockSize);
+		}
 		return SerializedSize;
 	}
 
@@ -137,6 +176,8 @@ struct FPakEntry
 		return Size == B.Size && 
 			UncompressedSize == B.UncompressedSize &&
 			CompressionMethod == B.CompressionMethod &&
+			CompressionBlockSize == B.CompressionBlockSize &&
+			CompressionBlocks == B.CompressionBlocks &&
 			FMemory::Memcmp(Hash, B.Hash, sizeof(Hash)) == 0;
 	}
 
@@ -147,10 +188,7 @@ struct FPakEntry
 	{
 		// Offsets are not compared here because they're not
 		// serialized with file headers anyway.
-		return Size != B.Size || 
-			UncompressedSize != B.UncompressedSize ||
-			CompressionMethod != B.CompressionMethod ||
-			FMemory::Memcmp(Hash, B.Hash, sizeof(Hash)) != 0;
+		return !(*this == B);
 	}
 
 	/**
@@ -171,6 +209,34 @@ struct FPakEntry
 			Ar << Timestamp;
 		}
 		Ar.Serialize(Hash, sizeof(Hash));
+		if (IsBlockCompressed(Version))
+		{
+			Ar << CompressionBlocks;
+			Ar << CompressionBlockSize;
+		}
+	}
+
+	/**
+	 * Checks whether this entry is stored as compressed blocks. Paks older than PakFile_Version_CompressedBlocks
+	 * have no block table, and their entries are read as they are stored whatever their compression method says.
+	 *
+	 * @param Version Version of the pak file the entry belongs to.
+	 * @return true if the entry has a block table and has to be decompressed when it is read.
+	 */
+	bool IsBlockCompressed(int32 Version) const
+	{
+		return Version >= FPakInfo::PakFile_Version_CompressedBlocks && CompressionMethod != COMPRESS_None;
+	}
+
+	/**
+	 * Gets the size of the file once it has been read from the pak.
+	 *
+	 * @param Version Version of the pak file the entry belongs to.
+	 * @return Uncompressed file size.
+	 */
+	int64 GetFileSize(int32 Version) const
+	{
+		return IsBlockCompressed(Version) ? UncompressedSize : Size;
 	}
 
 	/**
@@ -212,6 +278,10 @@ class PAKFILE_API FPakFile
 	bool bSigned;
 	/** True if this pak file is valid and usable */
 	bool bIsValid;
+	/** Start of the memory mapped pak file, NULL if the pak is read through archives. */
+	const uint8* MappedData;
+	/** Size of the memory mapped pak file. */
+	int64 MappedSize;
 
 	FArchive* CreatePakReader(const TCHAR* Filename);
 	FArchive* CreatePakReader(IFileHandle& InHandle, const TCHAR* Filename);
@@ -275,6 +345,36 @@ public:
 	 */
 	FArchive* GetSharedReader(IPlatformFile* LowerLevel);
 
+	/**
+	 * Maps the whole pak file into memory. Handles to a mapped pak read without taking any locks or seeking,
+	 * and uncompressed entries can be used in place. Only supported on Linux, and only for unsigned paks
+	 * that live on the physical file system.
+	 *
+	 * @param LowerLevel Platform file the pak was opened through, NULL for the default one.
+	 * @return true if the pak file is mapped.
+	 */
+	bool Map(IPlatformFile* LowerLevel);
+
+	/**
+	 * Gets the memory mapped pak file.
+	 *
+	 * @return Start of the mapped pak file, NULL if the pak is not mapped.
+	 */
+	const uint8* GetMappedData() const
+	{
+		return MappedData;
+	}
+
+	/**
+	 * Gets the size of the memory mapped pak file.
+	 *
+	 * @return Size of the mapping, 0 if the pak is not mapped.
+	 */
+	int64 GetMappedSize() const
+	{
+		return MappedSize;
+	}
+
 	/**
 	 * Finds an entry in the pak file matching the given filename.
 	 *
@@ -532,14 +632,93 @@ class PAKFILE_API FPakFileHandle : public IFileHandle
 	const FPakFile& PakFile;
 	/** Pak file entry for this file. */
 	const FPakEntry& PakEntry;
-	/** Pak file archive to read the data from. */
+	/** Pak file archive to read the data from, NULL if the pak is memory mapped. */
 	FArchive* PakReader;
+	/** Memory mapped pak file, NULL if the data is read through PakReader. */
+	const uint8* MappedData;
 	/** True if PakReader is shared and should not be deleted by this handle. */
 	const bool bSharedReader;
 	/** Offset to the file in pak (including the file header). */
 	int64 OffsetToFile;
 	/** Current read position. */
 	int64 ReadPos;
+	/** True if the entry is stored as compressed blocks, see FPakEntry::IsBlockCompressed. */
+	const bool bBlockCompressed;
+
+	enum
+	{
+		/** Number of uncompressed blocks kept around by a handle to a compressed entry, so that small sequential reads and seeks back do not decompress the same block over and over. */
+		NumCachedBlocks = 2,
+		/** Reads that cover at least this many whole blocks decompress them straight into the destination, spread over the task graph workers. */
+		MinBlocksForParallelDecompression = 4,
+	};
+
+	/** Uncompressed copy of one block of a compressed entry. */
+	struct FCachedBlock
+	{
+		/** Index of the block, INDEX_NONE if this slot is empty. */
+		int32 BlockIndex;
+		/** Value of BlockUseCounter when this block was last read from, used to pick the slot to reuse. */
+		uint32 LastUse;
+		/** Uncompressed block data. */
+		TArray<uint8> Data;
+
+		FCachedBlock()
+			: BlockIndex(INDEX_NONE)
+			, LastUse(0)
+		{}
+	};
+	/** Block cache, only used for compressed entries. */
+	FCachedBlock CachedBlocks[NumCachedBlocks];
+	/** Incremented every time a cached block is used. */
+	uint32 BlockUseCounter;
+	/** Scratch buffer for compressed data, not used when the pak is memory mapped. */
+	TArray<uint8> CompressedBuffer;
+
+	/**
+	 * Gets compressed data of this entry, either straight from the mapped pak or by reading it into CompressedBuffer.
+	 *
+	 * @param Start Offset of the data, relative to the entry header.
+	 * @param End Offset of the end of the data, relative to the entry header.
+	 * @return Pointer to the compressed data, valid until the next call. NULL if the range lies outside of the entry.
+	 */
+	const uint8* GetCompressedData(int64 Start, int64 End);
+
+	/**
+	 * Checks the file header against the index entry, once per entry.
+	 *
+	 * @return true if the header matches.
+	 */
+	bool VerifyHeader();
+
+	/**
+	 * Reads from an uncompressed entry.
+	 */
+	bool ReadUncompressed(uint8* Destination, int64 BytesToRead);
+
+	/**
+	 * Reads from a compressed entry, decompressing the blocks that the read touches.
+	 */
+	bool ReadCompressed(uint8* Destination, int64 BytesToRead);
+
+	/**
+	 * Gets the uncompressed size of a block.
+	 *
+	 * @param BlockIndex Index of the block.
+	 * @return Size of the block once uncompressed.
+	 */
+	int64 GetUncompressedBlockSize(int32 BlockIndex) const
+	{
+		return FMath::Min<int64>(PakEntry.CompressionBlockSize, PakEntry.UncompressedSize - (int64)BlockIndex * PakEntry.CompressionBlockSize);
+	}
+
+	/**
+	 * Finds a block in the cache, decompressing it into the least recently used slot if it is not there.
+	 *
+	 * @param BlockIndex Index of the block.
+	 * @return The cached block, or NULL if the block could not be read.
+	 */
+	const FCachedBlock* GetCachedBlock(int32 BlockIndex);
 
 public:
 
@@ -554,8 +733,11 @@ public:
 		: PakFile(InPakFile)
 		, PakEntry(InPakEntry)
 		, PakReader(InPakReader)
+		, MappedData(InPakFile.GetMappedData())
 		, bSharedReader(bIsSharedReader)
 		, ReadPos(0)
+		, bBlockCompressed(InPakEntry.IsBlockCompressed(InPakFile.GetInfo().Version))
+		, BlockUseCounter(0)
 	{
 		OffsetToFile = PakEntry.Offset + PakEntry.GetSerializedSize(PakFile.GetInfo().Version);
 	}
@@ -571,6 +753,25 @@ public:
 		}
 	}
 
+	/**
+	 * Decompresses a single block of a compressed entry. Thread safe.
+	 *
+	 * @param Entry Pak entry the block belongs to.
+	 * @param BlockIndex Index of the block.
+	 * @param Compressed Compressed block data.
+	 * @param Destination Buffer that receives the uncompressed block.
+	 * @param UncompressedBlockSize Size of the block once uncompressed.
+	 * @return true if the block was decompressed successfully.
+	 */
+	static bool DecompressBlock(const FPakEntry& Entry, int32 BlockIndex, const uint8* Compressed, uint8* Destination, int64 UncompressedBlockSize);
+
+	/**
+	 * Gets the contents of an uncompressed entry of a memory mapped pak, so they can be used without copying them.
+	 *
+	 * @return Pointer to the first byte of the file, NULL if the pak is not mapped, the entry is compressed or its header is corrupt.
+	 */
+	const uint8* GetMappedFileData();
+
 	// BEGIN IFileHandle Interface
 	virtual int64 Tell() OVERRIDE
 	{
@@ -578,7 +779,7 @@ public:
 	}
 	virtual bool Seek(int64 NewPosition) OVERRIDE
 	{
-		if (NewPosition > PakEntry.Size || NewPosition < 0)
+		if (NewPosition > Size() || NewPosition < 0)
 		{
 			return false;
 		}
@@ -587,39 +788,21 @@ public:
 	}
 	virtual bool SeekFromEnd(int64 NewPositionRelativeToEnd) OVERRIDE
 	{
-		return Seek(PakEntry.Size - NewPositionRelativeToEnd);
+		return Seek(Size() - NewPositionRelativeToEnd);
 	}
 	virtual bool Read(uint8* Destination, int64 BytesToRead) OVERRIDE
 	{
 		// Check that the file header is OK
-		if (!PakEntry.Verified)
-		{
-			FPakEntry FileHeader;
-			PakReader->Seek(PakEntry.Offset);
-			FileHeader.Serialize(*PakReader, PakFile.GetInfo().Version);
-			if (FPakEntry::VerifyPakEntriesMatch(PakEntry, FileHeader))
-			{
-				PakEntry.Verified = true;
-			}
-			else
-			{
-				//Header is corrupt, fail the read
-				return false;
-			}
-		}
-		//
-		PakReader->Seek(OffsetToFile + ReadPos);
-		if (PakEntry.Size >= (ReadPos + BytesToRead))
+		if (!VerifyHeader())
 		{
-			// Read directly from Pak.
-			PakReader->Serialize(Destination, BytesToRead);
-			ReadPos += BytesToRead;
-			return true;
+			//Header is corrupt, fail the read
+			return false;
 		}
-		else
+		if (bBlockCompressed)
 		{
-			return false;
+			return ReadCompressed(Destination, BytesToRead);
 		}
+		return ReadUncompressed(Destination, BytesToRead);
 	}
 	virtual bool Write(const uint8* Source, int64 BytesToWrite) OVERRIDE
 	{
@@ -628,7 +811,7 @@ public:
 	}
 	virtual int64 Size() OVERRIDE
 	{
-		return PakEntry.Size;
+		return bBlockCompressed ? PakEntry.UncompressedSize : PakEntry.Size;
 	}
 	/// END IFileHandle Interface
 };
@@ -644,6 +827,8 @@ class PAKFILE_API FPakPlatformFile : public IPlatformFile
 	TArray<FPakFile*> PakFiles;
 	/** True if this we're using signed content. */
 	bool bSigned;
+	/** True if pak files should be memory mapped when they are mounted (-MapPaks). */
+	bool bMapPakFiles;
 	/** Synchronization object for accessing the list of currently mounted pak files. */
 	FCriticalSection PakListCritical;
 
@@ -703,6 +888,20 @@ class PAKFILE_API FPakPlatformFile : public IPlatformFile
 	 */
 	IFileHandle* CreatePakFileHandle(const TCHAR* Filename, FPakFile* PakFile, const FPakEntry* FileEntry);
 
+public:
+
+	/**
+	 * Gets the contents of a file without copying them, which only works for uncompressed files in memory mapped pak files.
+	 * The data stays valid for as long as the pak file is mounted.
+	 *
+	 * @param Filename File to look for.
+	 * @param OutSize Receives the size of the file.
+	 * @return Pointer to the file contents, NULL if the file has to be read with OpenRead instead.
+	 */
+	const uint8* GetMappedFileData(const TCHAR* Filename, int64& OutSize);
+
+private:
+
 	/**
 	 * Handler for device delegate to prompt us to load a new pak.	 
 	 */
@@ -833,10 +1032,11 @@ public:
 	virtual int64 FileSize(const TCHAR* Filename) OVERRIDE
 	{
 		// Check pak files first
-		const FPakEntry* FileEntry = FindFileInPakFiles(Filename);
+		FPakFile* PakFile = NULL;
+		const FPakEntry* FileEntry = FindFileInPakFiles(Filename, &PakFile);
 		if (FileEntry != NULL)
 		{
-			return FileEntry->Size;
+			return FileEntry->GetFileSize(PakFile->GetInfo().Version);
 		}
 		// First look for the file in the user dir.
 		int64 Result = LowerLevel->FileSize(Filename);
@@ -1140,6 +1340,7 @@ public:
 #if !UE_BUILD_SHIPPING
 	void HandlePakListCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 	void HandleMountCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	void HandlePakReadBenchCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 #endif
 	// END Console commands
 };
@@ -0,0 +1,122 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	RHICommandList.cpp: Recordable lists of RHI commands.
+=============================================================================*/
+
+#include "RHI.h"
+#include "RHICommandList.h"
+
+DECLARE_CYCLE_STAT(TEXT("Execute RHI command lists"), STAT_RHICommandListExecute, STATGROUP_RHI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RHI commands executed"), STAT_RHICommandsExecuted, STATGROUP_RHI);
+
+FRHICommandList::FRHICommandList(int32 InChunkSize)
+	: Root(NULL)
+	, CommandLink(&Root)
+	, NumCommands(0)
+	, Top(NULL)
+	, End(NULL)
+	, FirstChunk(NULL)
+	, CurrentChunk(NULL)
+	, ChunkSize(InChunkSize)
+{
+}
+
+FRHICommandList::~FRHICommandList()
+{
+	checkf(IsEmpty(), TEXT("An RHI command list with %d commands was destroyed without being executed or reset."), NumCommands);
+	FChunk* Chunk = FirstChunk;
+	while (Chunk)
+	{
+		FChunk* Next = Chunk->Next;
+		FMemory::Free(Chunk);
+		Chunk = Next;
+	}
+}
+
+void FRHICommandList::Execute()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RHICommandListExecute);
+	INC_DWORD_STAT_BY(STAT_RHICommandsExecuted, NumCommands);
+
+	for (FRHICommandBase* Command = Root; Command; Command = Command->Next)
+	{
+		Command->ExecuteCommand(Command);
+	}
+	Reset();
+}
+
+void FRHICommandList::ExecuteLists(FRHICommandList* const* Lists, int32 NumLists)
+{
+	for (int32 ListIndex = 0; ListIndex < NumLists; ListIndex++)
+	{
+		Lists[ListIndex]->Execute();
+	}
+}
+
+void FRHICommandList::Reset()
+{
+	Root = NULL;
+	CommandLink = &Root;
+	NumCommands = 0;
+
+	// keep every chunk, the next recording is usually about as large as this one
+	CurrentChunk = FirstChunk;
+	if (CurrentChunk)
+	{
+		Top = CurrentChunk->GetData();
+		End = Top + CurrentChunk->Size;
+	}
+	else
+	{
+		Top = End = NULL;
+	}
+}
+
+int32 FRHICommandList::GetAllocatedSize() const
+{
+	int32 Size = 0;
+	for (FChunk* Chunk = FirstChunk; Chunk; Chunk = Chunk->Next)
+	{
+		Size += sizeof(FChunk) + Chunk->Size;
+	}
+	return Size;
+}
+
+void* FRHICommandList::AllocNewChunk(int32 AllocSize, int32 Alignment)
+{
+	const int32 MinSize = AllocSize + Alignment;
+
+	// reuse the chunks left over from an earlier recording, dropping any that are too small for this allocation
+	FChunk* NextChunk = CurrentChunk ? CurrentChunk->Next : FirstChunk;
+	while (NextChunk && NextChunk->Size < MinSize)
+	{
+		FChunk* TooSmall = NextChunk;
+		NextChunk = NextChunk->Next;
+		FMemory::Free(TooSmall);
+	}
+
+	if (!NextChunk)
+	{
+		const int32 DataSize = FMath::Max(ChunkSize - (int32)sizeof(FChunk), MinSize);
+		NextChunk = (FChunk*)FMemory::Malloc(sizeof(FChunk) + DataSize);
+		NextChunk->Next = NULL;
+		NextChunk->Size = DataSize;
+	}
+
+	if (CurrentChunk)
+	{
+		CurrentChunk->Next = NextChunk;
+	}
+	else
+	{
+		FirstChunk = NextChunk;
+	}
+	CurrentChunk = NextChunk;
+
+	uint8* Result = Align(CurrentChunk->GetData(), Alignment);
+	Top = Result + AllocSize;
+	End = CurrentChunk->GetData() + CurrentChunk->Size;
+	check(Top <= End);
+	return Result;
+}
@@ -1563,4 +1563,7 @@ extern RHI_API void RHIExit();
 // RHI utility functions that depend on the RHI definitions.
 #include "RHIUtilities.h"
 
+// Recordable lists of RHI commands.
+#include "RHICommandList.h"
+
 #endif // __RHI_h__
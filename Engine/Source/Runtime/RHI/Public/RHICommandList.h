@@ -0,0 +1,462 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	RHICommandList.h: Recordable lists of RHI commands.
+=============================================================================*/
+
+#pragma once
+
+#include "RHI.h"
+
+/**
+ * Base of every recorded RHI command.
+ * Commands are constructed in the owning list's memory arena and linked in recording order. Replaying a command calls
+ * ExecuteCommand, which casts back to the concrete command type, so replay is a single indirect call per command.
+ */
+struct FRHICommandBase
+{
+	typedef void (*FExecuteCommandFunc)(FRHICommandBase* Command);
+
+	/** The next command in the list, or NULL for the last command. */
+	FRHICommandBase* Next;
+
+	/** Calls the RHI function that this command was recorded from. */
+	FExecuteCommandFunc ExecuteCommand;
+
+	FRHICommandBase(FExecuteCommandFunc InExecuteCommand)
+		: Next(NULL)
+		, ExecuteCommand(InExecuteCommand)
+	{
+	}
+};
+
+/**
+ * Helper that provides the replay function for a concrete command type, which must implement Execute().
+ * Commands are never destructed, so they may only hold raw resource pointers and values; anything variably sized
+ * is copied into the list's arena when the command is recorded.
+ */
+template<typename TCmd>
+struct TRHICommand : public FRHICommandBase
+{
+	TRHICommand()
+		: FRHICommandBase(&ExecuteThunk)
+	{
+	}
+
+private:
+	static void ExecuteThunk(FRHICommandBase* Command)
+	{
+		static_cast<TCmd*>(Command)->Execute();
+	}
+};
+
+struct FRHICommandSetStreamSource : public TRHICommand<FRHICommandSetStreamSource>
+{
+	uint32 StreamIndex;
+	FVertexBufferRHIParamRef VertexBuffer;
+	uint32 Stride;
+	uint32 Offset;
+
+	FORCEINLINE FRHICommandSetStreamSource(uint32 InStreamIndex, FVertexBufferRHIParamRef InVertexBuffer, uint32 InStride, uint32 InOffset)
+		: StreamIndex(InStreamIndex)
+		, VertexBuffer(InVertexBuffer)
+		, Stride(InStride)
+		, Offset(InOffset)
+	{
+	}
+	void Execute() { RHISetStreamSource(StreamIndex, VertexBuffer, Stride, Offset); }
+};
+
+struct FRHICommandSetRasterizerState : public TRHICommand<FRHICommandSetRasterizerState>
+{
+	FRasterizerStateRHIParamRef State;
+
+	FORCEINLINE FRHICommandSetRasterizerState(FRasterizerStateRHIParamRef InState)
+		: State(InState)
+	{
+	}
+	void Execute() { RHISetRasterizerState(State); }
+};
+
+struct FRHICommandSetDepthStencilState : public TRHICommand<FRHICommandSetDepthStencilState>
+{
+	FDepthStencilStateRHIParamRef State;
+	uint32 StencilRef;
+
+	FORCEINLINE FRHICommandSetDepthStencilState(FDepthStencilStateRHIParamRef InState, uint32 InStencilRef)
+		: State(InState)
+		, StencilRef(InStencilRef)
+	{
+	}
+	void Execute() { RHISetDepthStencilState(State, StencilRef); }
+};
+
+struct FRHICommandSetBlendState : public TRHICommand<FRHICommandSetBlendState>
+{
+	FBlendStateRHIParamRef State;
+	FLinearColor BlendFactor;
+
+	FORCEINLINE FRHICommandSetBlendState(FBlendStateRHIParamRef InState, const FLinearColor& InBlendFactor)
+		: State(InState)
+		, BlendFactor(InBlendFactor)
+	{
+	}
+	void Execute() { RHISetBlendState(State, BlendFactor); }
+};
+
+struct FRHICommandSetBoundShaderState : public TRHICommand<FRHICommandSetBoundShaderState>
+{
+	FBoundShaderStateRHIParamRef BoundShaderState;
+
+	FORCEINLINE FRHICommandSetBoundShaderState(FBoundShaderStateRHIParamRef InBoundShaderState)
+		: BoundShaderState(InBoundShaderState)
+	{
+	}
+	void Execute() { RHISetBoundShaderState(BoundShaderState); }
+};
+
+struct FRHICommandSetViewport : public TRHICommand<FRHICommandSetViewport>
+{
+	uint32 MinX;
+	uint32 MinY;
+	float MinZ;
+	uint32 MaxX;
+	uint32 MaxY;
+	float MaxZ;
+
+	FORCEINLINE FRHICommandSetViewport(uint32 InMinX, uint32 InMinY, float InMinZ, uint32 InMaxX, uint32 InMaxY, float InMaxZ)
+		: MinX(InMinX)
+		, MinY(InMinY)
+		, MinZ(InMinZ)
+		, MaxX(InMaxX)
+		, MaxY(InMaxY)
+		, MaxZ(InMaxZ)
+	{
+	}
+	void Execute() { RHISetViewport(MinX, MinY, MinZ, MaxX, MaxY, MaxZ); }
+};
+
+struct FRHICommandSetScissorRect : public TRHICommand<FRHICommandSetScissorRect>
+{
+	bool bEnable;
+	uint32 MinX;
+	uint32 MinY;
+	uint32 MaxX;
+	uint32 MaxY;
+
+	FORCEINLINE FRHICommandSetScissorRect(bool InbEnable, uint32 InMinX, uint32 InMinY, uint32 InMaxX, uint32 InMaxY)
+		: bEnable(InbEnable)
+		, MinX(InMinX)
+		, MinY(InMinY)
+		, MaxX(InMaxX)
+		, MaxY(InMaxY)
+	{
+	}
+	void Execute() { RHISetScissorRect(bEnable, MinX, MinY, MaxX, MaxY); }
+};
+
+/** The shader commands are templated on the shader reference type and resolve to the matching RHI overload. */
+template<typename TShaderRHIParamRef>
+struct TRHICommandSetShaderParameter : public TRHICommand<TRHICommandSetShaderParameter<TShaderRHIParamRef> >
+{
+	TShaderRHIParamRef Shader;
+	uint32 BufferIndex;
+	uint32 BaseIndex;
+	uint32 NumBytes;
+	/** Copy of the parameter value in the list's arena. */
+	const void* NewValue;
+
+	FORCEINLINE TRHICommandSetShaderParameter(TShaderRHIParamRef InShader, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue)
+		: Shader(InShader)
+		, BufferIndex(InBufferIndex)
+		, BaseIndex(InBaseIndex)
+		, NumBytes(InNumBytes)
+		, NewValue(InNewValue)
+	{
+	}
+	void Execute() { RHISetShaderParameter(Shader, BufferIndex, BaseIndex, NumBytes, NewValue); }
+};
+
+template<typename TShaderRHIParamRef>
+struct TRHICommandSetShaderTexture : public TRHICommand<TRHICommandSetShaderTexture<TShaderRHIParamRef> >
+{
+	TShaderRHIParamRef Shader;
+	uint32 TextureIndex;
+	FTextureRHIParamRef Texture;
+
+	FORCEINLINE TRHICommandSetShaderTexture(TShaderRHIParamRef InShader, uint32 InTextureIndex, FTextureRHIParamRef InTexture)
+		: Shader(InShader)
+		, TextureIndex(InTextureIndex)
+		, Texture(InTexture)
+	{
+	}
+	void Execute() { RHISetShaderTexture(Shader, TextureIndex, Texture); }
+};
+
+template<typename TShaderRHIParamRef>
+struct TRHICommandSetShaderSampler : public TRHICommand<TRHICommandSetShaderSampler<TShaderRHIParamRef> >
+{
+	TShaderRHIParamRef Shader;
+	uint32 SamplerIndex;
+	FSamplerStateRHIParamRef State;
+
+	FORCEINLINE TRHICommandSetShaderSampler(TShaderRHIParamRef InShader, uint32 InSamplerIndex, FSamplerStateRHIParamRef InState)
+		: Shader(InShader)
+		, SamplerIndex(InSamplerIndex)
+		, State(InState)
+	{
+	}
+	void Execute() { RHISetShaderSampler(Shader, SamplerIndex, State); }
+};
+
+template<typename TShaderRHIParamRef>
+struct TRHICommandSetShaderResourceViewParameter : public TRHICommand<TRHICommandSetShaderResourceViewParameter<TShaderRHIParamRef> >
+{
+	TShaderRHIParamRef Shader;
+	uint32 SamplerIndex;
+	FShaderResourceViewRHIParamRef SRV;
+
+	FORCEINLINE TRHICommandSetShaderResourceViewParameter(TShaderRHIParamRef InShader, uint32 InSamplerIndex, FShaderResourceViewRHIParamRef InSRV)
+		: Shader(InShader)
+		, SamplerIndex(InSamplerIndex)
+		, SRV(InSRV)
+	{
+	}
+	void Execute() { RHISetShaderResourceViewParameter(Shader, SamplerIndex, SRV); }
+};
+
+template<typename TShaderRHIParamRef>
+struct TRHICommandSetShaderUniformBuffer : public TRHICommand<TRHICommandSetShaderUniformBuffer<TShaderRHIParamRef> >
+{
+	TShaderRHIParamRef Shader;
+	uint32 BufferIndex;
+	FUniformBufferRHIParamRef Buffer;
+
+	FORCEINLINE TRHICommandSetShaderUniformBuffer(TShaderRHIParamRef InShader, uint32 InBufferIndex, FUniformBufferRHIParamRef InBuffer)
+		: Shader(InShader)
+		, BufferIndex(InBufferIndex)
+		, Buffer(InBuffer)
+	{
+	}
+	void Execute() { RHISetShaderUniformBuffer(Shader, BufferIndex, Buffer); }
+};
+
+struct FRHICommandDrawPrimitive : public TRHICommand<FRHICommandDrawPrimitive>
+{
+	uint32 PrimitiveType;
+	uint32 BaseVertexIndex;
+	uint32 NumPrimitives;
+	uint32 NumInstances;
+
+	FORCEINLINE FRHICommandDrawPrimitive(uint32 InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, uint32 InNumInstances)
+		: PrimitiveType(InPrimitiveType)
+		, BaseVertexIndex(InBaseVertexIndex)
+		, NumPrimitives(InNumPrimitives)
+		, NumInstances(InNumInstances)
+	{
+	}
+	void Execute() { RHIDrawPrimitive(PrimitiveType, BaseVertexIndex, NumPrimitives, NumInstances); }
+};
+
+struct FRHICommandDrawIndexedPrimitive : public TRHICommand<FRHICommandDrawIndexedPrimitive>
+{
+	FIndexBufferRHIParamRef IndexBuffer;
+	uint32 PrimitiveType;
+	int32 BaseVertexIndex;
+	uint32 MinIndex;
+	uint32 NumVertices;
+	uint32 StartIndex;
+	uint32 NumPrimitives;
+	uint32 NumInstances;
+
+	FORCEINLINE FRHICommandDrawIndexedPrimitive(FIndexBufferRHIParamRef InIndexBuffer, uint32 InPrimitiveType, int32 InBaseVertexIndex, uint32 InMinIndex, uint32 InNumVertices, uint32 InStartIndex, uint32 InNumPrimitives, uint32 InNumInstances)
+		: IndexBuffer(InIndexBuffer)
+		, PrimitiveType(InPrimitiveType)
+		, BaseVertexIndex(InBaseVertexIndex)
+		, MinIndex(InMinIndex)
+		, NumVertices(InNumVertices)
+		, StartIndex(InStartIndex)
+		, NumPrimitives(InNumPrimitives)
+		, NumInstances(InNumInstances)
+	{
+	}
+	void Execute() { RHIDrawIndexedPrimitive(IndexBuffer, PrimitiveType, BaseVertexIndex, MinIndex, NumVertices, StartIndex, NumPrimitives, NumInstances); }
+};
+
+/**
+ * A list of RHI commands that is recorded now and replayed later.
+ *
+ * Recording only writes into the list's own memory arena, so any thread may record into a list it owns, and several
+ * task graph workers can each record a list in parallel. The lists are then replayed with Execute or ExecuteLists on
+ * the thread that owns the RHI (the rendering thread), which calls the RHI functions in the order they were recorded.
+ *
+ * Resources are referenced by raw pointer and are not reference counted by the list, so every resource used by a
+ * recorded command must stay alive until the list has been executed or reset.
+ */
+class RHI_API FRHICommandList : public FNoncopyable
+{
+public:
+
+	FRHICommandList(int32 InChunkSize = DEFAULT_CHUNK_SIZE);
+	~FRHICommandList();
+
+	/** Replays every recorded command on the calling thread, then empties the list so it can be recorded again. */
+	void Execute();
+
+	/** Replays several lists in array order. Used to submit lists that were recorded in parallel. */
+	static void ExecuteLists(FRHICommandList* const* Lists, int32 NumLists);
+
+	/** Discards the recorded commands without executing them. The arena memory is kept for the next recording. */
+	void Reset();
+
+	/** @return true if no commands have been recorded since the list was last executed or reset. */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return NumCommands == 0;
+	}
+
+	/** @return the number of commands recorded since the list was last executed or reset. */
+	FORCEINLINE int32 GetNumCommands() const
+	{
+		return NumCommands;
+	}
+
+	/** @return the number of bytes of arena memory currently owned by this list. */
+	int32 GetAllocatedSize() const;
+
+	/** Allocates memory from the list's arena that stays valid until the list is executed or reset. */
+	FORCEINLINE void* Alloc(int32 AllocSize, int32 Alignment)
+	{
+		uint8* Result = Align(Top, Alignment);
+		uint8* NewTop = Result + AllocSize;
+		if (NewTop <= End)
+		{
+			Top = NewTop;
+			return Result;
+		}
+		return AllocNewChunk(AllocSize, Alignment);
+	}
+
+	FORCEINLINE void SetStreamSource(uint32 StreamIndex, FVertexBufferRHIParamRef VertexBuffer, uint32 Stride, uint32 Offset)
+	{
+		new (AllocCommand<FRHICommandSetStreamSource>()) FRHICommandSetStreamSource(StreamIndex, VertexBuffer, Stride, Offset);
+	}
+
+	FORCEINLINE void SetRasterizerState(FRasterizerStateRHIParamRef NewState)
+	{
+		new (AllocCommand<FRHICommandSetRasterizerState>()) FRHICommandSetRasterizerState(NewState);
+	}
+
+	FORCEINLINE void SetDepthStencilState(FDepthStencilStateRHIParamRef NewState, uint32 StencilRef = 0)
+	{
+		new (AllocCommand<FRHICommandSetDepthStencilState>()) FRHICommandSetDepthStencilState(NewState, StencilRef);
+	}
+
+	FORCEINLINE void SetBlendState(FBlendStateRHIParamRef NewState, const FLinearColor& BlendFactor = FLinearColor::White)
+	{
+		new (AllocCommand<FRHICommandSetBlendState>()) FRHICommandSetBlendState(NewState, BlendFactor);
+	}
+
+	FORCEINLINE void SetBoundShaderState(FBoundShaderStateRHIParamRef BoundShaderState)
+	{
+		new (AllocCommand<FRHICommandSetBoundShaderState>()) FRHICommandSetBoundShaderState(BoundShaderState);
+	}
+
+	FORCEINLINE void SetViewport(uint32 MinX, uint32 MinY, float MinZ, uint32 MaxX, uint32 MaxY, float MaxZ)
+	{
+		new (AllocCommand<FRHICommandSetViewport>()) FRHICommandSetViewport(MinX, MinY, MinZ, MaxX, MaxY, MaxZ);
+	}
+
+	FORCEINLINE void SetScissorRect(bool bEnable, uint32 MinX, uint32 MinY, uint32 MaxX, uint32 MaxY)
+	{
+		new (AllocCommand<FRHICommandSetScissorRect>()) FRHICommandSetScissorRect(bEnable, MinX, MinY, MaxX, MaxY);
+	}
+
+	/** Records a shader parameter. The value is copied, so the caller's memory may be reused as soon as this returns. */
+	template<typename TShaderRHIParamRef>
+	FORCEINLINE void SetShaderParameter(TShaderRHIParamRef Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue)
+	{
+		void* ValueCopy = Alloc(NumBytes, 16);
+		FMemory::Memcpy(ValueCopy, NewValue, NumBytes);
+		new (AllocCommand<TRHICommandSetShaderParameter<TShaderRHIParamRef> >()) TRHICommandSetShaderParameter<TShaderRHIParamRef>(Shader, BufferIndex, BaseIndex, NumBytes, ValueCopy);
+	}
+
+	template<typename TShaderRHIParamRef>
+	FORCEINLINE void SetShaderTexture(TShaderRHIParamRef Shader, uint32 TextureIndex, FTextureRHIParamRef NewTexture)
+	{
+		new (AllocCommand<TRHICommandSetShaderTexture<TShaderRHIParamRef> >()) TRHICommandSetShaderTexture<TShaderRHIParamRef>(Shader, TextureIndex, NewTexture);
+	}
+
+	template<typename TShaderRHIParamRef>
+	FORCEINLINE void SetShaderSampler(TShaderRHIParamRef Shader, uint32 SamplerIndex, FSamplerStateRHIParamRef NewState)
+	{
+		new (AllocCommand<TRHICommandSetShaderSampler<TShaderRHIParamRef> >()) TRHICommandSetShaderSampler<TShaderRHIParamRef>(Shader, SamplerIndex, NewState);
+	}
+
+	template<typename TShaderRHIParamRef>
+	FORCEINLINE void SetShaderResourceViewParameter(TShaderRHIParamRef Shader, uint32 SamplerIndex, FShaderResourceViewRHIParamRef SRV)
+	{
+		new (AllocCommand<TRHICommandSetShaderResourceViewParameter<TShaderRHIParamRef> >()) TRHICommandSetShaderResourceViewParameter<TShaderRHIParamRef>(Shader, SamplerIndex, SRV);
+	}
+
+	template<typename TShaderRHIParamRef>
+	FORCEINLINE void SetShaderUniformBuffer(TShaderRHIParamRef Shader, uint32 BufferIndex, FUniformBufferRHIParamRef Buffer)
+	{
+		new (AllocCommand<TRHICommandSetShaderUniformBuffer<TShaderRHIParamRef> >()) TRHICommandSetShaderUniformBuffer<TShaderRHIParamRef>(Shader, BufferIndex, Buffer);
+	}
+
+	FORCEINLINE void DrawPrimitive(uint32 PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances)
+	{
+		new (AllocCommand<FRHICommandDrawPrimitive>()) FRHICommandDrawPrimitive(PrimitiveType, BaseVertexIndex, NumPrimitives, NumInstances);
+	}
+
+	FORCEINLINE void DrawIndexedPrimitive(FIndexBufferRHIParamRef IndexBuffer, uint32 PrimitiveType, int32 BaseVertexIndex, uint32 MinIndex, uint32 NumVertices, uint32 StartIndex, uint32 NumPrimitives, uint32 NumInstances)
+	{
+		new (AllocCommand<FRHICommandDrawIndexedPrimitive>()) FRHICommandDrawIndexedPrimitive(IndexBuffer, PrimitiveType, BaseVertexIndex, MinIndex, NumVertices, StartIndex, NumPrimitives, NumInstances);
+	}
+
+	/**
+	 * Allocates and links a command of type TCmd, which the caller then constructs in place.
+	 * Custom commands derived from TRHICommand may be recorded this way as well.
+	 */
+	template<typename TCmd>
+	FORCEINLINE void* AllocCommand()
+	{
+		checkAtCompileTime(HAS_TRIVIAL_DESTRUCTOR(TCmd), RHICommandsMustBeTriviallyDestructible);
+		FRHICommandBase* Command = (FRHICommandBase*)Alloc(sizeof(TCmd), ALIGNOF(TCmd));
+		*CommandLink = Command;
+		CommandLink = &Command->Next;
+		NumCommands++;
+		return Command;
+	}
+
+private:
+
+	enum { DEFAULT_CHUNK_SIZE = 64 * 1024 };
+
+	/** Header of a block of arena memory; the usable memory follows it. */
+	struct FChunk
+	{
+		FChunk* Next;
+		int32 Size;
+
+		uint8* GetData() { return (uint8*)(this + 1); }
+	};
+
+	/** Moves to the next chunk that can hold the allocation, allocating one if needed, and allocates from it. */
+	void* AllocNewChunk(int32 AllocSize, int32 Alignment);
+
+	/** The first recorded command. */
+	FRHICommandBase* Root;
+	/** Where the next recorded command is linked. */
+	FRHICommandBase** CommandLink;
+	int32 NumCommands;
+
+	/** Allocation cursor and end of the current chunk. */
+	uint8* Top;
+	uint8* End;
+	/** All chunks owned by the list, in allocation order, and the one being allocated from. */
+	FChunk* FirstChunk;
+	FChunk* CurrentChunk;
+	int32 ChunkSize;
+};
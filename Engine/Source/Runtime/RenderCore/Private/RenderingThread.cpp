@@ -11,6 +11,8 @@
 #include "ExceptionHandling.h"
 #include "TaskGraphInterfaces.h"
 #include "StatsData.h"
+#include "RHIStaticStates.h"
+#include "ParallelFor.h"
 
 //
 // Globals
@@ -790,3 +792,126 @@ FPendingCleanupObjects* GetPendingCleanupObjects()
 {
 	return new FPendingCleanupObjects;
 }
+
+/*-----------------------------------------------------------------------------
+	RHI command list benchmark.
+-----------------------------------------------------------------------------*/
+
+/** Forwards the command list recording functions straight to the RHI, so the same draw loop can be timed without recording. */
+struct FImmediateBenchmarkRHI
+{
+	void SetStreamSource(uint32 StreamIndex, FVertexBufferRHIParamRef VertexBuffer, uint32 Stride, uint32 Offset) { RHISetStreamSource(StreamIndex, VertexBuffer, Stride, Offset); }
+	void SetRasterizerState(FRasterizerStateRHIParamRef NewState) { RHISetRasterizerState(NewState); }
+	void SetDepthStencilState(FDepthStencilStateRHIParamRef NewState) { RHISetDepthStencilState(NewState, 0); }
+	void SetBlendState(FBlendStateRHIParamRef NewState) { RHISetBlendState(NewState, FLinearColor::White); }
+	void SetShaderParameter(FVertexShaderRHIParamRef Shader, uint32 BufferIndex, uint32 BaseIndex, uint32 NumBytes, const void* NewValue) { RHISetShaderParameter(Shader, BufferIndex, BaseIndex, NumBytes, NewValue); }
+	void DrawIndexedPrimitive(FIndexBufferRHIParamRef IndexBuffer, uint32 PrimitiveType, int32 BaseVertexIndex, uint32 MinIndex, uint32 NumVertices, uint32 StartIndex, uint32 NumPrimitives, uint32 NumInstances) { RHIDrawIndexedPrimitive(IndexBuffer, PrimitiveType, BaseVertexIndex, MinIndex, NumVertices, StartIndex, NumPrimitives, NumInstances); }
+};
+
+/** Resources shared by every benchmark draw. The static states are fetched on the rendering thread, their first use is not thread safe. */
+struct FBenchmarkDrawResources
+{
+	FVertexBufferRHIRef VertexBuffer;
+	FIndexBufferRHIRef IndexBuffer;
+	FRasterizerStateRHIParamRef RasterizerState;
+	FDepthStencilStateRHIParamRef DepthStencilState;
+	FBlendStateRHIParamRef BlendState;
+};
+
+/** Issues the commands of a typical mesh draw: vertex stream, pipeline state, a transform and an indexed draw. */
+template<typename TRHICmdList>
+static void RecordBenchmarkDraws(TRHICmdList& RHICmdList, const FBenchmarkDrawResources& Resources, int32 FirstDraw, int32 NumDraws)
+{
+	for (int32 DrawIndex = FirstDraw; DrawIndex < FirstDraw + NumDraws; DrawIndex++)
+	{
+		const FMatrix LocalToWorld = FTranslationMatrix(FVector(DrawIndex, 0, 0));
+		RHICmdList.SetStreamSource(0, Resources.VertexBuffer, 32, (DrawIndex & 63) * 32);
+		RHICmdList.SetRasterizerState(Resources.RasterizerState);
+		RHICmdList.SetDepthStencilState(Resources.DepthStencilState);
+		RHICmdList.SetBlendState(Resources.BlendState);
+		RHICmdList.SetShaderParameter((FVertexShaderRHIParamRef)NULL, 0, 0, sizeof(LocalToWorld), &LocalToWorld);
+		RHICmdList.DrawIndexedPrimitive(Resources.IndexBuffer, PT_TriangleList, 0, 0, 64, 0, 32, 1);
+	}
+}
+
+/** Times the same draws issued immediately, recorded into one list and recorded into NumLists lists in parallel. */
+static void RunRHICommandListBenchmark(int32 NumDraws, int32 NumLists)
+{
+	check(IsInRenderingThread());
+
+	FBenchmarkDrawResources Resources;
+	Resources.VertexBuffer = RHICreateVertexBuffer(64 * 32, NULL, BUF_Static);
+	Resources.IndexBuffer = RHICreateIndexBuffer(sizeof(uint16), 96 * sizeof(uint16), NULL, BUF_Static);
+	Resources.RasterizerState = TStaticRasterizerState<>::GetRHI();
+	Resources.DepthStencilState = TStaticDepthStencilState<>::GetRHI();
+	Resources.BlendState = TStaticBlendState<>::GetRHI();
+
+	double StartTime = FPlatformTime::Seconds();
+	FImmediateBenchmarkRHI ImmediateRHI;
+	RecordBenchmarkDraws(ImmediateRHI, Resources, 0, NumDraws);
+	const double ImmediateTime = FPlatformTime::Seconds() - StartTime;
+
+	FRHICommandList SerialList;
+	StartTime = FPlatformTime::Seconds();
+	RecordBenchmarkDraws(SerialList, Resources, 0, NumDraws);
+	const double SerialRecordTime = FPlatformTime::Seconds() - StartTime;
+	const int32 NumCommands = SerialList.GetNumCommands();
+	const int32 ArenaSize = SerialList.GetAllocatedSize();
+	StartTime = FPlatformTime::Seconds();
+	SerialList.Execute();
+	const double SerialExecuteTime = FPlatformTime::Seconds() - StartTime;
+
+	TArray<FRHICommandList*> Lists;
+	for (int32 ListIndex = 0; ListIndex < NumLists; ListIndex++)
+	{
+		Lists.Add(new FRHICommandList());
+	}
+	const int32 DrawsPerList = FMath::DivideAndRoundUp(NumDraws, NumLists);
+	StartTime = FPlatformTime::Seconds();
+	ParallelFor(NumLists, [&Lists, &Resources, DrawsPerList, NumDraws](int32 ListIndex)
+	{
+		const int32 FirstDraw = ListIndex * DrawsPerList;
+		RecordBenchmarkDraws(*Lists[ListIndex], Resources, FirstDraw, FMath::Clamp(NumDraws - FirstDraw, 0, DrawsPerList));
+	}, EParallelForFlags::AllowNamedThreadCaller);
+	const double ParallelRecordTime = FPlatformTime::Seconds() - StartTime;
+	StartTime = FPlatformTime::Seconds();
+	FRHICommandList::ExecuteLists(Lists.GetData(), Lists.Num());
+	const double ParallelExecuteTime = FPlatformTime::Seconds() - StartTime;
+	for (int32 ListIndex = 0; ListIndex < NumLists; ListIndex++)
+	{
+		delete Lists[ListIndex];
+	}
+
+	UE_LOG(LogRendererCore, Display, TEXT("RHI command list benchmark: %d draws, %d commands, %.1f KB recorded"), NumDraws, NumCommands, ArenaSize / 1024.0f);
+	UE_LOG(LogRendererCore, Display, TEXT("  Immediate:                        %.2f ms"), ImmediateTime * 1000.0);
+	UE_LOG(LogRendererCore, Display, TEXT("  One list:       record %.2f ms, execute %.2f ms"), SerialRecordTime * 1000.0, SerialExecuteTime * 1000.0);
+	UE_LOG(LogRendererCore, Display, TEXT("  %3d lists:      record %.2f ms, execute %.2f ms"), NumLists, ParallelRecordTime * 1000.0, ParallelExecuteTime * 1000.0);
+}
+
+static void RHICommandListBenchmark(const TArray<FString>& Args)
+{
+	if (!GUsingNullRHI)
+	{
+		// the benchmark draws without a bound shader state, which only the null RHI accepts
+		UE_LOG(LogRendererCore, Warning, TEXT("r.RHICmdListBenchmark needs the null RHI, run with -nullrhi."));
+		return;
+	}
+
+	const int32 NumDraws = FMath::Max(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000, 1);
+	const int32 NumLists = FMath::Max(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1);
+	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		FRHICommandListBenchmarkCommand,
+		int32,NumDraws,NumDraws,
+		int32,NumLists,NumLists,
+	{
+		RunRHICommandListBenchmark(NumDraws, NumLists);
+	});
+	FlushRenderingCommands();
+}
+
+static FAutoConsoleCommand GRHICommandListBenchmarkCmd(
+	TEXT("r.RHICmdListBenchmark"),
+	TEXT("Times recording and executing RHI command lists against issuing the same draws immediately. Requires -nullrhi.\n")
+	TEXT("Usage: r.RHICmdListBenchmark [NumDraws=100000] [NumLists=NumWorkerThreads+1]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(RHICommandListBenchmark)
+	);
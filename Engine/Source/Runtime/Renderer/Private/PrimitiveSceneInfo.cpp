@@ -200,6 +200,7 @@ void FPrimitiveSceneInfo::AddToScene(bool bUpdateStaticDrawLists)
 	PrimitiveBounds.BoxExtent = BoxSphereBounds.BoxExtent;
 	PrimitiveBounds.MinDrawDistanceSq = FMath::Square(Proxy->GetMinDrawDistance());
 	PrimitiveBounds.MaxDrawDistance = Proxy->GetMaxDrawDistance();
+	Scene->PrimitiveCullBounds.Set(PackedIndex, PrimitiveBounds);
 
 	// Store precomputed visibility ID.
 	int32 VisibilityBitIndex = Proxy->GetVisibilityId();
@@ -90,6 +90,7 @@ SIZE_T FScene::GetSizeBytes() const
 void FScene::CheckPrimitiveArrays()
 {
 	check(Primitives.Num() == PrimitiveBounds.Num());
+	check(Primitives.Num() == PrimitiveCullBounds.Num());
 	check(Primitives.Num() == PrimitiveVisibilityIds.Num());
 	check(Primitives.Num() == PrimitiveOcclusionFlags.Num());
 	check(Primitives.Num() == PrimitiveComponentIds.Num());
@@ -106,6 +107,7 @@ void FScene::AddPrimitiveSceneInfo_RenderThread(FPrimitiveSceneInfo* PrimitiveSc
 	PrimitiveSceneInfo->PackedIndex = PrimitiveIndex;
 
 	PrimitiveBounds.AddUninitialized();
+	PrimitiveCullBounds.Add();
 	PrimitiveVisibilityIds.AddUninitialized();
 	PrimitiveOcclusionFlags.AddUninitialized();
 	PrimitiveComponentIds.AddUninitialized();
@@ -477,6 +479,7 @@ void FScene::RemovePrimitiveSceneInfo_RenderThread(FPrimitiveSceneInfo* Primitiv
 	int32 PrimitiveIndex = PrimitiveSceneInfo->PackedIndex;
 	Primitives.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveBounds.RemoveAtSwap(PrimitiveIndex);
+	PrimitiveCullBounds.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveVisibilityIds.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveOcclusionFlags.RemoveAtSwap(PrimitiveIndex);
 	PrimitiveComponentIds.RemoveAtSwap(PrimitiveIndex);
@@ -1830,6 +1833,7 @@ void FScene::ApplyWorldOffset_RenderThread(FVector InOffset)
 	{
 		(*It).Origin+= InOffset;
 	}
+	PrimitiveCullBounds.ApplyOffset(InOffset);
 
 	// Primitive occlusion bounds
 	for (auto It = PrimitiveOcclusionBounds.CreateIterator(); It; ++It)
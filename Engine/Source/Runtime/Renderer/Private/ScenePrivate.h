@@ -1032,6 +1032,136 @@ struct FPrimitiveBounds
 	float MaxDrawDistance;
 };
 
+/**
+ * The culling bounds of four primitives, stored component by component so that vector math can test all four at once.
+ */
+struct FPrimitiveCullBoundsBlock
+{
+	float OriginX[4];
+	float OriginY[4];
+	float OriginZ[4];
+	float SphereRadius[4];
+	float BoxExtentX[4];
+	float BoxExtentY[4];
+	float BoxExtentZ[4];
+	float MinDrawDistanceSq[4];
+	float MaxDrawDistance[4];
+};
+
+/**
+ * A copy of FScene::PrimitiveBounds in blocks of four primitives, in the same packed order, used by frustum culling.
+ * Lanes past the last primitive are set up to always be culled.
+ */
+class FPrimitiveCullBounds
+{
+public:
+
+	FPrimitiveCullBounds()
+		: NumPrimitives(0)
+	{
+	}
+
+	/** @return the number of primitives */
+	int32 Num() const
+	{
+		return NumPrimitives;
+	}
+
+	/** @return the blocks of bounds, enough to hold Num() primitives */
+	const FPrimitiveCullBoundsBlock* GetBlocks() const
+	{
+		return Blocks.GetTypedData();
+	}
+
+	/** Adds a primitive at the end. Its bounds must be set before the next cull. */
+	void Add()
+	{
+		if (NumPrimitives % 4 == 0)
+		{
+			FPrimitiveCullBoundsBlock& Block = Blocks[Blocks.AddUninitialized()];
+			for (int32 Lane = 0; Lane < 4; Lane++)
+			{
+				ResetLane(Block, Lane);
+			}
+		}
+		NumPrimitives++;
+	}
+
+	/** Sets the bounds of a primitive. */
+	void Set(int32 Index, const FPrimitiveBounds& Bounds)
+	{
+		checkSlow(Index >= 0 && Index < NumPrimitives);
+		FPrimitiveCullBoundsBlock& Block = Blocks[Index / 4];
+		const int32 Lane = Index % 4;
+		Block.OriginX[Lane] = Bounds.Origin.X;
+		Block.OriginY[Lane] = Bounds.Origin.Y;
+		Block.OriginZ[Lane] = Bounds.Origin.Z;
+		Block.SphereRadius[Lane] = Bounds.SphereRadius;
+		Block.BoxExtentX[Lane] = Bounds.BoxExtent.X;
+		Block.BoxExtentY[Lane] = Bounds.BoxExtent.Y;
+		Block.BoxExtentZ[Lane] = Bounds.BoxExtent.Z;
+		Block.MinDrawDistanceSq[Lane] = Bounds.MinDrawDistanceSq;
+		Block.MaxDrawDistance[Lane] = Bounds.MaxDrawDistance;
+	}
+
+	/** Removes a primitive by moving the last one into its place, matching TArray::RemoveAtSwap. */
+	void RemoveAtSwap(int32 Index)
+	{
+		checkSlow(Index >= 0 && Index < NumPrimitives);
+		const int32 LastIndex = NumPrimitives - 1;
+		FPrimitiveCullBoundsBlock& LastBlock = Blocks[LastIndex / 4];
+		const int32 LastLane = LastIndex % 4;
+		if (Index != LastIndex)
+		{
+			FPrimitiveCullBoundsBlock& Block = Blocks[Index / 4];
+			const int32 Lane = Index % 4;
+			Block.OriginX[Lane] = LastBlock.OriginX[LastLane];
+			Block.OriginY[Lane] = LastBlock.OriginY[LastLane];
+			Block.OriginZ[Lane] = LastBlock.OriginZ[LastLane];
+			Block.SphereRadius[Lane] = LastBlock.SphereRadius[LastLane];
+			Block.BoxExtentX[Lane] = LastBlock.BoxExtentX[LastLane];
+			Block.BoxExtentY[Lane] = LastBlock.BoxExtentY[LastLane];
+			Block.BoxExtentZ[Lane] = LastBlock.BoxExtentZ[LastLane];
+			Block.MinDrawDistanceSq[Lane] = LastBlock.MinDrawDistanceSq[LastLane];
+			Block.MaxDrawDistance[Lane] = LastBlock.MaxDrawDistance[LastLane];
+		}
+		ResetLane(LastBlock, LastLane);
+		NumPrimitives--;
+		if (NumPrimitives % 4 == 0)
+		{
+			Blocks.Pop();
+		}
+	}
+
+	/** Moves every primitive by the given offset. */
+	void ApplyOffset(const FVector& Offset)
+	{
+		for (int32 Index = 0; Index < NumPrimitives; Index++)
+		{
+			FPrimitiveCullBoundsBlock& Block = Blocks[Index / 4];
+			const int32 Lane = Index % 4;
+			Block.OriginX[Lane] += Offset.X;
+			Block.OriginY[Lane] += Offset.Y;
+			Block.OriginZ[Lane] += Offset.Z;
+		}
+	}
+
+private:
+
+	/** Sets a lane up so that it is culled by the distance test whatever the view. */
+	static void ResetLane(FPrimitiveCullBoundsBlock& Block, int32 Lane)
+	{
+		Block.OriginX[Lane] = Block.OriginY[Lane] = Block.OriginZ[Lane] = 0.0f;
+		Block.SphereRadius[Lane] = 0.0f;
+		Block.BoxExtentX[Lane] = Block.BoxExtentY[Lane] = Block.BoxExtentZ[Lane] = 0.0f;
+		Block.MinDrawDistanceSq[Lane] = FLT_MAX;
+		Block.MaxDrawDistance[Lane] = 0.0f;
+	}
+
+	TArray<FPrimitiveCullBoundsBlock> Blocks;
+	int32 NumPrimitives;
+};
+
 /**
  * Precomputed primitive visibility ID.
  */
@@ -1178,6 +1308,8 @@ public:
 	TArray<FPrimitiveSceneInfo*> Primitives;
 	/** Packed array of primitive bounds. */
 	TArray<FPrimitiveBounds> PrimitiveBounds;
+	/** The same bounds in blocks of four primitives, for frustum culling. */
+	FPrimitiveCullBounds PrimitiveCullBounds;
 	/** Packed array of precomputed primitive visibility IDs. */
 	TArray<FPrimitiveVisibilityId> PrimitiveVisibilityIds;
 	/** Packed array of primitive occlusion flags. See EOcclusionFlags. */
@@ -8,6 +8,7 @@
 #include "EnginePrivate.h"
 #include "ScenePrivate.h"
 #include "FXSystem.h"
+#include "ParallelFor.h"
 #include "../../Engine/Private/SkeletalRenderGPUSkin.h"		// GPrevPerBoneMotionBlur
 
 /*------------------------------------------------------------------------------
@@ -205,57 +206,177 @@ bool FViewInfo::IsDistanceCulled( float DistanceSquared, float MinDrawDistance,
 	return ( bDistanceCulled && !bStillFading );
 }
 
+static int32 GParallelFrustumCull = 1;
+static FAutoConsoleVariableRef CVarParallelFrustumCull(
+	TEXT("r.ParallelFrustumCull"),
+	GParallelFrustumCull,
+	TEXT("Whether frustum culling is spread over the task graph worker threads.\n")
+	TEXT(" 0: cull on the rendering thread only\n")
+	TEXT(" 1: cull in parallel (default)"),
+	ECVF_RenderThreadSafe
+	);
+
 /**
- * Frustum cull primitives in the scene against the view.
+ * View dependent inputs of the frustum cull.
  */
-static int32 FrustumCull(const FScene* Scene, FViewInfo& View)
+struct FFrustumCullParams
 {
-	SCOPE_CYCLE_COUNTER(STAT_FrustumCull);
-
-	int32 NumCulledPrimitives = 0;
-	FVector ViewOriginForDistanceCulling = View.ViewMatrices.ViewOrigin;
-	float MaxDrawDistanceScale = GetCachedScalabilityCVars().ViewDistanceScale;
-	float FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
+	/** Frustum primitives must intersect. */
+	const FConvexVolume* ViewFrustum;
+	/** Origin draw distances are measured from. */
+	FVector ViewOrigin;
+	/** Scale applied to the max draw distance of every primitive. */
+	float MaxDrawDistanceScale;
+	/** Distance over which primitives fade in and out past their max draw distance. */
+	float FadeRadius;
+	/** If not NULL, the scene's primitives, and the max draw distance is ignored for those that aren't detail meshes. */
+	FPrimitiveSceneInfo* const* PrimitivesIgnoringMaxDrawDistance;
+};
+
+/** @return the number of set bits in Bits */
+static FORCEINLINE int32 CountSetBits(uint32 Bits)
+{
+	Bits = Bits - ((Bits >> 1) & 0x55555555);
+	Bits = (Bits & 0x33333333) + ((Bits >> 2) & 0x33333333);
+	return (((Bits + (Bits >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+}
 
-	for (FSceneBitArray::FIterator BitIt(View.PrimitiveVisibilityMap); BitIt; ++BitIt)
+/**
+ * Frustum and distance culls the primitives of one 32 bit word of the visibility maps, four primitives at a time.
+ * Does the same tests in the same order as FConvexVolume::IntersectSphere and IntersectBox, so the results match the scalar path.
+ *
+ * @param CullBounds		bounds of the scene's primitives
+ * @param Params			view dependent inputs
+ * @param WordIndex			index of the word, the primitives culled are [WordIndex * 32, WordIndex * 32 + 32)
+ * @param InOutVisibleWord	receives a bit for every visible primitive
+ * @param InOutFadingWord	receives a bit for every primitive that may be fading
+ * @return the number of culled primitives
+ */
+static int32 FrustumCullWord(const FPrimitiveCullBounds& CullBounds, const FFrustumCullParams& Params, int32 WordIndex, uint32& InOutVisibleWord, uint32& InOutFadingWord)
+{
+	const FPrimitiveCullBoundsBlock* Blocks = CullBounds.GetBlocks();
+	const int32 FirstPrimitive = WordIndex * NumBitsPerDWORD;
+	const int32 NumWordPrimitives = FMath::Min<int32>(NumBitsPerDWORD, CullBounds.Num() - FirstPrimitive);
+	const FPlane* Planes = Params.ViewFrustum->Planes.GetTypedData();
+	const int32 NumPlanes = Params.ViewFrustum->Planes.Num();
+	static const float NoMaxDrawDistance = FLT_MAX;
+
+	const VectorRegister ViewOriginX = VectorLoadFloat1(&Params.ViewOrigin.X);
+	const VectorRegister ViewOriginY = VectorLoadFloat1(&Params.ViewOrigin.Y);
+	const VectorRegister ViewOriginZ = VectorLoadFloat1(&Params.ViewOrigin.Z);
+	const VectorRegister MaxDrawDistanceScale = VectorLoadFloat1(&Params.MaxDrawDistanceScale);
+	const VectorRegister FadeRadius = VectorLoadFloat1(&Params.FadeRadius);
+
+	uint32 CulledBits = 0;
+	uint32 VisibleBits = 0;
+	uint32 FadingBits = 0;
+	for (int32 BlockOffset = 0; BlockOffset < NumWordPrimitives; BlockOffset += 4)
 	{
-		const FPrimitiveBounds& Bounds = Scene->PrimitiveBounds[BitIt.GetIndex()];
-		float DistanceSquared = (Bounds.Origin - ViewOriginForDistanceCulling).SizeSquared();
-		float MaxDrawDistance = Bounds.MaxDrawDistance * MaxDrawDistanceScale;
-
-		// If cull distance is disabled, always show (except foliage)
-		if (View.Family->EngineShowFlags.DistanceCulledPrimitives
-			&& !Scene->Primitives[BitIt.GetIndex()]->Proxy->IsDetailMesh())
+		const FPrimitiveCullBoundsBlock& Block = Blocks[(FirstPrimitive + BlockOffset) / 4];
+		const VectorRegister OriginX = VectorLoad(Block.OriginX);
+		const VectorRegister OriginY = VectorLoad(Block.OriginY);
+		const VectorRegister OriginZ = VectorLoad(Block.OriginZ);
+
+		// Distance to the view
+		const VectorRegister DeltaX = VectorSubtract(OriginX, ViewOriginX);
+		const VectorRegister DeltaY = VectorSubtract(OriginY, ViewOriginY);
+		const VectorRegister DeltaZ = VectorSubtract(OriginZ, ViewOriginZ);
+		const VectorRegister DistanceSquared = VectorMultiplyAdd(DeltaZ, DeltaZ, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaX, DeltaX)));
+
+		VectorRegister MaxDrawDistance = VectorMultiply(VectorLoad(Block.MaxDrawDistance), MaxDrawDistanceScale);
+		if (Params.PrimitivesIgnoringMaxDrawDistance)
 		{
-			MaxDrawDistance = FLT_MAX;
+			// If cull distance is disabled, always show (except foliage)
+			float MaxDrawDistances[4];
+			VectorStore(MaxDrawDistance, MaxDrawDistances);
+			for (int32 Lane = 0; Lane < 4 && BlockOffset + Lane < NumWordPrimitives; Lane++)
+			{
+				if (!Params.PrimitivesIgnoringMaxDrawDistance[FirstPrimitive + BlockOffset + Lane]->Proxy->IsDetailMesh())
+				{
+					MaxDrawDistances[Lane] = NoMaxDrawDistance;
+				}
+			}
+			MaxDrawDistance = VectorLoad(MaxDrawDistances);
 		}
+		const VectorRegister MaxFadeDistance = VectorAdd(MaxDrawDistance, FadeRadius);
+		const VectorRegister MinFadeDistance = VectorSubtract(MaxDrawDistance, FadeRadius);
 
 		// The primitive is always culled if it exceeds the max fade distance or lay outside the view frustum.
-		if (DistanceSquared > FMath::Square(MaxDrawDistance + FadeRadius) ||
-			DistanceSquared < Bounds.MinDrawDistanceSq ||
-			View.ViewFrustum.IntersectSphere(Bounds.Origin, Bounds.SphereRadius) == false ||
-			View.ViewFrustum.IntersectBox(Bounds.Origin, Bounds.BoxExtent) == false)
+		VectorRegister Culled = VectorBitwiseOr(
+			VectorCompareGT(DistanceSquared, VectorMultiply(MaxFadeDistance, MaxFadeDistance)),
+			VectorCompareGT(VectorLoad(Block.MinDrawDistanceSq), DistanceSquared));
+
+		const VectorRegister SphereRadius = VectorLoad(Block.SphereRadius);
+		const VectorRegister AbsExtentX = VectorAbs(VectorLoad(Block.BoxExtentX));
+		const VectorRegister AbsExtentY = VectorAbs(VectorLoad(Block.BoxExtentY));
+		const VectorRegister AbsExtentZ = VectorAbs(VectorLoad(Block.BoxExtentZ));
+		for (int32 PlaneIndex = 0; PlaneIndex < NumPlanes; PlaneIndex++)
 		{
-			STAT(NumCulledPrimitives++);
-			continue;
+			const FPlane& Plane = Planes[PlaneIndex];
+			const VectorRegister PlaneX = VectorLoadFloat1(&Plane.X);
+			const VectorRegister PlaneY = VectorLoadFloat1(&Plane.Y);
+			const VectorRegister PlaneZ = VectorLoadFloat1(&Plane.Z);
+			const VectorRegister PlaneW = VectorLoadFloat1(&Plane.W);
+			const VectorRegister Distance = VectorSubtract(VectorMultiplyAdd(OriginZ, PlaneZ, VectorMultiplyAdd(OriginY, PlaneY, VectorMultiply(OriginX, PlaneX))), PlaneW);
+			const VectorRegister PushOut = VectorMultiplyAdd(AbsExtentZ, VectorAbs(PlaneZ), VectorMultiplyAdd(AbsExtentY, VectorAbs(PlaneY), VectorMultiply(AbsExtentX, VectorAbs(PlaneX))));
+			Culled = VectorBitwiseOr(Culled, VectorBitwiseOr(VectorCompareGT(Distance, SphereRadius), VectorCompareGT(Distance, PushOut)));
 		}
 
-		if (DistanceSquared > FMath::Square(MaxDrawDistance))
-		{
-			View.PotentiallyFadingPrimitiveMap.AccessCorrespondingBit(BitIt) = true;
-		}
-		else
+		const uint32 CulledMask = VectorMaskBits(Culled);
+		const uint32 BeyondMaxDrawDistanceMask = VectorMaskBits(VectorCompareGT(DistanceSquared, VectorMultiply(MaxDrawDistance, MaxDrawDistance)));
+		const uint32 FadeBandMask = VectorMaskBits(VectorCompareGT(DistanceSquared, VectorMultiply(MinFadeDistance, MinFadeDistance)));
+		CulledBits |= CulledMask << BlockOffset;
+		// Primitives past their max draw distance are only potentially fading, the others are visible and may be fading in or out.
+		VisibleBits |= (~CulledMask & ~BeyondMaxDrawDistanceMask & 0xf) << BlockOffset;
+		FadingBits |= (~CulledMask & (BeyondMaxDrawDistanceMask | FadeBandMask) & 0xf) << BlockOffset;
+	}
+
+	// Lanes past the last primitive are always culled, and don't count.
+	const uint32 ValidBits = NumWordPrimitives == NumBitsPerDWORD ? 0xffffffff : ((1u << NumWordPrimitives) - 1);
+	InOutVisibleWord |= VisibleBits & ValidBits;
+	InOutFadingWord |= FadingBits & ValidBits;
+	return CountSetBits(CulledBits & ValidBits);
+}
+
+/**
+ * Frustum and distance culls primitives, one visibility word per iteration of a ParallelFor.
+ * Each word is written by a single iteration, so the maps need no synchronization.
+ *
+ * @return the number of culled primitives
+ */
+static int32 FrustumCullPrimitives(const FPrimitiveCullBounds& CullBounds, const FFrustumCullParams& Params, uint32* VisibleWords, uint32* FadingWords, bool bParallel)
+{
+	const int32 NumWords = (CullBounds.Num() + NumBitsPerDWORD - 1) / NumBitsPerDWORD;
+	FThreadSafeCounter NumCulledPrimitives;
+	ParallelFor(NumWords, [&](int32 WordIndex)
+	{
+		const int32 NumCulledInWord = FrustumCullWord(CullBounds, Params, WordIndex, VisibleWords[WordIndex], FadingWords[WordIndex]);
+		if (NumCulledInWord)
 		{
-			// The primitive is visible!
-			BitIt.GetValue() = true;
-			if (DistanceSquared > FMath::Square(MaxDrawDistance - FadeRadius))
-			{
-				View.PotentiallyFadingPrimitiveMap.AccessCorrespondingBit(BitIt) = true;
-			}
+			NumCulledPrimitives.Add(NumCulledInWord);
 		}
-	}
+	}, bParallel ? EParallelForFlags::AllowNamedThreadCaller : EParallelForFlags::ForceSingleThread);
+	return NumCulledPrimitives.GetValue();
+}
+
+/**
+ * Frustum cull primitives in the scene against the view.
+ */
+static int32 FrustumCull(const FScene* Scene, FViewInfo& View)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FrustumCull);
+
+	check(View.PrimitiveVisibilityMap.Num() == Scene->PrimitiveCullBounds.Num());
+	check(View.PotentiallyFadingPrimitiveMap.Num() == Scene->PrimitiveCullBounds.Num());
 
-	return NumCulledPrimitives;
+	FFrustumCullParams Params;
+	Params.ViewFrustum = &View.ViewFrustum;
+	Params.ViewOrigin = View.ViewMatrices.ViewOrigin;
+	Params.MaxDrawDistanceScale = GetCachedScalabilityCVars().ViewDistanceScale;
+	Params.FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
+	Params.PrimitivesIgnoringMaxDrawDistance = View.Family->EngineShowFlags.DistanceCulledPrimitives ? Scene->Primitives.GetTypedData() : NULL;
+
+	return FrustumCullPrimitives(Scene->PrimitiveCullBounds, Params, View.PrimitiveVisibilityMap.GetData(), View.PotentiallyFadingPrimitiveMap.GetData(), GParallelFrustumCull != 0);
 }
 
 /**
@@ -1544,3 +1665,144 @@ void FDeferredShadingSceneRenderer::InitViews()
 	OnStartFrame();
 }
 
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Exec handler for the frustum culling benchmark. It culls synthetic bounds rather than a scene and needs no RHI resources,
+ * so it also runs headless with -nullrhi.
+ */
+static class FFrustumCullBenchExec : private FSelfRegisteringExec
+{
+	/** The per primitive frustum cull that FrustumCullWord replaced, kept as a reference for its results and speed. */
+	static int32 FrustumCullReference(const TArray<FPrimitiveBounds>& PrimitiveBounds, const FFrustumCullParams& Params, TBitArray<>& VisibilityMap, TBitArray<>& FadingMap)
+	{
+		int32 NumCulledPrimitives = 0;
+		for (TBitArray<>::FIterator BitIt(VisibilityMap); BitIt; ++BitIt)
+		{
+			const FPrimitiveBounds& Bounds = PrimitiveBounds[BitIt.GetIndex()];
+			float DistanceSquared = (Bounds.Origin - Params.ViewOrigin).SizeSquared();
+			float MaxDrawDistance = Bounds.MaxDrawDistance * Params.MaxDrawDistanceScale;
+
+			if (DistanceSquared > FMath::Square(MaxDrawDistance + Params.FadeRadius) ||
+				DistanceSquared < Bounds.MinDrawDistanceSq ||
+				Params.ViewFrustum->IntersectSphere(Bounds.Origin, Bounds.SphereRadius) == false ||
+				Params.ViewFrustum->IntersectBox(Bounds.Origin, Bounds.BoxExtent) == false)
+			{
+				NumCulledPrimitives++;
+				continue;
+			}
+
+			if (DistanceSquared > FMath::Square(MaxDrawDistance))
+			{
+				FadingMap.AccessCorrespondingBit(BitIt) = true;
+			}
+			else
+			{
+				BitIt.GetValue() = true;
+				if (DistanceSquared > FMath::Square(MaxDrawDistance - Params.FadeRadius))
+				{
+					FadingMap.AccessCorrespondingBit(BitIt) = true;
+				}
+			}
+		}
+		return NumCulledPrimitives;
+	}
+
+	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) OVERRIDE
+	{
+		if (FParse::Command(&Cmd, TEXT("FRUSTUMCULLBENCH")))
+		{
+			int32 NumPrimitives = 200000;
+			int32 NumRuns = 20;
+			FParse::Value(Cmd, TEXT("NUM="), NumPrimitives);
+			FParse::Value(Cmd, TEXT("RUNS="), NumRuns);
+			NumPrimitives = FMath::Max(NumPrimitives, 1);
+			NumRuns = FMath::Max(NumRuns, 1);
+
+			// Primitives spread over a large level, a third of them with a cull distance.
+			FRandomStream RandomStream(0x5eed);
+			TArray<FPrimitiveBounds> PrimitiveBounds;
+			FPrimitiveCullBounds CullBounds;
+			PrimitiveBounds.AddUninitialized(NumPrimitives);
+			for (int32 PrimitiveIndex = 0; PrimitiveIndex < NumPrimitives; PrimitiveIndex++)
+			{
+				FPrimitiveBounds& Bounds = PrimitiveBounds[PrimitiveIndex];
+				Bounds.Origin = FVector(RandomStream.FRandRange(-200000.0f, 200000.0f), RandomStream.FRandRange(-200000.0f, 200000.0f), RandomStream.FRandRange(-5000.0f, 5000.0f));
+				Bounds.BoxExtent = FVector(RandomStream.FRandRange(50.0f, 1000.0f), RandomStream.FRandRange(50.0f, 1000.0f), RandomStream.FRandRange(50.0f, 1000.0f));
+				Bounds.SphereRadius = Bounds.BoxExtent.Size();
+				Bounds.MinDrawDistanceSq = 0.0f;
+				Bounds.MaxDrawDistance = RandomStream.FRand() < 0.33f ? RandomStream.FRandRange(5000.0f, 100000.0f) : FLT_MAX;
+				CullBounds.Add();
+				CullBounds.Set(PrimitiveIndex, Bounds);
+			}
+
+			const FVector ViewOrigin(0.0f, 0.0f, 200.0f);
+			const FMatrix ViewMatrix = FTranslationMatrix(-ViewOrigin) * FInverseRotationMatrix(FRotator(-10.0f, 30.0f, 0.0f)) * FMatrix(
+				FPlane(0,	0,	1,	0),
+				FPlane(1,	0,	0,	0),
+				FPlane(0,	1,	0,	0),
+				FPlane(0,	0,	0,	1));
+			const FMatrix ProjectionMatrix = FReversedZPerspectiveMatrix(90.0f * (float)PI / 360.0f, 16.0f, 9.0f, 10.0f);
+			FConvexVolume ViewFrustum;
+			GetViewFrustumBounds(ViewFrustum, ViewMatrix * ProjectionMatrix, true);
+
+			FFrustumCullParams Params;
+			Params.ViewFrustum = &ViewFrustum;
+			Params.ViewOrigin = ViewOrigin;
+			Params.MaxDrawDistanceScale = 1.0f;
+			Params.FadeRadius = GDistanceFadeMaxTravel;
+			Params.PrimitivesIgnoringMaxDrawDistance = NULL;
+
+			TBitArray<> ReferenceVisibilityMap;
+			TBitArray<> ReferenceFadingMap;
+			TBitArray<> VisibilityMap;
+			TBitArray<> FadingMap;
+			int32 NumReferenceCulled = 0;
+			int32 NumCulled = 0;
+			double ReferenceTime = 0.0;
+			double SingleThreadedTime = 0.0;
+			double ParallelTime = 0.0;
+			int32 NumMismatches = 0;
+			for (int32 Run = 0; Run < NumRuns; Run++)
+			{
+				ReferenceVisibilityMap.Init(false, NumPrimitives);
+				ReferenceFadingMap.Init(false, NumPrimitives);
+				double StartTime = FPlatformTime::Seconds();
+				NumReferenceCulled = FrustumCullReference(PrimitiveBounds, Params, ReferenceVisibilityMap, ReferenceFadingMap);
+				ReferenceTime += FPlatformTime::Seconds() - StartTime;
+
+				for (int32 Pass = 0; Pass < 2; Pass++)
+				{
+					const bool bParallel = Pass == 1;
+					VisibilityMap.Init(false, NumPrimitives);
+					FadingMap.Init(false, NumPrimitives);
+					StartTime = FPlatformTime::Seconds();
+					NumCulled = FrustumCullPrimitives(CullBounds, Params, VisibilityMap.GetData(), FadingMap.GetData(), bParallel);
+					(bParallel ? ParallelTime : SingleThreadedTime) += FPlatformTime::Seconds() - StartTime;
+
+					for (int32 PrimitiveIndex = 0; PrimitiveIndex < NumPrimitives; PrimitiveIndex++)
+					{
+						if (VisibilityMap[PrimitiveIndex] != ReferenceVisibilityMap[PrimitiveIndex] || FadingMap[PrimitiveIndex] != ReferenceFadingMap[PrimitiveIndex])
+						{
+							NumMismatches++;
+						}
+					}
+				}
+			}
+
+			Ar.Logf(TEXT("Frustum cull bench: %d primitives, %d culled, %d runs"), NumPrimitives, NumCulled, NumRuns);
+			Ar.Logf(TEXT("  per primitive:        %.3fms per cull (%d culled)"), ReferenceTime * 1000.0 / NumRuns, NumReferenceCulled);
+			Ar.Logf(TEXT("  vector, 1 thread:     %.3fms per cull (%.2fx)"), SingleThreadedTime * 1000.0 / NumRuns, ReferenceTime / FMath::Max(SingleThreadedTime, 0.000001));
+			Ar.Logf(TEXT("  vector, parallel:     %.3fms per cull (%.2fx)"), ParallelTime * 1000.0 / NumRuns, ReferenceTime / FMath::Max(ParallelTime, 0.000001));
+			if (NumMismatches)
+			{
+				Ar.Logf(TEXT("  %d results differ from the per primitive cull!"), NumMismatches);
+			}
+			return true;
+		}
+		return false;
+	}
+} FrustumCullBenchExec;
+
+#endif // !UE_BUILD_SHIPPING
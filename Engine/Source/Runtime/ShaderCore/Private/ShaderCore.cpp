@@ -71,6 +71,8 @@ DEFINE_STAT(STAT_ShaderCompiling_HLSLTranslation);
 DEFINE_STAT(STAT_ShaderCompiling_DDCLoading);
 DEFINE_STAT(STAT_ShaderCompiling_MaterialLoading);
 DEFINE_STAT(STAT_ShaderCompiling_MaterialCompiling);
+DEFINE_STAT(STAT_ShaderCompiling_NumJobCacheHits);
+DEFINE_STAT(STAT_ShaderCompiling_NumJobCacheMisses);
 
 DEFINE_STAT(STAT_ShaderCompiling_NumTotalMaterialShaders);
 DEFINE_STAT(STAT_ShaderCompiling_NumSpecialMaterialShaders);
@@ -216,6 +216,60 @@ bool FSocketBSD::RecvFrom(uint8* Data, int32 BufferSize, int32& BytesRead, FInte
 }
 
 
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_RECVMMSG
+bool FSocketBSD::RecvFromBatch(uint8* Data, int32 BufferSize, int32 MaxPackets, int32* BytesRead, FInternetAddr** Sources, int32& NumPacketsRead)
+{
+	// one recvmmsg call fetches as many packets as fit into the stack arrays
+	const int32 MaxPacketsPerCall = 64;
+	mmsghdr Messages[MaxPacketsPerCall];
+	iovec Vectors[MaxPacketsPerCall];
+
+	NumPacketsRead = 0;
+	while (NumPacketsRead < MaxPackets)
+	{
+		const int32 NumToRead = FMath::Min(MaxPackets - NumPacketsRead, MaxPacketsPerCall);
+		FMemory::Memzero(Messages, sizeof(mmsghdr) * NumToRead);
+		for (int32 Index = 0; Index < NumToRead; Index++)
+		{
+			const int32 PacketIndex = NumPacketsRead + Index;
+			Vectors[Index].iov_base = Data + PacketIndex * BufferSize;
+			Vectors[Index].iov_len = BufferSize;
+			Messages[Index].msg_hdr.msg_name = (sockaddr*)*(FInternetAddrBSD*)Sources[PacketIndex];
+			Messages[Index].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			Messages[Index].msg_hdr.msg_iov = &Vectors[Index];
+			Messages[Index].msg_hdr.msg_iovlen = 1;
+		}
+
+		const int32 NumRead = recvmmsg(Socket, Messages, NumToRead, MSG_DONTWAIT, NULL);
+		if (NumRead <= 0)
+		{
+			// errors surface again on the next call once the packets read so far have been handed out
+			break;
+		}
+
+		for (int32 Index = 0; Index < NumRead; Index++)
+		{
+			BytesRead[NumPacketsRead + Index] = Messages[Index].msg_len;
+		}
+		NumPacketsRead += NumRead;
+
+		if (NumRead < NumToRead)
+		{
+			// the socket has been drained
+			break;
+		}
+	}
+
+	if (NumPacketsRead > 0)
+	{
+		LastActivityTime = FDateTime::UtcNow();
+		return true;
+	}
+	return false;
+}
+#endif
+
+
 bool FSocketBSD::Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketReceiveFlags::Type Flags)
 {
 	BytesRead = recv(Socket, (char*)Data, BufferSize, Flags);
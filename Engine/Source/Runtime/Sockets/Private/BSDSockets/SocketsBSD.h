@@ -85,6 +85,10 @@ public:
 
 	virtual bool RecvFrom(uint8* Data, int32 BufferSize, int32& BytesRead, FInternetAddr& Source, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None) OVERRIDE;
 
+#if PLATFORM_HAS_BSD_SOCKET_FEATURE_RECVMMSG
+	virtual bool RecvFromBatch(uint8* Data, int32 BufferSize, int32 MaxPackets, int32* BytesRead, FInternetAddr** Sources, int32& NumPacketsRead) OVERRIDE;
+#endif
+
 	virtual bool Recv(uint8* Data,int32 BufferSize,int32& BytesRead, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None) OVERRIDE;
 
 	virtual bool Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime) OVERRIDE;
@@ -34,6 +34,22 @@ bool FSocket::RecvFrom(uint8* Data, int32 BufferSize, int32& BytesRead, FInterne
 }
 
 
+bool FSocket::RecvFromBatch(uint8* Data, int32 BufferSize, int32 MaxPackets, int32* BytesRead, FInternetAddr** Sources, int32& NumPacketsRead)
+{
+	NumPacketsRead = 0;
+	while (NumPacketsRead < MaxPackets)
+	{
+		if (!RecvFrom(Data + NumPacketsRead * BufferSize, BufferSize, BytesRead[NumPacketsRead], *Sources[NumPacketsRead]))
+		{
+			// errors surface again on the next call once the packets read so far have been handed out
+			break;
+		}
+		NumPacketsRead++;
+	}
+	return NumPacketsRead > 0;
+}
+
+
 bool FSocket::Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketReceiveFlags::Type Flags)
 {
 	if( BytesRead > 0 )
@@ -145,6 +145,21 @@ public:
 	 */
 	virtual bool RecvFrom(uint8* Data, int32 BufferSize, int32& BytesRead, FInternetAddr& Source, ESocketReceiveFlags::Type Flags = ESocketReceiveFlags::None);
 
+	/**
+	 * Reads several datagrams from the socket at once, gathering the source address of each.
+	 * Packet i is read into Data + i * BufferSize. The base implementation calls RecvFrom once
+	 * per packet; platforms that can fetch a batch with a single system call override it.
+	 *
+	 * @param Data the buffer to read into, MaxPackets * BufferSize bytes large
+	 * @param BufferSize the max size of a single packet
+	 * @param MaxPackets the max number of packets to read
+	 * @param BytesRead array of MaxPackets entries receiving the size of each packet read
+	 * @param Sources array of MaxPackets addresses receiving the sender of each packet read
+	 * @param NumPacketsRead out param indicating how many packets were read
+	 * @return false if not even one packet could be read, in which case the socket subsystem holds the error
+	 */
+	virtual bool RecvFromBatch(uint8* Data, int32 BufferSize, int32 MaxPackets, int32* BytesRead, FInternetAddr** Sources, int32& NumPacketsRead);
+
 	/**
 	 * Reads a chunk of data from a connected socket
 	 *